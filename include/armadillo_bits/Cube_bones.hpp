@@ -51,6 +51,7 @@ class Cube : public BaseCube< eT, Cube<eT> >
   // mem_state = 1: use auxiliary memory until a size change
   // mem_state = 2: use auxiliary memory and don't allow the number of elements to be changed
   // mem_state = 3: fixed size (eg. via template based size specification)
+  // mem_state = 4: as for mem_state = 2, but the memory is never taken over by another cube (eg. memory mapped file)
   
   arma_aligned const eT* const mem;  //!< pointer to the memory used for storing elements (memory is read-only)
   
@@ -450,6 +451,8 @@ class Cube : public BaseCube< eT, Cube<eT> >
   
   template<uword fixed_n_rows, uword fixed_n_cols, uword fixed_n_slices> class fixed;
   
+  class mapped;
+  
   
   protected:
   
@@ -536,6 +539,30 @@ class Cube<eT>::fixed : public Cube<eT>
 
 
 
+//! cube with elements stored in a memory mapped file (arma_binary or raw_binary format);
+//! the elements are not copied and the size of the cube cannot be changed
+template<typename eT>
+class Cube<eT>::mapped : private mapped_file_elems<eT>, public Cube<eT>
+  {
+  public:
+  
+  typedef eT                                elem_type;
+  typedef typename get_pod_type<eT>::result pod_type;
+  typedef mapped                            Cube_mapped_type;
+  
+  inline explicit mapped(const std::string& name, const file_type type = arma_binary, const map_mode mode = map_mode::read_only);
+  
+  inline mapped(const mapped& X);
+  
+  inline mapped& operator=(const mapped& X);
+  
+  using Cube<eT>::operator=;
+  
+  inline bool flush() const;
+  };
+
+
+
 class Cube_aux
   {
   public:
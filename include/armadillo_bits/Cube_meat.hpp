@@ -396,7 +396,7 @@ Cube<eT>::init_warm(const uword in_n_rows, const uword in_n_cols, const uword in
     return;
     }
   
-  arma_debug_check( (t_mem_state == 2), "Cube::init(): mismatch between size of auxiliary memory and requested size" );
+  arma_debug_check( ((t_mem_state == 2) || (t_mem_state == 4)), "Cube::init(): mismatch between size of auxiliary memory and requested size" );
   
   delete_mat();
   
@@ -539,7 +539,7 @@ Cube<eT>::delete_mat()
         }
       }
     
-    if( (mem_state <= 2) && (n_slices > Cube_prealloc::mat_ptrs_size) )
+    if( (mem_state != 3) && (n_slices > Cube_prealloc::mat_ptrs_size) )
       {
       arma_extra_debug_print("Cube::delete_mat(): freeing mat_ptrs array");
       delete [] mat_ptrs;
@@ -559,7 +559,8 @@ Cube<eT>::create_mat()
   
   if(n_slices == 0)  { mat_ptrs = nullptr; return; }
   
-  if(mem_state <= 2)
+  // Cube::fixed provides its own mat_ptrs array
+  if(mem_state != 3)
     {
     if(n_slices <= Cube_prealloc::mat_ptrs_size)
       {
@@ -2013,23 +2014,22 @@ Cube<eT>::each_slice(const std::function< void(Mat<eT>&) >& F, const bool use_mp
   {
   arma_extra_debug_sigprint();
   
-  if((use_mp == false) || (arma_config::openmp == false))
+  if((use_mp == false) || (arma_config::mp == false))
     {
     return (*this).each_slice(F);
     }
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_MP)
     {
     const uword local_n_slices = n_slices;
     const int   n_threads      = mp_thread_limit::get();
     
-    #pragma omp parallel for schedule(static) num_threads(n_threads)
-    for(uword slice_id=0; slice_id < local_n_slices; ++slice_id)
+    mp_parallel::run(local_n_slices, n_threads, [&](const uword slice_id)
       {
       Mat<eT> tmp('j', slice_memptr(slice_id), n_rows, n_cols);
       
       F(tmp);
-      }
+      });
     }
   #endif
   
@@ -2045,23 +2045,22 @@ Cube<eT>::each_slice(const std::function< void(const Mat<eT>&) >& F, const bool
   {
   arma_extra_debug_sigprint();
   
-  if((use_mp == false) || (arma_config::openmp == false))
+  if((use_mp == false) || (arma_config::mp == false))
     {
     return (*this).each_slice(F);
     }
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_MP)
     {
     const uword local_n_slices = n_slices;
     const int   n_threads      = mp_thread_limit::get();
     
-    #pragma omp parallel for schedule(static) num_threads(n_threads)
-    for(uword slice_id=0; slice_id < local_n_slices; ++slice_id)
+    mp_parallel::run(local_n_slices, n_threads, [&](const uword slice_id)
       {
       Mat<eT> tmp('j', slice_memptr(slice_id), n_rows, n_cols);
       
       F(tmp);
-      }
+      });
     }
   #endif
   
@@ -4569,6 +4568,10 @@ Cube<eT>::save(const std::string name, const file_type type) const
       save_okay = diskio::save_arma_binary(*this, name);
       break;
     
+    case arma_binary_compressed:
+      save_okay = diskio::save_arma_binary_compressed(*this, name);
+      break;
+    
     case ppm_binary:
       save_okay = diskio::save_ppm_binary(*this, name);
       break;
@@ -4681,6 +4684,10 @@ Cube<eT>::save(std::ostream& os, const file_type type) const
       save_okay = diskio::save_arma_binary(*this, os);
       break;
     
+    case arma_binary_compressed:
+      save_okay = diskio::save_arma_binary_compressed(*this, os);
+      break;
+    
     case ppm_binary:
       save_okay = diskio::save_ppm_binary(*this, os);
       break;
@@ -4731,6 +4738,10 @@ Cube<eT>::load(const std::string name, const file_type type)
       load_okay = diskio::load_arma_binary(*this, name, err_msg);
       break;
     
+    case arma_binary_compressed:
+      load_okay = diskio::load_arma_binary_compressed(*this, name, err_msg);
+      break;
+    
     case ppm_binary:
       load_okay = diskio::load_ppm_binary(*this, name, err_msg);
       break;
@@ -4853,6 +4864,10 @@ Cube<eT>::load(std::istream& is, const file_type type)
       load_okay = diskio::load_arma_binary(*this, is, err_msg);
       break;
     
+    case arma_binary_compressed:
+      load_okay = diskio::load_arma_binary_compressed(*this, is, err_msg);
+      break;
+    
     case ppm_binary:
       load_okay = diskio::load_ppm_binary(*this, is, err_msg);
       break;
@@ -5670,6 +5685,66 @@ Cube<eT>::fixed<fixed_n_rows, fixed_n_cols, fixed_n_slices>::operator() (const u
 
 
 
+//
+// Cube::mapped
+
+
+
+template<typename eT>
+inline
+Cube<eT>::mapped::mapped(const std::string& name, const file_type type, const map_mode mode)
+  : mapped_file_elems<eT>(name, type, mode, true)
+  , Cube<eT>(mapped_file_elems<eT>::map_mem, mapped_file_elems<eT>::map_n_rows, mapped_file_elems<eT>::map_n_cols, mapped_file_elems<eT>::map_n_slices, false, true)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  // the memory is unmapped by the destructor, so moving from a mapped cube must copy the elements
+  access::rw(Cube<eT>::mem_state) = 4;
+  }
+
+
+
+//! a copy of a mapped cube is an ordinary cube with its own memory
+template<typename eT>
+inline
+Cube<eT>::mapped::mapped(const mapped& X)
+  : mapped_file_elems<eT>()
+  , Cube<eT>(X)
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+//! copy the elements of X; the sizes must match
+template<typename eT>
+inline
+typename Cube<eT>::mapped&
+Cube<eT>::mapped::operator=(const mapped& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  Cube<eT>::operator=(X);
+  
+  return *this;
+  }
+
+
+
+//! write changes to the file when using map_mode::read_write;
+//! changes are otherwise written by the operating system at an unspecified time, at the latest when the cube is destroyed
+template<typename eT>
+inline
+bool
+Cube<eT>::mapped::flush() const
+  {
+  arma_extra_debug_sigprint();
+  
+  return mapped_file_elems<eT>::file.flush();
+  }
+
+
+
 //
 // Cube_aux
 
@@ -21,6 +21,56 @@
 
 
 
+// this class is for internal use only; subject to change and/or removal without notice
+//! hash table mapping linear indices to element values, using open addressing with linear probing
+template<typename eT>
+class MapMat_map
+  {
+  public:
+  
+  inline ~MapMat_map();
+  inline  MapMat_map();
+  
+  inline                 MapMat_map(const MapMat_map<eT>& x);
+  inline MapMat_map<eT>& operator=(const MapMat_map<eT>& x);
+  
+  arma_inline uword size()  const;
+  arma_inline bool  empty() const;
+  
+  inline void clear();  //!< remove all elements, keeping the memory
+  inline void reset();  //!< remove all elements and release the memory
+  
+  inline void reserve(const uword n);
+  
+  inline arma_warn_unused       eT* find(const uword key);
+  inline arma_warn_unused const eT* find(const uword key) const;
+  
+  inline eT& operator[](const uword key);  //!< creates a zero element if it doesn't exist
+  
+  inline void erase(const uword key);
+  
+  inline void get_sorted(podarray<uword>& out_keys, podarray<eT>& out_vals) const;
+  
+  
+  private:
+  
+  static constexpr uword empty_key = ~uword(0);  //!< never a valid linear index
+  
+  uword  n_used;
+  uword  n_slots;  //!< zero or a power of two
+  uword  shift;
+  uword* keys;
+  eT*    vals;
+  
+  arma_inline uword home(const uword key) const;
+  
+  inline void rehash(const uword new_n_slots);
+  
+  friend class SpMat<eT>;
+  };
+
+
+
 // this class is for internal use only; subject to change and/or removal without notice
 template<typename eT>
 class MapMat
@@ -41,10 +91,12 @@ class MapMat
   
   private:
   
-  typedef typename std::map<uword, eT> map_type;
+  typedef MapMat_map<eT> map_type;
   
   arma_aligned map_type* map_ptr;
   
+  uword csc_insert_cost;  //!< elements copied by SpMat::try_insert_value_csc() since the last reset
+  
   
   public:
   
@@ -21,6 +21,353 @@
 
 
 
+// MapMat_map
+
+
+
+template<typename eT>
+inline
+MapMat_map<eT>::~MapMat_map()
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  memory::release(keys);
+  memory::release(vals);
+  }
+
+
+
+template<typename eT>
+inline
+MapMat_map<eT>::MapMat_map()
+  : n_used (0)
+  , n_slots(0)
+  , shift  (0)
+  , keys   (nullptr)
+  , vals   (nullptr)
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+MapMat_map<eT>::MapMat_map(const MapMat_map<eT>& x)
+  : n_used (0)
+  , n_slots(0)
+  , shift  (0)
+  , keys   (nullptr)
+  , vals   (nullptr)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  (*this).operator=(x);
+  }
+
+
+
+template<typename eT>
+inline
+MapMat_map<eT>&
+MapMat_map<eT>::operator=(const MapMat_map<eT>& x)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(this == &x)  { return *this; }
+  
+  if(n_slots != x.n_slots)
+    {
+    reset();
+    
+    if(x.n_slots > 0)
+      {
+      keys = memory::acquire<uword>(x.n_slots);
+      vals = memory::acquire<eT>   (x.n_slots);
+      }
+    }
+  
+  n_used  = x.n_used;
+  n_slots = x.n_slots;
+  shift   = x.shift;
+  
+  arrayops::copy(keys, x.keys, n_slots);
+  arrayops::copy(vals, x.vals, n_slots);
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+arma_inline
+uword
+MapMat_map<eT>::size() const
+  {
+  return n_used;
+  }
+
+
+
+template<typename eT>
+arma_inline
+bool
+MapMat_map<eT>::empty() const
+  {
+  return (n_used == 0);
+  }
+
+
+
+template<typename eT>
+inline
+void
+MapMat_map<eT>::clear()
+  {
+  arma_extra_debug_sigprint();
+  
+  if(n_used == 0)  { return; }
+  
+  for(uword i=0; i < n_slots; ++i)  { keys[i] = empty_key; }
+  
+  n_used = 0;
+  }
+
+
+
+template<typename eT>
+inline
+void
+MapMat_map<eT>::reset()
+  {
+  arma_extra_debug_sigprint();
+  
+  memory::release(keys);
+  memory::release(vals);
+  
+  n_used  = 0;
+  n_slots = 0;
+  shift   = 0;
+  keys    = nullptr;
+  vals    = nullptr;
+  }
+
+
+
+template<typename eT>
+inline
+void
+MapMat_map<eT>::reserve(const uword n)
+  {
+  arma_extra_debug_sigprint();
+  
+  // the table is kept at most 3/4 full
+  
+  uword new_n_slots = (n_slots > 0) ? n_slots : uword(16);
+  
+  while( (new_n_slots/4)*3 < n )  { new_n_slots *= 2; }
+  
+  if(new_n_slots > n_slots)  { rehash(new_n_slots); }
+  }
+
+
+
+template<typename eT>
+inline
+arma_warn_unused
+eT*
+MapMat_map<eT>::find(const uword key)
+  {
+  if(n_used == 0)  { return nullptr; }
+  
+  const uword mask = n_slots - 1;
+  
+  for(uword i = home(key); true; i = (i+1) & mask)
+    {
+    const uword slot_key = keys[i];
+    
+    if(slot_key == key      )  { return &(vals[i]); }
+    if(slot_key == empty_key)  { return nullptr;     }
+    }
+  }
+
+
+
+template<typename eT>
+inline
+arma_warn_unused
+const eT*
+MapMat_map<eT>::find(const uword key) const
+  {
+  return const_cast< MapMat_map<eT>& >(*this).find(key);
+  }
+
+
+
+template<typename eT>
+inline
+eT&
+MapMat_map<eT>::operator[](const uword key)
+  {
+  if(n_slots == 0)  { rehash(16); }
+  
+  uword mask = n_slots - 1;
+  uword i    = home(key);
+  
+  for(; keys[i] != empty_key; i = (i+1) & mask)
+    {
+    if(keys[i] == key)  { return vals[i]; }
+    }
+  
+  if( (n_used + 1) > (n_slots/4)*3 )
+    {
+    rehash(2*n_slots);
+    
+    mask = n_slots - 1;
+    
+    for(i = home(key); keys[i] != empty_key; i = (i+1) & mask)  {}
+    }
+  
+  ++n_used;
+  
+  keys[i] = key;
+  vals[i] = eT(0);
+  
+  return vals[i];
+  }
+
+
+
+template<typename eT>
+inline
+void
+MapMat_map<eT>::erase(const uword key)
+  {
+  if(n_used == 0)  { return; }
+  
+  const uword mask = n_slots - 1;
+  
+  uword i = home(key);
+  
+  for(; keys[i] != key; i = (i+1) & mask)
+    {
+    if(keys[i] == empty_key)  { return; }
+    }
+  
+  // backward shift deletion: move later elements of the probe sequence into the gap,
+  // unless their home slot is cyclically within (gap, current]
+  
+  for(uword j = (i+1) & mask; keys[j] != empty_key; j = (j+1) & mask)
+    {
+    const uword k = home(keys[j]);
+    
+    const bool stays = (i <= j) ? ( (i < k) && (k <= j) ) : ( (i < k) || (k <= j) );
+    
+    if(stays)  { continue; }
+    
+    keys[i] = keys[j];
+    vals[i] = vals[j];
+    
+    i = j;
+    }
+  
+  keys[i] = empty_key;
+  
+  --n_used;
+  }
+
+
+
+template<typename eT>
+inline
+void
+MapMat_map<eT>::get_sorted(podarray<uword>& out_keys, podarray<eT>& out_vals) const
+  {
+  arma_extra_debug_sigprint();
+  
+  out_keys.set_size(n_used);
+  out_vals.set_size(n_used);
+  
+  uword count = 0;
+  
+  for(uword i=0; i < n_slots; ++i)
+    {
+    if(keys[i] != empty_key)  { out_keys[count] = keys[i]; ++count; }
+    }
+  
+  std::sort( out_keys.memptr(), out_keys.memptr() + n_used );
+  
+  for(uword i=0; i < n_used; ++i)  { out_vals[i] = *(find(out_keys[i])); }
+  }
+
+
+
+template<typename eT>
+arma_inline
+uword
+MapMat_map<eT>::home(const uword key) const
+  {
+  // Fibonacci hashing; the top bits of the product select the slot
+  
+  const uword multiplier = (sizeof(uword) >= 8) ? uword(0x9E3779B97F4A7C15ULL) : uword(0x9E3779B9UL);
+  
+  return (key * multiplier) >> shift;
+  }
+
+
+
+template<typename eT>
+inline
+void
+MapMat_map<eT>::rehash(const uword new_n_slots)
+  {
+  arma_extra_debug_sigprint();
+  
+  uword* old_keys    = keys;
+  eT*    old_vals    = vals;
+  uword  old_n_slots = n_slots;
+  
+  keys = memory::acquire<uword>(new_n_slots);
+  vals = memory::acquire<eT>   (new_n_slots);
+  
+  for(uword i=0; i < new_n_slots; ++i)  { keys[i] = empty_key; }
+  
+  uword log2_n_slots = 0;
+  
+  while( (uword(1) << log2_n_slots) < new_n_slots )  { ++log2_n_slots; }
+  
+  n_slots = new_n_slots;
+  shift   = uword(8*sizeof(uword)) - log2_n_slots;
+  
+  const uword mask = n_slots - 1;
+  
+  for(uword j=0; j < old_n_slots; ++j)
+    {
+    const uword key = old_keys[j];
+    
+    if(key == empty_key)  { continue; }
+    
+    uword i = home(key);
+    
+    while(keys[i] != empty_key)  { i = (i+1) & mask; }
+    
+    keys[i] = key;
+    vals[i] = old_vals[j];
+    }
+  
+  memory::release(old_keys);
+  memory::release(old_vals);
+  }
+
+
+
+
+
+
+// MapMat
+
+
+
 template<typename eT>
 inline
 MapMat<eT>::~MapMat()
@@ -44,6 +391,7 @@ MapMat<eT>::MapMat()
   , n_cols (0)
   , n_elem (0)
   , map_ptr(nullptr)
+  , csc_insert_cost(0)
   {
   arma_extra_debug_sigprint_this(this);
   
@@ -59,6 +407,7 @@ MapMat<eT>::MapMat(const uword in_n_rows, const uword in_n_cols)
   , n_cols (in_n_cols)
   , n_elem (in_n_rows * in_n_cols)
   , map_ptr(nullptr)
+  , csc_insert_cost(0)
   {
   arma_extra_debug_sigprint_this(this);
   
@@ -74,6 +423,7 @@ MapMat<eT>::MapMat(const SizeMat& s)
   , n_cols (s.n_cols)
   , n_elem (s.n_rows * s.n_cols)
   , map_ptr(nullptr)
+  , csc_insert_cost(0)
   {
   arma_extra_debug_sigprint_this(this);
   
@@ -89,6 +439,7 @@ MapMat<eT>::MapMat(const MapMat<eT>& x)
   , n_cols (0)
   , n_elem (0)
   , map_ptr(nullptr)
+  , csc_insert_cost(0)
   {
   arma_extra_debug_sigprint_this(this);
   
@@ -124,6 +475,7 @@ MapMat<eT>::MapMat(const SpMat<eT>& x)
   , n_cols (0)
   , n_elem (0)
   , map_ptr(nullptr)
+  , csc_insert_cost(0)
   {
   arma_extra_debug_sigprint_this(this);
   
@@ -154,6 +506,8 @@ MapMat<eT>::operator=(const SpMat<eT>& x)
   
   map_type& map_ref = (*map_ptr);
   
+  map_ref.reserve(x.n_nonzero);
+  
   for(uword col = 0; col < x_n_cols; ++col)
     {
     const uword start = x_col_ptrs[col    ];
@@ -166,7 +520,7 @@ MapMat<eT>::operator=(const SpMat<eT>& x)
       
       const uword index = (x_n_rows * col) + row;
       
-      map_ref.emplace_hint(map_ref.cend(), index, val);
+      map_ref[index] = val;
       }
     }
   }
@@ -180,6 +534,7 @@ MapMat<eT>::MapMat(MapMat<eT>&& x)
   , n_cols (x.n_cols )
   , n_elem (x.n_elem )
   , map_ptr(x.map_ptr)
+  , csc_insert_cost(0)
   {
   arma_extra_debug_sigprint_this(this);
   
@@ -228,7 +583,9 @@ MapMat<eT>::reset()
   access::rw(n_cols) = 0;
   access::rw(n_elem) = 0;
   
-  if((*map_ptr).empty() == false)  { (*map_ptr).clear(); }
+  (*map_ptr).reset();
+  
+  csc_insert_cost = 0;
   }
 
 
@@ -348,11 +705,13 @@ MapMat<eT>::eye(const uword in_n_rows, const uword in_n_cols)
   
   map_type& map_ref = (*map_ptr);
   
+  map_ref.reserve(N);
+  
   for(uword i=0; i<N; ++i)
     {
     const uword index = (in_n_rows * i) + i;
     
-    map_ref.emplace_hint(map_ref.cend(), index, eT(1));
+    map_ref[index] = eT(1);
     }
   }
 
@@ -425,10 +784,9 @@ MapMat<eT>::operator[](const uword index) const
   {
   map_type& map_ref = (*map_ptr);
   
-  typename map_type::const_iterator it     = map_ref.find(index);
-  typename map_type::const_iterator it_end = map_ref.end();
+  const eT* val_ptr = map_ref.find(index);
   
-  return (it != it_end) ? eT((*it).second) : eT(0);
+  return (val_ptr != nullptr) ? eT(*val_ptr) : eT(0);
   }
 
 
@@ -456,10 +814,9 @@ MapMat<eT>::operator()(const uword index) const
   
   map_type& map_ref = (*map_ptr);
   
-  typename map_type::const_iterator it     = map_ref.find(index);
-  typename map_type::const_iterator it_end = map_ref.end();
+  const eT* val_ptr = map_ref.find(index);
   
-  return (it != it_end) ? eT((*it).second) : eT(0);
+  return (val_ptr != nullptr) ? eT(*val_ptr) : eT(0);
   }
 
 
@@ -487,10 +844,9 @@ MapMat<eT>::at(const uword in_row, const uword in_col) const
   
   map_type& map_ref = (*map_ptr);
   
-  typename map_type::const_iterator it     = map_ref.find(index);
-  typename map_type::const_iterator it_end = map_ref.end();
+  const eT* val_ptr = map_ref.find(index);
   
-  return (it != it_end) ? eT((*it).second) : eT(0);
+  return (val_ptr != nullptr) ? eT(*val_ptr) : eT(0);
   }
 
 
@@ -522,10 +878,9 @@ MapMat<eT>::operator()(const uword in_row, const uword in_col) const
   
   map_type& map_ref = (*map_ptr);
   
-  typename map_type::const_iterator it     = map_ref.find(index);
-  typename map_type::const_iterator it_end = map_ref.end();
+  const eT* val_ptr = map_ref.find(index);
   
-  return (it != it_end) ? eT((*it).second) : eT(0);
+  return (val_ptr != nullptr) ? eT(*val_ptr) : eT(0);
   }
 
 
@@ -606,12 +961,14 @@ MapMat<eT>::sprandu(const uword in_n_rows, const uword in_n_cols, const double d
   
   map_type& map_ref = (*map_ptr);
   
+  map_ref.reserve(N);
+  
   for(uword i=0; i < N; ++i)
     {
     const uword index = indx_mem[i];
     const eT    val   = vals_mem[i];
     
-    map_ref.emplace_hint(map_ref.cend(), index, val);
+    if(map_ref.find(index) == nullptr)  { map_ref[index] = val; }
     }
   }
 
@@ -634,9 +991,7 @@ MapMat<eT>::print(const std::string& extra_text) const
     get_cout_stream().width(orig_width);
     }
   
-  map_type& map_ref = (*map_ptr);
-  
-  const uword n_nonzero = uword(map_ref.size());
+  const uword n_nonzero = (*map_ptr).size();
   
   const double density = (n_elem > 0) ? ((double(n_nonzero) / double(n_elem))*double(100)) : double(0);
   
@@ -646,22 +1001,21 @@ MapMat<eT>::print(const std::string& extra_text) const
   
   if(n_nonzero > 0)
     {
-    typename map_type::const_iterator it = map_ref.begin();
-
+    podarray<uword> keys;
+    podarray<eT>    vals;
+    
+    (*map_ptr).get_sorted(keys, vals);
+    
     for(uword i=0; i < n_nonzero; ++i)
       {
-      const std::pair<uword, eT>& entry = (*it);
-      
-      const uword index = entry.first;
-      const eT    val   = entry.second;
+      const uword index = keys[i];
+      const eT    val   = vals[i];
       
       const uword row = index % n_rows;
       const uword col = index / n_rows;
       
       get_cout_stream() << '(' << row << ", " << col << ") ";
       get_cout_stream() << val << '\n';
-      
-      ++it;
       }
     }
   
@@ -689,11 +1043,12 @@ MapMat<eT>::get_locval_format(umat& locs, Col<eT>& vals) const
   {
   arma_extra_debug_sigprint();
   
-  map_type& map_ref = (*map_ptr);
+  podarray<uword> keys;
+  podarray<eT>    vals_tmp;
   
-  typename map_type::const_iterator it = map_ref.begin();
+  (*map_ptr).get_sorted(keys, vals_tmp);
   
-  const uword N = uword(map_ref.size());
+  const uword N = keys.n_elem;
   
   locs.set_size(2,N);
   vals.set_size(N);
@@ -702,10 +1057,8 @@ MapMat<eT>::get_locval_format(umat& locs, Col<eT>& vals) const
   
   for(uword i=0; i<N; ++i)
     {
-    const std::pair<uword, eT>& entry = (*it);
-    
-    const uword index = entry.first;
-    const eT    val   = entry.second;
+    const uword index = keys[i];
+    const eT    val   = vals_tmp[i];
     
     const uword row = index % n_rows;
     const uword col = index / n_rows;
@@ -716,8 +1069,6 @@ MapMat<eT>::get_locval_format(umat& locs, Col<eT>& vals) const
     locs_colptr[1] = col;
     
     vals_mem[i] = val;
-    
-    ++it;
     }
   }
 
@@ -802,16 +1153,7 @@ MapMat<eT>::set_val(const uword index, const eT& in_val)
   
   if(in_val != eT(0))
     {
-    map_type& map_ref = (*map_ptr);
-    
-    if( (map_ref.empty() == false) && (index > uword(map_ref.crbegin()->first)) )
-      {
-      map_ref.emplace_hint(map_ref.cend(), index, in_val);
-      }
-    else
-      {
-      map_ref.operator[](index) = in_val;
-      }
+    (*map_ptr)[index] = in_val;
     }
   else
     {
@@ -830,10 +1172,7 @@ MapMat<eT>::erase_val(const uword index)
   
   map_type& map_ref = (*map_ptr);
   
-  typename map_type::iterator it     = map_ref.find(index);
-  typename map_type::iterator it_end = map_ref.end();
-  
-  if(it != it_end)  { map_ref.erase(it); }
+  map_ref.erase(index);
   }
 
 
@@ -978,22 +1317,21 @@ MapMat_val<eT>::operator*=(const eT in_val)
   
   typename MapMat<eT>::map_type& map_ref = *(parent.map_ptr);
   
-  typename MapMat<eT>::map_type::iterator it     = map_ref.find(index);
-  typename MapMat<eT>::map_type::iterator it_end = map_ref.end();
+  eT* val_ptr = map_ref.find(index);
   
-  if(it != it_end)
+  if(val_ptr != nullptr)
     {
     if(in_val != eT(0))
       {
-      eT& val = (*it).second;
+      eT& val = (*val_ptr);
       
       val *= in_val;
       
-      if(val == eT(0))  { map_ref.erase(it); }
+      if(val == eT(0))  { map_ref.erase(index); }
       }
     else
       {
-      map_ref.erase(it);
+      map_ref.erase(index);
       }
     }
   }
@@ -1009,16 +1347,15 @@ MapMat_val<eT>::operator/=(const eT in_val)
   
   typename MapMat<eT>::map_type& map_ref = *(parent.map_ptr);
   
-  typename MapMat<eT>::map_type::iterator it     = map_ref.find(index);
-  typename MapMat<eT>::map_type::iterator it_end = map_ref.end();
+  eT* val_ptr = map_ref.find(index);
   
-  if(it != it_end)
+  if(val_ptr != nullptr)
     {
-    eT& val = (*it).second;
+    eT& val = (*val_ptr);
     
     val /= in_val;
     
-    if(val == eT(0))  { map_ref.erase(it); }
+    if(val == eT(0))  { map_ref.erase(index); }
     }
   else
     {
@@ -1394,7 +1731,9 @@ SpMat_MapMat_val<eT>::set(const eT in_val)
   {
   arma_extra_debug_sigprint();
   
-  const bool done = (s_parent.sync_state == 0) ? s_parent.try_set_value_csc(row, col, in_val) : false;
+  bool done = (s_parent.sync_state == 0) ? s_parent.try_set_value_csc(row, col, in_val) : false;
+  
+  if(done == false)  { done = s_parent.try_insert_value_csc(row, col, in_val); }
   
   if(done == false)
     {
@@ -1419,7 +1758,9 @@ SpMat_MapMat_val<eT>::add(const eT in_val)
   {
   arma_extra_debug_sigprint();
   
-  const bool done = (s_parent.sync_state == 0) ? s_parent.try_add_value_csc(row, col, in_val) : false;
+  bool done = (s_parent.sync_state == 0) ? s_parent.try_add_value_csc(row, col, in_val) : false;
+  
+  if(done == false)  { done = s_parent.try_insert_value_csc(row, col, in_val); }
     
   if(done == false)
     {
@@ -1450,7 +1791,9 @@ SpMat_MapMat_val<eT>::sub(const eT in_val)
   {
   arma_extra_debug_sigprint();
   
-  const bool done = (s_parent.sync_state == 0) ? s_parent.try_sub_value_csc(row, col, in_val) : false;
+  bool done = (s_parent.sync_state == 0) ? s_parent.try_sub_value_csc(row, col, in_val) : false;
+  
+  if(done == false)  { done = s_parent.try_insert_value_csc(row, col, eT(0) - in_val); }
   
   if(done == false)
     {
@@ -1491,22 +1834,21 @@ SpMat_MapMat_val<eT>::mul(const eT in_val)
     
     typename MapMat<eT>::map_type& map_ref = *(m_parent.map_ptr);
     
-    typename MapMat<eT>::map_type::iterator it     = map_ref.find(index);
-    typename MapMat<eT>::map_type::iterator it_end = map_ref.end();
+    eT* val_ptr = map_ref.find(index);
     
-    if(it != it_end)
+    if(val_ptr != nullptr)
       {
       if(in_val != eT(0))
         {
-        eT& val = (*it).second;
+        eT& val = (*val_ptr);
         
         val *= in_val;
         
-        if(val == eT(0))  { map_ref.erase(it); }
+        if(val == eT(0))  { map_ref.erase(index); }
         }
       else
         {
-        map_ref.erase(it);
+        map_ref.erase(index);
         }
       
       s_parent.sync_state = 1;
@@ -1552,16 +1894,15 @@ SpMat_MapMat_val<eT>::div(const eT in_val)
     
     typename MapMat<eT>::map_type& map_ref = *(m_parent.map_ptr);
     
-    typename MapMat<eT>::map_type::iterator it     = map_ref.find(index);
-    typename MapMat<eT>::map_type::iterator it_end = map_ref.end();
+    eT* val_ptr = map_ref.find(index);
     
-    if(it != it_end)
+    if(val_ptr != nullptr)
       {
-      eT& val = (*it).second;
+      eT& val = (*val_ptr);
       
       val /= in_val;
       
-      if(val == eT(0))  { map_ref.erase(it); }
+      if(val == eT(0))  { map_ref.erase(index); }
       
       s_parent.sync_state = 1;
       
@@ -42,6 +42,7 @@ class Mat : public Base< eT, Mat<eT> >
   // mem_state = 1: use auxiliary memory until a size change
   // mem_state = 2: use auxiliary memory and don't allow the number of elements to be changed
   // mem_state = 3: fixed size (eg. via template based size specification)
+  // mem_state = 4: as for mem_state = 2, but the memory is never taken over by another matrix (eg. memory mapped file)
   
   arma_aligned const eT* const mem;  //!< pointer to the memory used for storing elements (memory is read-only)
   
@@ -756,6 +757,8 @@ class Mat : public Base< eT, Mat<eT> >
   
   template<uword fixed_n_rows, uword fixed_n_cols> class fixed;
   
+  class mapped;
+  
   
   protected:
   
@@ -909,6 +912,30 @@ const uword Mat<eT>::fixed<fixed_n_rows, fixed_n_cols>::n_elem = fixed_n_rows *
 
 
 
+//! matrix with elements stored in a memory mapped file (arma_binary or raw_binary format);
+//! the elements are not copied and the size of the matrix cannot be changed
+template<typename eT>
+class Mat<eT>::mapped : private mapped_file_elems<eT>, public Mat<eT>
+  {
+  public:
+  
+  typedef eT                                elem_type;
+  typedef typename get_pod_type<eT>::result pod_type;
+  typedef mapped                            Mat_mapped_type;
+  
+  inline explicit mapped(const std::string& name, const file_type type = arma_binary, const map_mode mode = map_mode::read_only);
+  
+  inline mapped(const mapped& X);
+  
+  inline mapped& operator=(const mapped& X);
+  
+  using Mat<eT>::operator=;
+  
+  inline bool flush() const;
+  };
+
+
+
 class Mat_aux
   {
   public:
@@ -404,7 +404,7 @@ Mat<eT>::init_warm(uword in_n_rows, uword in_n_cols)
     return;
     }
   
-  arma_debug_check( (t_mem_state == 2), "Mat::init(): mismatch between size of auxiliary memory and requested size" );
+  arma_debug_check( ((t_mem_state == 2) || (t_mem_state == 4)), "Mat::init(): mismatch between size of auxiliary memory and requested size" );
   
   if(new_n_elem <= arma_config::mat_prealloc)
     {
@@ -771,7 +771,7 @@ Mat<eT>::Mat(Mat<eT>&& X)
     access::rw(X.mem_state) = 0;
     access::rw(X.mem)       = nullptr;
     }
-  else  // condition: (X.n_alloc <= arma_config::mat_prealloc) || (X.mem_state == 0) || (X.mem_state == 3)
+  else  // condition: (X.n_alloc <= arma_config::mat_prealloc) || (X.mem_state == 0) || (X.mem_state >= 3)
     {
     init_cold();
     
@@ -7553,6 +7553,10 @@ Mat<eT>::save(const std::string name, const file_type type) const
       save_okay = diskio::save_arma_binary(*this, name);
       break;
     
+    case arma_binary_compressed:
+      save_okay = diskio::save_arma_binary_compressed(*this, name);
+      break;
+    
     case pgm_binary:
       save_okay = diskio::save_pgm_binary(*this, name);
       break;
@@ -7756,6 +7760,10 @@ Mat<eT>::save(std::ostream& os, const file_type type) const
       save_okay = diskio::save_arma_binary(*this, os);
       break;
     
+    case arma_binary_compressed:
+      save_okay = diskio::save_arma_binary_compressed(*this, os);
+      break;
+    
     case pgm_binary:
       save_okay = diskio::save_pgm_binary(*this, os);
       break;
@@ -7818,6 +7826,10 @@ Mat<eT>::load(const std::string name, const file_type type)
       load_okay = diskio::load_arma_binary(*this, name, err_msg);
       break;
     
+    case arma_binary_compressed:
+      load_okay = diskio::load_arma_binary_compressed(*this, name, err_msg);
+      break;
+    
     case pgm_binary:
       load_okay = diskio::load_pgm_binary(*this, name, err_msg);
       break;
@@ -8040,6 +8052,10 @@ Mat<eT>::load(std::istream& is, const file_type type)
       load_okay = diskio::load_arma_binary(*this, is, err_msg);
       break;
     
+    case arma_binary_compressed:
+      load_okay = diskio::load_arma_binary_compressed(*this, is, err_msg);
+      break;
+    
     case pgm_binary:
       load_okay = diskio::load_pgm_binary(*this, is, err_msg);
       break;
@@ -9859,6 +9875,61 @@ Mat<eT>::fixed<fixed_n_rows, fixed_n_cols>::ones()
 
 
 
+template<typename eT>
+inline
+Mat<eT>::mapped::mapped(const std::string& name, const file_type type, const map_mode mode)
+  : mapped_file_elems<eT>(name, type, mode, false)
+  , Mat<eT>(mapped_file_elems<eT>::map_mem, mapped_file_elems<eT>::map_n_rows, mapped_file_elems<eT>::map_n_cols, false, true)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  // the memory is unmapped by the destructor, so moving from a mapped matrix must copy the elements
+  access::rw(Mat<eT>::mem_state) = 4;
+  }
+
+
+
+//! a copy of a mapped matrix is an ordinary matrix with its own memory
+template<typename eT>
+inline
+Mat<eT>::mapped::mapped(const mapped& X)
+  : mapped_file_elems<eT>()
+  , Mat<eT>(X)
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+//! copy the elements of X; the sizes must match
+template<typename eT>
+inline
+typename Mat<eT>::mapped&
+Mat<eT>::mapped::operator=(const mapped& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  Mat<eT>::operator=(X);
+  
+  return *this;
+  }
+
+
+
+//! write changes to the file when using map_mode::read_write;
+//! changes are otherwise written by the operating system at an unspecified time, at the latest when the matrix is destroyed
+template<typename eT>
+inline
+bool
+Mat<eT>::mapped::flush() const
+  {
+  arma_extra_debug_sigprint();
+  
+  return mapped_file_elems<eT>::file.flush();
+  }
+
+
+
 //! prefix ++
 template<typename eT>
 inline
@@ -129,22 +129,38 @@ struct Proxy_fixed
 
 
 
-template<typename T1, bool condition>
+//! Mat::mapped is handled as its Mat base class
+template<typename T1>
+struct Proxy_mapped : public Proxy< Mat<typename T1::elem_type> >
+  {
+  inline explicit Proxy_mapped(const T1& A)
+    : Proxy< Mat<typename T1::elem_type> >(A)
+    {
+    arma_extra_debug_sigprint();
+    }
+  };
+
+
+
+template<typename T1, bool is_fixed, bool is_mapped>
 struct Proxy_redirect {};
 
 template<typename T1>
-struct Proxy_redirect<T1, false> { typedef Proxy_default<T1> result; };
+struct Proxy_redirect<T1, false, false> { typedef Proxy_default<T1> result; };
+
+template<typename T1>
+struct Proxy_redirect<T1, true,  false> { typedef Proxy_fixed<T1>   result; };
 
 template<typename T1>
-struct Proxy_redirect<T1, true>  { typedef Proxy_fixed<T1>   result; };
+struct Proxy_redirect<T1, false, true > { typedef Proxy_mapped<T1>  result; };
 
 
 
 template<typename T1>
-struct Proxy : public Proxy_redirect<T1, is_Mat_fixed<T1>::value>::result
+struct Proxy : public Proxy_redirect<T1, is_Mat_fixed<T1>::value, is_Mat_mapped_only<T1>::value>::result
   {
   inline Proxy(const T1& A)
-    : Proxy_redirect<T1, is_Mat_fixed<T1>::value>::result(A)
+    : Proxy_redirect<T1, is_Mat_fixed<T1>::value, is_Mat_mapped_only<T1>::value>::result(A)
     {
     }
   };
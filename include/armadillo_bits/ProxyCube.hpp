@@ -22,9 +22,9 @@
 
 
 template<typename T1>
-struct ProxyCube
+struct ProxyCube_default
   {
-  inline ProxyCube(const T1&)
+  inline ProxyCube_default(const T1&)
     {
     arma_type_check(( is_arma_cube_type<T1>::value == false ));
     }
@@ -32,6 +32,32 @@ struct ProxyCube
 
 
 
+template<typename T1>
+struct ProxyCube_mapped;
+
+
+
+template<typename T1, bool condition>
+struct ProxyCube_redirect {};
+
+template<typename T1>
+struct ProxyCube_redirect<T1, false> { typedef ProxyCube_default<T1> result; };
+
+template<typename T1>
+struct ProxyCube_redirect<T1, true>  { typedef ProxyCube_mapped<T1>  result; };
+
+
+template<typename T1>
+struct ProxyCube : public ProxyCube_redirect<T1, is_Cube_mapped_only<T1>::value>::result
+  {
+  inline ProxyCube(const T1& A)
+    : ProxyCube_redirect<T1, is_Cube_mapped_only<T1>::value>::result(A)
+    {
+    }
+  };
+
+
+
 // ea_type is the "element accessor" type,
 // which can provide access to elements via operator[]
 
@@ -80,6 +106,19 @@ struct ProxyCube< Cube<eT> >
 
 
 
+//! Cube::mapped is handled as its Cube base class
+template<typename T1>
+struct ProxyCube_mapped : public ProxyCube< Cube<typename T1::elem_type> >
+  {
+  inline explicit ProxyCube_mapped(const T1& A)
+    : ProxyCube< Cube<typename T1::elem_type> >(A)
+    {
+    arma_extra_debug_sigprint();
+    }
+  };
+
+
+
 template<typename eT, typename gen_type>
 struct ProxyCube< GenCube<eT, gen_type> >
   {
@@ -393,7 +393,7 @@ Row<eT>::Row(Row<eT>&& X)
     access::rw(X.mem_state) = 0;
     access::rw(X.mem)       = nullptr;
     }
-  else  // condition: (X.n_alloc <= arma_config::mat_prealloc) || (X.mem_state == 0) || (X.mem_state == 3)
+  else  // condition: (X.n_alloc <= arma_config::mat_prealloc) || (X.mem_state == 0) || (X.mem_state >= 3)
     {
     (*this).init_cold();
     
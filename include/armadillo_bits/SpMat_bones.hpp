@@ -100,6 +100,9 @@ class SpMat : public SpBase< eT, SpMat<eT> >
   inline explicit    SpMat(const MapMat<eT>& x);
   inline SpMat& operator= (const MapMat<eT>& x);
   
+  inline explicit    SpMat(const SpMat_csr<eT>& x);
+  inline SpMat& operator= (const SpMat_csr<eT>& x);
+  
   template<typename T1, typename T2, typename T3>
   inline SpMat(const Base<uword,T1>& rowind, const Base<uword,T2>& colptr, const Base<eT,T3>& values, const uword n_rows, const uword n_cols);
   
@@ -112,6 +115,9 @@ class SpMat : public SpBase< eT, SpMat<eT> >
   template<typename T1, typename T2>
   inline SpMat(const bool add_values, const Base<uword,T1>& locations, const Base<eT,T2>& values, const uword n_rows, const uword n_cols, const bool sort_locations = true, const bool check_for_zeros = true);
   
+  template<typename T1, typename T2, typename T3>
+  inline SpMat(const bool add_values, const Base<uword,T1>& row_indices, const Base<uword,T2>& col_indices, const Base<eT,T3>& values, const uword n_rows, const uword n_cols, const bool sort_locations = true, const bool check_for_zeros = true);
+  
   inline SpMat& operator= (const eT val); //! sets size to 1x1
   inline SpMat& operator*=(const eT val);
   inline SpMat& operator/=(const eT val);
@@ -624,7 +630,8 @@ class SpMat : public SpBase< eT, SpMat<eT> >
   // n_nonzero is updated.
   inline void mem_resize(const uword new_n_nonzero);
   
-  //! synchronise CSC from cache
+  //! synchronise CSC from cache;
+  //! afterwards, concurrent read-only access (eg. via .at() or const iterators) does not take any locks
   inline void sync() const;
   
   //! don't use this unless you're writing internal Armadillo code
@@ -655,8 +662,7 @@ class SpMat : public SpBase< eT, SpMat<eT> >
   
   inline void init_simple(const SpMat<eT>& x);
   
-  inline void init_batch_std(const Mat<uword>& locations, const Mat<eT>& values, const bool sort_locations);
-  inline void init_batch_add(const Mat<uword>& locations, const Mat<eT>& values, const bool sort_locations);
+  inline void init_batch(const uword* row_mem, const uword row_stride, const uword* col_mem, const uword col_stride, const eT* val_mem, const uword N, const bool sort_locations, const bool add_values, const bool check_for_zeros);
   
   inline SpMat(const arma_vec_indicator&, const uword in_vec_state);
   inline SpMat(const arma_vec_indicator&, const uword in_n_rows, const uword in_n_cols, const uword in_vec_state);
@@ -678,6 +684,8 @@ class SpMat : public SpBase< eT, SpMat<eT> >
   inline arma_hot arma_warn_unused bool try_mul_value_csc(const uword in_row, const uword in_col, const eT in_val);
   inline arma_hot arma_warn_unused bool try_div_value_csc(const uword in_row, const uword in_col, const eT in_val);
   
+  inline arma_warn_unused bool try_insert_value_csc(const uword in_row, const uword in_col, const eT in_val);
+  
   inline arma_warn_unused eT&  insert_element(const uword in_row, const uword in_col, const eT in_val = eT(0));
   inline                  void delete_element(const uword in_row, const uword in_col);
   
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup SpMat_csr
+//! @{
+
+
+
+//! Sparse matrix stored in compressed sparse row (CSR) format.
+//! The CSR form of a matrix is the CSC form of its transpose,
+//! which is held as an SpMat and can be accessed without copying via .st()
+template<typename eT>
+class SpMat_csr
+  {
+  public:
+  
+  typedef eT                                elem_type;  //!< the type of elements stored in the matrix
+  typedef typename get_pod_type<eT>::result  pod_type;  //!< if eT is std::complex<T>, pod_type is T; otherwise pod_type is eT
+  
+  const uword n_rows;     //!< number of rows     (read-only)
+  const uword n_cols;     //!< number of columns  (read-only)
+  const uword n_elem;     //!< number of elements (read-only)
+  const uword n_nonzero;  //!< number of nonzero elements (read-only)
+  
+  const eT*    values;       //!< the nonzero values, stored row by row (read-only)
+  const uword* col_indices;  //!< the column index of each nonzero value (read-only)
+  const uword* row_ptrs;     //!< the start of each row in values and col_indices; has n_rows+1 entries (read-only)
+  
+  inline ~SpMat_csr();
+  inline  SpMat_csr();
+  
+  inline explicit SpMat_csr(const uword in_n_rows, const uword in_n_cols);
+  inline explicit SpMat_csr(const SizeMat& s);
+  
+  inline             SpMat_csr(const SpMat_csr& x);
+  inline SpMat_csr& operator= (const SpMat_csr& x);
+  
+  inline             SpMat_csr(SpMat_csr&& x);
+  inline SpMat_csr& operator= (SpMat_csr&& x);
+  
+  template<typename T1> inline explicit SpMat_csr(const SpBase<eT,T1>& expr);
+  template<typename T1> inline SpMat_csr& operator= (const SpBase<eT,T1>& expr);
+  
+  inline SpMat_csr& operator*=(const eT val);
+  inline SpMat_csr& operator/=(const eT val);
+  
+  inline void steal_st(SpMat<eT>& X);
+  
+  arma_inline arma_warn_unused const SpMat<eT>& st() const;
+  
+  arma_inline arma_warn_unused eT at        (const uword in_row, const uword in_col) const;
+  arma_inline arma_warn_unused eT operator()(const uword in_row, const uword in_col) const;
+  
+  inline arma_warn_unused SpMat_csr row (const uword row_num)                     const;
+  inline arma_warn_unused SpMat_csr rows(const uword in_row1, const uword in_row2) const;
+  
+  inline void zeros(const uword in_n_rows, const uword in_n_cols);
+  inline void reset();
+  
+  inline arma_warn_unused bool is_empty() const;
+  
+  inline void print(const std::string extra_text = "") const;
+  
+  
+  class const_iterator
+    {
+    public:
+    
+    inline const_iterator(const SpMat_csr& in_M, const uword in_row, const uword in_pos);
+    
+    arma_inline eT operator*() const { return M->values[internal_pos]; }
+    
+    arma_inline uword row() const { return internal_row;                 }
+    arma_inline uword col() const { return M->col_indices[internal_pos]; }
+    arma_inline uword pos() const { return internal_pos;                 }
+    
+    inline arma_hot         const_iterator& operator++();
+    inline arma_warn_unused const_iterator  operator++(int);
+    
+    inline arma_hot bool operator==(const const_iterator& rhs) const;
+    inline arma_hot bool operator!=(const const_iterator& rhs) const;
+    
+    typedef std::forward_iterator_tag iterator_category;
+    typedef eT                        value_type;
+    typedef std::ptrdiff_t            difference_type;
+    typedef const eT*                 pointer;
+    typedef const eT&                 reference;
+    
+    
+    private:
+    
+    inline void skip_empty_rows();
+    
+    arma_aligned const SpMat_csr* M;
+    arma_aligned       uword      internal_row;
+    arma_aligned       uword      internal_pos;
+    };
+  
+  inline const_iterator begin() const;
+  inline const_iterator end()   const;
+  
+  inline const_iterator begin_row(const uword row_num) const;
+  inline const_iterator end_row  (const uword row_num) const;
+  
+  
+  private:
+  
+  SpMat<eT> AT;  //!< CSC form of the transpose
+  
+  inline void update_members();
+  };
+
+
+
+//! @}
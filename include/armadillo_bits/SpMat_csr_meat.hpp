@@ -0,0 +1,517 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup SpMat_csr
+//! @{
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>::~SpMat_csr()
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>::SpMat_csr()
+  : n_rows(0)
+  , n_cols(0)
+  , n_elem(0)
+  , n_nonzero(0)
+  , values(nullptr)
+  , col_indices(nullptr)
+  , row_ptrs(nullptr)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  update_members();
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>::SpMat_csr(const uword in_n_rows, const uword in_n_cols)
+  : n_rows(0)
+  , n_cols(0)
+  , n_elem(0)
+  , n_nonzero(0)
+  , values(nullptr)
+  , col_indices(nullptr)
+  , row_ptrs(nullptr)
+  , AT(in_n_cols, in_n_rows)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  update_members();
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>::SpMat_csr(const SizeMat& s)
+  : n_rows(0)
+  , n_cols(0)
+  , n_elem(0)
+  , n_nonzero(0)
+  , values(nullptr)
+  , col_indices(nullptr)
+  , row_ptrs(nullptr)
+  , AT(s.n_cols, s.n_rows)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  update_members();
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>::SpMat_csr(const SpMat_csr<eT>& x)
+  : n_rows(0)
+  , n_cols(0)
+  , n_elem(0)
+  , n_nonzero(0)
+  , values(nullptr)
+  , col_indices(nullptr)
+  , row_ptrs(nullptr)
+  , AT(x.AT)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  update_members();
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>&
+SpMat_csr<eT>::operator=(const SpMat_csr<eT>& x)
+  {
+  arma_extra_debug_sigprint();
+  
+  AT = x.AT;
+  
+  update_members();
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>::SpMat_csr(SpMat_csr<eT>&& x)
+  : n_rows(0)
+  , n_cols(0)
+  , n_elem(0)
+  , n_nonzero(0)
+  , values(nullptr)
+  , col_indices(nullptr)
+  , row_ptrs(nullptr)
+  , AT(std::move(x.AT))
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  update_members();
+  
+  x.update_members();
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>&
+SpMat_csr<eT>::operator=(SpMat_csr<eT>&& x)
+  {
+  arma_extra_debug_sigprint();
+  
+  AT = std::move(x.AT);
+  
+  update_members();
+  
+  x.update_members();
+  
+  return *this;
+  }
+
+
+
+//! convert from CSC; the conversion is a transposition
+template<typename eT>
+template<typename T1>
+inline
+SpMat_csr<eT>::SpMat_csr(const SpBase<eT,T1>& expr)
+  : n_rows(0)
+  , n_cols(0)
+  , n_elem(0)
+  , n_nonzero(0)
+  , values(nullptr)
+  , col_indices(nullptr)
+  , row_ptrs(nullptr)
+  , AT(expr.get_ref().st())
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  update_members();
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+SpMat_csr<eT>&
+SpMat_csr<eT>::operator=(const SpBase<eT,T1>& expr)
+  {
+  arma_extra_debug_sigprint();
+  
+  AT = expr.get_ref().st();
+  
+  update_members();
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>&
+SpMat_csr<eT>::operator*=(const eT val)
+  {
+  arma_extra_debug_sigprint();
+  
+  AT *= val;
+  
+  update_members();
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>&
+SpMat_csr<eT>::operator/=(const eT val)
+  {
+  arma_extra_debug_sigprint();
+  
+  AT /= val;
+  
+  update_members();
+  
+  return *this;
+  }
+
+
+
+//! take over the memory of X, so that this matrix becomes X.st(); no elements are copied
+template<typename eT>
+inline
+void
+SpMat_csr<eT>::steal_st(SpMat<eT>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  AT.steal_mem(X);
+  
+  update_members();
+  }
+
+
+
+//! the simple transpose as a CSC sparse matrix, sharing the storage of this matrix
+template<typename eT>
+arma_inline
+const SpMat<eT>&
+SpMat_csr<eT>::st() const
+  {
+  return AT;
+  }
+
+
+
+template<typename eT>
+arma_inline
+eT
+SpMat_csr<eT>::at(const uword in_row, const uword in_col) const
+  {
+  return AT.at(in_col, in_row);
+  }
+
+
+
+template<typename eT>
+arma_inline
+eT
+SpMat_csr<eT>::operator()(const uword in_row, const uword in_col) const
+  {
+  arma_debug_check_bounds( ((in_row >= n_rows) || (in_col >= n_cols)), "SpMat_csr::operator(): index out of bounds" );
+  
+  return AT.at(in_col, in_row);
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>
+SpMat_csr<eT>::row(const uword row_num) const
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check_bounds( (row_num >= n_rows), "SpMat_csr::row(): out of bounds" );
+  
+  return (*this).rows(row_num, row_num);
+  }
+
+
+
+//! the rows are stored contiguously, so extracting them copies one block of memory
+template<typename eT>
+inline
+SpMat_csr<eT>
+SpMat_csr<eT>::rows(const uword in_row1, const uword in_row2) const
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check_bounds
+    (
+    (in_row1 > in_row2) || (in_row2 >= n_rows),
+    "SpMat_csr::rows(): indices out of bounds or incorrectly used"
+    );
+  
+  SpMat_csr<eT> out;
+  
+  out.AT = AT.cols(in_row1, in_row2);
+  
+  out.update_members();
+  
+  return out;
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_csr<eT>::zeros(const uword in_n_rows, const uword in_n_cols)
+  {
+  arma_extra_debug_sigprint();
+  
+  AT.zeros(in_n_cols, in_n_rows);
+  
+  update_members();
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_csr<eT>::reset()
+  {
+  arma_extra_debug_sigprint();
+  
+  AT.reset();
+  
+  update_members();
+  }
+
+
+
+template<typename eT>
+inline
+bool
+SpMat_csr<eT>::is_empty() const
+  {
+  return (n_elem == 0);
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_csr<eT>::print(const std::string extra_text) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const SpMat<eT> tmp(*this);
+  
+  tmp.print(extra_text);
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_csr<eT>::const_iterator
+SpMat_csr<eT>::begin() const
+  {
+  return const_iterator(*this, 0, 0);
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_csr<eT>::const_iterator
+SpMat_csr<eT>::end() const
+  {
+  return const_iterator(*this, n_rows, n_nonzero);
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_csr<eT>::const_iterator
+SpMat_csr<eT>::begin_row(const uword row_num) const
+  {
+  arma_debug_check_bounds( (row_num >= n_rows), "SpMat_csr::begin_row(): index out of bounds" );
+  
+  return const_iterator(*this, row_num, row_ptrs[row_num]);
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_csr<eT>::const_iterator
+SpMat_csr<eT>::end_row(const uword row_num) const
+  {
+  arma_debug_check_bounds( (row_num >= n_rows), "SpMat_csr::end_row(): index out of bounds" );
+  
+  return const_iterator(*this, row_num + 1, row_ptrs[row_num + 1]);
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_csr<eT>::update_members()
+  {
+  // the members mirror the CSC form of the transpose, with rows and columns swapped
+  
+  AT.sync();
+  
+  access::rw(n_rows)    = AT.n_cols;
+  access::rw(n_cols)    = AT.n_rows;
+  access::rw(n_elem)    = AT.n_elem;
+  access::rw(n_nonzero) = AT.n_nonzero;
+  
+  access::rw(values)      = AT.values;
+  access::rw(col_indices) = AT.row_indices;
+  access::rw(row_ptrs)    = AT.col_ptrs;
+  }
+
+
+
+// 
+// SpMat_csr::const_iterator
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>::const_iterator::const_iterator(const SpMat_csr<eT>& in_M, const uword in_row, const uword in_pos)
+  : M(&in_M)
+  , internal_row(in_row)
+  , internal_pos(in_pos)
+  {
+  skip_empty_rows();
+  }
+
+
+
+template<typename eT>
+inline
+arma_hot
+typename SpMat_csr<eT>::const_iterator&
+SpMat_csr<eT>::const_iterator::operator++()
+  {
+  ++internal_pos;
+  
+  skip_empty_rows();
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_csr<eT>::const_iterator
+SpMat_csr<eT>::const_iterator::operator++(int)
+  {
+  const_iterator tmp(*this);
+  
+  ++(*this);
+  
+  return tmp;
+  }
+
+
+
+template<typename eT>
+inline
+arma_hot
+bool
+SpMat_csr<eT>::const_iterator::operator==(const const_iterator& rhs) const
+  {
+  return (internal_pos == rhs.internal_pos);
+  }
+
+
+
+template<typename eT>
+inline
+arma_hot
+bool
+SpMat_csr<eT>::const_iterator::operator!=(const const_iterator& rhs) const
+  {
+  return (internal_pos != rhs.internal_pos);
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_csr<eT>::const_iterator::skip_empty_rows()
+  {
+  const uword  M_n_rows   = M->n_rows;
+  const uword* M_row_ptrs = M->row_ptrs;
+  
+  while( (internal_row < M_n_rows) && (internal_pos >= M_row_ptrs[internal_row + 1]) )  { ++internal_row; }
+  }
+
+
+
+//! @}
@@ -300,6 +300,42 @@ SpMat<eT>::operator=(const MapMat<eT>& x)
 
 
 
+//! convert from CSR; the conversion is a transposition
+template<typename eT>
+inline
+SpMat<eT>::SpMat(const SpMat_csr<eT>& x)
+  : n_rows(0)
+  , n_cols(0)
+  , n_elem(0)
+  , n_nonzero(0)
+  , vec_state(0)
+  , values(nullptr)
+  , row_indices(nullptr)
+  , col_ptrs(nullptr)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  init_cold(0, 0);
+  
+  spop_strans::apply_noalias(*this, x.st());
+  }
+
+
+
+template<typename eT>
+inline
+SpMat<eT>&
+SpMat<eT>::operator=(const SpMat_csr<eT>& x)
+  {
+  arma_extra_debug_sigprint();
+  
+  spop_strans::apply_noalias(*this, x.st());
+  
+  return *this;
+  }
+
+
+
 //! Insert a large number of values at once.
 //! locations.row[0] should be row indices, locations.row[1] should be column indices,
 //! and values should be the corresponding values.
@@ -337,37 +373,7 @@ SpMat<eT>::SpMat(const Base<uword,T1>& locations_expr, const Base<eT,T2>& vals_e
   uvec bounds = arma::max(locs, 1);
   init_cold(bounds[0] + 1, bounds[1] + 1);
   
-  // Ensure that there are no zeros
-  const uword N_old = vals.n_elem;
-        uword N_new = 0;
-  
-  for(uword i=0; i < N_old; ++i)  { N_new += (vals[i] != eT(0)) ? uword(1) : uword(0); }
-  
-  if(N_new != N_old)
-    {
-    Col<eT>    filtered_vals(   N_new, arma_nozeros_indicator());
-    Mat<uword> filtered_locs(2, N_new, arma_nozeros_indicator());
-    
-    uword index = 0;
-    for(uword i = 0; i < N_old; ++i)
-      {
-      if(vals[i] != eT(0))
-        {
-        filtered_vals[index] = vals[i];
-        
-        filtered_locs.at(0, index) = locs.at(0, i);
-        filtered_locs.at(1, index) = locs.at(1, i);
-        
-        ++index;
-        }
-      }
-    
-    init_batch_std(filtered_locs, filtered_vals, sort_locations);
-    }
-  else
-    {
-    init_batch_std(locs, vals, sort_locations);
-    }
+  init_batch(locs.memptr(), 2, locs.memptr() + 1, 2, vals.memptr(), vals.n_elem, sort_locations, false, true);
   }
 
 
@@ -405,44 +411,7 @@ SpMat<eT>::SpMat(const Base<uword,T1>& locations_expr, const Base<eT,T2>& vals_e
   
   init_cold(in_n_rows, in_n_cols);
   
-  // Ensure that there are no zeros, unless the user asked not to.
-  if(check_for_zeros)
-    {
-    const uword N_old = vals.n_elem;
-          uword N_new = 0;
-    
-    for(uword i=0; i < N_old; ++i)  { N_new += (vals[i] != eT(0)) ? uword(1) : uword(0); }
-    
-    if(N_new != N_old)
-      {
-      Col<eT>    filtered_vals(   N_new, arma_nozeros_indicator());
-      Mat<uword> filtered_locs(2, N_new, arma_nozeros_indicator());
-      
-      uword index = 0;
-      for(uword i = 0; i < N_old; ++i)
-        {
-        if(vals[i] != eT(0))
-          {
-          filtered_vals[index] = vals[i];
-          
-          filtered_locs.at(0, index) = locs.at(0, i);
-          filtered_locs.at(1, index) = locs.at(1, i);
-          
-          ++index;
-          }
-        }
-      
-      init_batch_std(filtered_locs, filtered_vals, sort_locations);
-      }
-    else
-      {
-      init_batch_std(locs, vals, sort_locations);
-      }
-    }
-  else
-    {
-    init_batch_std(locs, vals, sort_locations);
-    }
+  init_batch(locs.memptr(), 2, locs.memptr() + 1, 2, vals.memptr(), vals.n_elem, sort_locations, false, check_for_zeros);
   }
 
 
@@ -474,44 +443,45 @@ SpMat<eT>::SpMat(const bool add_values, const Base<uword,T1>& locations_expr, co
   
   init_cold(in_n_rows, in_n_cols);
   
-  // Ensure that there are no zeros, unless the user asked not to.
-  if(check_for_zeros)
-    {
-    const uword N_old = vals.n_elem;
-          uword N_new = 0;
-    
-    for(uword i=0; i < N_old; ++i)  { N_new += (vals[i] != eT(0)) ? uword(1) : uword(0); }
-    
-    if(N_new != N_old)
-      {
-      Col<eT>    filtered_vals(   N_new, arma_nozeros_indicator());
-      Mat<uword> filtered_locs(2, N_new, arma_nozeros_indicator());
-      
-      uword index = 0;
-      for(uword i = 0; i < N_old; ++i)
-        {
-        if(vals[i] != eT(0))
-          {
-          filtered_vals[index] = vals[i];
-          
-          filtered_locs.at(0, index) = locs.at(0, i);
-          filtered_locs.at(1, index) = locs.at(1, i);
-          
-          ++index;
-          }
-        }
-      
-      add_values ? init_batch_add(filtered_locs, filtered_vals, sort_locations) : init_batch_std(filtered_locs, filtered_vals, sort_locations);
-      }
-    else
-      {
-      add_values ? init_batch_add(locs, vals, sort_locations) : init_batch_std(locs, vals, sort_locations);
-      }
-    }
-  else
-    {
-    add_values ? init_batch_add(locs, vals, sort_locations) : init_batch_std(locs, vals, sort_locations);
-    }
+  init_batch(locs.memptr(), 2, locs.memptr() + 1, 2, vals.memptr(), vals.n_elem, sort_locations, add_values, check_for_zeros);
+  }
+
+
+
+//! Insert a large number of values at once, with the locations given as separate vectors of row and column indices.
+//! If add_values is true, the values at identical locations are added.
+template<typename eT>
+template<typename T1, typename T2, typename T3>
+inline
+SpMat<eT>::SpMat(const bool add_values, const Base<uword,T1>& rowind_expr, const Base<uword,T2>& colind_expr, const Base<eT,T3>& vals_expr, const uword in_n_rows, const uword in_n_cols, const bool sort_locations, const bool check_for_zeros)
+  : n_rows(0)
+  , n_cols(0)
+  , n_elem(0)
+  , n_nonzero(0)
+  , vec_state(0)
+  , values(nullptr)
+  , row_indices(nullptr)
+  , col_ptrs(nullptr)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  const unwrap<T1> rowind_tmp( rowind_expr.get_ref() );
+  const unwrap<T2> colind_tmp( colind_expr.get_ref() );
+  const unwrap<T3>   vals_tmp(   vals_expr.get_ref() );
+  
+  const Mat<uword>& rowind = rowind_tmp.M;
+  const Mat<uword>& colind = colind_tmp.M;
+  const Mat<eT>&    vals   =   vals_tmp.M;
+  
+  arma_debug_check( (rowind.is_vec() == false), "SpMat::SpMat(): given 'row_indices' object must be a vector" );
+  arma_debug_check( (colind.is_vec() == false), "SpMat::SpMat(): given 'col_indices' object must be a vector" );
+  arma_debug_check( (vals.is_vec()   == false), "SpMat::SpMat(): given 'values' object must be a vector"      );
+  
+  arma_debug_check( ( (rowind.n_elem != vals.n_elem) || (colind.n_elem != vals.n_elem) ), "SpMat::SpMat(): number of locations is different than number of values" );
+  
+  init_cold(in_n_rows, in_n_cols);
+  
+  init_batch(rowind.memptr(), 1, colind.memptr(), 1, vals.memptr(), vals.n_elem, sort_locations, add_values, check_for_zeros);
   }
 
 
@@ -5230,80 +5200,91 @@ SpMat<eT>::init(const MapMat<eT>& x)
   
   if(x_n_nz == 0)  { return; }
   
-  typename MapMat<eT>::map_type& x_map_ref = *(x.map_ptr);
+  // the elements in the hash table are unordered:
+  // count the elements in each column, scatter them into their columns,
+  // then sort the row indices within each column
+  
+  const MapMat_map<eT>& x_map_ref = *(x.map_ptr);
+  
+  const uword  x_n_slots = x_map_ref.n_slots;
+  const uword* x_keys    = x_map_ref.keys;
+  const eT*    x_vals    = x_map_ref.vals;
   
-  typename MapMat<eT>::map_type::const_iterator x_it = x_map_ref.begin();
+  const uword empty_key = MapMat_map<eT>::empty_key;
   
-  uword x_col             = 0;
-  uword x_col_index_start = 0;
-  uword x_col_index_endp1 = x_n_rows;
+  uword* t_col_ptrs    = access::rwp(col_ptrs);
+  uword* t_row_indices = access::rwp(row_indices);
+  eT*    t_values      = access::rwp(values);
   
-  for(uword i=0; i < x_n_nz; ++i)
+  for(uword i=0; i < x_n_slots; ++i)
     {
-    const std::pair<uword, eT>& x_entry = (*x_it);
-    
-    const uword x_index = x_entry.first;
-    const eT    x_val   = x_entry.second;
-    
-    // have we gone past the curent column?
-    if(x_index >= x_col_index_endp1)
-      {
-      x_col = x_index / x_n_rows;
-      
-      x_col_index_start = x_col * x_n_rows;
-      x_col_index_endp1 = x_col_index_start + x_n_rows;
-      }
-    
-    const uword x_row = x_index - x_col_index_start;
+    if(x_keys[i] != empty_key)  { ++t_col_ptrs[ (x_keys[i] / x_n_rows) + 1 ]; }
+    }
+  
+  for(uword i=0; i < x_n_cols; ++i)  { t_col_ptrs[i + 1] += t_col_ptrs[i]; }
+  
+  podarray<uword> col_pos(t_col_ptrs, x_n_cols);
+  
+  for(uword i=0; i < x_n_slots; ++i)
+    {
+    const uword x_index = x_keys[i];
     
-    // // sanity check
-    // 
-    // const uword tmp_x_row = x_index % x_n_rows;
-    // const uword tmp_x_col = x_index / x_n_rows;
-    // 
-    // if(x_row != tmp_x_row)  { cout << "x_row != tmp_x_row" << endl; exit(-1); }
-    // if(x_col != tmp_x_col)  { cout << "x_col != tmp_x_col" << endl; exit(-1); }
+    if(x_index == empty_key)  { continue; }
     
-    access::rw(values[i])      = x_val;
-    access::rw(row_indices[i]) = x_row;
+    const uword x_col = x_index / x_n_rows;
+    const uword x_row = x_index - (x_col * x_n_rows);
     
-    access::rw(col_ptrs[ x_col + 1 ])++;
+    const uword pos = col_pos[x_col]++;
     
-    ++x_it;
+    t_row_indices[pos] = x_row;
+    t_values[pos]      = x_vals[i];
     }
   
+  std::vector< std::pair<uword, eT> > packets;
   
-  for(uword i = 0; i < x_n_cols; ++i)
+  for(uword col=0; col < x_n_cols; ++col)
     {
-    access::rw(col_ptrs[i + 1]) += col_ptrs[i];
+    const uword start = t_col_ptrs[col    ];
+    const uword end   = t_col_ptrs[col + 1];
+    
+    const uword N = end - start;
+    
+    if(N <= 1)  { continue; }
+    
+    uword* col_rows = &(t_row_indices[start]);
+    eT*    col_vals = &(t_values[start]);
+    
+    if(N <= 32)
+      {
+      // insertion sort for short columns
+      for(uword i=1; i < N; ++i)
+        {
+        const uword row = col_rows[i];
+        const eT    val = col_vals[i];
+        
+        uword j = i;
+        
+        for(; (j > 0) && (col_rows[j-1] > row); --j)
+          {
+          col_rows[j] = col_rows[j-1];
+          col_vals[j] = col_vals[j-1];
+          }
+        
+        col_rows[j] = row;
+        col_vals[j] = val;
+        }
+      }
+    else
+      {
+      packets.resize(N);
+      
+      for(uword i=0; i < N; ++i)  { packets[i] = std::make_pair(col_rows[i], col_vals[i]); }
+      
+      std::sort( packets.begin(), packets.end(), [](const std::pair<uword, eT>& A, const std::pair<uword, eT>& B) { return (A.first < B.first); } );
+      
+      for(uword i=0; i < N; ++i)  { col_rows[i] = packets[i].first; col_vals[i] = packets[i].second; }
+      }
     }
-  
-  
-  // // OLD METHOD
-  // 
-  // for(uword i=0; i < x_n_nz; ++i)
-  //   {
-  //   const std::pair<uword, eT>& x_entry = (*x_it);
-  //   
-  //   const uword x_index = x_entry.first;
-  //   const eT    x_val   = x_entry.second;
-  // 
-  // const uword x_row = x_index % x_n_rows;
-  // const uword x_col = x_index / x_n_rows;
-  // 
-  // access::rw(values[i])      = x_val;
-  // access::rw(row_indices[i]) = x_row;
-  // 
-  // access::rw(col_ptrs[ x_col + 1 ])++;
-  // 
-  // ++x_it;
-  // }
-  // 
-  // 
-  // for(uword i = 0; i < x_n_cols; ++i)
-  // {
-  // access::rw(col_ptrs[i + 1]) += col_ptrs[i];
-  // }
   }
 
 
@@ -5329,312 +5310,224 @@ SpMat<eT>::init_simple(const SpMat<eT>& x)
 template<typename eT>
 inline
 void
-SpMat<eT>::init_batch_std(const Mat<uword>& locs, const Mat<eT>& vals, const bool sort_locations)
+SpMat<eT>::init_batch(const uword* row_mem, const uword row_stride, const uword* col_mem, const uword col_stride, const eT* val_mem, const uword N, const bool sort_locations, const bool add_values, const bool check_for_zeros)
   {
   arma_extra_debug_sigprint();
   
-  // Resize to correct number of elements.
-  mem_resize(vals.n_elem);
-  
-  // Reset column pointers to zero.
-  arrayops::fill_zeros(access::rwp(col_ptrs), n_cols + 1);
-  
-  bool actually_sorted = true;
-  
-  if(sort_locations)
-    {
-    // check if we really need a time consuming sort
-    
-    const uword locs_n_cols = locs.n_cols;
-    
-    for(uword i = 1; i < locs_n_cols; ++i)
-      {
-      const uword* locs_i   = locs.colptr(i  );
-      const uword* locs_im1 = locs.colptr(i-1);
-      
-      const uword row_i = locs_i[0];
-      const uword col_i = locs_i[1];
-      
-      const uword row_im1 = locs_im1[0];
-      const uword col_im1 = locs_im1[1];
-      
-      if( (col_i < col_im1) || ((col_i == col_im1) && (row_i <= row_im1)) )
-        {
-        actually_sorted = false;
-        break;
-        }
-      }
-    
-    if(actually_sorted == false)
-      {
-      // see op_sort_index_bones.hpp for the definition of arma_sort_index_packet and arma_sort_index_helper_ascend
-      
-      std::vector< arma_sort_index_packet<uword> > packet_vec(locs_n_cols);
-      
-      const uword* locs_mem = locs.memptr();
-      
-      for(uword i = 0; i < locs_n_cols; ++i)
-        {
-        const uword row = (*locs_mem);  locs_mem++;
-        const uword col = (*locs_mem);  locs_mem++;
-        
-        packet_vec[i].val   = (col * n_rows) + row;
-        packet_vec[i].index = i;
-        }
-      
-      arma_sort_index_helper_ascend<uword> comparator;
-      
-      std::sort( packet_vec.begin(), packet_vec.end(), comparator );
-      
-      // insert the elements in the sorted order
-      for(uword i = 0; i < locs_n_cols; ++i)
-        {
-        const uword index = packet_vec[i].index;
-        
-        const uword* locs_i = locs.colptr(index);
-        
-        const uword row_i = locs_i[0];
-        const uword col_i = locs_i[1];
-        
-        arma_debug_check( ( (row_i >= n_rows) || (col_i >= n_cols) ), "SpMat::SpMat(): invalid row or column index" );
-        
-        if(i > 0)
-          {
-          const uword prev_index = packet_vec[i-1].index;
-          
-          const uword* locs_im1 = locs.colptr(prev_index);
-          
-          const uword row_im1 = locs_im1[0];
-          const uword col_im1 = locs_im1[1];
-          
-          arma_debug_check( ( (row_i == row_im1) && (col_i == col_im1) ), "SpMat::SpMat(): detected identical locations" );
-          }
-        
-        access::rw(values[i])      = vals[index];
-        access::rw(row_indices[i]) = row_i;
-        
-        access::rw(col_ptrs[ col_i + 1 ])++;
-        }
-      }
-    }
+  // counting sort by column:
+  // each part of the input is counted per column, the counts are turned into offsets,
+  // and each part is scattered into its columns, keeping the order of the input within each column;
+  // the row indices within each column are then sorted, and identical locations are merged
   
-  if( (sort_locations == false) || (actually_sorted == true) )
+  if(arma_config::debug)
     {
-    // Now set the values and row indices correctly.
-    // Increment the column pointers in each column (so they are column "counts").
+    uword prev_row = 0;
+    uword prev_col = 0;
+    bool  has_prev = false;
     
-    const uword locs_n_cols = locs.n_cols;
-    
-    for(uword i=0; i < locs_n_cols; ++i)
+    for(uword i=0; i < N; ++i)
       {
-      const uword* locs_i = locs.colptr(i);
+      if(check_for_zeros && (val_mem[i] == eT(0)))  { continue; }
       
-      const uword row_i = locs_i[0];
-      const uword col_i = locs_i[1];
+      const uword row = row_mem[i*row_stride];
+      const uword col = col_mem[i*col_stride];
       
-      arma_debug_check( ( (row_i >= n_rows) || (col_i >= n_cols) ), "SpMat::SpMat(): invalid row or column index" );
+      arma_debug_check( ( (row >= n_rows) || (col >= n_cols) ), "SpMat::SpMat(): invalid row or column index" );
       
-      if(i > 0)
+      if( (sort_locations == false) && has_prev )
         {
-        const uword* locs_im1 = locs.colptr(i-1);
-        
-        const uword row_im1 = locs_im1[0];
-        const uword col_im1 = locs_im1[1];
-        
         arma_debug_check
           (
-          ( (col_i < col_im1) || ((col_i == col_im1) && (row_i < row_im1)) ),
+          ( (col < prev_col) || ((col == prev_col) && (row < prev_row)) ),
           "SpMat::SpMat(): out of order points; either pass sort_locations = true, or sort points in column-major ordering"
           );
-        
-        arma_debug_check( ( (col_i == col_im1) && (row_i == row_im1) ), "SpMat::SpMat(): detected identical locations" );
         }
       
-      access::rw(values[i])      = vals[i];
-      access::rw(row_indices[i]) = row_i;
-      
-      access::rw(col_ptrs[ col_i + 1 ])++;
+      prev_row = row;
+      prev_col = col;
+      has_prev = true;
       }
     }
   
-  // Now fix the column pointers.
-  for(uword i = 0; i < n_cols; ++i)
-    {
-    access::rw(col_ptrs[i + 1]) += col_ptrs[i];
-    }
-  }
-
-
-
-template<typename eT>
-inline
-void
-SpMat<eT>::init_batch_add(const Mat<uword>& locs, const Mat<eT>& vals, const bool sort_locations)
-  {
-  arma_extra_debug_sigprint();
+  int n_threads = 1;
   
-  if(locs.n_cols < 2)
+  #if defined(ARMA_USE_MP)
     {
-    init_batch_std(locs, vals, false);
-    return;
+    // per-part counts are only worthwhile when they are small compared to the input
+    if( mp_gate<eT>::eval(N) && ((uword(mp_thread_limit::get()) * n_cols) <= N) )  { n_threads = mp_thread_limit::get(); }
     }
+  #endif
   
-  // Reset column pointers to zero.
-  arrayops::fill_zeros(access::rwp(col_ptrs), n_cols + 1);
+  const uword n_parts   = uword(n_threads);
+  const uword part_size = (N + n_parts - 1) / n_parts;
   
-  bool actually_sorted = true;
+  Mat<uword> offsets(n_cols, n_parts, arma_zeros_indicator());
   
-  if(sort_locations)
+  mp_parallel::run(n_parts, n_threads, [&](const uword part)
     {
-    // sort_index() uses std::sort() which may use quicksort... so we better
-    // make sure it's not already sorted before taking an O(N^2) sort penalty.
-    for(uword i = 1; i < locs.n_cols; ++i)
+    const uword start = part * part_size;
+    const uword endp1 = (std::min)(start + part_size, N);
+    
+    uword* part_counts = offsets.colptr(part);
+    
+    for(uword i=start; i < endp1; ++i)
       {
-      const uword* locs_i   = locs.colptr(i  );
-      const uword* locs_im1 = locs.colptr(i-1);
+      if(check_for_zeros && (val_mem[i] == eT(0)))  { continue; }
       
-      if( (locs_i[1] < locs_im1[1]) || (locs_i[1] == locs_im1[1]  &&  locs_i[0] <= locs_im1[0]) )
-        {
-        actually_sorted = false;
-        break;
-        }
+      ++part_counts[ col_mem[i*col_stride] ];
       }
+    } );
+  
+  uword* t_col_ptrs = access::rwp(col_ptrs);
+  
+  uword n_kept = 0;
+  
+  for(uword col=0; col < n_cols; ++col)
+    {
+    t_col_ptrs[col] = n_kept;
     
-    if(actually_sorted == false)
+    for(uword part=0; part < n_parts; ++part)
       {
-      // This may not be the fastest possible implementation but it maximizes code reuse.
-      Col<uword> abslocs(locs.n_cols, arma_nozeros_indicator());
+      uword& val = offsets.at(col, part);
       
-      for(uword i = 0; i < locs.n_cols; ++i)
-        {
-        const uword* locs_i = locs.colptr(i);
-        
-        abslocs[i] = locs_i[1] * n_rows + locs_i[0];
-        }
-      
-      uvec sorted_indices = sort_index(abslocs); // Ascending sort.
-      
-      // work out the number of unique elments 
-      uword n_unique = 1;  // first element is unique
-      
-      for(uword i=1; i < sorted_indices.n_elem; ++i)
-        {
-        const uword* locs_i   = locs.colptr( sorted_indices[i  ] );
-        const uword* locs_im1 = locs.colptr( sorted_indices[i-1] );
-        
-        if( (locs_i[1] != locs_im1[1]) || (locs_i[0] != locs_im1[0]) )  { ++n_unique; }
-        }
-      
-      // resize to correct number of elements
-      mem_resize(n_unique);
+      const uword count = val;
       
-      // Now we add the elements in this sorted order.
-      uword count = 0;
-      
-      // first element
-        {
-        const uword  i      = 0;
-        const uword* locs_i = locs.colptr( sorted_indices[i] );
-        
-        arma_debug_check( ( (locs_i[0] >= n_rows) || (locs_i[1] >= n_cols) ), "SpMat::SpMat(): invalid row or column index" );
-        
-        access::rw(values[count])      = vals[ sorted_indices[i] ];
-        access::rw(row_indices[count]) = locs_i[0];
-        
-        access::rw(col_ptrs[ locs_i[1] + 1 ])++;
-        }
+      val = n_kept;
       
-      for(uword i=1; i < sorted_indices.n_elem; ++i)
-        {
-        const uword* locs_i   = locs.colptr( sorted_indices[i  ] );
-        const uword* locs_im1 = locs.colptr( sorted_indices[i-1] );
-        
-        arma_debug_check( ( (locs_i[0] >= n_rows) || (locs_i[1] >= n_cols) ), "SpMat::SpMat(): invalid row or column index" );
-        
-        if( (locs_i[1] == locs_im1[1]) && (locs_i[0] == locs_im1[0]) )
-          {
-          access::rw(values[count]) += vals[ sorted_indices[i] ];
-          }
-        else
-          {
-          count++;
-          access::rw(values[count])      = vals[ sorted_indices[i] ];
-          access::rw(row_indices[count]) = locs_i[0];
-          
-          access::rw(col_ptrs[ locs_i[1] + 1 ])++;
-          }
-        }
+      n_kept += count;
       }
     }
   
-  if( (sort_locations == false) || (actually_sorted == true) )
+  t_col_ptrs[n_cols] = n_kept;
+  
+  mem_resize(n_kept);
+  
+  uword* t_row_indices = access::rwp(row_indices);
+  eT*    t_values      = access::rwp(values);
+  
+  mp_parallel::run(n_parts, n_threads, [&](const uword part)
     {
-    // work out the number of unique elments 
-    uword n_unique = 1;  // first element is unique
+    const uword start = part * part_size;
+    const uword endp1 = (std::min)(start + part_size, N);
+    
+    uword* part_offsets = offsets.colptr(part);
     
-    for(uword i=1; i < locs.n_cols; ++i)
+    for(uword i=start; i < endp1; ++i)
       {
-      const uword* locs_i   = locs.colptr(i  );
-      const uword* locs_im1 = locs.colptr(i-1);
+      const eT val = val_mem[i];
       
-      if( (locs_i[1] != locs_im1[1]) || (locs_i[0] != locs_im1[0]) )  { ++n_unique; }
+      if(check_for_zeros && (val == eT(0)))  { continue; }
+      
+      const uword pos = part_offsets[ col_mem[i*col_stride] ]++;
+      
+      t_row_indices[pos] = row_mem[i*row_stride];
+      t_values[pos]      = val;
       }
+    } );
+  
+  // sort each column with a stable sort, so that identical locations are merged in the order given
+  
+  podarray<uword> n_unique(n_cols);
+  
+  mp_parallel::run(n_cols, n_threads, [&](const uword col)
+    {
+    const uword start = t_col_ptrs[col    ];
+    const uword endp1 = t_col_ptrs[col + 1];
     
-    // resize to correct number of elements
-    mem_resize(n_unique);
-    
-    // Now set the values and row indices correctly.
-    // Increment the column pointers in each column (so they are column "counts").
+    const uword len = endp1 - start;
     
-    uword count = 0;
+    uword* col_rows = &(t_row_indices[start]);
+    eT*    col_vals = &(t_values[start]);
     
-    // first element
+    if( (len > 1) && (std::is_sorted(col_rows, col_rows + len) == false) )
       {
-      const uword  i      = 0;
-      const uword* locs_i = locs.colptr(i);
-      
-      arma_debug_check( ( (locs_i[0] >= n_rows) || (locs_i[1] >= n_cols) ), "SpMat::SpMat(): invalid row or column index" );
-      
-      access::rw(values[count])      = vals[i];
-      access::rw(row_indices[count]) = locs_i[0];
-      
-      access::rw(col_ptrs[ locs_i[1] + 1 ])++;
+      if(len <= 32)
+        {
+        for(uword i=1; i < len; ++i)
+          {
+          const uword row = col_rows[i];
+          const eT    val = col_vals[i];
+          
+          uword j = i;
+          
+          for(; (j > 0) && (col_rows[j-1] > row); --j)
+            {
+            col_rows[j] = col_rows[j-1];
+            col_vals[j] = col_vals[j-1];
+            }
+          
+          col_rows[j] = row;
+          col_vals[j] = val;
+          }
+        }
+      else
+        {
+        std::vector< std::pair<uword, eT> > packets(len);
+        
+        for(uword i=0; i < len; ++i)  { packets[i] = std::make_pair(col_rows[i], col_vals[i]); }
+        
+        std::stable_sort( packets.begin(), packets.end(), [](const std::pair<uword, eT>& A, const std::pair<uword, eT>& B) { return (A.first < B.first); } );
+        
+        for(uword i=0; i < len; ++i)  { col_rows[i] = packets[i].first; col_vals[i] = packets[i].second; }
+        }
       }
     
-    for(uword i=1; i < locs.n_cols; ++i)
+    // identical locations: values are added, or the last value is kept
+    
+    uword count = (len > 0) ? uword(1) : uword(0);
+    
+    for(uword i=1; i < len; ++i)
       {
-      const uword* locs_i   = locs.colptr(i  );
-      const uword* locs_im1 = locs.colptr(i-1);
-      
-      arma_debug_check( ( (locs_i[0] >= n_rows) || (locs_i[1] >= n_cols) ), "SpMat::SpMat(): invalid row or column index" );
-      
-      arma_debug_check
-        (
-        ( (locs_i[1] < locs_im1[1]) || (locs_i[1] == locs_im1[1]  &&  locs_i[0] < locs_im1[0]) ),
-        "SpMat::SpMat(): out of order points; either pass sort_locations = true, or sort points in column-major ordering"
-        );
-      
-      if( (locs_i[1] == locs_im1[1]) && (locs_i[0] == locs_im1[0]) )
+      if(col_rows[i] == col_rows[count-1])
         {
-        access::rw(values[count]) += vals[i];
+        col_vals[count-1] = (add_values) ? eT(col_vals[count-1] + col_vals[i]) : eT(col_vals[i]);
         }
       else
         {
-        count++;
-        
-        access::rw(values[count])      = vals[i];
-        access::rw(row_indices[count]) = locs_i[0];
+        col_rows[count] = col_rows[i];
+        col_vals[count] = col_vals[i];
         
-        access::rw(col_ptrs[ locs_i[1] + 1 ])++;
+        ++count;
         }
       }
-    }
+    
+    n_unique[col] = count;
+    } );
   
-  // Now fix the column pointers.
-  for(uword i = 0; i < n_cols; ++i)
+  uword n_total_unique = 0;
+  
+  for(uword col=0; col < n_cols; ++col)  { n_total_unique += n_unique[col]; }
+  
+  arma_debug_check( ( (add_values == false) && (n_total_unique != n_kept) ), "SpMat::SpMat(): detected identical locations" );
+  
+  if(n_total_unique == n_kept)  { return; }
+  
+  // remove the gaps left by merged elements
+  
+  uword pos = 0;
+  
+  for(uword col=0; col < n_cols; ++col)
     {
-    access::rw(col_ptrs[i + 1]) += col_ptrs[i];
+    const uword start = t_col_ptrs[col];
+    const uword count = n_unique[col];
+    
+    if(pos != start)
+      {
+      for(uword i=0; i < count; ++i)
+        {
+        t_row_indices[pos + i] = t_row_indices[start + i];
+        t_values     [pos + i] = t_values     [start + i];
+        }
+      }
+    
+    t_col_ptrs[col] = pos;
+    
+    pos += count;
     }
+  
+  t_col_ptrs[n_cols] = pos;
+  
+  mem_resize(pos);
   }
 
 
@@ -6583,6 +6476,42 @@ SpMat<eT>::try_div_value_csc(const uword in_row, const uword in_col, const eT in
 
 
 
+//! insert a new element directly into the CSC representation, instead of switching to the cache;
+//! each insertion copies all elements, while switching to the cache and later flushing it
+//! costs about as much as copying all elements csc_insert_ratio times;
+//! direct insertions are done until their combined cost reaches the cost of switching
+template<typename eT>
+inline
+arma_warn_unused
+bool
+SpMat<eT>::try_insert_value_csc(const uword in_row, const uword in_col, const eT in_val)
+  {
+  arma_extra_debug_sigprint();
+  
+  if( (sync_state != 0) || (in_val == eT(0)) )  { return false; }
+  
+  // fail if the element exists, ie. it is being erased
+  if(find_value_csc(in_row, in_col) != nullptr)  { return false; }
+  
+  const uword csc_insert_ratio = 16;  // measured for matrices with 1e5 to 3e6 non-zero elements
+  
+  const uword cost = n_nonzero + n_cols + 1;
+  
+  uword& spent = cache.csc_insert_cost;
+  
+  if( (spent + cost) > (csc_insert_ratio * (n_nonzero + 1)) )  { return false; }
+  
+  spent += cost;
+  
+  const eT& val_ref = insert_element(in_row, in_col, in_val);
+  
+  arma_ignore(val_ref);
+  
+  return true;
+  }
+
+
+
 /**
  * Insert an element at the given position, and return a reference to it.  
  * The element will be set to 0, unless otherwise specified.
@@ -30,6 +30,48 @@ struct arma_config
   #endif
   
   
+  #if defined(ARMA_USE_MEM_POOL)
+    static constexpr bool mem_pool = true;
+  #else
+    static constexpr bool mem_pool = false;
+  #endif
+  
+  
+  #if defined(ARMA_MEM_POOL_MAX_BYTES)
+    static constexpr size_t mem_pool_max_bytes = (sword(ARMA_MEM_POOL_MAX_BYTES) > 0) ? size_t(ARMA_MEM_POOL_MAX_BYTES) : 1048576;
+  #else
+    static constexpr size_t mem_pool_max_bytes = 1048576;
+  #endif
+  
+  
+  #if defined(ARMA_MEM_POOL_MAX_RETAINED)
+    static constexpr size_t mem_pool_max_retained = (sword(ARMA_MEM_POOL_MAX_RETAINED) >= 0) ? size_t(ARMA_MEM_POOL_MAX_RETAINED) : 67108864;
+  #else
+    static constexpr size_t mem_pool_max_retained = 67108864;
+  #endif
+  
+  
+  #if defined(ARMA_MEM_ALIGNMENT)
+    static constexpr uword mem_align = ( (sword(ARMA_MEM_ALIGNMENT) >= 16) && ((uword(ARMA_MEM_ALIGNMENT) & (uword(ARMA_MEM_ALIGNMENT) - 1)) == 0) ) ? uword(ARMA_MEM_ALIGNMENT) : 64;
+  #else
+    static constexpr uword mem_align = 64;
+  #endif
+  
+  
+  #if defined(ARMA_USE_HUGE_PAGES)
+    static constexpr bool huge_pages = true;
+  #else
+    static constexpr bool huge_pages = false;
+  #endif
+  
+  
+  #if defined(ARMA_HUGE_PAGE_THRESHOLD)
+    static constexpr size_t huge_page_threshold = (sword(ARMA_HUGE_PAGE_THRESHOLD) > 0) ? size_t(ARMA_HUGE_PAGE_THRESHOLD) : 4194304;
+  #else
+    static constexpr size_t huge_page_threshold = 4194304;
+  #endif
+  
+  
   #if defined(ARMA_OPENMP_THRESHOLD)
     static constexpr uword mp_threshold = (sword(ARMA_OPENMP_THRESHOLD) > 0) ? uword(ARMA_OPENMP_THRESHOLD) : 320;
   #else
@@ -44,6 +86,13 @@ struct arma_config
   #endif
   
   
+  #if defined(ARMA_OPENMP_CALIBRATE)
+    static constexpr bool mp_calibrate = true;
+  #else
+    static constexpr bool mp_calibrate = false;
+  #endif
+  
+  
   #if defined(ARMA_OPTIMISE_BAND)
     static constexpr bool optimise_band = true;
   #else
@@ -209,6 +258,27 @@ struct arma_config
   #endif
   
   
+  #if defined(ARMA_USE_MP)
+    static constexpr bool mp = true;
+  #else
+    static constexpr bool mp = false;
+  #endif
+  
+  
+  #if defined(ARMA_USE_VECMATH)
+    static constexpr bool vecmath = true;
+  #else
+    static constexpr bool vecmath = false;
+  #endif
+  
+  
+  #if defined(ARMA_USE_CPU_DISPATCH)
+    static constexpr bool cpu_dispatch = true;
+  #else
+    static constexpr bool cpu_dispatch = false;
+  #endif
+  
+  
   #if defined(ARMA_USE_FORTRAN_HIDDEN_ARGS)
     static constexpr bool hidden_args = true;
   #else
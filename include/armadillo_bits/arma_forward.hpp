@@ -29,11 +29,14 @@ template<typename eT> class Mat;
 template<typename eT> class Col;
 template<typename eT> class Row;
 template<typename eT> class Cube;
+template<typename eT> class mapped_file_elems;
 template<typename eT> class xvec_htrans;
 template<typename oT> class field;
 
 template<typename eT, bool do_conj> class xtrans_mat;
 
+namespace mat_reader_priv { template<typename eT> class mat_reader; }
+
 
 template<typename eT> class subview;
 template<typename eT> class subview_col;
@@ -48,6 +51,7 @@ template<typename eT> class SpValProxy;
 template<typename eT> class SpMat;
 template<typename eT> class SpCol;
 template<typename eT> class SpRow;
+template<typename eT> class SpMat_csr;
 template<typename eT> class SpSubview;
 template<typename eT> class SpSubview_col;
 template<typename eT> class SpSubview_row;
@@ -56,6 +60,7 @@ template<typename eT> class diagview;
 template<typename eT> class spdiagview;
 
 template<typename eT> class MapMat;
+template<typename eT> class MapMat_map;
 template<typename eT> class MapMat_val;
 template<typename eT> class SpMat_MapMat_val;
 template<typename eT> class SpSubview_MapMat_val;
@@ -266,6 +271,7 @@ template<typename T1> class diagmat_proxy;
 template<typename T1> struct unwrap;
 template<typename T1> struct quasi_unwrap;
 template<typename T1> struct unwrap_cube;
+template<typename T1> struct unwrap_cube_check;
 template<typename T1> struct unwrap_spmat;
 
 
@@ -374,6 +380,7 @@ enum struct file_type : unsigned int
   hdf5_binary_trans,  //!< [NOTE: DO NOT USE - deprecated] as per hdf5_binary, but save/load the data with columns transposed to rows
   coord_ascii,        //!< simple co-ordinate format for sparse matrices (indices start at zero)
   ssv_ascii,          //!< similar to csv_ascii; uses semicolon (;) instead of comma (,) as the separator
+  arma_binary_compressed,  //!< as per arma_binary, but with the elements stored as independently compressed blocks of columns
   };
 
 
@@ -390,6 +397,16 @@ static constexpr file_type hdf5_binary        = file_type::hdf5_binary;
 static constexpr file_type hdf5_binary_trans  = file_type::hdf5_binary_trans;
 static constexpr file_type coord_ascii        = file_type::coord_ascii;
 static constexpr file_type ssv_ascii          = file_type::ssv_ascii;
+static constexpr file_type arma_binary_compressed = file_type::arma_binary_compressed;
+
+
+//! access modes for matrices and cubes stored in memory mapped files
+enum struct map_mode : unsigned int
+  {
+  read_only,      //!< the file is not modified; a mapped matrix or cube treats this as copy_on_write
+  read_write,     //!< changes to the elements are written to the file and are visible to other processes mapping the file
+  copy_on_write   //!< changes to the elements are private; memory is shared with other processes until modified
+  };
 
 
 struct hdf5_name;
@@ -444,6 +461,28 @@ struct superlu_opts : public spsolve_opts_base
   };
 
 
+struct spsolve_opts : public spsolve_opts_base
+  {
+  typedef enum {PRECOND_NONE, PRECOND_JACOBI, PRECOND_ILU0, PRECOND_IC0} precond_type;
+  
+  double       tol;         // relative residual tolerance; 0 = automatic
+  unsigned int max_iter;    // max iterations
+  unsigned int restart;     // dimension of the Krylov subspace in GMRES before restarting
+  precond_type precond;
+  bool         warm_start;  // use the contents of the output matrix as the initial guess
+  
+  inline spsolve_opts()
+    : spsolve_opts_base(2)
+    {
+    tol        = 0.0;
+    max_iter   = 1000;
+    restart    = 30;
+    precond    = PRECOND_JACOBI;
+    warm_start = false;
+    }
+  };
+
+
 //! @}
 
 
@@ -454,15 +493,44 @@ struct superlu_opts : public spsolve_opts_base
 
 struct eigs_opts
   {
+  typedef enum {METHOD_KRYLOV, METHOD_LOBPCG} method_type;
+  
+  typedef enum {PRECOND_NONE, PRECOND_JACOBI} precond_type;
+  
   double       tol;     // tolerance
   unsigned int maxiter; // max iterations
-  unsigned int subdim;  // subspace dimension
+  unsigned int subdim;  // subspace dimension; for METHOD_LOBPCG, number of vectors in the block
+  method_type  method;  // eigs_sym() only
+  precond_type precond; // METHOD_LOBPCG only
   
   inline eigs_opts()
     {
     tol     = 0.0;
     maxiter = 1000;
     subdim  = 0;
+    method  = METHOD_KRYLOV;
+    precond = PRECOND_NONE;
+    }
+  };
+
+
+//! @}
+
+
+
+//! \ingroup fn_svd_rand fn_svds
+//! @{
+
+
+struct svd_rand_opts
+  {
+  unsigned int oversample;  // number of extra columns in the random sketch
+  unsigned int power_iter;  // number of power iterations
+  
+  inline svd_rand_opts()
+    {
+    oversample = 10;
+    power_iter = 2;
     }
   };
 
@@ -633,9 +633,9 @@ struct arma_rng::randn
   void
   fill(eT* mem, const uword N)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
-      if((N < 1024) || omp_in_parallel())  { arma_rng::randn<eT>::fill_simple(mem, N); return; }
+      if((N < 1024) || mp_thread_limit::in_parallel())  { arma_rng::randn<eT>::fill_simple(mem, N); return; }
       
       typedef typename std::mt19937_64::result_type local_seed_type;
       
@@ -653,8 +653,7 @@ struct arma_rng::randn
       
       const uword chunk_size = N / n_threads;
       
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
-      for(uword t=0; t < n_threads; ++t)
+      mp_parallel::run(n_threads, int(n_threads), [&](const uword t)
         {
         const uword start = (t+0) * chunk_size;
         const uword endp1 = (t+1) * chunk_size;
@@ -663,7 +662,7 @@ struct arma_rng::randn
         std::normal_distribution<double>& t_distr  =  distr[t];
         
         for(uword i=start; i < endp1; ++i)  { mem[i] = eT( t_distr(t_engine)); }
-        }
+        });
       
       std::mt19937_64&                  t0_engine = engine[0];
       std::normal_distribution<double>& t0_distr  =  distr[0];
@@ -801,9 +800,9 @@ struct arma_rng::randn< std::complex<T> >
   void
   fill(std::complex<T>* mem, const uword N)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
-      if((N < 512) || omp_in_parallel())  { arma_rng::randn< std::complex<T> >::fill_simple(mem, N); return; }
+      if((N < 512) || mp_thread_limit::in_parallel())  { arma_rng::randn< std::complex<T> >::fill_simple(mem, N); return; }
       
       typedef typename std::mt19937_64::result_type local_seed_type;
       
@@ -821,8 +820,7 @@ struct arma_rng::randn< std::complex<T> >
       
       const uword chunk_size = N / n_threads;
       
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
-      for(uword t=0; t < n_threads; ++t)
+      mp_parallel::run(n_threads, int(n_threads), [&](const uword t)
         {
         const uword start = (t+0) * chunk_size;
         const uword endp1 = (t+1) * chunk_size;
@@ -837,7 +835,7 @@ struct arma_rng::randn< std::complex<T> >
           
           mem[i] = std::complex<T>(val1, val2);
           }
-        }
+        });
       
       std::mt19937_64&                  t0_engine = engine[0];
       std::normal_distribution<double>& t0_distr  =  distr[0];
@@ -916,9 +914,9 @@ struct arma_rng::randg
   void
   fill(eT* mem, const uword N, const double a, const double b)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
-      if((N < 512) || omp_in_parallel())  { arma_rng::randg<eT>::fill_simple(mem, N, a, b); return; }
+      if((N < 512) || mp_thread_limit::in_parallel())  { arma_rng::randg<eT>::fill_simple(mem, N, a, b); return; }
       
       typedef std::mt19937_64                  motor_type;
       typedef std::mt19937_64::result_type      ovum_type;
@@ -943,8 +941,7 @@ struct arma_rng::randg
       
       const uword chunk_size = N / n_threads;
       
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads))
-      for(uword t=0; t < n_threads; ++t)
+      mp_parallel::run(n_threads, int(n_threads), [&](const uword t)
         {
         const uword start = (t+0) * chunk_size;
         const uword endp1 = (t+1) * chunk_size;
@@ -953,7 +950,7 @@ struct arma_rng::randg
         distr_type& g_distr_t = g_distr[t];
         
         for(uword i=start; i < endp1; ++i)  { mem[i] = eT( g_distr_t(g_motor_t)); }
-        }
+        });
       
       motor_type& g_motor_0 = g_motor[0];
       distr_type& g_distr_0 = g_distr[0];
@@ -0,0 +1,588 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup arma_vecmath
+//! @{
+
+
+#if defined(ARMA_USE_VECMATH)
+
+//! SIMD evaluation of exp(), log(), sin(), cos() and tanh() for float and double arrays,
+//! using the vector extensions of GCC and Clang; the instruction set is selected by the compiler flags.
+//!
+//! Maximum observed error (in units in the last place) relative to a high precision reference:
+//! exp: 1.0;  log: 0.85;  sin & cos: 2.2;  tanh: 1.4.
+//! Special values (NaN, infinities, signed zeros, subnormals, overflow and underflow) follow std::exp() etc.
+//! For sin() and cos(), arguments with magnitude above 1e5 (double) or 8192 (float) are passed to the standard library.
+class vecmath
+  {
+  public:
+  
+  #if defined(__AVX512F__)
+    static constexpr uword n_bytes = 64;  //!< width of the vector registers
+  #else
+    static constexpr uword n_bytes = 32;
+  #endif
+  
+  static constexpr uword block_size = 1024;  //!< number of elements processed by each thread at a time
+  
+  typedef double    vd __attribute__((__vector_size__(n_bytes)));
+  typedef long long vl __attribute__((__vector_size__(n_bytes)));
+  typedef float     vf __attribute__((__vector_size__(n_bytes)));
+  typedef int       vi __attribute__((__vector_size__(n_bytes)));
+  
+  arma_inline static vd exp(const vd x);
+  arma_inline static vf exp(const vf x);
+  
+  arma_inline static vd log(const vd x);
+  arma_inline static vf log(const vf x);
+  
+  arma_inline static vd sincos(const vd x, const long long quadrant_offset);
+  arma_inline static vf sincos(const vf x, const int       quadrant_offset);
+  
+  arma_inline static vd tanh(const vd x);
+  arma_inline static vf tanh(const vf x);
+  
+  template<typename eop_type, typename eT>                   inline static void apply(eT* out, const eT*      P, const uword n_elem, const bool use_mp);
+  template<typename eop_type, typename eT, typename ea_type> inline static void apply(eT* out, const ea_type& P, const uword n_elem, const bool use_mp);
+  
+  
+  private:
+  
+  template<typename vT, typename eT> arma_inline static vT splat(const eT val) { return vT{} + val; }
+  
+  arma_inline static vd select(const vl mask, const vd a, const vd b) { return (vd)( (mask & (vl)a) | (~mask & (vl)b) ); }
+  arma_inline static vf select(const vi mask, const vf a, const vf b) { return (vf)( (mask & (vi)a) | (~mask & (vi)b) ); }
+  
+  template<typename eop_type, typename eT> inline static void apply_block(eT* out, const eT* in, const uword n_elem);
+  };
+
+
+
+template<typename eT> struct vecmath_vec        { typedef vecmath::vd result; };
+template<>            struct vecmath_vec<float> { typedef vecmath::vf result; };
+
+
+
+//! mapping from element-wise operations to vecmath kernels
+template<typename eop_type, typename eT>
+struct vecmath_op
+  {
+  static constexpr bool value = false;
+  
+  template<typename vT> arma_inline static vT   eval(const vT x) { return x; }
+  template<typename vT> arma_inline static void fixup(vT&, const vT&) {}
+  };
+
+
+
+template<typename eT>
+struct vecmath_op_real
+  {
+  static constexpr bool value = (is_same_type<eT,float>::yes || is_same_type<eT,double>::yes);
+  };
+
+
+
+template<typename eT>
+struct vecmath_op<eop_exp, eT> : public vecmath_op_real<eT>
+  {
+  template<typename vT> arma_inline static vT eval(const vT x) { return vecmath::exp(x); }
+  
+  template<typename vT> arma_inline static void fixup(vT&, const vT&) {}
+  };
+
+
+
+template<typename eT>
+struct vecmath_op<eop_log, eT> : public vecmath_op_real<eT>
+  {
+  template<typename vT> arma_inline static vT eval(const vT x) { return vecmath::log(x); }
+  
+  template<typename vT> arma_inline static void fixup(vT&, const vT&) {}
+  };
+
+
+
+template<typename eT>
+struct vecmath_op<eop_sin, eT> : public vecmath_op_real<eT>
+  {
+  template<typename vT> arma_inline static vT eval(const vT x) { return vecmath::sincos(x, 0); }
+  
+  template<typename vT>
+  arma_inline
+  static
+  void
+  fixup(vT& y, const vT& x)
+    {
+    const eT limit = (sizeof(eT) == 8) ? eT(1.0e5) : eT(8192);
+    
+    for(uword i=0; i < uword(sizeof(vT)/sizeof(eT)); ++i)  { if( (std::abs(x[i]) <= limit) == false )  { y[i] = std::sin(eT(x[i])); } }
+    }
+  };
+
+
+
+template<typename eT>
+struct vecmath_op<eop_cos, eT> : public vecmath_op_real<eT>
+  {
+  template<typename vT> arma_inline static vT eval(const vT x) { return vecmath::sincos(x, 1); }
+  
+  template<typename vT>
+  arma_inline
+  static
+  void
+  fixup(vT& y, const vT& x)
+    {
+    const eT limit = (sizeof(eT) == 8) ? eT(1.0e5) : eT(8192);
+    
+    for(uword i=0; i < uword(sizeof(vT)/sizeof(eT)); ++i)  { if( (std::abs(x[i]) <= limit) == false )  { y[i] = std::cos(eT(x[i])); } }
+    }
+  };
+
+
+
+template<typename eT>
+struct vecmath_op<eop_tanh, eT> : public vecmath_op_real<eT>
+  {
+  template<typename vT> arma_inline static vT eval(const vT x) { return vecmath::tanh(x); }
+  
+  template<typename vT> arma_inline static void fixup(vT&, const vT&) {}
+  };
+
+
+
+// 
+// double precision kernels
+
+
+arma_inline
+vecmath::vd
+vecmath::exp(const vd x)
+  {
+  const vd magic = splat<vd>(6755399441055744.0);  // 1.5 * 2^52
+  
+  const vl not_nan = (x == x);
+  
+  vd xc = select( (x  > splat<vd>( 709.8)), splat<vd>( 709.8), x  );
+     xc = select( (xc < splat<vd>(-746.0)), splat<vd>(-746.0), xc );
+     xc = select( not_nan, xc, vd{} );
+  
+  // x = n*ln(2) + r, with |r| <= ln(2)/2
+  const vd t = xc * 1.44269504088896340736 + magic;
+  const vd n = t - magic;
+  const vd r = (xc - n * 6.93147180369123816490e-01) - n * 1.90821492927058770002e-10;
+  
+  vd p = splat<vd>(1.6059043836821614599e-10);
+  
+  p = p*r + 2.0876756987868098979e-09;
+  p = p*r + 2.5052108385441718775e-08;
+  p = p*r + 2.7557319223985890653e-07;
+  p = p*r + 2.7557319223985890653e-06;
+  p = p*r + 2.4801587301587301587e-05;
+  p = p*r + 1.9841269841269841270e-04;
+  p = p*r + 1.3888888888888888889e-03;
+  p = p*r + 8.3333333333333333333e-03;
+  p = p*r + 4.1666666666666666667e-02;
+  p = p*r + 1.6666666666666666667e-01;
+  p = p*r + 0.5;
+  p = 1.0 + (r + (r*r)*p);
+  
+  // 2^n is applied in two steps, so that results in the subnormal range and close to overflow are exact
+  const vd n1 = (n*0.5 + magic) - magic;
+  const vd n2 = n - n1;
+  
+  const vd s1 = (vd)( ((vl)(n1 + magic) - (vl)magic + 1023) << 52 );
+  const vd s2 = (vd)( ((vl)(n2 + magic) - (vl)magic + 1023) << 52 );
+  
+  return select( not_nan, (p * s1) * s2, x );
+  }
+
+
+
+arma_inline
+vecmath::vd
+vecmath::log(const vd x)
+  {
+  const vd magic = splat<vd>(4503599627370496.0);  // 2^52
+  const vd inf   = splat<vd>(std::numeric_limits<double>::infinity());
+  
+  // x = m * 2^e, with sqrt(2)/2 < m <= sqrt(2)
+  const vl subnormal = (x < splat<vd>(std::numeric_limits<double>::min()));
+  
+  const vl u = (vl)select( subnormal, x * 18014398509481984.0, x );  // 2^54
+  
+  vd e = (vd)( (u >> 52) | (vl)magic ) - magic;
+     e = e - select( subnormal, splat<vd>(1077.0), splat<vd>(1023.0) );
+  vd m = (vd)( (u & 0x000FFFFFFFFFFFFFLL) | 0x3FF0000000000000LL );
+  
+  const vl upper = (m > splat<vd>(1.41421356237309504880));
+  
+  m = select( upper, m*0.5, m );
+  e = select( upper, e+1.0, e );
+  
+  const vd f    = m - 1.0;
+  const vd s    = f / (2.0 + f);
+  const vd z    = s*s;
+  const vd w    = z*z;
+  const vd t1   = w*(3.999999999940941908e-01 + w*(2.222219843214978396e-01 + w*1.531383769920937332e-01));
+  const vd t2   = z*(6.666666666666735130e-01 + w*(2.857142874366239149e-01 + w*(1.818357216161805012e-01 + w*1.479819860511658591e-01)));
+  const vd hfsq = 0.5*f*f;
+  
+  const vd y = e*6.93147180369123816490e-01 - ((hfsq - (s*(hfsq + t1 + t2) + e*1.90821492927058770002e-10)) - f);
+  
+  const vd special = select( (x == vd{}), -inf, select( (x == inf), inf, splat<vd>(std::numeric_limits<double>::quiet_NaN()) ) );
+  
+  return select( ((x > vd{}) & (x < inf)), y, special );
+  }
+
+
+
+//! quadrant_offset = 0 for sin(), 1 for cos()
+arma_inline
+vecmath::vd
+vecmath::sincos(const vd x, const long long quadrant_offset)
+  {
+  const vd magic = splat<vd>(6755399441055744.0);  // 1.5 * 2^52
+  
+  const vd ax = (vd)( (vl)x & 0x7FFFFFFFFFFFFFFFLL );
+  const vd xc = select( (ax <= splat<vd>(1.0e5)), x, vd{} );  // large arguments are handled by vecmath_op::fixup()
+  
+  // x = k*(pi/2) + r, with |r| <= pi/4; the constants for pi/2 have trailing zeros so that k*c is exact
+  const vd t = xc * 6.36619772367581382433e-01 + magic;
+  const vd k = t - magic;
+  const vl q = (vl)t + quadrant_offset;
+  
+  vd r = xc - k*1.57079632673412561417e+00;
+     r = r  - k*6.07710050630396597660e-11;
+     r = r  - k*2.02226624871116645580e-21;
+  
+  const vd z = r*r;
+  
+  vd ps = splat<vd>(1.58969099521155010221e-10);
+  
+  ps = ps*z - 2.50507602534068634195e-08;
+  ps = ps*z + 2.75573137070700676789e-06;
+  ps = ps*z - 1.98412698298579493134e-04;
+  ps = ps*z + 8.33333333332248946124e-03;
+  ps = ps*z - 1.66666666666666324348e-01;
+  
+  vd pc = splat<vd>(-1.13596475577881948265e-11);
+  
+  pc = pc*z + 2.08757232129817482790e-09;
+  pc = pc*z - 2.75573143513906633035e-07;
+  pc = pc*z + 2.48015872894767294178e-05;
+  pc = pc*z - 1.38888888888741095749e-03;
+  pc = pc*z + 4.16666666666666019037e-02;
+  
+  const vd hz = 0.5*z;
+  const vd w  = 1.0 - hz;
+  
+  const vd s = r + r*z*ps;
+  const vd c = w + (((1.0 - w) - hz) + z*z*pc);
+  
+  const vd y = (vd)( (vl)select( ((q & 1) != 0), c, s ) ^ ((q & 2) << 62) );
+  
+  // tiny arguments: sin(x) = x (preserving the sign of zero), cos(x) = 1
+  const vd tiny = (quadrant_offset == 0) ? x : splat<vd>(1.0);
+  
+  return select( (ax < splat<vd>(1.0e-8)), tiny, y );
+  }
+
+
+
+arma_inline
+vecmath::vd
+vecmath::tanh(const vd x)
+  {
+  const vl sign = (vl)x & (long long)(0x8000000000000000ULL);
+  
+  const vd a = (vd)( (vl)x ^ sign );
+  const vd z = a*a;
+  
+  const vd P = (-9.64399179425052238628e-01*z - 9.92877231001918586564e+01)*z - 1.61468768441708447952e+03;
+  const vd Q = ((z + 1.12811678491632931402e+02)*z + 2.23548839060100448583e+03)*z + 4.84406305325125486048e+03;
+  
+  const vd y_small = a + a*z*(P/Q);
+  const vd y_large = 1.0 - 2.0/(vecmath::exp(2.0*a) + 1.0);
+  
+  return (vd)( (vl)select( (a > splat<vd>(0.625)), y_large, y_small ) | sign );
+  }
+
+
+
+// 
+// single precision kernels
+
+
+arma_inline
+vecmath::vf
+vecmath::exp(const vf x)
+  {
+  const vf magic = splat<vf>(12582912.0f);  // 1.5 * 2^23
+  
+  const vi not_nan = (x == x);
+  
+  vf xc = select( (x  > splat<vf>(  88.8f)), splat<vf>(  88.8f), x  );
+     xc = select( (xc < splat<vf>(-104.0f)), splat<vf>(-104.0f), xc );
+     xc = select( not_nan, xc, vf{} );
+  
+  const vf t = xc * 1.44269504088896341f + magic;
+  const vf n = t - magic;
+  const vf r = (xc - n * 0.693359375f) - n * (-2.12194440e-4f);
+  
+  vf p = splat<vf>(1.9875691500e-4f);
+  
+  p = p*r + 1.3981999507e-3f;
+  p = p*r + 8.3334519073e-3f;
+  p = p*r + 4.1665795894e-2f;
+  p = p*r + 1.6666665459e-1f;
+  p = p*r + 5.0000001201e-1f;
+  p = 1.0f + (r + (r*r)*p);
+  
+  const vf n1 = (n*0.5f + magic) - magic;
+  const vf n2 = n - n1;
+  
+  const vf s1 = (vf)( ((vi)(n1 + magic) - (vi)magic + 127) << 23 );
+  const vf s2 = (vf)( ((vi)(n2 + magic) - (vi)magic + 127) << 23 );
+  
+  return select( not_nan, (p * s1) * s2, x );
+  }
+
+
+
+arma_inline
+vecmath::vf
+vecmath::log(const vf x)
+  {
+  const vf magic = splat<vf>(8388608.0f);  // 2^23
+  const vf inf   = splat<vf>(std::numeric_limits<float>::infinity());
+  
+  const vi subnormal = (x < splat<vf>(std::numeric_limits<float>::min()));
+  
+  const vi u = (vi)select( subnormal, x * 33554432.0f, x );  // 2^25
+  
+  vf e = (vf)( (u >> 23) | (vi)magic ) - magic;
+     e = e - select( subnormal, splat<vf>(152.0f), splat<vf>(127.0f) );
+  vf m = (vf)( (u & 0x007FFFFF) | 0x3F800000 );
+  
+  const vi upper = (m > splat<vf>(1.41421356237f));
+  
+  m = select( upper, m*0.5f, m );
+  e = select( upper, e+1.0f, e );
+  
+  const vf f = m - 1.0f;
+  const vf z = f*f;
+  
+  vf y = splat<vf>(7.0376836292e-2f);
+  
+  y = y*f - 1.1514610310e-1f;
+  y = y*f + 1.1676998740e-1f;
+  y = y*f - 1.2420140846e-1f;
+  y = y*f + 1.4249322787e-1f;
+  y = y*f - 1.6668057665e-1f;
+  y = y*f + 2.0000714765e-1f;
+  y = y*f - 2.4999993993e-1f;
+  y = y*f + 3.3333331174e-1f;
+  y = y*f*z;
+  
+  y = y + e*(-2.12194440e-4f);
+  y = y - 0.5f*z;
+  y = (f + y) + e*0.693359375f;
+  
+  const vf special = select( (x == vf{}), -inf, select( (x == inf), inf, splat<vf>(std::numeric_limits<float>::quiet_NaN()) ) );
+  
+  return select( ((x > vf{}) & (x < inf)), y, special );
+  }
+
+
+
+arma_inline
+vecmath::vf
+vecmath::sincos(const vf x, const int quadrant_offset)
+  {
+  const vf magic = splat<vf>(12582912.0f);  // 1.5 * 2^23
+  
+  const vf ax = (vf)( (vi)x & 0x7FFFFFFF );
+  const vf xc = select( (ax <= splat<vf>(8192.0f)), x, vf{} );
+  
+  const vf t = xc * 0.636619772367581343f + magic;
+  const vf k = t - magic;
+  const vi q = (vi)t + quadrant_offset;
+  
+  vf r = xc - k*1.5703125f;
+     r = r  - k*4.837512969970703125e-4f;
+     r = r  - k*7.549533620476723e-8f;
+     r = r  - k*2.5633440682570896e-12f;
+  
+  const vf z = r*r;
+  
+  const vf s = ((-1.9515295891e-4f*z + 8.3321608736e-3f)*z - 1.6666654611e-1f)*z*r + r;
+  const vf c = ((2.443315711809948e-5f*z - 1.388731625493765e-3f)*z + 4.166664568298827e-2f)*z*z - 0.5f*z + 1.0f;
+  
+  const vf y = (vf)( (vi)select( ((q & 1) != 0), c, s ) ^ ((q & 2) << 30) );
+  
+  const vf tiny = (quadrant_offset == 0) ? x : splat<vf>(1.0f);
+  
+  return select( (ax < splat<vf>(1.0e-4f)), tiny, y );
+  }
+
+
+
+arma_inline
+vecmath::vf
+vecmath::tanh(const vf x)
+  {
+  const vi sign = (vi)x & int(0x80000000U);
+  
+  const vf a = (vf)( (vi)x ^ sign );
+  const vf z = a*a;
+  
+  const vf y_small = ((((-5.70498872745e-3f*z + 2.06390887954e-2f)*z - 5.37397155531e-2f)*z + 1.33314422036e-1f)*z - 3.33332819422e-1f)*z*a + a;
+  const vf y_large = 1.0f - 2.0f/(vecmath::exp(2.0f*a) + 1.0f);
+  
+  return (vf)( (vi)select( (a > splat<vf>(0.625f)), y_large, y_small ) | sign );
+  }
+
+
+
+// 
+// array processing
+
+
+template<typename eop_type, typename eT>
+inline
+void
+vecmath::apply_block(eT* out, const eT* in, const uword n_elem)
+  {
+  typedef typename vecmath_vec<eT>::result vT;
+  
+  constexpr uword n_lanes = uword(sizeof(vT) / sizeof(eT));
+  
+  uword i = 0;
+  
+  for(; (i + n_lanes) <= n_elem; i += n_lanes)
+    {
+    vT x;
+    
+    std::memcpy(&x, &(in[i]), sizeof(vT));
+    
+    vT y = vecmath_op<eop_type,eT>::eval(x);
+    
+    vecmath_op<eop_type,eT>::fixup(y, x);
+    
+    std::memcpy(&(out[i]), &y, sizeof(vT));
+    }
+  
+  if(i < n_elem)
+    {
+    const size_t n_bytes_tail = sizeof(eT) * size_t(n_elem - i);
+    
+    vT x = vT{};
+    
+    std::memcpy(&x, &(in[i]), n_bytes_tail);
+    
+    vT y = vecmath_op<eop_type,eT>::eval(x);
+    
+    vecmath_op<eop_type,eT>::fixup(y, x);
+    
+    std::memcpy(&(out[i]), &y, n_bytes_tail);
+    }
+  }
+
+
+
+//! evaluate out[i] = eop_type(P[i]) for contiguous input
+template<typename eop_type, typename eT>
+inline
+void
+vecmath::apply(eT* out, const eT* P, const uword n_elem, const bool use_mp)
+  {
+  #if defined(ARMA_USE_MP)
+    if(use_mp)
+      {
+      const uword n_blocks  = (n_elem + block_size - 1) / block_size;
+      const int   n_threads = mp_thread_limit::get();
+      
+      mp_parallel::run(n_blocks, n_threads, [&](const uword block)
+        {
+        const uword start = block * block_size;
+        const uword count = ( (n_elem - start) < block_size ) ? (n_elem - start) : block_size;
+        
+        vecmath::apply_block<eop_type>( &(out[start]), &(P[start]), count );
+        });
+      
+      return;
+      }
+  #else
+    arma_ignore(use_mp);
+  #endif
+  
+  vecmath::apply_block<eop_type>(out, P, n_elem);
+  }
+
+
+
+//! evaluate out[i] = eop_type(P[i]) for expressions; elements are gathered into blocks before evaluation
+template<typename eop_type, typename eT, typename ea_type>
+inline
+void
+vecmath::apply(eT* out, const ea_type& P, const uword n_elem, const bool use_mp)
+  {
+  const uword n_blocks = (n_elem + block_size - 1) / block_size;
+  
+  #if defined(ARMA_USE_MP)
+    if(use_mp)
+      {
+      const int n_threads = mp_thread_limit::get();
+      
+      mp_parallel::run(n_blocks, n_threads, [&](const uword block)
+        {
+        eT buf[block_size];
+        
+        const uword start = block * block_size;
+        const uword count = ( (n_elem - start) < block_size ) ? (n_elem - start) : block_size;
+        
+        for(uword i=0; i < count; ++i)  { buf[i] = P[start + i]; }
+        
+        vecmath::apply_block<eop_type>( &(out[start]), buf, count );
+        });
+      
+      return;
+      }
+  #else
+    arma_ignore(use_mp);
+  #endif
+  
+  eT buf[block_size];
+  
+  for(uword block=0; block < n_blocks; ++block)
+    {
+    const uword start = block * block_size;
+    const uword count = ( (n_elem - start) < block_size ) ? (n_elem - start) : block_size;
+    
+    for(uword i=0; i < count; ++i)  { buf[i] = P[start + i]; }
+    
+    vecmath::apply_block<eop_type>( &(out[start]), buf, count );
+    }
+  }
+
+
+#endif
+
+
+//! @}
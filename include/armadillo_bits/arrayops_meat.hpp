@@ -90,6 +90,10 @@ arrayops::clean(eT* mem, const uword n_elem, const eT abs_limit, const typename
   {
   arma_ignore(junk);
   
+  #if defined(ARMA_USE_CPU_DISPATCH)
+    if(cpu_dispatch::use<eT>(n_elem))  { cpu_dispatch::table<eT>().clean(mem, n_elem, abs_limit);  return; }
+  #endif
+  
   for(uword i=0; i<n_elem; ++i)
     {
     eT& val = mem[i];
@@ -138,6 +142,10 @@ arrayops::clamp(eT* mem, const uword n_elem, const eT min_val, const eT max_val,
   {
   arma_ignore(junk);
   
+  #if defined(ARMA_USE_CPU_DISPATCH)
+    if(cpu_dispatch::use<eT>(n_elem))  { cpu_dispatch::table<eT>().clamp(mem, n_elem, min_val, max_val);  return; }
+  #endif
+  
   for(uword i=0; i<n_elem; ++i)
     {
     eT& val = mem[i];
@@ -248,6 +256,10 @@ arrayops::convert(out_eT* dest, const in_eT* src, const uword n_elem)
     return;
     }
   
+  #if defined(ARMA_USE_CPU_DISPATCH)
+    if(cpu_dispatch::convert(dest, src, n_elem))  { return; }
+  #endif
+  
   const bool check_finite = (std::is_integral<out_eT>::value && std::is_floating_point<in_eT>::value);
   
   uword j;
@@ -331,6 +343,10 @@ inline
 void
 arrayops::inplace_plus(eT* dest, const eT* src, const uword n_elem)
   {
+  #if defined(ARMA_USE_CPU_DISPATCH)
+    if(cpu_dispatch::use<eT>(n_elem))  { cpu_dispatch::table<eT>().inplace_plus(dest, src, n_elem);  return; }
+  #endif
+  
   if(memory::is_aligned(dest))
     {
     memory::mark_as_aligned(dest);
@@ -924,6 +940,10 @@ inline
 eT
 arrayops::accumulate(const eT* src, const uword n_elem)
   {
+  #if defined(ARMA_USE_CPU_DISPATCH)
+    if(cpu_dispatch::use<eT>(n_elem))  { return cpu_dispatch::table<eT>().accumulate(src, n_elem); }
+  #endif
+  
   #if defined(__FINITE_MATH_ONLY__) && (__FINITE_MATH_ONLY__ > 0)
     {
     eT acc = eT(0);
@@ -1064,6 +1084,10 @@ inline
 bool
 arrayops::is_finite(const eT* src, const uword n_elem)
   {
+  #if defined(ARMA_USE_CPU_DISPATCH)
+    if(cpu_dispatch::use<eT>(n_elem))  { return cpu_dispatch::table<eT>().is_finite(src, n_elem); }
+  #endif
+  
   uword j;
   
   for(j=1; j<n_elem; j+=2)
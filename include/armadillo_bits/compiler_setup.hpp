@@ -419,6 +419,29 @@
 #endif
 
 
+#if defined(ARMA_USE_VECMATH)
+  #if (!defined(ARMA_GOOD_COMPILER) || !defined(__AVX__) || defined(ARMA_DONT_USE_VECMATH))
+    // vecmath relies on the vector extensions of GCC and Clang, and on AVX registers
+    #undef ARMA_USE_VECMATH
+  #endif
+#endif
+
+
+#if defined(ARMA_USE_THREAD_POOL)
+  #if (defined(ARMA_DONT_USE_STD_MUTEX) || defined(ARMA_DONT_USE_THREAD_POOL))
+    #undef ARMA_USE_THREAD_POOL
+  #endif
+#endif
+
+
+#if defined(ARMA_USE_CPU_DISPATCH)
+  #if (!defined(ARMA_GOOD_COMPILER) || !(defined(__x86_64__) || defined(__i386__)) || (defined(ARMA_GCC_VERSION) && (ARMA_GCC_VERSION < 90000)) || defined(ARMA_DONT_USE_STD_MUTEX) || defined(ARMA_DONT_USE_CPU_DISPATCH))
+    // run-time dispatch relies on the target attribute and vector extensions of GCC 9+ and Clang, and on std::atomic
+    #undef ARMA_USE_CPU_DISPATCH
+  #endif
+#endif
+
+
 #if ( (defined(_WIN32) || defined(_WIN64) || defined(_MSC_VER)) && (!defined(__MINGW32__) && !defined(__MINGW64__)) )
   #undef  ARMA_PRINT_EXCEPTIONS_INTERNAL
   #define ARMA_PRINT_EXCEPTIONS_INTERNAL
@@ -110,6 +110,21 @@
 // #define ARMA_USE_MKL_ALLOC
 //// Uncomment the above line to use Intel MKL mkl_malloc() and mkl_free() instead of standard malloc() and free()
 
+// #define ARMA_USE_MEM_POOL
+//// Uncomment the above line to keep released matrix memory in thread-local caches for reuse,
+//// and to allow scoped allocation of temporaries via arma::memory_arena.
+//// See also ARMA_MEM_POOL_MAX_BYTES and ARMA_MEM_POOL_MAX_RETAINED below.
+
+// #define ARMA_USE_VECMATH
+//// Uncomment the above line to evaluate exp(), log(), sin(), cos() and tanh() for float and double elements
+//// via built-in SIMD kernels instead of the standard math library.
+//// Requires GCC or Clang, with AVX or later enabled at compile time (eg. -mavx2 or -march=native).
+
+// #define ARMA_USE_CPU_DISPATCH
+//// Uncomment the above line to select AVX2 or AVX-512 variants of frequently used array kernels
+//// (eg. summation, conversion, clamping, finiteness checks) at run time, based on the capabilities of the CPU.
+//// Requires GCC 9+ or Clang on x86-64 or x86.
+
 // #define ARMA_USE_MKL_TYPES
 //// Uncomment the above line to use Intel MKL types for complex numbers.
 //// You will need to include appropriate MKL headers before the Armadillo header.
@@ -122,6 +137,11 @@
 //// Note that ARMA_USE_OPENMP is automatically enabled when a compiler supporting OpenMP 3.1 is detected.
 #endif
 
+// #define ARMA_USE_THREAD_POOL
+//// Uncomment the above line to allow parallelisation via a built-in pool of std::thread workers
+//// or via an executor supplied with set_mp_executor(), in addition to or instead of OpenMP.
+//// The backend can be selected at run-time via set_mp_backend().
+
 #if !defined(ARMA_64BIT_WORD)
 // #define ARMA_64BIT_WORD
 //// Uncomment the above line if you require matrices/vectors capable of holding more than 4 billion elements.
@@ -175,17 +195,52 @@
 //// If you mainly use lots of very small vectors (eg. <= 4 elements),
 //// change the number to the size of your vectors.
 
+#if !defined(ARMA_MEM_POOL_MAX_BYTES)
+  #define ARMA_MEM_POOL_MAX_BYTES 1048576
+#endif
+//// The largest memory block (in bytes) which is kept for reuse when ARMA_USE_MEM_POOL is enabled;
+//// larger blocks are always returned to the system.
+
+#if !defined(ARMA_MEM_POOL_MAX_RETAINED)
+  #define ARMA_MEM_POOL_MAX_RETAINED 67108864
+#endif
+//// The maximum number of bytes kept for reuse by each thread when ARMA_USE_MEM_POOL is enabled.
+
+#if !defined(ARMA_MEM_ALIGNMENT)
+  #define ARMA_MEM_ALIGNMENT 64
+#endif
+//// The alignment (in bytes) of memory blocks which are at least 1024 bytes in size;
+//// it must be a power of two that is at least 16.  Smaller blocks are aligned to 16 bytes.
+//// The default value of 64 matches the size of a cache line on most systems.
+
+// #define ARMA_USE_HUGE_PAGES
+//// Uncomment the above line to request transparent huge pages (via madvise) for large matrices.
+//// Only used on Linux; see also ARMA_HUGE_PAGE_THRESHOLD below.
+
+#if !defined(ARMA_HUGE_PAGE_THRESHOLD)
+  #define ARMA_HUGE_PAGE_THRESHOLD 4194304
+#endif
+//// The minimum size (in bytes) of memory blocks for which huge pages are requested when ARMA_USE_HUGE_PAGES is enabled.
+
 #if !defined(ARMA_OPENMP_THRESHOLD)
   #define ARMA_OPENMP_THRESHOLD 320
 #endif
-//// The minimum number of elements in a matrix to allow OpenMP based parallelisation;
-//// it must be an integer that is at least 1.
+//// The minimum number of elements in a matrix to allow OpenMP based parallelisation
+//// of element-wise functions with a cost similar to exp();
+//// cheaper and more expensive operations are scaled by their estimated cost.
+//// It must be an integer that is at least 1.
+//// The threshold can be changed at run-time via set_mp_threshold().
 
 #if !defined(ARMA_OPENMP_THREADS)
   #define ARMA_OPENMP_THREADS 8
 #endif
 //// The maximum number of threads to use for OpenMP based parallelisation;
 //// it must be an integer that is at least 1.
+//// The number of threads can be changed at run-time via set_mp_threads().
+
+// #define ARMA_OPENMP_CALIBRATE
+//// Uncomment the above line to measure the overhead of starting OpenMP threads on first use,
+//// and to set the threshold for OpenMP based parallelisation accordingly.
 
 // #define ARMA_NO_DEBUG
 //// Uncomment the above line to disable all run-time checks. NOT RECOMMENDED.
@@ -280,6 +335,11 @@
   //// Uncomment the above line to disable use of std::mutex
 #endif
 
+#if !defined(ARMA_DONT_USE_MMAP)
+  // #define ARMA_DONT_USE_MMAP
+  //// Uncomment the above line to disable memory mapping of files when loading data
+#endif
+
 // for compatibility with earlier versions of Armadillo
 #if defined(ARMA_DONT_USE_CXX11_MUTEX)
   #pragma message ("WARNING: support for ARMA_DONT_USE_CXX11_MUTEX is deprecated and will be removed;")
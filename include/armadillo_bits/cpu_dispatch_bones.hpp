@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup cpu_dispatch
+//! @{
+
+
+#if defined(ARMA_USE_CPU_DISPATCH)
+
+template<typename eT> struct cpu_dispatch_other         { typedef eT     result; };
+template<>            struct cpu_dispatch_other<float>  { typedef double result; };
+template<>            struct cpu_dispatch_other<double> { typedef float  result; };
+
+
+
+//! pointers to the variants of the array kernels for one instruction set
+template<typename eT>
+struct cpu_dispatch_table
+  {
+  typedef typename cpu_dispatch_other<eT>::result other_eT;
+  
+  void (*inplace_plus)(eT* dest, const eT* src, const uword n_elem);
+  eT   (*accumulate)  (const eT* src, const uword n_elem);
+  void (*convert)     (eT* dest, const other_eT* src, const uword n_elem);
+  void (*clean)       (eT* mem, const uword n_elem, const eT abs_limit);
+  void (*clamp)       (eT* mem, const uword n_elem, const eT min_val, const eT max_val);
+  bool (*is_finite)   (const eT* src, const uword n_elem);
+  eT   (*dot)         (const uword n_elem, const eT* A, const eT* B);
+  };
+
+
+
+//! Selection of instruction set specific variants of hot array kernels at run time.
+//! The best variant supported by the CPU is detected once, on first use.
+//! Used by arrayops and op_dot::direct_dot() for float and double elements when ARMA_USE_CPU_DISPATCH is defined.
+class cpu_dispatch
+  {
+  public:
+  
+  enum isa_type
+    {
+    isa_generic = 0,  //!< code generated for the instruction set selected at compile time
+    isa_avx2    = 1,  //!< AVX2 and FMA
+    isa_avx512  = 2   //!< AVX-512F
+    };
+  
+  static constexpr uword min_n_elem = 32;  //!< smaller arrays are handled by the inline code
+  
+  inline static isa_type    detected();     //!< best variant supported by the CPU
+  inline static isa_type    active();       //!< variant in use
+  inline static const char* active_name();  //!< "avx512", "avx2" or "generic"
+  
+  inline static void set_active(const isa_type isa);  //!< restrict the variant in use; variants not supported by the CPU are ignored
+  
+  template<typename eT> arma_inline static bool use(const uword n_elem);
+  
+  template<typename eT> inline static const cpu_dispatch_table<eT>& table();
+  
+  //! float <-> double conversion; returns false if the conversion was not handled
+  template<typename out_eT, typename in_eT> arma_inline static bool convert(out_eT* dest, const in_eT* src, const uword n_elem);
+  
+  inline static bool convert(float*  dest, const double* src, const uword n_elem);
+  inline static bool convert(double* dest, const float*  src, const uword n_elem);
+  
+  
+  private:
+  
+  inline static std::atomic<int>& active_state();
+  };
+
+
+#endif
+
+
+//! @}
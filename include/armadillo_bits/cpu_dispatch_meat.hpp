@@ -0,0 +1,431 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup cpu_dispatch
+//! @{
+
+
+#if defined(ARMA_USE_CPU_DISPATCH)
+
+template<typename eT> struct cpu_kernel_int         { typedef eT        result; };
+template<>            struct cpu_kernel_int<float>  { typedef int       result; };
+template<>            struct cpu_kernel_int<double> { typedef long long result; };
+
+
+
+//! array kernels written with vector registers of n_bytes;
+//! these are only instantiated within functions that enable the corresponding instruction set
+template<typename eT, uword n_bytes>
+struct cpu_kernel
+  {
+  typedef typename cpu_kernel_int<eT>::result iT;
+  typedef typename cpu_dispatch_other<eT>::result other_eT;
+  
+  typedef eT       vT  __attribute__((__vector_size__(n_bytes)));
+  typedef iT       viT __attribute__((__vector_size__(n_bytes)));
+  
+  static constexpr uword n_lanes = n_bytes / sizeof(eT);
+  
+  static constexpr iT sign_mask = iT( (unsigned long long)(1) << (8*sizeof(eT) - 1) );
+  
+  
+  arma_inline
+  static
+  void
+  inplace_plus(eT* dest, const eT* src, const uword n_elem)
+    {
+    uword i = 0;
+    
+    for(; (i + n_lanes) <= n_elem; i += n_lanes)
+      {
+      vT a;  std::memcpy(&a, &(dest[i]), sizeof(vT));
+      vT b;  std::memcpy(&b, &( src[i]), sizeof(vT));
+      
+      a += b;
+      
+      std::memcpy(&(dest[i]), &a, sizeof(vT));
+      }
+    
+    for(; i < n_elem; ++i)  { dest[i] += src[i]; }
+    }
+  
+  
+  arma_inline
+  static
+  eT
+  accumulate(const eT* src, const uword n_elem)
+    {
+    vT acc1 = vT{};
+    vT acc2 = vT{};
+    vT acc3 = vT{};
+    vT acc4 = vT{};
+    
+    uword i = 0;
+    
+    for(; (i + 4*n_lanes) <= n_elem; i += 4*n_lanes)
+      {
+      vT a;  std::memcpy(&a, &(src[i            ]), sizeof(vT));
+      vT b;  std::memcpy(&b, &(src[i +   n_lanes]), sizeof(vT));
+      vT c;  std::memcpy(&c, &(src[i + 2*n_lanes]), sizeof(vT));
+      vT d;  std::memcpy(&d, &(src[i + 3*n_lanes]), sizeof(vT));
+      
+      acc1 += a;
+      acc2 += b;
+      acc3 += c;
+      acc4 += d;
+      }
+    
+    acc1 = (acc1 + acc2) + (acc3 + acc4);
+    
+    eT acc = eT(0);
+    
+    for(uword j=0; j < n_lanes; ++j)  { acc += acc1[j]; }
+    
+    for(; i < n_elem; ++i)  { acc += src[i]; }
+    
+    return acc;
+    }
+  
+  
+  arma_inline
+  static
+  void
+  convert(eT* dest, const other_eT* src, const uword n_elem)
+    {
+    // each iteration converts one input register, so the number of elements is set by the larger type
+    constexpr uword n_step = (sizeof(other_eT) > sizeof(eT)) ? n_bytes / sizeof(other_eT) : n_lanes;
+    
+    typedef eT       vT_step  __attribute__((__vector_size__(n_step * sizeof(eT))));
+    typedef other_eT voT_step __attribute__((__vector_size__(n_step * sizeof(other_eT))));
+    
+    uword i = 0;
+    
+    for(; (i + n_step) <= n_elem; i += n_step)
+      {
+      voT_step a;  std::memcpy(&a, &(src[i]), sizeof(voT_step));
+      
+      const vT_step b = __builtin_convertvector(a, vT_step);
+      
+      std::memcpy(&(dest[i]), &b, sizeof(vT_step));
+      }
+    
+    for(; i < n_elem; ++i)  { dest[i] = eT(src[i]); }
+    }
+  
+  
+  arma_inline
+  static
+  void
+  clean(eT* mem, const uword n_elem, const eT abs_limit)
+    {
+    const vT limit = vT{} + abs_limit;
+    
+    uword i = 0;
+    
+    for(; (i + n_lanes) <= n_elem; i += n_lanes)
+      {
+      vT a;  std::memcpy(&a, &(mem[i]), sizeof(vT));
+      
+      const vT abs_a = (vT)( (viT)a & ~sign_mask );
+      
+      a = (abs_a <= limit) ? vT{} : a;
+      
+      std::memcpy(&(mem[i]), &a, sizeof(vT));
+      }
+    
+    for(; i < n_elem; ++i)  { mem[i] = (std::abs(mem[i]) <= abs_limit) ? eT(0) : mem[i]; }
+    }
+  
+  
+  arma_inline
+  static
+  void
+  clamp(eT* mem, const uword n_elem, const eT min_val, const eT max_val)
+    {
+    const vT vmin = vT{} + min_val;
+    const vT vmax = vT{} + max_val;
+    
+    uword i = 0;
+    
+    for(; (i + n_lanes) <= n_elem; i += n_lanes)
+      {
+      vT a;  std::memcpy(&a, &(mem[i]), sizeof(vT));
+      
+      a = (a < vmin) ? vmin : a;
+      a = (a > vmax) ? vmax : a;
+      
+      std::memcpy(&(mem[i]), &a, sizeof(vT));
+      }
+    
+    for(; i < n_elem; ++i)  { eT& val = mem[i];  val = (val < min_val) ? min_val : ((val > max_val) ? max_val : val); }
+    }
+  
+  
+  arma_inline
+  static
+  bool
+  is_finite(const eT* src, const uword n_elem)
+    {
+    // x - x is NaN for infinities and NaN, and zero otherwise
+    constexpr uword n_chunk = 64 * n_lanes;
+    
+    uword i = 0;
+    
+    while( (i + n_chunk) <= n_elem )
+      {
+      vT acc = vT{};
+      
+      for(const uword i_end = i + n_chunk; i < i_end; i += n_lanes)
+        {
+        vT a;  std::memcpy(&a, &(src[i]), sizeof(vT));
+        
+        acc += (a - a);
+        }
+      
+      eT sum = eT(0);
+      
+      for(uword j=0; j < n_lanes; ++j)  { sum += acc[j]; }
+      
+      if(sum != eT(0))  { return false; }
+      }
+    
+    for(; i < n_elem; ++i)  { if(arma_isfinite(src[i]) == false)  { return false; } }
+    
+    return true;
+    }
+  
+  
+  arma_inline
+  static
+  eT
+  dot(const uword n_elem, const eT* A, const eT* B)
+    {
+    vT acc1 = vT{};
+    vT acc2 = vT{};
+    vT acc3 = vT{};
+    vT acc4 = vT{};
+    
+    uword i = 0;
+    
+    for(; (i + 4*n_lanes) <= n_elem; i += 4*n_lanes)
+      {
+      vT a1;  std::memcpy(&a1, &(A[i            ]), sizeof(vT));
+      vT a2;  std::memcpy(&a2, &(A[i +   n_lanes]), sizeof(vT));
+      vT a3;  std::memcpy(&a3, &(A[i + 2*n_lanes]), sizeof(vT));
+      vT a4;  std::memcpy(&a4, &(A[i + 3*n_lanes]), sizeof(vT));
+      
+      vT b1;  std::memcpy(&b1, &(B[i            ]), sizeof(vT));
+      vT b2;  std::memcpy(&b2, &(B[i +   n_lanes]), sizeof(vT));
+      vT b3;  std::memcpy(&b3, &(B[i + 2*n_lanes]), sizeof(vT));
+      vT b4;  std::memcpy(&b4, &(B[i + 3*n_lanes]), sizeof(vT));
+      
+      acc1 += a1 * b1;
+      acc2 += a2 * b2;
+      acc3 += a3 * b3;
+      acc4 += a4 * b4;
+      }
+    
+    acc1 = (acc1 + acc2) + (acc3 + acc4);
+    
+    eT acc = eT(0);
+    
+    for(uword j=0; j < n_lanes; ++j)  { acc += acc1[j]; }
+    
+    for(; i < n_elem; ++i)  { acc += A[i] * B[i]; }
+    
+    return acc;
+    }
+  };
+
+
+
+#undef  arma_cpu_dispatch_variant
+#define arma_cpu_dispatch_variant(name, target_string, n_bytes) \
+  template<typename eT> \
+  struct name \
+    { \
+    typedef typename cpu_dispatch_other<eT>::result other_eT; \
+    \
+    __attribute__((__target__(target_string))) static void inplace_plus(eT* dest, const eT* src, const uword n_elem)                { cpu_kernel<eT,n_bytes>::inplace_plus(dest, src, n_elem);        } \
+    __attribute__((__target__(target_string))) static eT   accumulate  (const eT* src, const uword n_elem)                          { return cpu_kernel<eT,n_bytes>::accumulate(src, n_elem);         } \
+    __attribute__((__target__(target_string))) static void convert     (eT* dest, const other_eT* src, const uword n_elem)          { cpu_kernel<eT,n_bytes>::convert(dest, src, n_elem);             } \
+    __attribute__((__target__(target_string))) static void clean       (eT* mem, const uword n_elem, const eT abs_limit)            { cpu_kernel<eT,n_bytes>::clean(mem, n_elem, abs_limit);          } \
+    __attribute__((__target__(target_string))) static void clamp       (eT* mem, const uword n_elem, const eT lo, const eT hi)      { cpu_kernel<eT,n_bytes>::clamp(mem, n_elem, lo, hi);             } \
+    __attribute__((__target__(target_string))) static bool is_finite   (const eT* src, const uword n_elem)                          { return cpu_kernel<eT,n_bytes>::is_finite(src, n_elem);          } \
+    __attribute__((__target__(target_string))) static eT   dot         (const uword n_elem, const eT* A, const eT* B)               { return cpu_kernel<eT,n_bytes>::dot(n_elem, A, B);               } \
+    \
+    static cpu_dispatch_table<eT> table() { return cpu_dispatch_table<eT>{ &inplace_plus, &accumulate, &convert, &clean, &clamp, &is_finite, &dot }; } \
+    };
+
+
+arma_cpu_dispatch_variant(cpu_variant_avx2,   "avx2,fma", 32)
+arma_cpu_dispatch_variant(cpu_variant_avx512, "avx512f,avx512dq,avx512bw,avx512vl", 64)
+
+#undef arma_cpu_dispatch_variant
+
+
+
+//! the variants are only generated for float and double
+template<typename eT, bool is_real_fp = (is_same_type<eT,float>::yes || is_same_type<eT,double>::yes)>
+struct cpu_dispatch_tables
+  {
+  static cpu_dispatch_table<eT> avx2()   { return cpu_dispatch_table<eT>(); }
+  static cpu_dispatch_table<eT> avx512() { return cpu_dispatch_table<eT>(); }
+  };
+
+
+
+template<typename eT>
+struct cpu_dispatch_tables<eT, true>
+  {
+  static cpu_dispatch_table<eT> avx2()   { return cpu_variant_avx2<eT>::table();   }
+  static cpu_dispatch_table<eT> avx512() { return cpu_variant_avx512<eT>::table(); }
+  };
+
+
+
+inline
+cpu_dispatch::isa_type
+cpu_dispatch::detected()
+  {
+  static const isa_type isa = []()
+    {
+    __builtin_cpu_init();
+    
+    if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))  { return isa_avx512; }
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))       { return isa_avx2;   }
+    
+    return isa_generic;
+    }();
+  
+  return isa;
+  }
+
+
+
+inline
+std::atomic<int>&
+cpu_dispatch::active_state()
+  {
+  static std::atomic<int> state{ int(detected()) };
+  
+  return state;
+  }
+
+
+
+inline
+cpu_dispatch::isa_type
+cpu_dispatch::active()
+  {
+  return isa_type( active_state().load(std::memory_order_relaxed) );
+  }
+
+
+
+inline
+const char*
+cpu_dispatch::active_name()
+  {
+  const isa_type isa = active();
+  
+  return (isa == isa_avx512) ? "avx512" : ( (isa == isa_avx2) ? "avx2" : "generic" );
+  }
+
+
+
+inline
+void
+cpu_dispatch::set_active(const isa_type isa)
+  {
+  const isa_type best = detected();
+  
+  active_state().store( int( (isa < best) ? isa : best ), std::memory_order_relaxed );
+  }
+
+
+
+template<typename eT>
+arma_inline
+bool
+cpu_dispatch::use(const uword n_elem)
+  {
+  return (is_same_type<eT,float>::yes || is_same_type<eT,double>::yes) && (n_elem >= min_n_elem) && (active() != isa_generic);
+  }
+
+
+
+template<typename out_eT, typename in_eT>
+arma_inline
+bool
+cpu_dispatch::convert(out_eT* dest, const in_eT* src, const uword n_elem)
+  {
+  arma_ignore(dest);
+  arma_ignore(src);
+  arma_ignore(n_elem);
+  
+  return false;
+  }
+
+
+
+inline
+bool
+cpu_dispatch::convert(float* dest, const double* src, const uword n_elem)
+  {
+  if(cpu_dispatch::use<float>(n_elem) == false)  { return false; }
+  
+  cpu_dispatch::table<float>().convert(dest, src, n_elem);
+  
+  return true;
+  }
+
+
+
+inline
+bool
+cpu_dispatch::convert(double* dest, const float* src, const uword n_elem)
+  {
+  if(cpu_dispatch::use<double>(n_elem) == false)  { return false; }
+  
+  cpu_dispatch::table<double>().convert(dest, src, n_elem);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+const cpu_dispatch_table<eT>&
+cpu_dispatch::table()
+  {
+  static const cpu_dispatch_table<eT> tables[3] =
+    {
+    cpu_dispatch_table<eT>(),
+    cpu_dispatch_tables<eT>::avx2(),
+    cpu_dispatch_tables<eT>::avx512()
+    };
+  
+  return tables[ active() ];
+  }
+
+
+#endif
+
+
+//! @}
@@ -1441,6 +1441,7 @@ arma_assert_atlas_size(const T1& A, const T2& B)
         out << "@ arma_config::std_mutex        = " << arma_config::std_mutex        << '\n';
         out << "@ arma_config::posix            = " << arma_config::posix            << '\n';
         out << "@ arma_config::openmp           = " << arma_config::openmp           << '\n';
+        out << "@ arma_config::mp               = " << arma_config::mp               << '\n';
         out << "@ arma_config::lapack           = " << arma_config::lapack           << '\n';
         out << "@ arma_config::blas             = " << arma_config::blas             << '\n';
         out << "@ arma_config::newarp           = " << arma_config::newarp           << '\n';
@@ -35,6 +35,9 @@ class diskio
   template<typename eT> friend class SpMat;
   template<typename oT> friend class field;
   
+  template<typename eT> friend class mapped_file_elems;
+  template<typename eT> friend class mat_reader_priv::mat_reader;
+  
   friend class   Mat_aux;
   friend class  Cube_aux;
   friend class SpMat_aux;
@@ -50,6 +53,8 @@ class diskio
   
   inline arma_cold static file_type guess_file_type_internal(std::istream& f);
   
+  inline arma_cold static std::string gen_blz_header(const std::string& bin_header);
+  
   inline arma_cold static std::string gen_tmp_name(const std::string& x);
   
   inline arma_cold static bool safe_rename(const std::string& old_name, const std::string& new_name);
@@ -57,8 +62,20 @@ class diskio
   template<typename eT> inline static bool convert_token(eT&              val, const std::string& token);
   template<typename  T> inline static bool convert_token(std::complex<T>& val, const std::string& token);
   
+  inline static uword bin_header_padding(const uword header_len);
+  
+  template<typename eT> inline static bool convert_csv_token(eT&              val, const char* str, const char* str_end);
+  template<typename  T> inline static bool convert_csv_token(std::complex<T>& val, const char* str, const char* str_end);
+  
   template<typename eT> inline static std::streamsize prepare_stream(std::ostream& f);
   
+  inline static bool is_plain_stream(const std::ostream& f);
+  
+  template<typename eT> inline static uword format_text_elem(char* buf, const eT&              val);
+  template<typename  T> inline static uword format_text_elem(char* buf, const std::complex<T>& val);
+  
+  template<typename eT> inline static bool save_text_lines(std::ostream& f, const eT* mem, const uword n_rows, const uword n_cols, const uword n_slices, const char separator, const bool raw);
+  
   
   //
   // matrix saving
@@ -69,6 +86,7 @@ class diskio
   template<typename eT> inline static bool save_csv_ascii  (const Mat<eT>&                x, const std::string& final_name, const field<std::string>& header, const bool with_header, const char separator);
   template<typename eT> inline static bool save_coord_ascii(const Mat<eT>&                x, const std::string& final_name);
   template<typename eT> inline static bool save_arma_binary(const Mat<eT>&                x, const std::string& final_name);
+  template<typename eT> inline static bool save_arma_binary_compressed(const Mat<eT>&     x, const std::string& final_name);
   template<typename eT> inline static bool save_pgm_binary (const Mat<eT>&                x, const std::string& final_name);
   template<typename  T> inline static bool save_pgm_binary (const Mat< std::complex<T> >& x, const std::string& final_name);
   template<typename eT> inline static bool save_hdf5_binary(const Mat<eT>&                x, const   hdf5_name& spec, std::string& err_msg);
@@ -81,6 +99,7 @@ class diskio
   template<typename eT> inline static bool save_coord_ascii(const Mat<eT>&                x, std::ostream& f);
   template<typename  T> inline static bool save_coord_ascii(const Mat< std::complex<T> >& x, std::ostream& f);
   template<typename eT> inline static bool save_arma_binary(const Mat<eT>&                x, std::ostream& f);
+  template<typename eT> inline static bool save_arma_binary_compressed(const Mat<eT>&     x, std::ostream& f);
   template<typename eT> inline static bool save_pgm_binary (const Mat<eT>&                x, std::ostream& f);
   template<typename  T> inline static bool save_pgm_binary (const Mat< std::complex<T> >& x, std::ostream& f);
   
@@ -94,6 +113,7 @@ class diskio
   template<typename eT> inline static bool load_csv_ascii  (Mat<eT>&                x, const std::string& name, std::string& err_msg, field<std::string>& header, const bool with_header, const char separator);
   template<typename eT> inline static bool load_coord_ascii(Mat<eT>&                x, const std::string& name, std::string& err_msg);
   template<typename eT> inline static bool load_arma_binary(Mat<eT>&                x, const std::string& name, std::string& err_msg);
+  template<typename eT> inline static bool load_arma_binary_compressed(Mat<eT>&     x, const std::string& name, std::string& err_msg);
   template<typename eT> inline static bool load_pgm_binary (Mat<eT>&                x, const std::string& name, std::string& err_msg);
   template<typename  T> inline static bool load_pgm_binary (Mat< std::complex<T> >& x, const std::string& name, std::string& err_msg);
   template<typename eT> inline static bool load_hdf5_binary(Mat<eT>&                x, const   hdf5_name& spec, std::string& err_msg);
@@ -103,14 +123,23 @@ class diskio
   template<typename eT> inline static bool load_raw_binary (Mat<eT>&                x, std::istream& f,  std::string& err_msg);
   template<typename eT> inline static bool load_arma_ascii (Mat<eT>&                x, std::istream& f,  std::string& err_msg);
   template<typename eT> inline static bool load_csv_ascii  (Mat<eT>&                x, std::istream& f,  std::string& err_msg, const char separator);
-  template<typename  T> inline static bool load_csv_ascii  (Mat< std::complex<T> >& x, std::istream& f,  std::string& err_msg, const char separator);
   template<typename eT> inline static bool load_coord_ascii(Mat<eT>&                x, std::istream& f,  std::string& err_msg);
   template<typename  T> inline static bool load_coord_ascii(Mat< std::complex<T> >& x, std::istream& f,  std::string& err_msg);
   template<typename eT> inline static bool load_arma_binary(Mat<eT>&                x, std::istream& f,  std::string& err_msg);
+  template<typename eT> inline static bool load_arma_binary_compressed(Mat<eT>&     x, std::istream& f,  std::string& err_msg);
   template<typename eT> inline static bool load_pgm_binary (Mat<eT>&                x, std::istream& is, std::string& err_msg);
   template<typename  T> inline static bool load_pgm_binary (Mat< std::complex<T> >& x, std::istream& is, std::string& err_msg);
   template<typename eT> inline static bool load_auto_detect(Mat<eT>&                x, std::istream& f,  std::string& err_msg);
   
+  template<typename eT> inline static bool load_csv_ascii  (Mat<eT>&                x, const char* mem, const uword mem_len, std::string& err_msg, const char separator);
+  template<typename eT> inline static bool load_arma_binary_header(const Mat<eT>&  x, const char* mem, const uword mem_len, uword& offset, uword& n_rows, uword& n_cols,                  std::string& err_msg);
+  template<typename eT> inline static bool load_arma_binary_header(const Cube<eT>& x, const char* mem, const uword mem_len, uword& offset, uword& n_rows, uword& n_cols, uword& n_slices, std::string& err_msg);
+  
+  template<typename eT> inline static bool save_blz_blocks(std::ostream& f, const eT* mem, const uword n_rows, const uword n_cols);
+  template<typename eT> inline static bool load_blz_blocks(std::istream& f,       eT* mem, const uword n_rows, const uword n_cols, std::string& err_msg);
+  
+  inline static void load_csv_header(field<std::string>& header, const char* str, const char* str_end, const char separator);
+  
   inline static void pnm_skip_comments(std::istream& f);
   
   
@@ -150,12 +179,14 @@ class diskio
   template<typename eT> inline static bool save_raw_binary (const Cube<eT>& x, const std::string& name);
   template<typename eT> inline static bool save_arma_ascii (const Cube<eT>& x, const std::string& name);
   template<typename eT> inline static bool save_arma_binary(const Cube<eT>& x, const std::string& name);
+  template<typename eT> inline static bool save_arma_binary_compressed(const Cube<eT>& x, const std::string& name);
   template<typename eT> inline static bool save_hdf5_binary(const Cube<eT>& x, const   hdf5_name& spec, std::string& err_msg);
   
   template<typename eT> inline static bool save_raw_ascii  (const Cube<eT>& x, std::ostream& f);
   template<typename eT> inline static bool save_raw_binary (const Cube<eT>& x, std::ostream& f);
   template<typename eT> inline static bool save_arma_ascii (const Cube<eT>& x, std::ostream& f);
   template<typename eT> inline static bool save_arma_binary(const Cube<eT>& x, std::ostream& f);
+  template<typename eT> inline static bool save_arma_binary_compressed(const Cube<eT>& x, std::ostream& f);
   
   
   //
@@ -165,6 +196,7 @@ class diskio
   template<typename eT> inline static bool load_raw_binary (Cube<eT>& x, const std::string& name, std::string& err_msg);
   template<typename eT> inline static bool load_arma_ascii (Cube<eT>& x, const std::string& name, std::string& err_msg);
   template<typename eT> inline static bool load_arma_binary(Cube<eT>& x, const std::string& name, std::string& err_msg);
+  template<typename eT> inline static bool load_arma_binary_compressed(Cube<eT>& x, const std::string& name, std::string& err_msg);
   template<typename eT> inline static bool load_hdf5_binary(Cube<eT>& x, const   hdf5_name& spec, std::string& err_msg);
   template<typename eT> inline static bool load_auto_detect(Cube<eT>& x, const std::string& name, std::string& err_msg);
   
@@ -172,6 +204,7 @@ class diskio
   template<typename eT> inline static bool load_raw_binary (Cube<eT>& x, std::istream& f, std::string& err_msg);
   template<typename eT> inline static bool load_arma_ascii (Cube<eT>& x, std::istream& f, std::string& err_msg);
   template<typename eT> inline static bool load_arma_binary(Cube<eT>& x, std::istream& f, std::string& err_msg);
+  template<typename eT> inline static bool load_arma_binary_compressed(Cube<eT>& x, std::istream& f, std::string& err_msg);
   template<typename eT> inline static bool load_auto_detect(Cube<eT>& x, std::istream& f, std::string& err_msg);
   
   
@@ -354,6 +354,23 @@ diskio::guess_file_type_internal(std::istream& f)
 
 
 
+//! Generate the first line of the header used for saving matrices and cubes in compressed binary format,
+//! by replacing BIN with BLZ in the header used for the arma_binary format.
+//! Format: "ARMA_MAT_BLZ_ABXYZ" or "ARMA_CUB_BLZ_ABXYZ".
+inline
+arma_cold
+std::string
+diskio::gen_blz_header(const std::string& bin_header)
+  {
+  std::string header = bin_header;
+  
+  header.replace(9, 3, "BLZ");
+  
+  return header;
+  }
+
+
+
 //! Append a quasi-random string to the given filename.
 //! Avoiding use of rand() to preserve its state. 
 inline
@@ -568,6 +585,323 @@ diskio::convert_token(std::complex<T>& val, const std::string& token)
 
 
 
+//! number of spaces appended to the first line of an arma_binary header,
+//! so that the elements start at a multiple of 64 bytes from the start of the file;
+//! this allows the elements to be used directly when the file is memory mapped (see Mat::mapped)
+inline
+uword
+diskio::bin_header_padding(const uword header_len)
+  {
+  const uword align = 64;
+  
+  return (align - (header_len % align)) % align;
+  }
+
+
+
+//! convert the CSV token in [str, str_end) without copying it;
+//! decimal numbers whose significant digits fit exactly in a double and which have a small exponent
+//! are converted directly, as the result is then correctly rounded (Clinger's fast path);
+//! other numbers are converted via std::from_chars() if available, or via convert_token()
+template<typename eT>
+inline
+bool
+diskio::convert_csv_token(eT& val, const char* str, const char* str_end)
+  {
+  while( (str < str_end) && ( (str[0] == ' ') || (str[0] == '\t') ) )  { ++str; }
+  
+  while( (str_end > str) && ( (str_end[-1] == ' ') || (str_end[-1] == '\t') || (str_end[-1] == '\r') ) )  { --str_end; }
+  
+  if(str == str_end)  { val = eT(0); return true; }
+  
+  const char* ptr = str;
+  
+  const bool neg = (ptr[0] == '-');
+  
+  if( neg || (ptr[0] == '+') )  { ++ptr; }
+  
+  u64   mantissa   = 0;
+  uword n_sig      = 0;  // number of significant digits in mantissa
+  int   exponent   = 0;
+  bool  has_digits = false;
+  bool  too_long   = false;
+  bool  is_integer = true;
+  
+  for(; (ptr < str_end) && (unsigned(ptr[0] - '0') < 10u); ++ptr)
+    {
+    const u64 digit = u64(ptr[0] - '0');
+    
+    has_digits = true;
+    
+    if( (mantissa == 0) && (digit == 0) )  { continue; }
+    
+    if(n_sig < 19)  { mantissa = mantissa*10 + digit; ++n_sig; } else { too_long = true; }
+    }
+  
+  if( (ptr < str_end) && (ptr[0] == '.') )
+    {
+    is_integer = false;
+    
+    for(++ptr; (ptr < str_end) && (unsigned(ptr[0] - '0') < 10u); ++ptr)
+      {
+      const u64 digit = u64(ptr[0] - '0');
+      
+      has_digits = true;
+      
+      if( (mantissa == 0) && (digit == 0) )  { --exponent; continue; }
+      
+      if(n_sig < 19)  { mantissa = mantissa*10 + digit; ++n_sig; --exponent; } else { too_long = true; }
+      }
+    }
+  
+  if( has_digits && (ptr < str_end) && ( (ptr[0] == 'e') || (ptr[0] == 'E') ) )
+    {
+    is_integer = false;
+    
+    ++ptr;
+    
+    const bool exp_neg = (ptr < str_end) && (ptr[0] == '-');
+    
+    if( (ptr < str_end) && ( exp_neg || (ptr[0] == '+') ) )  { ++ptr; }
+    
+    int  exp_val    = 0;
+    bool exp_digits = false;
+    
+    for(; (ptr < str_end) && (unsigned(ptr[0] - '0') < 10u); ++ptr)
+      {
+      exp_digits = true;
+      
+      if(exp_val < 10000)  { exp_val = exp_val*10 + int(ptr[0] - '0'); }
+      }
+    
+    if(exp_digits == false)  { too_long = true; }  // malformed; leave it to convert_token()
+    
+    exponent += (exp_neg) ? -exp_val : exp_val;
+    }
+  
+  const bool fast_ok = has_digits && (ptr == str_end) && (too_long == false);
+  
+  if(is_real<eT>::value)
+    {
+    if( fast_ok && (mantissa <= (u64(1) << 53)) && (exponent >= -22) && (exponent <= 22) )
+      {
+      // powers of ten up to 1e22 are exactly representable in double precision
+      static const double pow10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9, 1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+      
+      double tmp = double(mantissa);
+      
+      tmp = (exponent < 0) ? (tmp / pow10[-exponent]) : (tmp * pow10[exponent]);
+      
+      val = eT( (neg) ? -tmp : tmp );
+      
+      return true;
+      }
+    
+    #if defined(ARMA_HAVE_STD_FROM_CHARS)
+      {
+      // std::from_chars() is correctly rounded, but does not accept a leading plus sign
+      const char* num_start = (str[0] == '+') ? (str + 1) : str;
+      
+      double tmp = double(0);
+      
+      const std::from_chars_result result = std::from_chars(num_start, str_end, tmp);
+      
+      if( (result.ec == std::errc()) && (result.ptr == str_end) )  { val = eT(tmp); return true; }
+      }
+    #endif
+    
+    const size_t N = size_t(str_end - str);
+    
+    if(N < 64)
+      {
+      // std::strtod() requires a null terminated string; short tokens are copied to avoid allocating memory
+      char buf[64];
+      
+      std::memcpy(buf, str, N);
+      
+      buf[N] = char(0);
+      
+      char* endptr = nullptr;
+      
+      val = eT( std::strtod(buf, &endptr) );
+      
+      return (endptr != buf);
+      }
+    }
+  else
+    {
+    if( fast_ok && is_integer && (n_sig <= 18) && ( (neg == false) || is_signed<eT>::value ) )
+      {
+      val = (neg) ? eT( -(s64(mantissa)) ) : eT(mantissa);
+      
+      return true;
+      }
+    }
+  
+  return diskio::convert_token(val, std::string(str, str_end));
+  }
+
+
+
+//! convert the CSV token in [str, str_end); complex numbers are stored in "a+bi" format
+template<typename T>
+inline
+bool
+diskio::convert_csv_token(std::complex<T>& val, const char* str, const char* str_end)
+  {
+  std::string token(str, str_end);
+  
+  // remove spaces, tabs and carriage returns
+  if(token.length() > 0)
+    {
+    const char c_front = token.front();
+    const char c_back  = token.back();
+    
+    if( (c_front == ' ') || (c_front == '\t') || (c_back == ' ') || (c_back == '\t') || (c_back == '\r') )
+      {
+      token.erase(std::remove_if(token.begin(), token.end(), [](char c) { return ((c == ' ') || (c == '\t') || (c == '\r')); }), token.end());
+      }
+    }
+  
+  const size_t token_len = size_t( token.length() );
+  
+  if(token_len == 0)  { val = std::complex<T>(0); return true; }
+  
+  // handle special cases: inf and nan, without the imaginary part
+  if( (token_len == 3) || (token_len == 4) )
+    {
+    const char* token_str = token.c_str();
+    
+    const bool neg = (token_str[0] == '-');
+    const bool pos = (token_str[0] == '+');
+    
+    const size_t offset = ( (neg || pos) && (token_len == 4) ) ? 1 : 0;
+    
+    const char sig_a = token_str[offset  ];
+    const char sig_b = token_str[offset+1];
+    const char sig_c = token_str[offset+2];
+    
+    if( ((sig_a == 'i') || (sig_a == 'I')) && ((sig_b == 'n') || (sig_b == 'N')) && ((sig_c == 'f') || (sig_c == 'F')) )
+      {
+      val = std::complex<T>( ((neg) ? -(Datum<T>::inf) : Datum<T>::inf), T(0) );
+      
+      return true;
+      }
+    else
+    if( ((sig_a == 'n') || (sig_a == 'N')) && ((sig_b == 'a') || (sig_b == 'A')) && ((sig_c == 'n') || (sig_c == 'N')) )
+      {
+      val = std::complex<T>( Datum<T>::nan, T(0) );
+      
+      return true;
+      }
+    }
+  
+  std::string str_real;
+  std::string str_imag;
+  
+  bool found_x = false;
+  std::string::size_type loc_x = 0;  // location of the separator (+ or -) between the real and imaginary part
+  
+  std::string::size_type loc_i = token.find_last_of('i');  // location of the imaginary part indicator
+  
+  if(loc_i == std::string::npos)
+    {
+    str_real = token;
+    }
+  else
+    {
+    bool found_plus  = false;
+    bool found_minus = false;
+    
+    std::string::size_type loc_plus = token.find_last_of('+');
+    
+    if(loc_plus != std::string::npos)
+      {
+      if(loc_plus >= 1)
+        {
+        const char prev_char = token.at(loc_plus-1);
+        
+        // make sure we're not looking at the sign of the exponent
+        if( (prev_char != 'e') && (prev_char != 'E') )
+          {
+          found_plus = true;
+          }
+        else
+          {
+          // search again, omitting the exponent
+          loc_plus = token.find_last_of('+', loc_plus-1);
+          
+          if(loc_plus != std::string::npos)  { found_plus = true; }
+          }
+        }
+      else
+        {
+        // loc_plus == 0, meaning we're at the start of the string
+        found_plus = true;
+        }
+      }
+    
+    std::string::size_type loc_minus = token.find_last_of('-');
+    
+    if(loc_minus != std::string::npos)
+      {
+      if(loc_minus >= 1)
+        {
+        const char prev_char = token.at(loc_minus-1);
+        
+        // make sure we're not looking at the sign of the exponent
+        if( (prev_char != 'e') && (prev_char != 'E') )
+          {
+          found_minus = true;
+          }
+        else
+          {
+          // search again, omitting the exponent
+          loc_minus = token.find_last_of('-', loc_minus-1);
+          
+          if(loc_minus != std::string::npos)  { found_minus = true; }
+          }
+        }
+      else
+        {
+        // loc_minus == 0, meaning we're at the start of the string
+        found_minus = true;
+        }
+      }
+    
+    if(found_plus && found_minus)
+      {
+      if( (loc_i > loc_plus) && (loc_i > loc_minus) )
+        {
+        // choose the sign closest to the "i" to be the separator between the real and imaginary part
+        loc_x = ( (loc_i - loc_plus) < (loc_i - loc_minus) ) ? loc_plus : loc_minus;
+        found_x = true;
+        }
+      }
+    else if(found_plus )  { loc_x = loc_plus;  found_x = true; }
+    else if(found_minus)  { loc_x = loc_minus; found_x = true; }
+    
+    if(found_x)
+      {
+      if( loc_x    > 0           ) { str_real = token.substr(0,loc_x);                     }
+      if((loc_x+1) < token.size()) { str_imag = token.substr(loc_x, token.size()-loc_x-1); }
+      }
+    }
+  
+  T val_real = T(0);
+  T val_imag = T(0);
+  
+  const bool state_real = diskio::convert_token(val_real, str_real);
+  const bool state_imag = diskio::convert_token(val_imag, str_imag);
+  
+  val = std::complex<T>(val_real, val_imag);
+  
+  return (state_real && state_imag);
+  }
+
+
+
 template<typename eT>
 inline
 std::streamsize
@@ -603,6 +937,247 @@ diskio::prepare_stream(std::ostream& f)
 
 
 
+//! the text writers format the elements directly instead of via the stream;
+//! this gives the same output as the stream only if the stream has the default formatting flags, width and locale
+inline
+bool
+diskio::is_plain_stream(const std::ostream& f)
+  {
+  const ios::fmtflags special_flags = ios::showpos | ios::uppercase | ios::left | ios::internal | ios::showbase | ios::oct | ios::hex;
+  
+  return ( ((f.flags() & special_flags) == ios::fmtflags(0)) && (f.width() == 0) && (f.getloc() == std::locale::classic()) );
+  }
+
+
+
+//! format an element in the same way as arma_ostream::raw_print_elem() on a stream prepared by prepare_stream();
+//! returns the number of chars written to buf, which must have room for at least 32 chars
+template<typename eT>
+inline
+uword
+diskio::format_text_elem(char* buf, const eT& val)
+  {
+  if(is_real<eT>::value)
+    {
+    const double tmp = double(val);
+    
+    if(arma_isfinite(tmp) == false)
+      {
+      const char* str = arma_isinf(tmp) ? ((tmp <= double(0)) ? "-inf" : "inf") : "nan";
+      
+      const uword len = uword(std::strlen(str));
+      
+      std::memcpy(buf, str, size_t(len));
+      
+      return len;
+      }
+    
+    #if defined(ARMA_HAVE_STD_TO_CHARS)
+      {
+      const std::to_chars_result result = std::to_chars(buf, buf + 32, tmp, std::chars_format::scientific, 16);
+      
+      return uword(result.ptr - buf);
+      }
+    #else
+      {
+      const int len = std::snprintf(buf, 32, "%.16e", tmp);
+      
+      // the decimal point of std::snprintf() depends on the C locale; it always follows the first digit
+      buf[(buf[0] == '-') ? 2 : 1] = '.';
+      
+      return uword(len);
+      }
+    #endif
+    }
+  
+  u64  mag = 0;
+  bool neg = false;
+  
+  if(is_signed<eT>::value)
+    {
+    const s64 tmp = s64(val);
+    
+    neg = (tmp < s64(0));
+    mag = (neg) ? (u64(0) - u64(tmp)) : u64(tmp);
+    }
+  else
+    {
+    mag = u64(val);
+    }
+  
+  char  digits[24];
+  uword n_digits = 0;
+  
+  do
+    {
+    digits[n_digits] = char('0' + (mag % u64(10)));
+    
+    ++n_digits;
+    
+    mag /= u64(10);
+    }
+  while(mag > u64(0));
+  
+  uword len = 0;
+  
+  if(neg)  { buf[0] = '-'; len = 1; }
+  
+  while(n_digits > 0)  { --n_digits; buf[len] = digits[n_digits]; ++len; }
+  
+  return len;
+  }
+
+
+
+//! format a complex element in the same way as arma_ostream::raw_print_elem() on a stream prepared by prepare_stream();
+//! returns the number of chars written to buf, which must have room for at least 64 chars
+template<typename T>
+inline
+uword
+diskio::format_text_elem(char* buf, const std::complex<T>& val)
+  {
+  const T vals[2] = { val.real(), val.imag() };
+  
+  uword len = 0;
+  
+  buf[len] = '(';  ++len;
+  
+  for(uword i=0; i < 2; ++i)
+    {
+    const T x = vals[i];
+    
+    if(arma_isfinite(x))
+      {
+      len += diskio::format_text_elem(buf + len, x);
+      }
+    else
+      {
+      // unlike real elements, infinities always have a sign
+      const char* str = arma_isinf(x) ? ((x <= T(0)) ? "-inf" : "+inf") : "nan";
+      
+      const uword str_len = uword(std::strlen(str));
+      
+      std::memcpy(buf + len, str, size_t(str_len));
+      
+      len += str_len;
+      }
+    
+    buf[len] = (i == 0) ? ',' : ')';  ++len;
+    }
+  
+  return len;
+  }
+
+
+
+//! Write n_slices matrices with n_rows x n_cols elements each, stored consecutively in mem, as lines of text.
+//! In raw format each element is preceded by a space and real elements are right aligned in cells of 24 chars;
+//! otherwise the elements are separated by the separator.
+//! Blocks of lines are formatted in parallel when worthwhile, each into its own part of a buffer which is reused for all blocks;
+//! the parts are then written in order.
+template<typename eT>
+inline
+bool
+diskio::save_text_lines(std::ostream& f, const eT* mem, const uword n_rows, const uword n_cols, const uword n_slices, const char separator, const bool raw)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_lines = n_rows * n_slices;
+  
+  if(n_lines == 0)  { return f.good(); }
+  
+  int n_threads = 1;
+  
+  #if defined(ARMA_USE_MP)
+    {
+    // the cost per element is a rough estimate of formatting a number, relative to the cost of exp()
+    if(mp_gate<eT>::eval(n_lines * n_cols, 8))  { n_threads = mp_thread_limit::get(); }
+    }
+  #endif
+  
+  const uword elem_max_len = uword(2) * uword(32);
+  const uword line_max_len = n_cols * elem_max_len + uword(1);
+  
+  const uword task_n_lines = (std::max)( (uword(1) << 20) / line_max_len, uword(1) );
+  const uword task_max_len = task_n_lines * line_max_len;
+  
+  const uword batch_n_lines = uword(n_threads) * task_n_lines;
+  
+  podarray<char>  buffer;
+  podarray<uword> lengths( static_cast<uword>(n_threads) );
+  
+  try { buffer.set_size(uword(n_threads) * task_max_len); } catch(...) { return false; }
+  
+  const uword cell_width   = 24;
+  const uword slice_n_elem = n_rows * n_cols;
+  
+  for(uword batch_start=0; batch_start < n_lines; batch_start += batch_n_lines)
+    {
+    const uword batch_n_tasks = (std::min)( uword(n_threads), (n_lines - batch_start + task_n_lines - 1) / task_n_lines );
+    
+    mp_parallel::run(batch_n_tasks, n_threads, [&](const uword t)
+      {
+      const uword line_start = batch_start + t * task_n_lines;
+      const uword line_end   = (std::min)(line_start + task_n_lines, n_lines);
+      
+      char* out_start = buffer.memptr() + t * task_max_len;
+      char* out       = out_start;
+      
+      for(uword line=line_start; line < line_end; ++line)
+        {
+        const eT* line_mem = mem + (line / n_rows) * slice_n_elem + (line % n_rows);
+        
+        for(uword col=0; col < n_cols; ++col)
+          {
+          const eT& val = line_mem[col * n_rows];
+          
+          if(raw)
+            {
+            (*out) = ' ';  ++out;
+            
+            const uword len = diskio::format_text_elem(out, val);
+            
+            if( is_real<eT>::value && (len < cell_width) )
+              {
+              const uword n_pad = cell_width - len;
+              
+              std::memmove(out + n_pad, out, size_t(len));
+              std::memset(out, ' ', size_t(n_pad));
+              
+              out += cell_width;
+              }
+            else
+              {
+              out += len;
+              }
+            }
+          else
+            {
+            out += diskio::format_text_elem(out, val);
+            
+            if( col < (n_cols-1) )  { (*out) = separator;  ++out; }
+            }
+          }
+        
+        (*out) = '\n';  ++out;
+        }
+      
+      lengths[t] = uword(out - out_start);
+      } );
+    
+    for(uword t=0; t < batch_n_tasks; ++t)
+      {
+      f.write( buffer.memptr() + t * task_max_len, std::streamsize(lengths[t]) );
+      }
+    
+    if(f.good() == false)  { return false; }
+    }
+  
+  return f.good();
+  }
+
+
+
 //! Save a matrix as raw text (no header, human readable).
 //! Matrices can be loaded in Matlab and Octave, as long as they don't have complex elements.
 template<typename eT>
@@ -642,6 +1217,8 @@ diskio::save_raw_ascii(const Mat<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
+  if(diskio::is_plain_stream(f))  { return diskio::save_text_lines(f, x.memptr(), x.n_rows, x.n_cols, uword(1), ' ', true); }
+  
   const arma_ostream_state stream_state(f);
   
   const std::streamsize cell_width = diskio::prepare_stream<eT>(f);
@@ -833,6 +1410,8 @@ diskio::save_csv_ascii(const Mat<eT>& x, std::ostream& f, const char separator)
   {
   arma_extra_debug_sigprint();
   
+  if(diskio::is_plain_stream(f))  { return diskio::save_text_lines(f, x.memptr(), x.n_rows, x.n_cols, uword(1), separator, false); }
+  
   const arma_ostream_state stream_state(f);
   
   diskio::prepare_stream<eT>(f);
@@ -1066,8 +1645,17 @@ diskio::save_arma_binary(const Mat<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  f << diskio::gen_bin_header(x) << '\n';
-  f << x.n_rows << ' ' << x.n_cols << '\n';
+  const std::string header = diskio::gen_bin_header(x);
+  
+  std::ostringstream dims;
+  
+  dims << x.n_rows << ' ' << x.n_cols << '\n';
+  
+  // the padding is skipped when the header is read
+  const uword n_pad = diskio::bin_header_padding( uword(header.length() + 1 + dims.str().length()) );
+  
+  f << header << std::string(n_pad, ' ') << '\n';
+  f << dims.str();
   
   f.write( reinterpret_cast<const char*>(x.mem), std::streamsize(x.n_elem*sizeof(eT)) );
   
@@ -1076,6 +1664,145 @@ diskio::save_arma_binary(const Mat<eT>& x, std::ostream& f)
 
 
 
+//! Save a matrix in compressed binary format, with a header that stores the matrix type as well as its dimensions;
+//! the elements are stored as independently compressed blocks of columns (see save_blz_blocks())
+template<typename eT>
+inline
+bool
+diskio::save_arma_binary_compressed(const Mat<eT>& x, const std::string& final_name)
+  {
+  arma_extra_debug_sigprint();
+  
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  
+  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
+  
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
+    {
+    save_okay = diskio::save_arma_binary_compressed(x, f);
+    
+    f.flush();
+    f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+    }
+  
+  return save_okay;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::save_arma_binary_compressed(const Mat<eT>& x, std::ostream& f)
+  {
+  arma_extra_debug_sigprint();
+  
+  f << diskio::gen_blz_header( diskio::gen_bin_header(x) ) << '\n';
+  f << x.n_rows << ' ' << x.n_cols << '\n';
+  
+  return diskio::save_blz_blocks(f, x.mem, x.n_rows, x.n_cols);
+  }
+
+
+
+//! Write the elements as independently compressed blocks of columns, which are compressed in parallel when worthwhile.
+//! Format: a line with the number of columns per block and the number of blocks,
+//! followed by the length of each compressed block (as u64), followed by the compressed blocks.
+//! The first byte of each block indicates its encoding: 0 for raw elements, 1 for shuffled and LZ4 compressed elements.
+//! The lengths allow each block, and hence each range of columns, to be located without decompressing the preceding blocks.
+template<typename eT>
+inline
+bool
+diskio::save_blz_blocks(std::ostream& f, const eT* mem, const uword n_rows, const uword n_cols)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword block_n_bytes = uword(1) << 20;
+  const uword  col_n_bytes  = n_rows * uword(sizeof(eT));
+  
+  const uword block_n_cols = (col_n_bytes > 0) ? (std::max)(block_n_bytes / col_n_bytes, uword(1)) : (std::max)(n_cols, uword(1));
+  const uword n_blocks     = (n_cols + block_n_cols - 1) / block_n_cols;
+  
+  f << block_n_cols << ' ' << n_blocks << '\n';
+  
+  int n_threads = 1;
+  
+  #if defined(ARMA_USE_MP)
+    {
+    if( (n_blocks > 1) && mp_gate<eT>::eval(n_rows * n_cols, 2) )  { n_threads = mp_thread_limit::get(); }
+    }
+  #endif
+  
+  // the compressed blocks are kept until all lengths are known, as the lengths are written first
+  std::vector< std::vector<u8> > blocks(n_blocks);
+  
+  mp_parallel::run(n_blocks, n_threads, [&](const uword b)
+    {
+    std::vector<u8>& out = blocks[b];
+    
+    try
+      {
+      const uword col_start    = b * block_n_cols;
+      const uword block_n_elem = n_rows * (std::min)(block_n_cols, n_cols - col_start);
+      const uword n_bytes      = block_n_elem * uword(sizeof(eT));
+      
+      const u8* src = reinterpret_cast<const u8*>(mem + col_start * n_rows);
+      
+      podarray<u8> shuffled(n_bytes);
+      
+      lz_codec::shuffle(shuffled.memptr(), src, block_n_elem, uword(sizeof(eT)));
+      
+      out.resize( 1 + lz_codec::bound(n_bytes) );
+      
+      const uword out_len = lz_codec::compress(out.data() + 1, shuffled.memptr(), n_bytes);
+      
+      if(out_len < n_bytes)
+        {
+        out[0] = u8(1);
+        out.resize(1 + out_len);
+        }
+      else
+        {
+        out[0] = u8(0);
+        out.resize(1 + n_bytes);
+        
+        if(n_bytes > 0)  { std::memcpy(out.data() + 1, src, size_t(n_bytes)); }
+        }
+      }
+    catch(...)
+      {
+      std::vector<u8>().swap(out);
+      }
+    } );
+  
+  podarray<u64> lengths(n_blocks);
+  
+  for(uword b=0; b < n_blocks; ++b)
+    {
+    // each block has at least one byte, unless there was not enough memory
+    if(blocks[b].empty())  { return false; }
+    
+    lengths[b] = u64(blocks[b].size());
+    }
+  
+  f.write( reinterpret_cast<const char*>(lengths.memptr()), std::streamsize(n_blocks * sizeof(u64)) );
+  
+  for(uword b=0; b < n_blocks; ++b)
+    {
+    f.write( reinterpret_cast<const char*>(blocks[b].data()), std::streamsize(blocks[b].size()) );
+    
+    std::vector<u8>().swap(blocks[b]);
+    }
+  
+  return f.good();
+  }
+
+
+
 //! Save a matrix as a PGM greyscale image
 template<typename eT>
 inline
@@ -1570,449 +2297,284 @@ diskio::load_csv_ascii(Mat<eT>& x, const std::string& name, std::string& err_msg
   {
   arma_extra_debug_sigprint();
   
-  std::fstream f;
-  f.open(name.c_str(), std::fstream::in);
-  
-  bool load_okay = f.is_open();
-  
-  if(load_okay == false)  { return false; }
+  mapped_file file;
   
-  if(with_header)
+  if(file.open(name, map_mode::read_only) == false)
     {
-    arma_extra_debug_print("diskio::load_csv_ascii(): reading header");
+    arma_extra_debug_print("diskio::load_csv_ascii(): memory mapping not available; using stream");
     
-    std::string              header_line;
-    std::stringstream        header_stream;
-    std::vector<std::string> header_tokens;
+    std::fstream f;
+    f.open(name.c_str(), std::fstream::in);
     
-    std::getline(f, header_line);
+    bool load_okay = f.is_open();
     
-    load_okay = f.good();
+    if(load_okay == false)  { return false; }
     
-    if(load_okay)
+    if(with_header)
       {
-      std::string token;
+      arma_extra_debug_print("diskio::load_csv_ascii(): reading header");
       
-      header_stream.clear();
-      header_stream.str(header_line);
+      std::string header_line;
       
-      uword header_n_tokens = 0;
+      std::getline(f, header_line);
       
-      while(header_stream.good())
-        {
-        std::getline(header_stream, token, separator);
-        ++header_n_tokens;
-        header_tokens.push_back(token);
-        }
+      load_okay = f.good();
       
-      if(header_n_tokens == uword(0))
-        {
-        header.reset();
-        }
-      else
-        {
-        header.set_size(1,header_n_tokens);
-        
-        for(uword i=0; i < header_n_tokens; ++i)  { header.at(i) = header_tokens[i]; }
-        }
+      if(load_okay)  { diskio::load_csv_header(header, header_line.c_str(), header_line.c_str() + header_line.length(), separator); }
+      }
+    
+    if(load_okay)
+      {
+      load_okay = diskio::load_csv_ascii(x, f, err_msg, separator);
       }
+    
+    f.close();
+    
+    return load_okay;
     }
   
-  if(load_okay)
+  file.advise_sequential();
+  
+  const char* mem     = file.memptr();
+        uword mem_len = file.n_bytes();
+  
+  if(with_header)
     {
-    load_okay = diskio::load_csv_ascii(x, f, err_msg, separator);
+    arma_extra_debug_print("diskio::load_csv_ascii(): reading header");
+    
+    const char* header_end = (mem_len > 0) ? static_cast<const char*>( std::memchr(mem, '\n', size_t(mem_len)) ) : nullptr;
+    
+    // as with std::getline(), a header without a terminating newline indicates there is no data
+    if(header_end == nullptr)  { return false; }
+    
+    diskio::load_csv_header(header, mem, header_end, separator);
+    
+    mem_len -= uword(header_end + 1 - mem);
+    mem      = header_end + 1;
     }
   
-  f.close();
-  
-  return load_okay;
+  return diskio::load_csv_ascii(x, mem, mem_len, err_msg, separator);
   }
 
 
 
-//! Load a matrix in CSV text format (human readable)
-template<typename eT>
+//! split the CSV header line in [str, str_end) into tokens
 inline
-bool
-diskio::load_csv_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg, const char separator)
+void
+diskio::load_csv_header(field<std::string>& header, const char* str, const char* str_end, const char separator)
   {
   arma_extra_debug_sigprint();
   
-  // TODO: replace with more efficient implementation
-  
-  if(f.good() == false)  { return false; }
-  
-  f.clear();
-  const std::fstream::pos_type pos1 = f.tellg();
-  
-  //
-  // work out the size
-  
-  uword f_n_rows = 0;
-  uword f_n_cols = 0;
-  
-  std::string       line_string;
-  std::stringstream line_stream;
-  
-  std::string token;
+  std::vector<std::string> header_tokens;
   
-  while(f.good())
+  while(true)
     {
-    std::getline(f, line_string);
-    
-    if(line_string.size() == 0)  { break; }
-    
-    line_stream.clear();
-    line_stream.str(line_string);
+    const char* token_end = static_cast<const char*>( std::memchr(str, separator, size_t(str_end - str)) );
     
-    uword line_n_cols = 0;
-    
-    while(line_stream.good())
-      {
-      std::getline(line_stream, token, separator);
-      ++line_n_cols;
-      }
+    if(token_end == nullptr)  { header_tokens.push_back( std::string(str, str_end) ); break; }
     
-    if(f_n_cols < line_n_cols)  { f_n_cols = line_n_cols; }
+    header_tokens.push_back( std::string(str, token_end) );
     
-    ++f_n_rows;
+    str = token_end + 1;
     }
   
-  f.clear();
-  f.seekg(pos1);
-  
-  try { x.zeros(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+  const uword header_n_tokens = uword(header_tokens.size());
   
-  const bool use_mp = (arma_config::openmp) && (f_n_rows >= 2) && (f_n_cols >= 64);
+  header.set_size(1,header_n_tokens);
   
-  field<std::string> token_array;
+  for(uword i=0; i < header_n_tokens; ++i)  { header.at(i) = header_tokens[i]; }
+  }
+
+
+
+//! Load a matrix in CSV text format (human readable);
+//! the lines up to the first empty line are gathered and then parsed in memory
+template<typename eT>
+inline
+bool
+diskio::load_csv_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg, const char separator)
+  {
+  arma_extra_debug_sigprint();
   
-  bool token_array_ok = false;
+  if(f.good() == false)  { return false; }
   
-  if(use_mp)
-    {
-    try
-      {
-      token_array.set_size(f_n_cols);
-      
-      for(uword i=0; i < f_n_cols; ++i)  { token_array(i).reserve(32); }
-      
-      token_array_ok = true;
-      }
-    catch(...)
-      {
-      token_array.reset();
-      }
-    }
+  std::string buffer;
+  std::string line_string;
   
-  if(use_mp && token_array_ok)
-    {
-    #if defined(ARMA_USE_OPENMP)
-      {
-      uword row = 0;
-      
-      while(f.good())
-        {
-        std::getline(f, line_string);
-        
-        if(line_string.size() == 0)  { break; }
-        
-        line_stream.clear();
-        line_stream.str(line_string);
-        
-        for(uword i=0; i < f_n_cols; ++i)  { token_array(i).clear(); }
-        
-        uword line_stream_col = 0;
-        
-        while(line_stream.good())
-          {
-          std::getline(line_stream, token_array(line_stream_col), separator);
-          
-          ++line_stream_col;
-          }
-        
-        const int n_threads = mp_thread_limit::get();
-        
-        #pragma omp parallel for schedule(static) num_threads(n_threads)
-        for(uword col=0; col < line_stream_col; ++col)
-          {
-          diskio::convert_token( x.at(row,col), token_array(col) );
-          }
-        
-        ++row;
-        }
-      }
-    #endif
-    }
-  else  // serial implementation
+  try
     {
-    uword row = 0;
-    
     while(f.good())
       {
       std::getline(f, line_string);
       
       if(line_string.size() == 0)  { break; }
       
-      line_stream.clear();
-      line_stream.str(line_string);
-      
-      uword col = 0;
-      
-      while(line_stream.good())
-        {
-        std::getline(line_stream, token, separator);
-        
-        diskio::convert_token( x.at(row,col), token );
-        
-        ++col;
-        }
-      
-      ++row;
+      buffer += line_string;
+      buffer += '\n';
       }
     }
+  catch(...)
+    {
+    err_msg = "not enough memory";
+    return false;
+    }
   
-  return true;
+  return diskio::load_csv_ascii(x, buffer.c_str(), uword(buffer.length()), err_msg, separator);
   }
 
 
 
-//! Load a matrix in CSV text format (human readable); complex numbers stored in "a+bi" format
-template<typename T>
+//! Load a matrix in CSV text format from memory.
+//! The data ends at the first empty line or at the end of the memory.
+//! The memory is split into chunks at line boundaries, which are parsed in parallel when worthwhile;
+//! each chunk holds its values in row-major order, and the chunks are then copied into the matrix.
+template<typename eT>
 inline
 bool
-diskio::load_csv_ascii(Mat< std::complex<T> >& x, std::istream& f, std::string& err_msg, const char separator)
+diskio::load_csv_ascii(Mat<eT>& x, const char* mem, const uword mem_len, std::string& err_msg, const char separator)
   {
   arma_extra_debug_sigprint();
   
-  // TODO: replace with more efficient implementation
-  
-  if(f.good() == false)  { return false; }
+  int n_threads = 1;
   
-  f.clear();
-  const std::fstream::pos_type pos1 = f.tellg();
+  #if defined(ARMA_USE_MP)
+    {
+    // the cost per byte is a rough estimate of parsing a number, relative to the cost of exp()
+    if(mp_gate<eT>::eval(mem_len, 4))  { n_threads = mp_thread_limit::get(); }
+    }
+  #endif
   
-  //
-  // work out the size
+  // several chunks per thread, to balance lines of varying length
+  const uword n_chunks = (n_threads > 1) ? (std::min)( uword(n_threads) * uword(4), (std::max)(mem_len / uword(1024), uword(1)) ) : uword(1);
   
-  uword f_n_rows = 0;
-  uword f_n_cols = 0;
+  arma_extra_debug_print(arma_str::format("diskio::load_csv_ascii(): n_chunks: %u") % n_chunks);
   
-  std::string       line_string;
-  std::stringstream line_stream;
+  podarray<uword> bounds(n_chunks + 1);
   
-  std::string token;
+  bounds[0]        = 0;
+  bounds[n_chunks] = mem_len;
   
-  while(f.good())
+  for(uword t=1; t < n_chunks; ++t)
     {
-    std::getline(f, line_string);
-    
-    if(line_string.size() == 0)  { break; }
-    
-    line_stream.clear();
-    line_stream.str(line_string);
-    
-    uword line_n_cols = 0;
+    const uword target = (std::max)( bounds[t-1], uword( (double(mem_len) * double(t)) / double(n_chunks) ) );
     
-    while(line_stream.good())
-      {
-      std::getline(line_stream, token, separator);
-      ++line_n_cols;
-      }
-    
-    if(f_n_cols < line_n_cols)  { f_n_cols = line_n_cols; }
+    const char* line_end = (target < mem_len) ? static_cast<const char*>( std::memchr(mem + target, '\n', size_t(mem_len - target)) ) : nullptr;
     
-    ++f_n_rows;
+    bounds[t] = (line_end != nullptr) ? uword(line_end + 1 - mem) : mem_len;
     }
   
-  f.clear();
-  f.seekg(pos1);
-  
-  try { x.zeros(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
-  
-  uword row = 0;
+  struct csv_chunk
+    {
+    std::vector<eT>    values;      // values of all lines, in row-major order
+    std::vector<uword> line_start;  // location of the first value of each line, followed by the total number of values
+    uword              n_cols = 0;
+    bool               stop   = false;  // chunk contains an empty line
+    bool               ok     = true;
+    };
   
-  std::string str_real;
-  std::string str_imag;
+  std::vector<csv_chunk> chunks(n_chunks);
   
-  while(f.good())
+  mp_parallel::run(n_chunks, n_threads, [&](const uword t)
     {
-    std::getline(f, line_string);
-    
-    if(line_string.size() == 0)  { break; }
-    
-    line_stream.clear();
-    line_stream.str(line_string);
+    csv_chunk& chunk = chunks[t];
     
-    uword col = 0;
-    
-    while(line_stream.good())
+    try
       {
-      std::getline(line_stream, token, separator);
-      
-      // remove spaces and tabs
-      if(token.length() > 0)
-        {
-        const char c_front = token.front();
-        const char c_back  = token.back();
-        
-        if( (c_front == ' ') || (c_front == '\t') || (c_back == ' ') || (c_back == '\t') )
-          {
-          token.erase(std::remove_if(token.begin(), token.end(), [](char c) { return ((c == ' ') || (c == '\t')); }), token.end());
-          }
-        }
+      const char* ptr     = mem + bounds[t];
+      const char* ptr_end = mem + bounds[t+1];
       
-      const size_t token_len = size_t( token.length() );
+      chunk.line_start.push_back(0);
       
-      if(token_len == 0)  { col++; continue; }
-      
-      // handle special cases: inf and nan, without the imaginary part
-      if( (token_len == 3) || (token_len == 4) )
+      while(ptr < ptr_end)
         {
-        const char* str = token.c_str();
-        
-        const bool neg = (str[0] == '-');
-        const bool pos = (str[0] == '+');
+        const char* line_end = static_cast<const char*>( std::memchr(ptr, '\n', size_t(ptr_end - ptr)) );
         
-        const size_t offset = ( (neg || pos) && (token_len == 4) ) ? 1 : 0;
+        if(line_end == nullptr)  { line_end = ptr_end; }
         
-        const char sig_a = str[offset  ];
-        const char sig_b = str[offset+1];
-        const char sig_c = str[offset+2];
+        if(line_end == ptr)  { chunk.stop = true; break; }
         
-        bool found_val_real = false;
-        T          val_real = T(0);
+        uword line_n_cols = 0;
         
-        if( ((sig_a == 'i') || (sig_a == 'I')) && ((sig_b == 'n') || (sig_b == 'N')) && ((sig_c == 'f') || (sig_c == 'F')) )
+        while(true)
           {
-          val_real = (neg) ? -(Datum<T>::inf) : Datum<T>::inf;
+          const char* token_end = static_cast<const char*>( std::memchr(ptr, separator, size_t(line_end - ptr)) );
           
-          found_val_real = true;
-          }
-        else
-        if( ((sig_a == 'n') || (sig_a == 'N')) && ((sig_b == 'a') || (sig_b == 'A')) && ((sig_c == 'n') || (sig_c == 'N')) )
-          {
-          val_real = Datum<T>::nan;
+          if(token_end == nullptr)  { token_end = line_end; }
           
-          found_val_real = true;
-          }
-        
-        if(found_val_real)
-          {
-          x.at(row,col) = std::complex<T>(val_real, T(0));
+          eT val = eT(0);
           
-          col++; continue;  // get next token
-          }
-        }
-      
-      bool found_x = false;
-      std::string::size_type loc_x = 0;  // location of the separator (+ or -) between the real and imaginary part
-      
-      std::string::size_type loc_i = token.find_last_of('i');  // location of the imaginary part indicator
-      
-      if(loc_i == std::string::npos)
-        {
-        str_real = token;
-        str_imag.clear();
-        }
-      else
-        {
-        bool found_plus  = false;
-        bool found_minus = false;
-        
-        std::string::size_type loc_plus = token.find_last_of('+');
-        
-        if(loc_plus != std::string::npos)
-          {
-          if(loc_plus >= 1)
-            {
-            const char prev_char = token.at(loc_plus-1);
-            
-            // make sure we're not looking at the sign of the exponent
-            if( (prev_char != 'e') && (prev_char != 'E') )
-              {
-              found_plus = true;
-              }
-            else
-              {
-              // search again, omitting the exponent
-              loc_plus = token.find_last_of('+', loc_plus-1);
-              
-              if(loc_plus != std::string::npos)  { found_plus = true; }
-              }
-            }
-          else
-            {
-            // loc_plus == 0, meaning we're at the start of the string
-            found_plus = true;
-            }
+          diskio::convert_csv_token(val, ptr, token_end);
+          
+          chunk.values.push_back(val);
+          
+          ++line_n_cols;
+          
+          if(token_end == line_end)  { break; }
+          
+          ptr = token_end + 1;
           }
         
-        std::string::size_type loc_minus = token.find_last_of('-');
-        
-        if(loc_minus != std::string::npos)
-          {
-          if(loc_minus >= 1)
-            {
-            const char prev_char = token.at(loc_minus-1);
-            
-            // make sure we're not looking at the sign of the exponent
-            if( (prev_char != 'e') && (prev_char != 'E') )
-              {
-              found_minus = true;
-              }
-            else
-              {
-              // search again, omitting the exponent
-              loc_minus = token.find_last_of('-', loc_minus-1);
-              
-              if(loc_minus != std::string::npos)  { found_minus = true; }
-              }
-            }
-          else
-            {
-            // loc_minus == 0, meaning we're at the start of the string
-            found_minus = true;
-            }
-          }
+        chunk.line_start.push_back( uword(chunk.values.size()) );
         
-        if(found_plus && found_minus)
-          {
-          if( (loc_i > loc_plus) && (loc_i > loc_minus) )
-            {
-            // choose the sign closest to the "i" to be the separator between the real and imaginary part
-            loc_x = ( (loc_i - loc_plus) < (loc_i - loc_minus) ) ? loc_plus : loc_minus;
-            found_x = true;
-            }
-          }
-        else if(found_plus )  { loc_x = loc_plus;  found_x = true; }
-        else if(found_minus)  { loc_x = loc_minus; found_x = true; }
+        if(chunk.n_cols < line_n_cols)  { chunk.n_cols = line_n_cols; }
         
-        if(found_x)
-          {
-          if( loc_x    > 0           ) { str_real = token.substr(0,loc_x);                     } else { str_real.clear(); }
-          if((loc_x+1) < token.size()) { str_imag = token.substr(loc_x, token.size()-loc_x-1); } else { str_imag.clear(); }
-          }
-        else
-          {
-          str_real.clear();
-          str_imag.clear();
-          }
+        ptr = line_end + 1;
         }
+      }
+    catch(...)
+      {
+      chunk.ok = false;
+      }
+    } );
+  
+  // chunks after the first empty line are not used
+  
+  uword n_used = 0;
+  
+  uword f_n_rows = 0;
+  uword f_n_cols = 0;
+  
+  podarray<uword> row_start(n_chunks);
+  
+  for(uword t=0; t < n_chunks; ++t)
+    {
+    const csv_chunk& chunk = chunks[t];
+    
+    if(chunk.ok == false)  { err_msg = "not enough memory"; return false; }
+    
+    row_start[t] = f_n_rows;
+    
+    f_n_rows += uword(chunk.line_start.size()) - 1;
+    
+    if(f_n_cols < chunk.n_cols)  { f_n_cols = chunk.n_cols; }
+    
+    ++n_used;
+    
+    if(chunk.stop)  { break; }
+    }
+  
+  try { x.set_size(f_n_rows, f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+  
+  mp_parallel::run(n_used, n_threads, [&](const uword t)
+    {
+    csv_chunk& chunk = chunks[t];
+    
+    const uword chunk_n_rows = uword(chunk.line_start.size()) - 1;
+    
+    for(uword r=0; r < chunk_n_rows; ++r)
+      {
+      const uword row = row_start[t] + r;
       
-      T val_real = T(0);
-      T val_imag = T(0);
-      
-      diskio::convert_token(val_real, str_real);
-      diskio::convert_token(val_imag, str_imag);
-      
-      x.at(row,col) = std::complex<T>(val_real, val_imag);
+      const eT*   src         = chunk.values.data() + chunk.line_start[r];
+      const uword line_n_cols = chunk.line_start[r+1] - chunk.line_start[r];
       
-      ++col;
+      for(uword col=0;           col < line_n_cols; ++col)  { x.at(row,col) = src[col]; }
+      for(uword col=line_n_cols; col < f_n_cols;    ++col)  { x.at(row,col) = eT(0);    }
       }
     
-    ++row;
-    }
+    // release the memory as soon as possible
+    std::vector<eT>().swap(chunk.values);
+    } );
   
   return true;
   }
@@ -2259,12 +2821,144 @@ diskio::load_coord_ascii(Mat< std::complex<T> >& x, std::istream& f, std::string
 
 
 
-//! Load a matrix in binary format,
+//! Load a matrix in binary format,
+//! with a header that indicates the matrix type as well as its dimensions
+template<typename eT>
+inline
+bool
+diskio::load_arma_binary(Mat<eT>& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::ifstream f;
+  f.open(name.c_str(), std::fstream::binary);
+  
+  bool load_okay = f.is_open();
+  
+  if(load_okay)
+    {
+    load_okay = diskio::load_arma_binary(x, f, err_msg);
+    f.close();
+    }
+  
+  return load_okay;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::load_arma_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::streampos pos = f.tellg();
+  
+  bool load_okay = true;
+  
+  std::string f_header;
+  uword       f_n_rows;
+  uword       f_n_cols;
+  
+  f >> f_header;
+  f >> f_n_rows;
+  f >> f_n_cols;
+  
+  if(f_header == diskio::gen_bin_header(x))
+    {
+    //f.seekg(1, ios::cur);  // NOTE: this may not be portable, as on a Windows machine a newline could be two characters
+    f.get();
+    
+    try { x.set_size(f_n_rows,f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
+    
+    f.read( reinterpret_cast<char *>(x.memptr()), std::streamsize(x.n_elem*sizeof(eT)) );
+    
+    load_okay = f.good();
+    }
+  else
+    {
+    load_okay = false;
+    err_msg = "incorrect header";
+    }
+  
+  
+  // allow automatic conversion of u32/s32 matrices into u64/s64 matrices
+  
+  if(load_okay == false)
+    {
+    if( (sizeof(eT) == 8) && is_same_type<uword,eT>::yes )
+      {
+      Mat<u32>    tmp;
+      std::string junk;
+      
+      f.clear();
+      f.seekg(pos);
+      
+      load_okay = diskio::load_arma_binary(tmp, f, junk);
+      
+      if(load_okay)  { x = conv_to< Mat<eT> >::from(tmp); }
+      }
+    else
+    if( (sizeof(eT) == 8) && is_same_type<sword,eT>::yes )
+      {
+      Mat<s32>    tmp;
+      std::string junk;
+      
+      f.clear();
+      f.seekg(pos);
+      
+      load_okay = diskio::load_arma_binary(tmp, f, junk);
+      
+      if(load_okay)  { x = conv_to< Mat<eT> >::from(tmp); }
+      }
+    }
+  
+  return load_okay;
+  }
+
+
+
+//! Read the header of a matrix stored in arma_binary format in memory;
+//! offset is set to the location of the first element
+template<typename eT>
+inline
+bool
+diskio::load_arma_binary_header(const Mat<eT>& x, const char* mem, const uword mem_len, uword& offset, uword& n_rows, uword& n_cols, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  // the header, including any padding, is much shorter than this
+  std::istringstream f( std::string(mem, size_t( (std::min)(mem_len, uword(512)) )) );
+  
+  std::string f_header;
+  uword       f_n_rows = 0;
+  uword       f_n_cols = 0;
+  
+  f >> f_header;
+  f >> f_n_rows;
+  f >> f_n_cols;
+  f.get();
+  
+  if( (f.good() == false) || (f_header != diskio::gen_bin_header(x)) )  { err_msg = "incorrect header"; return false; }
+  
+  offset = uword(f.tellg());
+  n_rows = f_n_rows;
+  n_cols = f_n_cols;
+  
+  if( double(offset) + double(n_rows) * double(n_cols) * double(sizeof(eT)) > double(mem_len) )  { err_msg = "file is too short"; return false; }
+  
+  return true;
+  }
+
+
+
+//! Load a matrix in compressed binary format,
 //! with a header that indicates the matrix type as well as its dimensions
 template<typename eT>
 inline
 bool
-diskio::load_arma_binary(Mat<eT>& x, const std::string& name, std::string& err_msg)
+diskio::load_arma_binary_compressed(Mat<eT>& x, const std::string& name, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
@@ -2275,7 +2969,7 @@ diskio::load_arma_binary(Mat<eT>& x, const std::string& name, std::string& err_m
   
   if(load_okay)
     {
-    load_okay = diskio::load_arma_binary(x, f, err_msg);
+    load_okay = diskio::load_arma_binary_compressed(x, f, err_msg);
     f.close();
     }
   
@@ -2287,7 +2981,7 @@ diskio::load_arma_binary(Mat<eT>& x, const std::string& name, std::string& err_m
 template<typename eT>
 inline
 bool
-diskio::load_arma_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
+diskio::load_arma_binary_compressed(Mat<eT>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
@@ -2296,23 +2990,18 @@ diskio::load_arma_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
   bool load_okay = true;
   
   std::string f_header;
-  uword       f_n_rows;
-  uword       f_n_cols;
+  uword       f_n_rows = 0;
+  uword       f_n_cols = 0;
   
   f >> f_header;
   f >> f_n_rows;
   f >> f_n_cols;
   
-  if(f_header == diskio::gen_bin_header(x))
+  if(f_header == diskio::gen_blz_header( diskio::gen_bin_header(x) ))
     {
-    //f.seekg(1, ios::cur);  // NOTE: this may not be portable, as on a Windows machine a newline could be two characters
-    f.get();
-    
     try { x.set_size(f_n_rows,f_n_cols); } catch(...) { err_msg = "not enough memory"; return false; }
     
-    f.read( reinterpret_cast<char *>(x.memptr()), std::streamsize(x.n_elem*sizeof(eT)) );
-    
-    load_okay = f.good();
+    load_okay = diskio::load_blz_blocks(f, x.memptr(), x.n_rows, x.n_cols, err_msg);
     }
   else
     {
@@ -2323,7 +3012,7 @@ diskio::load_arma_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
   
   // allow automatic conversion of u32/s32 matrices into u64/s64 matrices
   
-  if(load_okay == false)
+  if( (load_okay == false) && (err_msg == "incorrect header") )
     {
     if( (sizeof(eT) == 8) && is_same_type<uword,eT>::yes )
       {
@@ -2333,7 +3022,7 @@ diskio::load_arma_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
       f.clear();
       f.seekg(pos);
       
-      load_okay = diskio::load_arma_binary(tmp, f, junk);
+      load_okay = diskio::load_arma_binary_compressed(tmp, f, junk);
       
       if(load_okay)  { x = conv_to< Mat<eT> >::from(tmp); }
       }
@@ -2346,7 +3035,7 @@ diskio::load_arma_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
       f.clear();
       f.seekg(pos);
       
-      load_okay = diskio::load_arma_binary(tmp, f, junk);
+      load_okay = diskio::load_arma_binary_compressed(tmp, f, junk);
       
       if(load_okay)  { x = conv_to< Mat<eT> >::from(tmp); }
       }
@@ -2357,6 +3046,127 @@ diskio::load_arma_binary(Mat<eT>& x, std::istream& f, std::string& err_msg)
 
 
 
+//! Read the elements written by save_blz_blocks() into memory which has room for n_rows*n_cols elements.
+//! The blocks are read in batches, and the blocks of each batch are decompressed in parallel when worthwhile.
+template<typename eT>
+inline
+bool
+diskio::load_blz_blocks(std::istream& f, eT* mem, const uword n_rows, const uword n_cols, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  uword block_n_cols = 0;
+  uword n_blocks     = 0;
+  
+  f >> block_n_cols;
+  f >> n_blocks;
+  
+  //f.seekg(1, ios::cur);  // NOTE: this may not be portable, as on a Windows machine a newline could be two characters
+  f.get();
+  
+  if( f.fail() || (block_n_cols == 0) || (n_blocks != (n_cols + block_n_cols - 1) / block_n_cols) )
+    {
+    err_msg = "incorrect header";
+    return false;
+    }
+  
+  podarray<u64> lengths(n_blocks);
+  
+  f.read( reinterpret_cast<char*>(lengths.memptr()), std::streamsize(n_blocks * sizeof(u64)) );
+  
+  if(f.good() == false)  { return false; }
+  
+  for(uword b=0; b < n_blocks; ++b)
+    {
+    if( (lengths[b] == u64(0)) || (lengths[b] > u64(1 + lz_codec::bound(n_rows * block_n_cols * uword(sizeof(eT))))) )
+      {
+      err_msg = "corrupted data";
+      return false;
+      }
+    }
+  
+  int n_threads = 1;
+  
+  #if defined(ARMA_USE_MP)
+    {
+    if( (n_blocks > 1) && mp_gate<eT>::eval(n_rows * n_cols, 2) )  { n_threads = mp_thread_limit::get(); }
+    }
+  #endif
+  
+  const uword batch_n_blocks = uword(n_threads) * uword(4);
+  
+  podarray<uword> offsets(batch_n_blocks + 1);
+  podarray<uword> status(batch_n_blocks);
+  
+  std::vector<u8> buffer;
+  
+  for(uword batch_start=0; batch_start < n_blocks; batch_start += batch_n_blocks)
+    {
+    const uword batch_end = (std::min)(batch_start + batch_n_blocks, n_blocks);
+    const uword batch_len = batch_end - batch_start;
+    
+    offsets[0] = 0;
+    
+    for(uword i=0; i < batch_len; ++i)  { offsets[i+1] = offsets[i] + uword(lengths[batch_start + i]); }
+    
+    try { buffer.resize(offsets[batch_len]); } catch(...) { err_msg = "not enough memory"; return false; }
+    
+    f.read( reinterpret_cast<char*>(buffer.data()), std::streamsize(offsets[batch_len]) );
+    
+    if(f.good() == false)  { return false; }
+    
+    mp_parallel::run(batch_len, n_threads, [&](const uword i)
+      {
+      const uword b = batch_start + i;
+      
+      const uword col_start    = b * block_n_cols;
+      const uword block_n_elem = n_rows * (std::min)(block_n_cols, n_cols - col_start);
+      const uword n_bytes      = block_n_elem * uword(sizeof(eT));
+      
+      const u8*   src     = buffer.data() + offsets[i];
+      const uword src_len = offsets[i+1] - offsets[i];
+      
+      u8* dest = reinterpret_cast<u8*>(mem + col_start * n_rows);
+      
+      bool ok = false;
+      
+      if(src[0] == u8(0))
+        {
+        ok = ((src_len - 1) == n_bytes);
+        
+        if(ok && (n_bytes > 0))  { std::memcpy(dest, src + 1, size_t(n_bytes)); }
+        }
+      else
+      if(src[0] == u8(1))
+        {
+        try
+          {
+          podarray<u8> shuffled(n_bytes);
+          
+          ok = lz_codec::decompress(shuffled.memptr(), n_bytes, src + 1, src_len - 1);
+          
+          if(ok)  { lz_codec::unshuffle(dest, shuffled.memptr(), block_n_elem, uword(sizeof(eT))); }
+          }
+        catch(...)
+          {
+          ok = false;
+          }
+        }
+      
+      status[i] = ok ? uword(1) : uword(0);
+      } );
+    
+    for(uword i=0; i < batch_len; ++i)
+      {
+      if(status[i] == uword(0))  { err_msg = "corrupted data"; return false; }
+      }
+    }
+  
+  return true;
+  }
+
+
+
 inline
 void
 diskio::pnm_skip_comments(std::istream& f)
@@ -2683,10 +3493,12 @@ diskio::load_auto_detect(Mat<eT>& x, std::istream& f, std::string& err_msg)
   
   const char* ARMA_MAT_TXT_str = "ARMA_MAT_TXT";
   const char* ARMA_MAT_BIN_str = "ARMA_MAT_BIN";
+  const char* ARMA_MAT_BLZ_str = "ARMA_MAT_BLZ";
   const char*           P5_str = "P5";
   
   const uword ARMA_MAT_TXT_len = uword(12);
   const uword ARMA_MAT_BIN_len = uword(12);
+  const uword ARMA_MAT_BLZ_len = uword(12);
   const uword           P5_len = uword(2);
   
   podarray<char> header(ARMA_MAT_TXT_len + 1);
@@ -2711,6 +3523,11 @@ diskio::load_auto_detect(Mat<eT>& x, std::istream& f, std::string& err_msg)
     return load_arma_binary(x, f, err_msg);
     }
   else
+  if( std::strncmp(ARMA_MAT_BLZ_str, header_mem, size_t(ARMA_MAT_BLZ_len)) == 0 )
+    {
+    return load_arma_binary_compressed(x, f, err_msg);
+    }
+  else
   if( std::strncmp(P5_str, header_mem, size_t(P5_len)) == 0 )
     {
     return load_pgm_binary(x, f, err_msg);
@@ -3607,6 +4424,8 @@ diskio::save_raw_ascii(const Cube<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
+  if(diskio::is_plain_stream(f))  { return diskio::save_text_lines(f, x.memptr(), x.n_rows, x.n_cols, x.n_slices, ' ', true); }
+  
   const arma_ostream_state stream_state(f);
   
   const std::streamsize cell_width = diskio::prepare_stream<eT>(f);
@@ -3791,8 +4610,17 @@ diskio::save_arma_binary(const Cube<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  f << diskio::gen_bin_header(x) << '\n';
-  f << x.n_rows << ' ' << x.n_cols << ' ' << x.n_slices << '\n';
+  const std::string header = diskio::gen_bin_header(x);
+  
+  std::ostringstream dims;
+  
+  dims << x.n_rows << ' ' << x.n_cols << ' ' << x.n_slices << '\n';
+  
+  // the padding is skipped when the header is read
+  const uword n_pad = diskio::bin_header_padding( uword(header.length() + 1 + dims.str().length()) );
+  
+  f << header << std::string(n_pad, ' ') << '\n';
+  f << dims.str();
   
   f.write( reinterpret_cast<const char*>(x.mem), std::streamsize(x.n_elem*sizeof(eT)) );
   
@@ -3801,6 +4629,51 @@ diskio::save_arma_binary(const Cube<eT>& x, std::ostream& f)
 
 
 
+//! Save a cube in compressed binary format, with a header that stores the cube type as well as its dimensions;
+//! the slices are stored as consecutive columns
+template<typename eT>
+inline
+bool
+diskio::save_arma_binary_compressed(const Cube<eT>& x, const std::string& final_name)
+  {
+  arma_extra_debug_sigprint();
+  
+  const std::string tmp_name = diskio::gen_tmp_name(final_name);
+  
+  std::ofstream f(tmp_name.c_str(), std::fstream::binary);
+  
+  bool save_okay = f.is_open();
+  
+  if(save_okay)
+    {
+    save_okay = diskio::save_arma_binary_compressed(x, f);
+    
+    f.flush();
+    f.close();
+    
+    if(save_okay)  { save_okay = diskio::safe_rename(tmp_name, final_name); }
+    }
+  
+  return save_okay;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::save_arma_binary_compressed(const Cube<eT>& x, std::ostream& f)
+  {
+  arma_extra_debug_sigprint();
+  
+  f << diskio::gen_blz_header( diskio::gen_bin_header(x) ) << '\n';
+  f << x.n_rows << ' ' << x.n_cols << ' ' << x.n_slices << '\n';
+  
+  return diskio::save_blz_blocks(f, x.mem, x.n_rows, x.n_cols * x.n_slices);
+  }
+
+
+
 //! Save a cube as part of a HDF5 file
 template<typename eT>
 inline
@@ -4238,6 +5111,138 @@ diskio::load_arma_binary(Cube<eT>& x, std::istream& f, std::string& err_msg)
 
 
 
+//! Load a cube in compressed binary format,
+//! with a header that indicates the cube type as well as its dimensions
+template<typename eT>
+inline
+bool
+diskio::load_arma_binary_compressed(Cube<eT>& x, const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::ifstream f;
+  f.open(name.c_str(), std::fstream::binary);
+  
+  bool load_okay = f.is_open();
+  
+  if(load_okay)
+    {
+    load_okay = diskio::load_arma_binary_compressed(x, f, err_msg);
+    f.close();
+    }
+  
+  return load_okay;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+diskio::load_arma_binary_compressed(Cube<eT>& x, std::istream& f, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  std::streampos pos = f.tellg();
+  
+  bool load_okay = true;
+  
+  std::string f_header;
+  uword       f_n_rows   = 0;
+  uword       f_n_cols   = 0;
+  uword       f_n_slices = 0;
+  
+  f >> f_header;
+  f >> f_n_rows;
+  f >> f_n_cols;
+  f >> f_n_slices;
+  
+  if(f_header == diskio::gen_blz_header( diskio::gen_bin_header(x) ))
+    {
+    try { x.set_size(f_n_rows, f_n_cols, f_n_slices); } catch(...) { err_msg = "not enough memory"; return false; }
+    
+    load_okay = diskio::load_blz_blocks(f, x.memptr(), x.n_rows, x.n_cols * x.n_slices, err_msg);
+    }
+  else
+    {
+    load_okay = false;
+    err_msg = "incorrect header";
+    }
+  
+  
+  // allow automatic conversion of u32/s32 cubes into u64/s64 cubes
+  
+  if( (load_okay == false) && (err_msg == "incorrect header") )
+    {
+    if( (sizeof(eT) == 8) && is_same_type<uword,eT>::yes )
+      {
+      Cube<u32>   tmp;
+      std::string junk;
+      
+      f.clear();
+      f.seekg(pos);
+      
+      load_okay = diskio::load_arma_binary_compressed(tmp, f, junk);
+      
+      if(load_okay)  { x = conv_to< Cube<eT> >::from(tmp); }
+      }
+    else
+    if( (sizeof(eT) == 8) && is_same_type<sword,eT>::yes )
+      {
+      Cube<s32>   tmp;
+      std::string junk;
+      
+      f.clear();
+      f.seekg(pos);
+      
+      load_okay = diskio::load_arma_binary_compressed(tmp, f, junk);
+      
+      if(load_okay)  { x = conv_to< Cube<eT> >::from(tmp); }
+      }
+    }
+  
+  return load_okay;
+  }
+
+
+
+//! Read the header of a cube stored in arma_binary format in memory;
+//! offset is set to the location of the first element
+template<typename eT>
+inline
+bool
+diskio::load_arma_binary_header(const Cube<eT>& x, const char* mem, const uword mem_len, uword& offset, uword& n_rows, uword& n_cols, uword& n_slices, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  // the header, including any padding, is much shorter than this
+  std::istringstream f( std::string(mem, size_t( (std::min)(mem_len, uword(512)) )) );
+  
+  std::string f_header;
+  uword       f_n_rows   = 0;
+  uword       f_n_cols   = 0;
+  uword       f_n_slices = 0;
+  
+  f >> f_header;
+  f >> f_n_rows;
+  f >> f_n_cols;
+  f >> f_n_slices;
+  f.get();
+  
+  if( (f.good() == false) || (f_header != diskio::gen_bin_header(x)) )  { err_msg = "incorrect header"; return false; }
+  
+  offset   = uword(f.tellg());
+  n_rows   = f_n_rows;
+  n_cols   = f_n_cols;
+  n_slices = f_n_slices;
+  
+  if( double(offset) + double(n_rows) * double(n_cols) * double(n_slices) * double(sizeof(eT)) > double(mem_len) )  { err_msg = "file is too short"; return false; }
+  
+  return true;
+  }
+
+
+
 //! Load a HDF5 file as a cube
 template<typename eT>
 inline
@@ -4400,10 +5405,12 @@ diskio::load_auto_detect(Cube<eT>& x, std::istream& f, std::string& err_msg)
   
   const char* ARMA_CUB_TXT_str = "ARMA_CUB_TXT";
   const char* ARMA_CUB_BIN_str = "ARMA_CUB_BIN";
+  const char* ARMA_CUB_BLZ_str = "ARMA_CUB_BLZ";
   const char*           P6_str = "P6";
   
   const uword ARMA_CUB_TXT_len = uword(12);
   const uword ARMA_CUB_BIN_len = uword(12);
+  const uword ARMA_CUB_BLZ_len = uword(12);
   const uword           P6_len = uword(2);
   
   podarray<char> header(ARMA_CUB_TXT_len + 1);
@@ -4428,6 +5435,11 @@ diskio::load_auto_detect(Cube<eT>& x, std::istream& f, std::string& err_msg)
     return load_arma_binary(x, f, err_msg);
     }
   else
+  if( std::strncmp(ARMA_CUB_BLZ_str, header_mem, size_t(ARMA_CUB_BLZ_len)) == 0 )
+    {
+    return load_arma_binary_compressed(x, f, err_msg);
+    }
+  else
   if( std::strncmp(P6_str, header_mem, size_t(P6_len)) == 0 )
     {
     return load_ppm_binary(x, f, err_msg);
@@ -52,6 +52,8 @@ class eglue_plus : public eglue_core<eglue_plus>
   public:
   
   inline static const char* text() { return "addition"; }
+  
+  static constexpr uword mp_cost = 1;  //!< estimated CPU cycles per element
   };
 
 
@@ -61,6 +63,8 @@ class eglue_minus : public eglue_core<eglue_minus>
   public:
   
   inline static const char* text() { return "subtraction"; }
+  
+  static constexpr uword mp_cost = 1;
   };
 
 
@@ -70,6 +74,8 @@ class eglue_div : public eglue_core<eglue_div>
   public:
   
   inline static const char* text() { return "element-wise division"; }
+  
+  static constexpr uword mp_cost = 4;
   };
 
 
@@ -79,6 +85,8 @@ class eglue_schur : public eglue_core<eglue_schur>
   public:
   
   inline static const char* text() { return "element-wise multiplication"; }
+  
+  static constexpr uword mp_cost = 1;
   };
 
 
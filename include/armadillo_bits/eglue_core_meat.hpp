@@ -179,16 +179,15 @@
 
 
 
-#if defined(ARMA_USE_OPENMP)
+#if defined(ARMA_USE_MP)
   
   #define arma_applier_1_mp(operatorA, operatorB) \
     {\
     const int n_threads = mp_thread_limit::get();\
-    _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-    for(uword i=0; i<n_elem; ++i)\
+    mp_parallel::run(n_elem, n_threads, [&](const uword i)\
       {\
       out_mem[i] operatorA P1[i] operatorB P2[i];\
-      }\
+      });\
     }
   
   #define arma_applier_2_mp(operatorA, operatorB) \
@@ -196,46 +195,42 @@
     const int n_threads = mp_thread_limit::get();\
     if(n_cols == 1)\
       {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword count=0; count < n_rows; ++count)\
+      mp_parallel::run(n_rows, n_threads, [&](const uword count)\
         {\
         out_mem[count] operatorA P1.at(count,0) operatorB P2.at(count,0);\
-        }\
+        });\
       }\
     else\
     if(n_rows == 1)\
       {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword count=0; count < n_cols; ++count)\
+      mp_parallel::run(n_cols, n_threads, [&](const uword count)\
         {\
         out_mem[count] operatorA P1.at(0,count) operatorB P2.at(0,count);\
-        }\
+        });\
       }\
     else\
       {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword col=0; col<n_cols; ++col)\
+      mp_parallel::run(n_cols, n_threads, [&](const uword col)\
         {\
         for(uword row=0; row<n_rows; ++row)\
           {\
           out.at(row,col) operatorA P1.at(row,col) operatorB P2.at(row,col);\
           }\
-        }\
+        });\
       }\
     }
   
   #define arma_applier_3_mp(operatorA, operatorB) \
     {\
     const int n_threads = mp_thread_limit::get();\
-    _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-    for(uword slice=0; slice<n_slices; ++slice)\
+    mp_parallel::run(n_slices, n_threads, [&](const uword slice)\
       {\
       for(uword col=0; col<n_cols; ++col)\
       for(uword row=0; row<n_rows; ++row)\
         {\
         out.at(row,col,slice) operatorA P1.at(row,col,slice) operatorB P2.at(row,col,slice);\
         }\
-      }\
+      });\
     }
   
 #else
@@ -264,8 +259,9 @@ eglue_core<eglue_type>::apply(outT& out, const eGlue<T1, T2, eglue_type>& x)
   
   typedef typename T1::elem_type eT;
   
-  constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool  use_at  = (Proxy<T1>::use_at || Proxy<T2>::use_at);
+  constexpr bool  use_mp  = (arma_config::mp);
+  constexpr uword mp_cost = mp_expr_cost< eGlue<T1, T2, eglue_type> >::value;
   
   // NOTE: we're assuming that the matrix has already been set to the correct size and there is no aliasing;
   // size setting and alias checking is done by either the Mat contructor or operator=()
@@ -277,7 +273,7 @@ eglue_core<eglue_type>::apply(outT& out, const eGlue<T1, T2, eglue_type>& x)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -334,7 +330,7 @@ eglue_core<eglue_type>::apply(outT& out, const eGlue<T1, T2, eglue_type>& x)
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(=, -); }
@@ -371,14 +367,15 @@ eglue_core<eglue_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, con
   
   eT* out_mem = out.memptr();
   
-  constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool  use_at  = (Proxy<T1>::use_at || Proxy<T2>::use_at);
+  constexpr bool  use_mp  = (arma_config::mp);
+  constexpr uword mp_cost = mp_expr_cost< eGlue<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -432,7 +429,7 @@ eglue_core<eglue_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, con
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(+=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(+=, -); }
@@ -469,14 +466,15 @@ eglue_core<eglue_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, co
   
   eT* out_mem = out.memptr();
   
-  constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool  use_at  = (Proxy<T1>::use_at || Proxy<T2>::use_at);
+  constexpr bool  use_mp  = (arma_config::mp);
+  constexpr uword mp_cost = mp_expr_cost< eGlue<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -530,7 +528,7 @@ eglue_core<eglue_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, co
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(-=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(-=, -); }
@@ -567,14 +565,15 @@ eglue_core<eglue_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, co
   
   eT* out_mem = out.memptr();
   
-  constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool  use_at  = (Proxy<T1>::use_at || Proxy<T2>::use_at);
+  constexpr bool  use_mp  = (arma_config::mp);
+  constexpr uword mp_cost = mp_expr_cost< eGlue<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -628,7 +627,7 @@ eglue_core<eglue_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, co
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(*=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(*=, -); }
@@ -665,14 +664,15 @@ eglue_core<eglue_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, cons
   
   eT* out_mem = out.memptr();
   
-  constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool  use_at  = (Proxy<T1>::use_at || Proxy<T2>::use_at);
+  constexpr bool  use_mp  = (arma_config::mp);
+  constexpr uword mp_cost = mp_expr_cost< eGlue<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -726,7 +726,7 @@ eglue_core<eglue_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, cons
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(/=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(/=, -); }
@@ -761,8 +761,9 @@ eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out, const eGlueCube
   
   typedef typename T1::elem_type eT;
   
-  constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool  use_at  = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
+  constexpr bool  use_mp  = (arma_config::mp);
+  constexpr uword mp_cost = mp_expr_cost< eGlueCube<T1, T2, eglue_type> >::value;
   
   // NOTE: we're assuming that the cube has already been set to the correct size and there is no aliasing;
   // size setting and alias checking is done by either the Cube contructor or operator=()
@@ -774,7 +775,7 @@ eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out, const eGlueCube
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -832,7 +833,7 @@ eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out, const eGlueCube
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(=, -); }
@@ -870,14 +871,15 @@ eglue_core<eglue_type>::apply_inplace_plus(Cube<typename T1::elem_type>& out, co
   
   eT* out_mem = out.memptr();
   
-  constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool  use_at  = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
+  constexpr bool  use_mp  = (arma_config::mp);
+  constexpr uword mp_cost = mp_expr_cost< eGlueCube<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -931,7 +933,7 @@ eglue_core<eglue_type>::apply_inplace_plus(Cube<typename T1::elem_type>& out, co
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(+=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(+=, -); }
@@ -969,14 +971,15 @@ eglue_core<eglue_type>::apply_inplace_minus(Cube<typename T1::elem_type>& out, c
   
   eT* out_mem = out.memptr();
   
-  constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool  use_at  = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
+  constexpr bool  use_mp  = (arma_config::mp);
+  constexpr uword mp_cost = mp_expr_cost< eGlueCube<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -1030,7 +1033,7 @@ eglue_core<eglue_type>::apply_inplace_minus(Cube<typename T1::elem_type>& out, c
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(-=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(-=, -); }
@@ -1068,14 +1071,15 @@ eglue_core<eglue_type>::apply_inplace_schur(Cube<typename T1::elem_type>& out, c
   
   eT* out_mem = out.memptr();
   
-  constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool  use_at  = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
+  constexpr bool  use_mp  = (arma_config::mp);
+  constexpr uword mp_cost = mp_expr_cost< eGlueCube<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -1129,7 +1133,7 @@ eglue_core<eglue_type>::apply_inplace_schur(Cube<typename T1::elem_type>& out, c
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(*=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(*=, -); }
@@ -1167,14 +1171,15 @@ eglue_core<eglue_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, con
   
   eT* out_mem = out.memptr();
   
-  constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool  use_at  = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
+  constexpr bool  use_mp  = (arma_config::mp);
+  constexpr uword mp_cost = mp_expr_cost< eGlueCube<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -1228,7 +1233,7 @@ eglue_core<eglue_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, con
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(/=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(/=, -); }
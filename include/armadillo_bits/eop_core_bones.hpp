@@ -49,59 +49,64 @@ class eop_core
   // common
   
   template<typename eT> arma_inline static eT process(const eT val, const eT k);
+  
+  template<typename expr_type> arma_inline static uword get_mp_cost(const expr_type& x);
   };
 
 
 struct eop_use_mp_true  { static constexpr bool use_mp = true;  };
 struct eop_use_mp_false { static constexpr bool use_mp = false; };
 
+//! estimated cost of an element-wise operation, in CPU cycles per element; used for deciding whether to use OpenMP
+template<uword cost> struct eop_mp_cost { static constexpr uword mp_cost = cost; };
+
 
-class eop_neg               : public eop_core<eop_neg>               , public eop_use_mp_false {};
-class eop_scalar_plus       : public eop_core<eop_scalar_plus>       , public eop_use_mp_false {};
-class eop_scalar_minus_pre  : public eop_core<eop_scalar_minus_pre>  , public eop_use_mp_false {};
-class eop_scalar_minus_post : public eop_core<eop_scalar_minus_post> , public eop_use_mp_false {};
-class eop_scalar_times      : public eop_core<eop_scalar_times>      , public eop_use_mp_false {};
-class eop_scalar_div_pre    : public eop_core<eop_scalar_div_pre>    , public eop_use_mp_false {};
-class eop_scalar_div_post   : public eop_core<eop_scalar_div_post>   , public eop_use_mp_false {};
-class eop_square            : public eop_core<eop_square>            , public eop_use_mp_false {};
-class eop_sqrt              : public eop_core<eop_sqrt>              , public eop_use_mp_true  {};
-class eop_pow               : public eop_core<eop_pow>               , public eop_use_mp_false {};  // for pow(), use_mp is selectively enabled in eop_core_meat.hpp
-class eop_log               : public eop_core<eop_log>               , public eop_use_mp_true  {};
-class eop_log2              : public eop_core<eop_log2>              , public eop_use_mp_true  {};
-class eop_log10             : public eop_core<eop_log10>             , public eop_use_mp_true  {};
-class eop_trunc_log         : public eop_core<eop_trunc_log>         , public eop_use_mp_true  {};
-class eop_log1p             : public eop_core<eop_log1p>             , public eop_use_mp_true  {};
-class eop_exp               : public eop_core<eop_exp>               , public eop_use_mp_true  {};
-class eop_exp2              : public eop_core<eop_exp2>              , public eop_use_mp_true  {};
-class eop_exp10             : public eop_core<eop_exp10>             , public eop_use_mp_true  {};
-class eop_trunc_exp         : public eop_core<eop_trunc_exp>         , public eop_use_mp_true  {};
-class eop_expm1             : public eop_core<eop_expm1>             , public eop_use_mp_true  {};
-class eop_cos               : public eop_core<eop_cos>               , public eop_use_mp_true  {};
-class eop_sin               : public eop_core<eop_sin>               , public eop_use_mp_true  {};
-class eop_tan               : public eop_core<eop_tan>               , public eop_use_mp_true  {};
-class eop_acos              : public eop_core<eop_acos>              , public eop_use_mp_true  {};
-class eop_asin              : public eop_core<eop_asin>              , public eop_use_mp_true  {};
-class eop_atan              : public eop_core<eop_atan>              , public eop_use_mp_true  {};
-class eop_cosh              : public eop_core<eop_cosh>              , public eop_use_mp_true  {};
-class eop_sinh              : public eop_core<eop_sinh>              , public eop_use_mp_true  {};
-class eop_tanh              : public eop_core<eop_tanh>              , public eop_use_mp_true  {};
-class eop_acosh             : public eop_core<eop_acosh>             , public eop_use_mp_true  {};
-class eop_asinh             : public eop_core<eop_asinh>             , public eop_use_mp_true  {};
-class eop_atanh             : public eop_core<eop_atanh>             , public eop_use_mp_true  {};
-class eop_sinc              : public eop_core<eop_sinc>              , public eop_use_mp_true  {};
-class eop_eps               : public eop_core<eop_eps>               , public eop_use_mp_true  {};
-class eop_abs               : public eop_core<eop_abs>               , public eop_use_mp_false {};
-class eop_arg               : public eop_core<eop_arg>               , public eop_use_mp_false {};
-class eop_conj              : public eop_core<eop_conj>              , public eop_use_mp_false {};
-class eop_floor             : public eop_core<eop_floor>             , public eop_use_mp_false {};
-class eop_ceil              : public eop_core<eop_ceil>              , public eop_use_mp_false {};
-class eop_round             : public eop_core<eop_round>             , public eop_use_mp_false {};
-class eop_trunc             : public eop_core<eop_trunc>             , public eop_use_mp_false {};
-class eop_sign              : public eop_core<eop_sign>              , public eop_use_mp_false {};
-class eop_erf               : public eop_core<eop_erf>               , public eop_use_mp_true  {};
-class eop_erfc              : public eop_core<eop_erfc>              , public eop_use_mp_true  {};
-class eop_lgamma            : public eop_core<eop_lgamma>            , public eop_use_mp_true  {};
-class eop_tgamma            : public eop_core<eop_tgamma>            , public eop_use_mp_true  {};
+class eop_neg               : public eop_core<eop_neg>               , public eop_use_mp_false, public eop_mp_cost< 1> {};
+class eop_scalar_plus       : public eop_core<eop_scalar_plus>       , public eop_use_mp_false, public eop_mp_cost< 1> {};
+class eop_scalar_minus_pre  : public eop_core<eop_scalar_minus_pre>  , public eop_use_mp_false, public eop_mp_cost< 1> {};
+class eop_scalar_minus_post : public eop_core<eop_scalar_minus_post> , public eop_use_mp_false, public eop_mp_cost< 1> {};
+class eop_scalar_times      : public eop_core<eop_scalar_times>      , public eop_use_mp_false, public eop_mp_cost< 1> {};
+class eop_scalar_div_pre    : public eop_core<eop_scalar_div_pre>    , public eop_use_mp_false, public eop_mp_cost< 4> {};
+class eop_scalar_div_post   : public eop_core<eop_scalar_div_post>   , public eop_use_mp_false, public eop_mp_cost< 4> {};
+class eop_square            : public eop_core<eop_square>            , public eop_use_mp_false, public eop_mp_cost< 1> {};
+class eop_sqrt              : public eop_core<eop_sqrt>              , public eop_use_mp_true , public eop_mp_cost< 6> {};
+class eop_pow               : public eop_core<eop_pow>               , public eop_use_mp_false, public eop_mp_cost<64> {};  // for pow(), use_mp is selectively enabled in eop_core_meat.hpp
+class eop_log               : public eop_core<eop_log>               , public eop_use_mp_true , public eop_mp_cost<24> {};
+class eop_log2              : public eop_core<eop_log2>              , public eop_use_mp_true , public eop_mp_cost<24> {};
+class eop_log10             : public eop_core<eop_log10>             , public eop_use_mp_true , public eop_mp_cost<24> {};
+class eop_trunc_log         : public eop_core<eop_trunc_log>         , public eop_use_mp_true , public eop_mp_cost<32> {};
+class eop_log1p             : public eop_core<eop_log1p>             , public eop_use_mp_true , public eop_mp_cost<32> {};
+class eop_exp               : public eop_core<eop_exp>               , public eop_use_mp_true , public eop_mp_cost<24> {};
+class eop_exp2              : public eop_core<eop_exp2>              , public eop_use_mp_true , public eop_mp_cost<24> {};
+class eop_exp10             : public eop_core<eop_exp10>             , public eop_use_mp_true , public eop_mp_cost<32> {};
+class eop_trunc_exp         : public eop_core<eop_trunc_exp>         , public eop_use_mp_true , public eop_mp_cost<32> {};
+class eop_expm1             : public eop_core<eop_expm1>             , public eop_use_mp_true , public eop_mp_cost<32> {};
+class eop_cos               : public eop_core<eop_cos>               , public eop_use_mp_true , public eop_mp_cost<24> {};
+class eop_sin               : public eop_core<eop_sin>               , public eop_use_mp_true , public eop_mp_cost<24> {};
+class eop_tan               : public eop_core<eop_tan>               , public eop_use_mp_true , public eop_mp_cost<40> {};
+class eop_acos              : public eop_core<eop_acos>              , public eop_use_mp_true , public eop_mp_cost<40> {};
+class eop_asin              : public eop_core<eop_asin>              , public eop_use_mp_true , public eop_mp_cost<40> {};
+class eop_atan              : public eop_core<eop_atan>              , public eop_use_mp_true , public eop_mp_cost<40> {};
+class eop_cosh              : public eop_core<eop_cosh>              , public eop_use_mp_true , public eop_mp_cost<40> {};
+class eop_sinh              : public eop_core<eop_sinh>              , public eop_use_mp_true , public eop_mp_cost<40> {};
+class eop_tanh              : public eop_core<eop_tanh>              , public eop_use_mp_true , public eop_mp_cost<40> {};
+class eop_acosh             : public eop_core<eop_acosh>             , public eop_use_mp_true , public eop_mp_cost<48> {};
+class eop_asinh             : public eop_core<eop_asinh>             , public eop_use_mp_true , public eop_mp_cost<48> {};
+class eop_atanh             : public eop_core<eop_atanh>             , public eop_use_mp_true , public eop_mp_cost<48> {};
+class eop_sinc              : public eop_core<eop_sinc>              , public eop_use_mp_true , public eop_mp_cost<32> {};
+class eop_eps               : public eop_core<eop_eps>               , public eop_use_mp_true , public eop_mp_cost<16> {};
+class eop_abs               : public eop_core<eop_abs>               , public eop_use_mp_false, public eop_mp_cost< 1> {};
+class eop_arg               : public eop_core<eop_arg>               , public eop_use_mp_false, public eop_mp_cost< 4> {};
+class eop_conj              : public eop_core<eop_conj>              , public eop_use_mp_false, public eop_mp_cost< 1> {};
+class eop_floor             : public eop_core<eop_floor>             , public eop_use_mp_false, public eop_mp_cost< 2> {};
+class eop_ceil              : public eop_core<eop_ceil>              , public eop_use_mp_false, public eop_mp_cost< 2> {};
+class eop_round             : public eop_core<eop_round>             , public eop_use_mp_false, public eop_mp_cost< 4> {};
+class eop_trunc             : public eop_core<eop_trunc>             , public eop_use_mp_false, public eop_mp_cost< 2> {};
+class eop_sign              : public eop_core<eop_sign>              , public eop_use_mp_false, public eop_mp_cost< 2> {};
+class eop_erf               : public eop_core<eop_erf>               , public eop_use_mp_true , public eop_mp_cost<40> {};
+class eop_erfc              : public eop_core<eop_erfc>              , public eop_use_mp_true , public eop_mp_cost<40> {};
+class eop_lgamma            : public eop_core<eop_lgamma>            , public eop_use_mp_true , public eop_mp_cost<80> {};
+class eop_tgamma            : public eop_core<eop_tgamma>            , public eop_use_mp_true , public eop_mp_cost<80> {};
 
 
 
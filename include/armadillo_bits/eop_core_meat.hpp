@@ -165,16 +165,15 @@
 
 
 
-#if defined(ARMA_USE_OPENMP)
+#if defined(ARMA_USE_MP)
   
   #define arma_applier_1_mp(operatorA) \
     {\
     const int n_threads = mp_thread_limit::get();\
-    _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-    for(uword i=0; i<n_elem; ++i)\
+    mp_parallel::run(n_elem, n_threads, [&](const uword i)\
       {\
       out_mem[i] operatorA eop_core<eop_type>::process(P[i], k);\
-      }\
+      });\
     }
   
   #define arma_applier_2_mp(operatorA) \
@@ -182,46 +181,42 @@
     const int n_threads = mp_thread_limit::get();\
     if(n_cols == 1)\
       {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword count=0; count < n_rows; ++count)\
+      mp_parallel::run(n_rows, n_threads, [&](const uword count)\
         {\
         out_mem[count] operatorA eop_core<eop_type>::process(P.at(count,0), k);\
-        }\
+        });\
       }\
     else\
     if(n_rows == 1)\
       {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword count=0; count < n_cols; ++count)\
+      mp_parallel::run(n_cols, n_threads, [&](const uword count)\
         {\
         out_mem[count] operatorA eop_core<eop_type>::process(P.at(0,count), k);\
-        }\
+        });\
       }\
     else\
       {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword col=0; col < n_cols; ++col)\
+      mp_parallel::run(n_cols, n_threads, [&](const uword col)\
         {\
         for(uword row=0; row < n_rows; ++row)\
           {\
           out.at(row,col) operatorA eop_core<eop_type>::process(P.at(row,col), k);\
           }\
-        }\
+        });\
       }\
     }
   
   #define arma_applier_3_mp(operatorA) \
     {\
     const int n_threads = mp_thread_limit::get();\
-    _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-    for(uword slice=0; slice<n_slices; ++slice)\
+    mp_parallel::run(n_slices, n_threads, [&](const uword slice)\
       {\
       for(uword col=0; col<n_cols; ++col)\
       for(uword row=0; row<n_rows; ++row)\
         {\
         out.at(row,col,slice) operatorA eop_core<eop_type>::process(P.at(row,col,slice), k);\
         }\
-      }\
+      });\
     }
 
 #else
@@ -256,13 +251,26 @@ eop_core<eop_type>::apply(outT& out, const eOp<T1, eop_type>& x)
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool  use_mp  = (arma_config::mp);
+  const uword mp_cost = eop_core<eop_type>::get_mp_cost(x);
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    #if defined(ARMA_USE_VECMATH)
+      {
+      if(vecmath_op<eop_type, eT>::value)
+        {
+        // the SIMD kernels are several times faster than the scalar functions
+        vecmath::apply<eop_type>(out_mem, x.P.get_ea(), n_elem, (use_mp && mp_gate<eT>::eval(n_elem, mp_cost/4)));
+        
+        return;
+        }
+      }
+    #endif
+    
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
@@ -302,7 +310,7 @@ eop_core<eop_type>::apply(outT& out, const eOp<T1, eop_type>& x)
     
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
       arma_applier_2_mp(=);
       }
@@ -334,13 +342,14 @@ eop_core<eop_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, const e
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool  use_mp  = (arma_config::mp);
+  const uword mp_cost = eop_core<eop_type>::get_mp_cost(x);
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
@@ -377,7 +386,7 @@ eop_core<eop_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, const e
     {
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
       arma_applier_2_mp(+=);
       }
@@ -409,13 +418,14 @@ eop_core<eop_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool  use_mp  = (arma_config::mp);
+  const uword mp_cost = eop_core<eop_type>::get_mp_cost(x);
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
@@ -452,7 +462,7 @@ eop_core<eop_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, const
     {
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
       arma_applier_2_mp(-=);
       }
@@ -484,13 +494,14 @@ eop_core<eop_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool  use_mp  = (arma_config::mp);
+  const uword mp_cost = eop_core<eop_type>::get_mp_cost(x);
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
@@ -527,7 +538,7 @@ eop_core<eop_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, const
     {
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
       arma_applier_2_mp(*=);
       }
@@ -559,13 +570,14 @@ eop_core<eop_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, const eO
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool  use_mp  = (arma_config::mp);
+  const uword mp_cost = eop_core<eop_type>::get_mp_cost(x);
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
@@ -602,7 +614,7 @@ eop_core<eop_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, const eO
     {
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
       arma_applier_2_mp(/=);
       }
@@ -637,13 +649,26 @@ eop_core<eop_type>::apply(Cube<typename T1::elem_type>& out, const eOpCube<T1, e
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool  use_mp  = (arma_config::mp);
+  const uword mp_cost = eop_core<eop_type>::get_mp_cost(x);
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    #if defined(ARMA_USE_VECMATH)
+      {
+      if(vecmath_op<eop_type, eT>::value)
+        {
+        // the SIMD kernels are several times faster than the scalar functions
+        vecmath::apply<eop_type>(out_mem, x.P.get_ea(), n_elem, (use_mp && mp_gate<eT>::eval(n_elem, mp_cost/4)));
+        
+        return;
+        }
+      }
+    #endif
+    
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
@@ -684,7 +709,7 @@ eop_core<eop_type>::apply(Cube<typename T1::elem_type>& out, const eOpCube<T1, e
     
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
       arma_applier_3_mp(=);
       }
@@ -717,13 +742,14 @@ eop_core<eop_type>::apply_inplace_plus(Cube<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool  use_mp  = (arma_config::mp);
+  const uword mp_cost = eop_core<eop_type>::get_mp_cost(x);
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
@@ -760,7 +786,7 @@ eop_core<eop_type>::apply_inplace_plus(Cube<typename T1::elem_type>& out, const
     {
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
       arma_applier_3_mp(+=);
       }
@@ -793,13 +819,14 @@ eop_core<eop_type>::apply_inplace_minus(Cube<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool  use_mp  = (arma_config::mp);
+  const uword mp_cost = eop_core<eop_type>::get_mp_cost(x);
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
       
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
@@ -836,7 +863,7 @@ eop_core<eop_type>::apply_inplace_minus(Cube<typename T1::elem_type>& out, const
     {
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
       arma_applier_3_mp(-=);
       }
@@ -869,13 +896,14 @@ eop_core<eop_type>::apply_inplace_schur(Cube<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool  use_mp  = (arma_config::mp);
+  const uword mp_cost = eop_core<eop_type>::get_mp_cost(x);
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
@@ -912,7 +940,7 @@ eop_core<eop_type>::apply_inplace_schur(Cube<typename T1::elem_type>& out, const
     {
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
       arma_applier_3_mp(*=);
       }
@@ -945,13 +973,14 @@ eop_core<eop_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, const e
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool  use_mp  = (arma_config::mp);
+  const uword mp_cost = eop_core<eop_type>::get_mp_cost(x);
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT>::eval(n_elem, mp_cost))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
@@ -988,7 +1017,7 @@ eop_core<eop_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, const e
     {
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT>::eval(x.get_n_elem(), mp_cost))
       {
       arma_applier_3_mp(/=);
       }
@@ -1006,6 +1035,25 @@ eop_core<eop_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, const e
 
 
 
+template<typename eop_type>
+template<typename expr_type>
+arma_inline
+uword
+eop_core<eop_type>::get_mp_cost(const expr_type& x)
+  {
+  typedef typename expr_type::elem_type eT;
+  
+  // pow(X,2) is evaluated as a square
+  if(is_same_type<eop_type, eop_pow>::yes && is_cx<eT>::no && (x.aux == eT(2)))
+    {
+    return mp_expr_cost<expr_type>::value - eop_pow::mp_cost + eop_square::mp_cost;
+    }
+  
+  return mp_expr_cost<expr_type>::value;
+  }
+
+
+
 template<typename eop_type>
 template<typename eT>
 arma_inline
@@ -37,9 +37,9 @@ accu_proxy_linear(const Proxy<T1>& P)
   
   const uword n_elem = P.get_n_elem();
   
-  if( arma_config::openmp && Proxy<T1>::use_mp && mp_gate<eT>::eval(n_elem) )
+  if( arma_config::mp && Proxy<T1>::use_mp && mp_gate<eT>::eval(n_elem, mp_expr_cost<T1>::value + 1) )
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       // NOTE: using parallelisation with manual reduction workaround to take into account complex numbers;
       // NOTE: OpenMP versions lower than 4.0 do not support user-defined reduction
@@ -50,8 +50,7 @@ accu_proxy_linear(const Proxy<T1>& P)
       
       podarray<eT> partial_accs(n_threads_use);
       
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads_use))
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)
+      mp_parallel::run(n_threads_use, int(n_threads_use), [&](const uword thread_id)
         {
         const uword start = (thread_id+0) * chunk_size;
         const uword endp1 = (thread_id+1) * chunk_size;
@@ -60,7 +59,7 @@ accu_proxy_linear(const Proxy<T1>& P)
         for(uword i=start; i < endp1; ++i)  { acc += Pea[i]; }
         
         partial_accs[thread_id] = acc;
-        }
+        });
       
       for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
       
@@ -115,7 +114,7 @@ accu_proxy_at_mp(const Proxy<T1>& P)
   
   eT val = eT(0);
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_MP)
     {
     const uword n_rows = P.get_n_rows();
     const uword n_cols = P.get_n_cols();
@@ -128,8 +127,7 @@ accu_proxy_at_mp(const Proxy<T1>& P)
       
       podarray<eT> partial_accs(n_threads_use);
       
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads_use))
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)
+      mp_parallel::run(n_threads_use, int(n_threads_use), [&](const uword thread_id)
         {
         const uword start = (thread_id+0) * chunk_size;
         const uword endp1 = (thread_id+1) * chunk_size;
@@ -138,7 +136,7 @@ accu_proxy_at_mp(const Proxy<T1>& P)
         for(uword i=start; i < endp1; ++i)  { acc += P.at(i,0); }
         
         partial_accs[thread_id] = acc;
-        }
+        });
       
       for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
       
@@ -153,8 +151,7 @@ accu_proxy_at_mp(const Proxy<T1>& P)
       
       podarray<eT> partial_accs(n_threads_use);
       
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads_use))
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)
+      mp_parallel::run(n_threads_use, int(n_threads_use), [&](const uword thread_id)
         {
         const uword start = (thread_id+0) * chunk_size;
         const uword endp1 = (thread_id+1) * chunk_size;
@@ -163,7 +160,7 @@ accu_proxy_at_mp(const Proxy<T1>& P)
         for(uword i=start; i < endp1; ++i)  { acc += P.at(0,i); }
         
         partial_accs[thread_id] = acc;
-        }
+        });
       
       for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
       
@@ -175,8 +172,7 @@ accu_proxy_at_mp(const Proxy<T1>& P)
       
       const int n_threads = mp_thread_limit::get();
       
-      #pragma omp parallel for schedule(static) num_threads(n_threads)
-      for(uword col=0; col < n_cols; ++col)
+      mp_parallel::run(n_cols, n_threads, [&](const uword col)
         {
         eT val1 = eT(0);
         eT val2 = eT(0);
@@ -187,7 +183,7 @@ accu_proxy_at_mp(const Proxy<T1>& P)
         if(i < n_rows)  { val1 += P.at(i,col); }
         
         col_accs[col] = val1 + val2;
-        }
+        });
       
       val = arrayops::accumulate(col_accs.memptr(), n_cols);
       }
@@ -213,7 +209,7 @@ accu_proxy_at(const Proxy<T1>& P)
   
   typedef typename T1::elem_type eT;
   
-  if(arma_config::openmp && Proxy<T1>::use_mp && mp_gate<eT>::eval(P.get_n_elem()))
+  if(arma_config::mp && Proxy<T1>::use_mp && mp_gate<eT>::eval(P.get_n_elem(), mp_expr_cost<T1>::value + 1))
     {
     return accu_proxy_at_mp(P);
     }
@@ -610,9 +606,9 @@ accu_cube_proxy_linear(const ProxyCube<T1>& P)
   
   const uword n_elem = P.get_n_elem();
   
-  if( arma_config::openmp && ProxyCube<T1>::use_mp && mp_gate<eT>::eval(n_elem) )
+  if( arma_config::mp && ProxyCube<T1>::use_mp && mp_gate<eT>::eval(n_elem, mp_expr_cost<T1>::value + 1) )
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       // NOTE: using parallelisation with manual reduction workaround to take into account complex numbers;
       // NOTE: OpenMP versions lower than 4.0 do not support user-defined reduction
@@ -623,8 +619,7 @@ accu_cube_proxy_linear(const ProxyCube<T1>& P)
       
       podarray<eT> partial_accs(n_threads_use);
       
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads_use))
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)
+      mp_parallel::run(n_threads_use, int(n_threads_use), [&](const uword thread_id)
         {
         const uword start = (thread_id+0) * chunk_size;
         const uword endp1 = (thread_id+1) * chunk_size;
@@ -633,7 +628,7 @@ accu_cube_proxy_linear(const ProxyCube<T1>& P)
         for(uword i=start; i < endp1; ++i)  { acc += Pea[i]; }
         
         partial_accs[thread_id] = acc;
-        }
+        });
       
       for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
       
@@ -688,7 +683,7 @@ accu_cube_proxy_at_mp(const ProxyCube<T1>& P)
   
   eT val = eT(0);
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_MP)
     {
     const uword n_rows   = P.get_n_rows();
     const uword n_cols   = P.get_n_cols();
@@ -698,8 +693,7 @@ accu_cube_proxy_at_mp(const ProxyCube<T1>& P)
     
     const int n_threads = mp_thread_limit::get();
     
-    #pragma omp parallel for schedule(static) num_threads(n_threads)
-    for(uword slice = 0; slice < n_slices; ++slice)
+    mp_parallel::run(n_slices, n_threads, [&](const uword slice)
       {
       eT val1 = eT(0);
       eT val2 = eT(0);
@@ -713,7 +707,7 @@ accu_cube_proxy_at_mp(const ProxyCube<T1>& P)
         }
       
       slice_accs[slice] = val1 + val2;
-      }
+      });
     
     val = arrayops::accumulate(slice_accs.memptr(), slice_accs.n_elem);
     }
@@ -738,7 +732,7 @@ accu_cube_proxy_at(const ProxyCube<T1>& P)
   
   typedef typename T1::elem_type eT;
   
-  if(arma_config::openmp && ProxyCube<T1>::use_mp && mp_gate<eT>::eval(P.get_n_elem()))
+  if(arma_config::mp && ProxyCube<T1>::use_mp && mp_gate<eT>::eval(P.get_n_elem(), mp_expr_cost<T1>::value + 1))
     {
     return accu_cube_proxy_at_mp(P);
     }
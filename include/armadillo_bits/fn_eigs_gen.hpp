@@ -422,4 +422,74 @@ eigs_gen
 
 
 
+//! eigenvalues of general real operator of size n x n, given as a function;
+//! fn(y,x) must evaluate y = A*x, where x and y are column vectors of length n;
+//! y must not be resized by fn
+template<typename T, typename fn_type>
+inline
+typename enable_if2< is_real<T>::value && (is_arma_type<fn_type>::value == false) && (is_arma_sparse_type<fn_type>::value == false), bool >::result
+eigs_gen
+  (
+         Col< std::complex<T> >& eigval,
+  const  fn_type&                fn,
+  const  uword                   n,
+  const  uword                   n_eigvals,
+  const  char*                   form = "lm",
+  const  eigs_opts               opts = eigs_opts()
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  Mat< std::complex<T> > eigvec;
+  
+  sp_auxlib::form_type form_val = sp_auxlib::interpret_form_str(form);
+  
+  const bool status = sp_auxlib::eigs_gen_fn(eigval, eigvec, fn, n, n_eigvals, form_val, opts);
+  
+  if(status == false)
+    {
+    eigval.soft_reset();
+    arma_debug_warn_level(3, "eigs_gen(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! eigenvalues and eigenvectors of general real operator of size n x n, given as a function
+template<typename T, typename fn_type>
+inline
+typename enable_if2< is_real<T>::value && (is_arma_type<fn_type>::value == false) && (is_arma_sparse_type<fn_type>::value == false), bool >::result
+eigs_gen
+  (
+         Col< std::complex<T> >& eigval,
+         Mat< std::complex<T> >& eigvec,
+  const  fn_type&                fn,
+  const  uword                   n,
+  const  uword                   n_eigvals,
+  const  char*                   form = "lm",
+  const  eigs_opts               opts = eigs_opts()
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( void_ptr(&eigval) == void_ptr(&eigvec), "eigs_gen(): parameter 'eigval' is an alias of parameter 'eigvec'" );
+  
+  sp_auxlib::form_type form_val = sp_auxlib::interpret_form_str(form);
+  
+  const bool status = sp_auxlib::eigs_gen_fn(eigval, eigvec, fn, n, n_eigvals, form_val, opts);
+  
+  if(status == false)
+    {
+    eigval.soft_reset();
+    eigvec.soft_reset();
+    arma_debug_warn_level(3, "eigs_gen(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
 //! @}
@@ -287,4 +287,141 @@ eigs_sym
 
 
 
+//! eigenvalues of symmetric real operator of size n x n, given as a function;
+//! fn(y,x) must evaluate y = A*x, where x and y are column vectors of length n;
+//! y must not be resized by fn
+template<typename eT, typename fn_type>
+inline
+typename enable_if2< is_real<eT>::value && (is_arma_type<fn_type>::value == false) && (is_arma_sparse_type<fn_type>::value == false), bool >::result
+eigs_sym
+  (
+           Col<eT>&  eigval,
+  const    fn_type&  fn,
+  const    uword     n,
+  const    uword     n_eigvals,
+  const    char*     form = "lm",
+  const eigs_opts    opts = eigs_opts()
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  Mat<eT> eigvec;
+  
+  sp_auxlib::form_type form_val = sp_auxlib::interpret_form_str(form);
+  
+  const bool status = sp_auxlib::eigs_sym_fn(eigval, eigvec, fn, n, n_eigvals, form_val, opts);
+  
+  if(status == false)
+    {
+    eigval.soft_reset();
+    arma_debug_warn_level(3, "eigs_sym(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! eigenvalues of symmetric real operator A of size n x n, nearest to sigma;
+//! solve_fn(y,x) must evaluate y = inv(A - sigma*I)*x, where x and y are column vectors of length n;
+//! y must not be resized by solve_fn
+template<typename eT, typename fn_type>
+inline
+typename enable_if2< is_real<eT>::value && (is_arma_type<fn_type>::value == false) && (is_arma_sparse_type<fn_type>::value == false), bool >::result
+eigs_sym
+  (
+           Col<eT>&  eigval,
+  const    fn_type&  solve_fn,
+  const    uword     n,
+  const    uword     n_eigvals,
+  const    double    sigma,
+  const eigs_opts    opts = eigs_opts()
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  Mat<eT> eigvec;
+  
+  const bool status = sp_auxlib::eigs_sym_fn(eigval, eigvec, solve_fn, n, n_eigvals, eT(sigma), opts);
+  
+  if(status == false)
+    {
+    eigval.soft_reset();
+    arma_debug_warn_level(3, "eigs_sym(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! eigenvalues and eigenvectors of symmetric real operator of size n x n, given as a function
+template<typename eT, typename fn_type>
+inline
+typename enable_if2< is_real<eT>::value && (is_arma_type<fn_type>::value == false) && (is_arma_sparse_type<fn_type>::value == false), bool >::result
+eigs_sym
+  (
+           Col<eT>&  eigval,
+           Mat<eT>&  eigvec,
+  const    fn_type&  fn,
+  const    uword     n,
+  const    uword     n_eigvals,
+  const    char*     form = "lm",
+  const eigs_opts    opts = eigs_opts()
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( void_ptr(&eigval) == void_ptr(&eigvec), "eigs_sym(): parameter 'eigval' is an alias of parameter 'eigvec'" );
+  
+  sp_auxlib::form_type form_val = sp_auxlib::interpret_form_str(form);
+  
+  const bool status = sp_auxlib::eigs_sym_fn(eigval, eigvec, fn, n, n_eigvals, form_val, opts);
+  
+  if(status == false)
+    {
+    eigval.soft_reset();
+    eigvec.soft_reset();
+    arma_debug_warn_level(3, "eigs_sym(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! eigenvalues and eigenvectors of symmetric real operator A of size n x n, nearest to sigma;
+//! solve_fn(y,x) must evaluate y = inv(A - sigma*I)*x
+template<typename eT, typename fn_type>
+inline
+typename enable_if2< is_real<eT>::value && (is_arma_type<fn_type>::value == false) && (is_arma_sparse_type<fn_type>::value == false), bool >::result
+eigs_sym
+  (
+           Col<eT>&  eigval,
+           Mat<eT>&  eigvec,
+  const    fn_type&  solve_fn,
+  const    uword     n,
+  const    uword     n_eigvals,
+  const    double    sigma,
+  const eigs_opts    opts = eigs_opts()
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( void_ptr(&eigval) == void_ptr(&eigvec), "eigs_sym(): parameter 'eigval' is an alias of parameter 'eigvec'" );
+  
+  const bool status = sp_auxlib::eigs_sym_fn(eigval, eigvec, solve_fn, n, n_eigvals, eT(sigma), opts);
+  
+  if(status == false)
+    {
+    eigval.soft_reset();
+    eigvec.soft_reset();
+    arma_debug_warn_level(3, "eigs_sym(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
 //! @}
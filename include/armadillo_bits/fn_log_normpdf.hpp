@@ -57,22 +57,21 @@ log_normpdf_helper(Mat<typename T1::elem_type>& out, const Base<typename T1::ele
   typename Proxy<T2>::ea_type M_ea = PM.get_ea();
   typename Proxy<T3>::ea_type S_ea = PS.get_ea();
   
-  const bool use_mp = arma_config::openmp && mp_gate<eT,true>::eval(N);
+  const bool use_mp = arma_config::mp && mp_gate<eT,true>::eval(N);
   
   if(use_mp)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       const int n_threads = mp_thread_limit::get();
-      #pragma omp parallel for schedule(static) num_threads(n_threads)
-      for(uword i=0; i<N; ++i)
+      mp_parallel::run(N, n_threads, [&](const uword i)
         {
         const eT sigma = S_ea[i];
         
         const eT tmp = (X_ea[i] - M_ea[i]) / sigma;
         
         out_mem[i] = (eT(-0.5) * (tmp*tmp)) - (std::log(sigma) + Datum<eT>::log_sqrt2pi);
-        }
+        });
       }
     #endif
     }
@@ -142,4 +142,19 @@ mean(const T1& x, const uword dim)
 
 
 
+template<typename eT>
+arma_warn_unused
+inline
+SpMat<eT>
+mean(const SpMat_csr<eT>& X, const uword dim = 0)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( (dim > 1), "mean(): parameter 'dim' must be 0 or 1" );
+  
+  return SpMat<eT>( mean(X.st(), ((dim == 0) ? uword(1) : uword(0))).st() );
+  }
+
+
+
 //! @}
@@ -92,6 +92,34 @@ normalise
 
 
 
+template<typename eT>
+arma_warn_unused
+inline
+SpMat_csr<eT>
+normalise
+  (
+  const SpMat_csr<eT>& X,
+  const uword p = uword(2),
+  const uword dim = 0,
+  const typename arma_real_or_cx_only<eT>::result* junk = nullptr
+  )
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  arma_debug_check( (dim > 1), "normalise(): parameter 'dim' must be 0 or 1" );
+  
+  SpMat<eT> tmp = normalise(X.st(), p, ((dim == 0) ? uword(1) : uword(0)));
+  
+  SpMat_csr<eT> out;
+  
+  out.steal_st(tmp);
+  
+  return out;
+  }
+
+
+
 //! for compatibility purposes: allows compiling user code designed for earlier versions of Armadillo
 template<typename T>
 arma_warn_unused
@@ -57,20 +57,19 @@ normcdf_helper(Mat<typename T1::elem_type>& out, const Base<typename T1::elem_ty
   typename Proxy<T2>::ea_type M_ea = PM.get_ea();
   typename Proxy<T3>::ea_type S_ea = PS.get_ea();
   
-  const bool use_mp = arma_config::openmp && mp_gate<eT,true>::eval(N);
+  const bool use_mp = arma_config::mp && mp_gate<eT,true>::eval(N);
   
   if(use_mp)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       const int n_threads = mp_thread_limit::get();
-      #pragma omp parallel for schedule(static) num_threads(n_threads)
-      for(uword i=0; i<N; ++i)
+      mp_parallel::run(N, n_threads, [&](const uword i)
         {
         const eT tmp = (X_ea[i] - M_ea[i]) / (S_ea[i] * (-Datum<eT>::sqrt2));
         
         out_mem[i] = eT(0.5) * std::erfc(tmp);
-        }
+        });
       }
     #endif
     }
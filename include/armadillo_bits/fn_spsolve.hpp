@@ -43,7 +43,30 @@ spsolve_helper
   
   const char sig = (solver != nullptr) ? solver[0] : char(0);
   
-  arma_debug_check( ((sig != 'l') && (sig != 's')), "spsolve(): unknown solver" );
+  arma_debug_check( ((sig != 'l') && (sig != 's') && (sig != 'c') && (sig != 'b') && (sig != 'g')), "spsolve(): unknown solver" );
+  
+  if( (sig == 'c') || (sig == 'b') || (sig == 'g') )  // built-in iterative solvers
+    {
+    if( (settings.id != 0) && (settings.id != 2) )
+      {
+      arma_debug_warn_level(1, "spsolve(): ignoring settings not applicable to iterative solver");
+      }
+    
+    const spsolve_opts  iter_opts_default;
+    const spsolve_opts& iter_opts = (settings.id == 2) ? static_cast<const spsolve_opts&>(settings) : iter_opts_default;
+    
+    const unwrap_spmat<T1> UA(A.get_ref());
+    const quasi_unwrap<T2> UB(B.get_ref());
+    
+    // the solution is formed separately from out, so B can alias out
+    
+    return sp_krylov::solve(out, UA.M, UB.M, sig, iter_opts);
+    }
+  
+  if(settings.id == 2)
+    {
+    arma_debug_warn_level(1, "spsolve(): ignoring settings only applicable to iterative solvers");
+    }
   
   T rcond = T(0);
   
@@ -144,4 +144,20 @@ sum(const T1& x, const uword dim)
 
 
 
+//! sum of CSR sparse matrix; the sums along rows (dim = 1) are formed from contiguous memory
+template<typename eT>
+arma_warn_unused
+inline
+SpMat<eT>
+sum(const SpMat_csr<eT>& X, const uword dim = 0)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( (dim > 1), "sum(): parameter 'dim' must be 0 or 1" );
+  
+  return SpMat<eT>( sum(X.st(), ((dim == 0) ? uword(1) : uword(0))).st() );
+  }
+
+
+
 //! @}
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup fn_svd_rand
+//! @{
+
+
+
+//! randomised truncated SVD (Halko, Martinsson, Tropp, 2011);
+//! A can be a dense or sparse matrix; the cost is dominated by products of A with tall dense blocks
+template<typename eT, typename MatType>
+inline
+bool
+svd_rand_helper
+  (
+        Mat<eT>&                                U,
+        Col<typename get_pod_type<eT>::result>& S,
+        Mat<eT>&                                V,
+  const MatType&                                A,
+  const uword                                   k,
+  const svd_rand_opts&                          opts,
+  const bool                                    calc_UV
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword min_mn = (std::min)(A.n_rows, A.n_cols);
+  
+  const uword kk = (std::min)(min_mn, k);
+  
+  if(kk == 0)
+    {
+    U.set_size(A.n_rows, 0);
+    S.set_size(0);
+    V.set_size(A.n_cols, 0);
+    
+    return true;
+    }
+  
+  // width of the sketch
+  const uword l = (std::min)(min_mn, kk + uword(opts.oversample));
+  
+  Mat<eT> Q;
+  Mat<eT> R;
+  
+  // range finder: Q is an orthonormal basis for the range of A*Omega
+  Mat<eT> Y = A * randn< Mat<eT> >(A.n_cols, l);
+  
+  if(auxlib::qr_econ(Q, R, Y) == false)  { return false; }
+  
+  // power iterations sharpen the decay of the singular values;
+  // re-orthonormalising after each product keeps the small singular directions from being lost to rounding
+  for(uword iter=0; iter < uword(opts.power_iter); ++iter)
+    {
+    // Z = A' * Q, computed as (Q' * A)' so that sparse A is not transposed
+    Y = (Q.t() * A).t();
+    
+    if(auxlib::qr_econ(Q, R, Y) == false)  { return false; }
+    
+    Y = A * Q;
+    
+    if(auxlib::qr_econ(Q, R, Y) == false)  { return false; }
+    }
+  
+  // project A onto the basis and decompose the small l x n matrix
+  Mat<eT> BB = Q.t() * A;
+  
+  if(BB.is_finite() == false)  { return false; }
+  
+  if(calc_UV)
+    {
+    Mat<eT> UB;
+    Mat<eT> VB;
+    
+    if(auxlib::svd_dc_econ(UB, S, VB, BB) == false)  { return false; }
+    
+    U = Q * UB.head_cols(kk);
+    V = VB.head_cols(kk);
+    }
+  else
+    {
+    if(auxlib::svd_dc(S, BB) == false)  { return false; }
+    }
+  
+  S = S.head(kk);
+  
+  return true;
+  }
+
+
+
+//! find the k largest singular values and corresponding singular vectors of X, using a randomised method
+template<typename T1>
+inline
+bool
+svd_rand
+  (
+         Mat<typename T1::elem_type>&    U,
+         Col<typename T1::pod_type >&    S,
+         Mat<typename T1::elem_type>&    V,
+  const Base<typename T1::elem_type,T1>& X,
+  const uword                            k,
+  const svd_rand_opts&                   opts = svd_rand_opts(),
+  const typename arma_blas_type_only<typename T1::elem_type>::result* junk = nullptr
+  )
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  arma_debug_check
+    (
+    ( ((void*)(&U) == (void*)(&S)) || (&U == &V) || ((void*)(&S) == (void*)(&V)) ),
+    "svd_rand(): two or more output objects are the same object"
+    );
+  
+  const quasi_unwrap<T1> UA(X.get_ref());
+  
+  const bool status = svd_rand_helper(U, S, V, UA.M, k, opts, true);
+  
+  if(status == false)
+    {
+    U.soft_reset();
+    S.soft_reset();
+    V.soft_reset();
+    arma_debug_warn_level(3, "svd_rand(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! find the k largest singular values of X, using a randomised method
+template<typename T1>
+inline
+bool
+svd_rand
+  (
+         Col<typename T1::pod_type >&    S,
+  const Base<typename T1::elem_type,T1>& X,
+  const uword                            k,
+  const svd_rand_opts&                   opts = svd_rand_opts(),
+  const typename arma_blas_type_only<typename T1::elem_type>::result* junk = nullptr
+  )
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename T1::elem_type eT;
+  
+  Mat<eT> U;
+  Mat<eT> V;
+  
+  const quasi_unwrap<T1> UA(X.get_ref());
+  
+  const bool status = svd_rand_helper(U, S, V, UA.M, k, opts, false);
+  
+  if(status == false)
+    {
+    S.soft_reset();
+    arma_debug_warn_level(3, "svd_rand(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! find the k largest singular values of X, using a randomised method
+template<typename T1>
+arma_warn_unused
+inline
+Col<typename T1::pod_type>
+svd_rand
+  (
+  const Base<typename T1::elem_type,T1>& X,
+  const uword                            k,
+  const svd_rand_opts&                   opts = svd_rand_opts(),
+  const typename arma_blas_type_only<typename T1::elem_type>::result* junk = nullptr
+  )
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename T1::elem_type eT;
+  
+  Col<typename T1::pod_type> S;
+  
+  Mat<eT> U;
+  Mat<eT> V;
+  
+  const quasi_unwrap<T1> UA(X.get_ref());
+  
+  const bool status = svd_rand_helper(U, S, V, UA.M, k, opts, false);
+  
+  if(status == false)
+    {
+    S.soft_reset();
+    arma_stop_runtime_error("svd_rand(): decomposition failed");
+    }
+  
+  return S;
+  }
+
+
+
+//! @}
@@ -349,4 +349,111 @@ svds
 
 
 
+//! find the k largest singular values and corresponding singular vectors of sparse matrix X, using a randomised method
+template<typename T1>
+inline
+bool
+svds
+  (
+           Mat<typename T1::elem_type>&    U,
+           Col<typename T1::pod_type >&    S,
+           Mat<typename T1::elem_type>&    V,
+  const SpBase<typename T1::elem_type,T1>& X,
+  const uword                              k,
+  const svd_rand_opts&                     opts,
+  const typename arma_blas_type_only<typename T1::elem_type>::result* junk = nullptr
+  )
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  arma_debug_check
+    (
+    ( ((void*)(&U) == (void*)(&S)) || (&U == &V) || ((void*)(&S) == (void*)(&V)) ),
+    "svds(): two or more output objects are the same object"
+    );
+  
+  const unwrap_spmat<T1> tmp(X.get_ref());
+  
+  const bool status = svd_rand_helper(U, S, V, tmp.M, k, opts, true);
+  
+  if(status == false)
+    {
+    U.soft_reset();
+    S.soft_reset();
+    V.soft_reset();
+    arma_debug_warn_level(3, "svds(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! find the k largest singular values of sparse matrix X, using a randomised method
+template<typename T1>
+inline
+bool
+svds
+  (
+           Col<typename T1::pod_type >&    S,
+  const SpBase<typename T1::elem_type,T1>& X,
+  const uword                              k,
+  const svd_rand_opts&                     opts,
+  const typename arma_blas_type_only<typename T1::elem_type>::result* junk = nullptr
+  )
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  Mat<typename T1::elem_type> U;
+  Mat<typename T1::elem_type> V;
+  
+  const unwrap_spmat<T1> tmp(X.get_ref());
+  
+  const bool status = svd_rand_helper(U, S, V, tmp.M, k, opts, false);
+  
+  if(status == false)
+    {
+    S.soft_reset();
+    arma_debug_warn_level(3, "svds(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! find the k largest singular values of sparse matrix X, using a randomised method
+template<typename T1>
+arma_warn_unused
+inline
+Col<typename T1::pod_type>
+svds
+  (
+  const SpBase<typename T1::elem_type,T1>& X,
+  const uword                              k,
+  const svd_rand_opts&                     opts,
+  const typename arma_blas_type_only<typename T1::elem_type>::result* junk = nullptr
+  )
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  Col<typename T1::pod_type>  S;
+  
+  Mat<typename T1::elem_type> U;
+  Mat<typename T1::elem_type> V;
+  
+  const unwrap_spmat<T1> tmp(X.get_ref());
+  
+  const bool status = svd_rand_helper(U, S, V, tmp.M, k, opts, false);
+  
+  if(status == false)  { arma_stop_runtime_error("svds(): decomposition failed"); }
+  
+  return S;
+  }
+
+
+
 //! @}
@@ -27,6 +27,8 @@ class glue_atan2
   {
   public:
   
+  static constexpr uword mp_cost = 64;  //!< estimated CPU cycles per element
+  
   
   // matrices
   
@@ -70,7 +70,7 @@ glue_atan2::apply_noalias(Mat<typename T1::elem_type>& out, const Proxy<T1>& P1,
   
   eT* out_mem = out.memptr();
   
-  const bool use_mp = arma_config::openmp && mp_gate<eT, (Proxy<T1>::use_mp || Proxy<T2>::use_mp)>::eval(n_elem);
+  const bool use_mp = arma_config::mp && mp_gate<eT>::eval(n_elem, mp_cost + mp_expr_cost<T1>::value + mp_expr_cost<T2>::value);
   const bool use_at = Proxy<T1>::use_at || Proxy<T2>::use_at;
   
   if(use_at == false)
@@ -80,14 +80,13 @@ glue_atan2::apply_noalias(Mat<typename T1::elem_type>& out, const Proxy<T1>& P1,
     
     if(use_mp)
       {
-      #if defined(ARMA_USE_OPENMP)
+      #if defined(ARMA_USE_MP)
         {
         const int n_threads = mp_thread_limit::get();
-        #pragma omp parallel for schedule(static) num_threads(n_threads)
-        for(uword i=0; i<n_elem; ++i)
+        mp_parallel::run(n_elem, n_threads, [&](const uword i)
           {
           out_mem[i] = std::atan2( eaP1[i], eaP2[i] );
-          }
+          });
         }
       #endif
       }
@@ -172,7 +171,7 @@ glue_atan2::apply_noalias(Cube<typename T1::elem_type>& out, const ProxyCube<T1>
   
   eT* out_mem = out.memptr();
   
-  const bool use_mp = arma_config::openmp && mp_gate<eT, (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp)>::eval(n_elem);
+  const bool use_mp = arma_config::mp && mp_gate<eT>::eval(n_elem, mp_cost + mp_expr_cost<T1>::value + mp_expr_cost<T2>::value);
   const bool use_at = ProxyCube<T1>::use_at || ProxyCube<T2>::use_at;
   
   if(use_at == false)
@@ -182,14 +181,13 @@ glue_atan2::apply_noalias(Cube<typename T1::elem_type>& out, const ProxyCube<T1>
     
     if(use_mp)
       {
-      #if defined(ARMA_USE_OPENMP)
+      #if defined(ARMA_USE_MP)
         {
         const int n_threads = mp_thread_limit::get();
-        #pragma omp parallel for schedule(static) num_threads(n_threads)
-        for(uword i=0; i<n_elem; ++i)
+        mp_parallel::run(n_elem, n_threads, [&](const uword i)
           {
           out_mem[i] = std::atan2( eaP1[i], eaP2[i] );
-          }
+          });
         }
       #endif
       }
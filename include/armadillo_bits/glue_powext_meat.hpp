@@ -72,17 +72,16 @@ glue_powext::apply(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>& B)
   const eT*   A_mem =   A.memptr();
   const eT*   B_mem =   B.memptr();
   
-  if( arma_config::openmp && mp_gate<eT>::eval(N) )
+  if( arma_config::mp && mp_gate<eT>::eval(N, eop_pow::mp_cost) )
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       const int n_threads = mp_thread_limit::get();
       
-      #pragma omp parallel for schedule(static) num_threads(n_threads)
-      for(uword i=0; i<N; ++i)
+      mp_parallel::run(N, n_threads, [&](const uword i)
         {
         out_mem[i] = eop_aux::pow(A_mem[i], B_mem[i]);
-        }
+        });
       }
     #endif
     }
@@ -126,14 +125,13 @@ glue_powext::apply
   
   if(mode == 0) // each column
     {
-    if( arma_config::openmp && mp_gate<eT>::eval(A.n_elem) )
+    if( arma_config::mp && mp_gate<eT>::eval(A.n_elem, eop_pow::mp_cost) )
       {
-      #if defined(ARMA_USE_OPENMP)
+      #if defined(ARMA_USE_MP)
         {
         const int n_threads = int( (std::min)(uword(mp_thread_limit::get()), A_n_cols) );
         
-        #pragma omp parallel for schedule(static) num_threads(n_threads)
-        for(uword i=0; i < A_n_cols; ++i)
+        mp_parallel::run(A_n_cols, n_threads, [&](const uword i)
           {
           const eT*   A_mem =   A.colptr(i);
                 eT* out_mem = out.colptr(i);
@@ -142,7 +140,7 @@ glue_powext::apply
             {
             out_mem[row] = eop_aux::pow(A_mem[row], B_mem[row]);
             }
-          }
+          });
         }
       #endif
       }
@@ -163,14 +161,13 @@ glue_powext::apply
   
   if(mode == 1) // each row
     {
-    if( arma_config::openmp && mp_gate<eT>::eval(A.n_elem) )
+    if( arma_config::mp && mp_gate<eT>::eval(A.n_elem, eop_pow::mp_cost) )
       {
-      #if defined(ARMA_USE_OPENMP)
+      #if defined(ARMA_USE_MP)
         {
         const int n_threads = int( (std::min)(uword(mp_thread_limit::get()), A_n_cols) );
         
-        #pragma omp parallel for schedule(static) num_threads(n_threads)
-        for(uword i=0; i < A_n_cols; ++i)
+        mp_parallel::run(A_n_cols, n_threads, [&](const uword i)
           {
           const eT*   A_mem =   A.colptr(i);
                 eT* out_mem = out.colptr(i);
@@ -181,7 +178,7 @@ glue_powext::apply
             {
             out_mem[row] = eop_aux::pow(A_mem[row], B_val);
             }
-          }
+          });
         }
       #endif
       }
@@ -255,17 +252,16 @@ glue_powext::apply(Cube<eT>& out, const Cube<eT>& A, const Cube<eT>& B)
   const eT*   A_mem =   A.memptr();
   const eT*   B_mem =   B.memptr();
   
-  if( arma_config::openmp && mp_gate<eT>::eval(N) )
+  if( arma_config::mp && mp_gate<eT>::eval(N, eop_pow::mp_cost) )
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       const int n_threads = mp_thread_limit::get();
       
-      #pragma omp parallel for schedule(static) num_threads(n_threads)
-      for(uword i=0; i<N; ++i)
+      mp_parallel::run(N, n_threads, [&](const uword i)
         {
         out_mem[i] = eop_aux::pow(A_mem[i], B_mem[i]);
-        }
+        });
       }
     #endif
     }
@@ -307,14 +303,13 @@ glue_powext::apply
   const eT*   B_mem    = B.memptr();
   const uword B_n_elem = B.n_elem;
   
-  if( arma_config::openmp && mp_gate<eT>::eval(A.n_elem) )
+  if( arma_config::mp && mp_gate<eT>::eval(A.n_elem, eop_pow::mp_cost) )
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       const int n_threads = int( (std::min)(uword(mp_thread_limit::get()), A_n_slices) );
       
-      #pragma omp parallel for schedule(static) num_threads(n_threads)
-      for(uword s=0; s < A_n_slices; ++s)
+      mp_parallel::run(A_n_slices, n_threads, [&](const uword s)
         {
         const eT*   A_slice_mem =   A.slice_memptr(s);
               eT* out_slice_mem = out.slice_memptr(s);
@@ -323,7 +318,7 @@ glue_powext::apply
           {
           out_slice_mem[i] = eop_aux::pow(A_slice_mem[i], B_mem[i]);
           }
-        }
+        });
       }
     #endif
     }
@@ -401,17 +396,16 @@ glue_powext_cx::apply(Mat< std::complex<T> >& out, const Mat< std::complex<T> >&
   const eT*   A_mem =   A.memptr();
   const  T*   B_mem =   B.memptr();
   
-  if( arma_config::openmp && mp_gate<eT>::eval(N) )
+  if( arma_config::mp && mp_gate<eT>::eval(N, eop_pow::mp_cost) )
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       const int n_threads = mp_thread_limit::get();
       
-      #pragma omp parallel for schedule(static) num_threads(n_threads)
-      for(uword i=0; i<N; ++i)
+      mp_parallel::run(N, n_threads, [&](const uword i)
         {
         out_mem[i] = std::pow(A_mem[i], B_mem[i]);
-        }
+        });
       }
     #endif
     }
@@ -456,14 +450,13 @@ glue_powext_cx::apply
   
   if(mode == 0) // each column
     {
-    if( arma_config::openmp && mp_gate<eT>::eval(A.n_elem) )
+    if( arma_config::mp && mp_gate<eT>::eval(A.n_elem, eop_pow::mp_cost) )
       {
-      #if defined(ARMA_USE_OPENMP)
+      #if defined(ARMA_USE_MP)
         {
         const int n_threads = int( (std::min)(uword(mp_thread_limit::get()), A_n_cols) );
         
-        #pragma omp parallel for schedule(static) num_threads(n_threads)
-        for(uword i=0; i < A_n_cols; ++i)
+        mp_parallel::run(A_n_cols, n_threads, [&](const uword i)
           {
           const eT*   A_mem =   A.colptr(i);
                 eT* out_mem = out.colptr(i);
@@ -472,7 +465,7 @@ glue_powext_cx::apply
             {
             out_mem[row] = std::pow(A_mem[row], B_mem[row]);
             }
-          }
+          });
         }
       #endif
       }
@@ -493,14 +486,13 @@ glue_powext_cx::apply
   
   if(mode == 1) // each row
     {
-    if( arma_config::openmp && mp_gate<eT>::eval(A.n_elem) )
+    if( arma_config::mp && mp_gate<eT>::eval(A.n_elem, eop_pow::mp_cost) )
       {
-      #if defined(ARMA_USE_OPENMP)
+      #if defined(ARMA_USE_MP)
         {
         const int n_threads = int( (std::min)(uword(mp_thread_limit::get()), A_n_cols) );
         
-        #pragma omp parallel for schedule(static) num_threads(n_threads)
-        for(uword i=0; i < A_n_cols; ++i)
+        mp_parallel::run(A_n_cols, n_threads, [&](const uword i)
           {
           const eT*   A_mem =   A.colptr(i);
                 eT* out_mem = out.colptr(i);
@@ -511,7 +503,7 @@ glue_powext_cx::apply
             {
             out_mem[row] = std::pow(A_mem[row], B_val);
             }
-          }
+          });
         }
       #endif
       }
@@ -578,17 +570,16 @@ glue_powext_cx::apply(Cube< std::complex<T> >& out, const Cube< std::complex<T>
   const eT*   A_mem =   A.memptr();
   const  T*   B_mem =   B.memptr();
   
-  if( arma_config::openmp && mp_gate<eT>::eval(N) )
+  if( arma_config::mp && mp_gate<eT>::eval(N, eop_pow::mp_cost) )
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       const int n_threads = mp_thread_limit::get();
       
-      #pragma omp parallel for schedule(static) num_threads(n_threads)
-      for(uword i=0; i<N; ++i)
+      mp_parallel::run(N, n_threads, [&](const uword i)
         {
         out_mem[i] = std::pow(A_mem[i], B_mem[i]);
-        }
+        });
       }
     #endif
     }
@@ -632,14 +623,13 @@ glue_powext_cx::apply
   const T*    B_mem    = B.memptr();
   const uword B_n_elem = B.n_elem;
   
-  if( arma_config::openmp && mp_gate<eT>::eval(A.n_elem) )
+  if( arma_config::mp && mp_gate<eT>::eval(A.n_elem, eop_pow::mp_cost) )
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       const int n_threads = int( (std::min)(uword(mp_thread_limit::get()), A_n_slices) );
       
-      #pragma omp parallel for schedule(static) num_threads(n_threads)
-      for(uword s=0; s < A_n_slices; ++s)
+      mp_parallel::run(A_n_slices, n_threads, [&](const uword s)
         {
         const eT*   A_slice_mem =   A.slice_memptr(s);
               eT* out_slice_mem = out.slice_memptr(s);
@@ -648,7 +638,7 @@ glue_powext_cx::apply
           {
           out_slice_mem[i] = std::pow(A_slice_mem[i], B_mem[i]);
           }
-        }
+        });
       }
     #endif
     }
@@ -1011,8 +1011,8 @@ gmm_diag<eT>::internal_gen_boundaries(const uword N) const
   {
   arma_extra_debug_sigprint();
   
-  #if defined(ARMA_USE_OPENMP)
-    const uword n_threads_avail = (omp_in_parallel()) ? uword(1) : uword(omp_get_max_threads());
+  #if defined(ARMA_USE_MP)
+    const uword n_threads_avail = (mp_thread_limit::in_parallel()) ? uword(1) : uword(mp_backend::max_threads());
     const uword n_threads       = (n_threads_avail > 0) ? ( (n_threads_avail <= N) ? n_threads_avail : 1 ) : 1;
   #else
     static constexpr uword n_threads = 1;
@@ -1141,14 +1141,13 @@ gmm_diag<eT>::internal_vec_log_p(const Mat<eT>& X) const
   
   if(N > 0)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       const umat boundaries = internal_gen_boundaries(N);
       
       const uword n_threads = boundaries.n_cols;
       
-      #pragma omp parallel for schedule(static)
-      for(uword t=0; t < n_threads; ++t)
+      mp_parallel::run(n_threads, int(n_threads), [&](const uword t)
         {
         const uword start_index = boundaries.at(0,t);
         const uword   end_index = boundaries.at(1,t);
@@ -1159,7 +1158,7 @@ gmm_diag<eT>::internal_vec_log_p(const Mat<eT>& X) const
           {
           out_mem[i] = internal_scalar_log_p( X.colptr(i) );
           }
-        }
+        });
       }
     #else
       {
@@ -1194,14 +1193,13 @@ gmm_diag<eT>::internal_vec_log_p(const Mat<eT>& X, const uword gaus_id) const
   
   if(N > 0)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       const umat boundaries = internal_gen_boundaries(N);
       
       const uword n_threads = boundaries.n_cols;
       
-      #pragma omp parallel for schedule(static)
-      for(uword t=0; t < n_threads; ++t)
+      mp_parallel::run(n_threads, int(n_threads), [&](const uword t)
         {
         const uword start_index = boundaries.at(0,t);
         const uword   end_index = boundaries.at(1,t);
@@ -1212,7 +1210,7 @@ gmm_diag<eT>::internal_vec_log_p(const Mat<eT>& X, const uword gaus_id) const
           {
           out_mem[i] = internal_scalar_log_p( X.colptr(i), gaus_id );
           }
-        }
+        });
       }
     #else
       {
@@ -1245,7 +1243,7 @@ gmm_diag<eT>::internal_sum_log_p(const Mat<eT>& X) const
   if(N == 0)  { return (-Datum<eT>::inf); }
   
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_MP)
     {
     const umat boundaries = internal_gen_boundaries(N);
     
@@ -1253,8 +1251,7 @@ gmm_diag<eT>::internal_sum_log_p(const Mat<eT>& X) const
     
     Col<eT> t_accs(n_threads, arma_zeros_indicator());
     
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t < n_threads; ++t)
+    mp_parallel::run(n_threads, int(n_threads), [&](const uword t)
       {
       const uword start_index = boundaries.at(0,t);
       const uword   end_index = boundaries.at(1,t);
@@ -1267,7 +1264,7 @@ gmm_diag<eT>::internal_sum_log_p(const Mat<eT>& X) const
         }
       
       t_accs[t] = t_acc;
-      }
+      });
     
     return eT(accu(t_accs));
     }
@@ -1302,7 +1299,7 @@ gmm_diag<eT>::internal_sum_log_p(const Mat<eT>& X, const uword gaus_id) const
   if(N == 0)  { return (-Datum<eT>::inf); }
   
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_MP)
     {
     const umat boundaries = internal_gen_boundaries(N);
     
@@ -1310,8 +1307,7 @@ gmm_diag<eT>::internal_sum_log_p(const Mat<eT>& X, const uword gaus_id) const
     
     Col<eT> t_accs(n_threads, arma_zeros_indicator());
     
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t < n_threads; ++t)
+    mp_parallel::run(n_threads, int(n_threads), [&](const uword t)
       {
       const uword start_index = boundaries.at(0,t);
       const uword   end_index = boundaries.at(1,t);
@@ -1324,7 +1320,7 @@ gmm_diag<eT>::internal_sum_log_p(const Mat<eT>& X, const uword gaus_id) const
         }
       
       t_accs[t] = t_acc;
-      }
+      });
     
     return eT(accu(t_accs));
     }
@@ -1358,7 +1354,7 @@ gmm_diag<eT>::internal_avg_log_p(const Mat<eT>& X) const
   if(N == 0)  { return (-Datum<eT>::inf); }
   
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_MP)
     {
     const umat boundaries = internal_gen_boundaries(N);
     
@@ -1367,8 +1363,7 @@ gmm_diag<eT>::internal_avg_log_p(const Mat<eT>& X) const
     field< running_mean_scalar<eT> > t_running_means(n_threads);
     
     
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t < n_threads; ++t)
+    mp_parallel::run(n_threads, int(n_threads), [&](const uword t)
       {
       const uword start_index = boundaries.at(0,t);
       const uword   end_index = boundaries.at(1,t);
@@ -1379,7 +1374,7 @@ gmm_diag<eT>::internal_avg_log_p(const Mat<eT>& X) const
         {
         current_running_mean( internal_scalar_log_p( X.colptr(i) ) );
         }
-      }
+      });
     
     
     eT avg = eT(0);
@@ -1426,7 +1421,7 @@ gmm_diag<eT>::internal_avg_log_p(const Mat<eT>& X, const uword gaus_id) const
   if(N == 0)  { return (-Datum<eT>::inf); }
   
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_MP)
     {
     const umat boundaries = internal_gen_boundaries(N);
     
@@ -1435,8 +1430,7 @@ gmm_diag<eT>::internal_avg_log_p(const Mat<eT>& X, const uword gaus_id) const
     field< running_mean_scalar<eT> > t_running_means(n_threads);
     
     
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t < n_threads; ++t)
+    mp_parallel::run(n_threads, int(n_threads), [&](const uword t)
       {
       const uword start_index = boundaries.at(0,t);
       const uword   end_index = boundaries.at(1,t);
@@ -1447,7 +1441,7 @@ gmm_diag<eT>::internal_avg_log_p(const Mat<eT>& X, const uword gaus_id) const
         {
         current_running_mean( internal_scalar_log_p( X.colptr(i), gaus_id) );
         }
-      }
+      });
     
     
     eT avg = eT(0);
@@ -1555,10 +1549,9 @@ gmm_diag<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X, const gmm_dist
   
   if(dist_mode == eucl_dist)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
-      #pragma omp parallel for schedule(static)
-      for(uword i=0; i<X_n_cols; ++i)
+      mp_parallel::run(X_n_cols, int(X_n_cols), [&](const uword i)
         {
         const eT* X_colptr = X.colptr(i);
         
@@ -1573,7 +1566,7 @@ gmm_diag<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X, const gmm_dist
           }
         
         out_mem[i] = best_g;
-        }
+        });
       }
     #else
       {
@@ -1599,12 +1592,11 @@ gmm_diag<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X, const gmm_dist
   else
   if(dist_mode == prob_dist)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       const eT* log_hefts_mem = log_hefts.memptr();
       
-      #pragma omp parallel for schedule(static)
-      for(uword i=0; i<X_n_cols; ++i)
+      mp_parallel::run(X_n_cols, int(X_n_cols), [&](const uword i)
         {
         const eT* X_colptr = X.colptr(i);
         
@@ -1619,7 +1611,7 @@ gmm_diag<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X, const gmm_dist
           }
         
         out_mem[i] = best_g;
-        }
+        });
       }
     #else
       {
@@ -1669,7 +1661,7 @@ gmm_diag<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X, const gmm_dist_
   
   if(N_gaus == 0)  { return; }
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_MP)
     {
     const umat boundaries = internal_gen_boundaries(X_n_cols);
     
@@ -1682,8 +1674,7 @@ gmm_diag<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X, const gmm_dist_
     
     if(dist_mode == eucl_dist)
       {
-      #pragma omp parallel for schedule(static)
-      for(uword t=0; t < n_threads; ++t)
+      mp_parallel::run(n_threads, int(n_threads), [&](const uword t)
         {
         uword* thread_hist_mem = thread_hist(t).memptr();
         
@@ -1706,15 +1697,14 @@ gmm_diag<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X, const gmm_dist_
           
           thread_hist_mem[best_g]++;
           }
-        }
+        });
       }
     else
     if(dist_mode == prob_dist)
       {
       const eT* log_hefts_mem = log_hefts.memptr();
       
-      #pragma omp parallel for schedule(static)
-      for(uword t=0; t < n_threads; ++t)
+      mp_parallel::run(n_threads, int(n_threads), [&](const uword t)
         {
         uword* thread_hist_mem = thread_hist(t).memptr();
         
@@ -1737,7 +1727,7 @@ gmm_diag<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X, const gmm_dist_
           
           thread_hist_mem[best_g]++;
           }
-        }
+        });
       }
     
     // reduction
@@ -1920,7 +1910,7 @@ gmm_diag<eT>::generate_initial_params(const Mat<eT>& X, const eT var_floor)
   
   uword* acc_hefts_mem = acc_hefts.memptr();
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_MP)
     {
     const umat boundaries = internal_gen_boundaries(X_n_cols);
     
@@ -1937,8 +1927,7 @@ gmm_diag<eT>::generate_initial_params(const Mat<eT>& X, const eT var_floor)
       t_acc_hefts(t).zeros(N_gaus);
       }
     
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t < n_threads; ++t)
+    mp_parallel::run(n_threads, int(n_threads), [&](const uword t)
       {
       uword* t_acc_hefts_mem = t_acc_hefts(t).memptr();
       
@@ -1972,7 +1961,7 @@ gmm_diag<eT>::generate_initial_params(const Mat<eT>& X, const eT var_floor)
         
         t_acc_hefts_mem[best_g]++;
         }
-      }
+      });
     
     // reduction
     acc_means = t_acc_means(0);
@@ -2083,7 +2072,7 @@ gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
   
   running_mean_scalar<eT> rs_delta;
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_MP)
     const umat boundaries = internal_gen_boundaries(X_n_cols);
     const uword n_threads = boundaries.n_cols;
     
@@ -2098,7 +2087,7 @@ gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
   
   for(uword iter=1; iter <= max_iter; ++iter)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       for(uword t=0; t < n_threads; ++t)
         {
@@ -2107,8 +2096,7 @@ gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
         t_last_indx(t).zeros(N_gaus);
         }
       
-      #pragma omp parallel for schedule(static)
-      for(uword t=0; t < n_threads; ++t)
+      mp_parallel::run(n_threads, int(n_threads), [&](const uword t)
         {
         Mat<eT>& t_acc_means_t   = t_acc_means(t);
         uword*   t_acc_hefts_mem = t_acc_hefts(t).memptr();
@@ -2138,7 +2126,7 @@ gmm_diag<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
           t_acc_hefts_mem[best_g]++;
           t_last_indx_mem[best_g] = i;
           }
-        }
+        });
       
       // reduction
       
@@ -2404,10 +2392,9 @@ gmm_diag<eT>::em_update_params
   
   // em_generate_acc() is the "map" operation, which produces partial accumulators for means, diagonal covariances and hefts
     
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_MP)
     {
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t<n_threads; t++)
+    mp_parallel::run(n_threads, int(n_threads), [&](const uword t)
       {
       Mat<eT>& acc_means          = t_acc_means[t];
       Mat<eT>& acc_dcovs          = t_acc_dcovs[t];
@@ -2416,7 +2403,7 @@ gmm_diag<eT>::em_update_params
       eT&      progress_log_lhood = t_progress_log_lhood[t];
       
       em_generate_acc(X, boundaries.at(0,t), boundaries.at(1,t), acc_means, acc_dcovs, acc_norm_lhoods, gaus_log_lhoods, progress_log_lhood);
-      }
+      });
     }
   #else
     {
@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup lz_codec
+//! @{
+
+
+//! compression of blocks of memory, used by the arma_binary_compressed file format;
+//! the compressed data uses the LZ4 block format, so that no external library is required;
+//! the shuffle filter groups the bytes of each element by significance,
+//! which makes runs of zeros and small integers longer and easier to compress
+class lz_codec
+  {
+  public:
+  
+  //! size of the buffer required by compress()
+  inline static uword bound(const uword n);
+  
+  //! compress n bytes from src into dest; returns the length of the compressed data
+  inline static uword compress(u8* dest, const u8* src, const uword n);
+  
+  //! decompress src_len bytes from src into exactly dest_len bytes of dest; returns false if the data is damaged
+  inline static bool decompress(u8* dest, const uword dest_len, const u8* src, const uword src_len);
+  
+  inline static void   shuffle(u8* dest, const u8* src, const uword n_elem, const uword elem_size);
+  inline static void unshuffle(u8* dest, const u8* src, const uword n_elem, const uword elem_size);
+  
+  
+  private:
+  
+  static constexpr uword hash_log    = 14;
+  static constexpr uword min_match   = 4;
+  static constexpr uword max_offset  = 65535;
+  static constexpr uword last_lits   = 5;   // the last bytes are always stored as literals
+  static constexpr uword match_limit = 12;  // the last match starts at least this many bytes before the end
+  
+  arma_inline static u32 read_u32(const u8* ptr);
+  arma_inline static u32 hash(const u32 val);
+  
+  inline static uword put_length(u8* dest, uword op, uword len);
+  inline static uword put_sequence(u8* dest, uword op, const u8* lits, const uword n_lits, const uword offset, const uword match_len);
+  };
+
+
+//! @}
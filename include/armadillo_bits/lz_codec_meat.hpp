@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup lz_codec
+//! @{
+
+
+
+inline
+uword
+lz_codec::bound(const uword n)
+  {
+  return n + (n / uword(255)) + uword(16);
+  }
+
+
+
+arma_inline
+u32
+lz_codec::read_u32(const u8* ptr)
+  {
+  u32 val;
+  
+  std::memcpy(&val, ptr, sizeof(u32));
+  
+  return val;
+  }
+
+
+
+arma_inline
+u32
+lz_codec::hash(const u32 val)
+  {
+  return u32( (val * u32(2654435761U)) >> (32 - hash_log) );
+  }
+
+
+
+//! store the part of a length that doesn't fit into the 4 bits of the token
+inline
+uword
+lz_codec::put_length(u8* dest, uword op, uword len)
+  {
+  while(len >= uword(255))  { dest[op] = u8(255); ++op; len -= uword(255); }
+  
+  dest[op] = u8(len);
+  
+  return op + 1;
+  }
+
+
+
+//! store a sequence of literals followed by a match;
+//! offset is zero for the last sequence, which has only literals
+inline
+uword
+lz_codec::put_sequence(u8* dest, uword op, const u8* lits, const uword n_lits, const uword offset, const uword match_len)
+  {
+  const uword token_pos = op;
+  
+  ++op;
+  
+  u8 token = u8( (std::min)(n_lits, uword(15)) << 4 );
+  
+  if(n_lits >= uword(15))  { op = lz_codec::put_length(dest, op, n_lits - uword(15)); }
+  
+  if(n_lits > 0)  { std::memcpy(dest + op, lits, size_t(n_lits)); op += n_lits; }
+  
+  if(offset > 0)
+    {
+    dest[op  ] = u8(offset & uword(0xFF));
+    dest[op+1] = u8(offset >> 8);
+    
+    op += 2;
+    
+    const uword len = match_len - min_match;
+    
+    token = u8( token | u8((std::min)(len, uword(15))) );
+    
+    if(len >= uword(15))  { op = lz_codec::put_length(dest, op, len - uword(15)); }
+    }
+  
+  dest[token_pos] = token;
+  
+  return op;
+  }
+
+
+
+//! greedy compression, with matches found via a hash table of recent positions;
+//! the step between positions grows while no match is found, so that incompressible data is processed quickly
+inline
+uword
+lz_codec::compress(u8* dest, const u8* src, const uword n)
+  {
+  arma_extra_debug_sigprint();
+  
+  uword ip     = 0;
+  uword anchor = 0;
+  uword op     = 0;
+  
+  if(n > match_limit)
+    {
+    podarray<uword> table(uword(1) << hash_log);
+    
+    table.zeros();
+    
+    const uword ip_limit    = n - match_limit;
+    const uword match_end   = n - last_lits;
+    
+    while(ip < ip_limit)
+      {
+      const u32   val  = lz_codec::read_u32(src + ip);
+      const u32   h    = lz_codec::hash(val);
+      const uword cand = table[h];
+      
+      table[h] = ip;
+      
+      if( (cand < ip) && ((ip - cand) <= max_offset) && (lz_codec::read_u32(src + cand) == val) )
+        {
+        uword len = min_match;
+        
+        while( ((ip + len) < match_end) && (src[cand + len] == src[ip + len]) )  { ++len; }
+        
+        op = lz_codec::put_sequence(dest, op, src + anchor, ip - anchor, ip - cand, len);
+        
+        ip    += len;
+        anchor = ip;
+        }
+      else
+        {
+        ip += uword(1) + ((ip - anchor) >> 6);
+        }
+      }
+    }
+  
+  op = lz_codec::put_sequence(dest, op, src + anchor, n - anchor, uword(0), uword(0));
+  
+  return op;
+  }
+
+
+
+inline
+bool
+lz_codec::decompress(u8* dest, const uword dest_len, const u8* src, const uword src_len)
+  {
+  arma_extra_debug_sigprint();
+  
+  uword ip = 0;
+  uword op = 0;
+  
+  while(true)
+    {
+    if(ip >= src_len)  { return false; }
+    
+    const u8 token = src[ip];  ++ip;
+    
+    uword n_lits = uword(token >> 4);
+    
+    if(n_lits == uword(15))
+      {
+      u8 extra = 0;
+      
+      do
+        {
+        if(ip >= src_len)  { return false; }
+        
+        extra = src[ip];  ++ip;
+        
+        n_lits += uword(extra);
+        }
+      while(extra == u8(255));
+      }
+    
+    if( (n_lits > (src_len - ip)) || (n_lits > (dest_len - op)) )  { return false; }
+    
+    if(n_lits > 0)  { std::memcpy(dest + op, src + ip, size_t(n_lits)); ip += n_lits; op += n_lits; }
+    
+    // the last sequence has only literals
+    if(ip == src_len)  { break; }
+    
+    if((src_len - ip) < uword(2))  { return false; }
+    
+    const uword offset = uword(src[ip]) | (uword(src[ip+1]) << 8);
+    
+    ip += 2;
+    
+    if( (offset == 0) || (offset > op) )  { return false; }
+    
+    uword len = uword(token & u8(15));
+    
+    if(len == uword(15))
+      {
+      u8 extra = 0;
+      
+      do
+        {
+        if(ip >= src_len)  { return false; }
+        
+        extra = src[ip];  ++ip;
+        
+        len += uword(extra);
+        }
+      while(extra == u8(255));
+      }
+    
+    len += min_match;
+    
+    if(len > (dest_len - op))  { return false; }
+    
+    // the match may overlap the output (eg. a run of repeated bytes);
+    // the copied part is doubled in each step, keeping the copied length a multiple of the offset
+    
+    u8* out = dest + op;
+    
+    uword done = 0;
+    
+    while(done < len)
+      {
+      const uword step = (std::min)(len - done, done + offset);
+      
+      std::memcpy(out + done, out - offset, size_t(step));
+      
+      done += step;
+      }
+    
+    op += len;
+    }
+  
+  return (op == dest_len);
+  }
+
+
+
+inline
+void
+lz_codec::shuffle(u8* dest, const u8* src, const uword n_elem, const uword elem_size)
+  {
+  for(uword k=0; k < elem_size; ++k)
+    {
+    u8* dest_k = dest + k*n_elem;
+    
+    for(uword i=0; i < n_elem; ++i)  { dest_k[i] = src[i*elem_size + k]; }
+    }
+  }
+
+
+
+inline
+void
+lz_codec::unshuffle(u8* dest, const u8* src, const uword n_elem, const uword elem_size)
+  {
+  for(uword k=0; k < elem_size; ++k)
+    {
+    const u8* src_k = src + k*n_elem;
+    
+    for(uword i=0; i < n_elem; ++i)  { dest[i*elem_size + k] = src_k[i]; }
+    }
+  }
+
+
+
+//! @}
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup mapped_file
+//! @{
+
+
+//! access to the contents of a file via memory mapping;
+//! open() fails if memory mapping is not available (see ARMA_DONT_USE_MMAP),
+//! in which case the caller is expected to read the file via a stream
+class mapped_file
+  {
+  public:
+  
+  inline  mapped_file();
+  inline ~mapped_file();
+  
+  mapped_file(const mapped_file&)            = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+  
+  inline bool open(const std::string& name, const map_mode mode = map_mode::read_only);
+  inline void close();
+  
+  inline void advise_sequential() const;
+  inline bool flush() const;
+  
+  arma_inline       char* memptr()        { return mem;     }
+  arma_inline const char* memptr()  const { return mem;     }
+  arma_inline uword       n_bytes() const { return mem_len; }
+  
+  
+  private:
+  
+  char* mem     = nullptr;
+  uword mem_len = 0;
+  };
+
+
+
+//! elements of a matrix or cube stored in a memory mapped file (arma_binary or raw_binary format);
+//! used as the first base class of Mat::mapped and Cube::mapped, so that the file is mapped before the matrix or cube is constructed
+template<typename eT>
+class mapped_file_elems
+  {
+  public:
+  
+  inline mapped_file_elems();
+  inline mapped_file_elems(const std::string& name, const file_type type, const map_mode mode, const bool is_cube);
+  
+  
+  protected:
+  
+  mapped_file file;
+  
+  eT*   map_mem      = nullptr;
+  uword map_n_rows   = 0;
+  uword map_n_cols   = 0;
+  uword map_n_slices = 0;
+  };
+
+
+//! @}
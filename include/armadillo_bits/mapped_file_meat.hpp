@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup mapped_file
+//! @{
+
+
+inline
+mapped_file::mapped_file()
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+inline
+mapped_file::~mapped_file()
+  {
+  arma_extra_debug_sigprint();
+  
+  close();
+  }
+
+
+
+//! read_only:     the memory is read-only and shared
+//! read_write:    changes to the memory are carried through to the file
+//! copy_on_write: changes to the memory are private; the file is not modified
+inline
+bool
+mapped_file::open(const std::string& name, const map_mode mode)
+  {
+  arma_extra_debug_sigprint();
+  
+  close();
+  
+  #if defined(ARMA_HAVE_MMAP)
+    {
+    const bool write_file = (mode == map_mode::read_write);
+    const bool write_mem  = (mode != map_mode::read_only);
+    
+    const int fd = ::open(name.c_str(), (write_file) ? O_RDWR : O_RDONLY);
+    
+    if(fd < 0)  { return false; }
+    
+    struct stat fd_stat;
+    
+    if( (::fstat(fd, &fd_stat) != 0) || (S_ISREG(fd_stat.st_mode) == 0) )  { ::close(fd); return false; }
+    
+    const uword len = uword(fd_stat.st_size);
+    
+    if(len == 0)  { ::close(fd); return true; }  // mmap() does not accept zero length
+    
+    const int prot  = (write_mem)  ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    const int flags = (write_file) ? MAP_SHARED               : MAP_PRIVATE;
+    
+    void* ptr = ::mmap(nullptr, size_t(len), prot, flags, fd, 0);
+    
+    // the mapping remains valid after the file descriptor is closed
+    ::close(fd);
+    
+    if(ptr == MAP_FAILED)  { return false; }
+    
+    mem     = static_cast<char*>(ptr);
+    mem_len = len;
+    
+    return true;
+    }
+  #else
+    {
+    arma_ignore(name);
+    arma_ignore(mode);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+inline
+void
+mapped_file::close()
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_HAVE_MMAP)
+    {
+    if(mem != nullptr)  { ::munmap(mem, size_t(mem_len)); }
+    }
+  #endif
+  
+  mem     = nullptr;
+  mem_len = 0;
+  }
+
+
+
+//! hint that the file will be read once from start to end
+inline
+void
+mapped_file::advise_sequential() const
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_HAVE_MMAP) && defined(POSIX_MADV_SEQUENTIAL)
+    {
+    if(mem != nullptr)  { ::posix_madvise(mem, size_t(mem_len), POSIX_MADV_SEQUENTIAL); }
+    }
+  #endif
+  }
+
+
+
+//! write changes to the file (read_write mode), without waiting for the mapping to be closed
+inline
+bool
+mapped_file::flush() const
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_HAVE_MMAP)
+    {
+    if(mem != nullptr)  { return (::msync(mem, size_t(mem_len), MS_SYNC) == 0); }
+    }
+  #endif
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+mapped_file_elems<eT>::mapped_file_elems()
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+template<typename eT>
+inline
+mapped_file_elems<eT>::mapped_file_elems(const std::string& name, const file_type type, const map_mode mode, const bool is_cube)
+  {
+  arma_extra_debug_sigprint();
+  
+  const char* func_name = (is_cube) ? "Cube::mapped(): " : "Mat::mapped(): ";
+  
+  if( (type != arma_binary) && (type != raw_binary) )
+    {
+    arma_stop_runtime_error( std::string(func_name) + "unsupported file type; must be arma_binary or raw_binary" );
+    }
+  
+  // writes to the elements can't be intercepted, so with a read-only mapping they would terminate the program;
+  // the file is instead mapped privately, so that changes to the elements are never carried through to the file
+  const map_mode file_mode = (mode == map_mode::read_only) ? map_mode::copy_on_write : mode;
+  
+  if(file.open(name, file_mode) == false)
+    {
+    #if defined(ARMA_HAVE_MMAP)
+      arma_stop_runtime_error( std::string(func_name) + "couldn't map file " + name );
+    #else
+      arma_stop_runtime_error( std::string(func_name) + "memory mapping is not available" );
+    #endif
+    }
+  
+  uword offset = 0;
+  
+  if(type == arma_binary)
+    {
+    std::string err_msg;
+    
+    map_n_slices = 1;  // overwritten by the cube header
+    
+    const bool header_ok = (is_cube)
+      ? diskio::load_arma_binary_header(Cube<eT>(), file.memptr(), file.n_bytes(), offset, map_n_rows, map_n_cols, map_n_slices, err_msg)
+      : diskio::load_arma_binary_header( Mat<eT>(), file.memptr(), file.n_bytes(), offset, map_n_rows, map_n_cols,               err_msg);
+    
+    if(header_ok == false)  { arma_stop_runtime_error( std::string(func_name) + err_msg + " in " + name ); }
+    }
+  else
+    {
+    // as with load(), the elements of a raw_binary file are taken as a column vector
+    map_n_rows   = file.n_bytes() / uword(sizeof(eT));
+    map_n_cols   = 1;
+    map_n_slices = 1;
+    }
+  
+  if(map_n_rows*map_n_cols*map_n_slices == 0)  { return; }
+  
+  char* ptr = file.memptr() + offset;
+  
+  if( (std::size_t(ptr) % std::size_t(alignof(eT))) != 0 )
+    {
+    arma_stop_runtime_error( std::string(func_name) + "elements are not suitably aligned in " + name + "; save the data again to add padding to the header" );
+    }
+  
+  map_mem = reinterpret_cast<eT*>(ptr);
+  }
+
+
+//! @}
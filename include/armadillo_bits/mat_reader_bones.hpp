@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup mat_reader
+//! @{
+
+
+namespace mat_reader_priv
+{
+
+//! reader for matrices stored in files, providing the matrix as a sequence of blocks of rows or columns;
+//! useful if the matrix is too large to be held in memory;
+//! if ARMA_USE_THREAD_POOL is enabled, the next block is read by a background thread while the current block is processed
+template<typename eT>
+class mat_reader
+  {
+  public:
+  
+  inline ~mat_reader();
+  inline  mat_reader();
+  
+  inline explicit mat_reader(const std::string& name, const file_type type = auto_detect, const uword block_size = 1024, const uword dim = 0);
+  
+  mat_reader(const mat_reader&)            = delete;
+  mat_reader& operator=(const mat_reader&) = delete;
+  
+  inline bool open(const std::string& name, const file_type type = auto_detect, const uword block_size = 1024, const uword dim = 0);
+  inline void close();
+  
+  inline bool is_open() const;
+  
+  inline bool next(Mat<eT>& X);
+  
+  inline uword n_rows() const;
+  inline uword n_cols() const;
+  
+  
+  private:
+  
+  inline bool read_block(Mat<eT>& X);
+  inline bool read_block_text(Mat<eT>& X);
+  inline bool read_block_binary(Mat<eT>& X);
+  
+  inline uword parse_line(const std::string& in_line, Mat<eT>* X, const uword row, bool& convert_okay) const;
+  
+  arma_inline static bool is_space(const char c) { return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\v') || (c == '\f'); }
+  
+  std::string   f_name;
+  std::ifstream f;
+  
+  file_type f_type     = file_type_unknown;
+  uword     f_block    = 0;
+  uword     f_dim      = 0;
+  uword     f_n_rows   = 0;
+  uword     f_n_cols   = 0;
+  uword     f_offset   = 0;  // position of the first element in binary files
+  uword     f_n_done   = 0;  // number of rows or columns read so far
+  bool      f_is_open  = false;
+  bool      f_at_end   = false;
+  
+  std::string pending_line;  // first line of a text file, read while determining the number of columns
+  std::string line;
+  std::string err_msg;
+  
+  #if defined(ARMA_USE_THREAD_POOL)
+    inline void start_worker();
+    inline void stop_worker();
+    inline void worker_loop();
+    
+    std::thread             worker;
+    std::mutex              state_mutex;
+    std::condition_variable state_cv;
+    
+    Mat<eT> staged;
+    
+    bool staged_ok   = false;
+    bool requested   = false;
+    bool ready       = false;
+    bool stop        = false;
+    bool has_worker  = false;
+  #endif
+  };
+
+}
+
+
+typedef mat_reader_priv::mat_reader<double>  mat_reader;
+typedef mat_reader_priv::mat_reader<float>  fmat_reader;
+typedef mat_reader_priv::mat_reader<uword>  umat_reader;
+typedef mat_reader_priv::mat_reader<sword>  imat_reader;
+
+
+//! @}
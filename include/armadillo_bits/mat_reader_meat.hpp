@@ -0,0 +1,592 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup mat_reader
+//! @{
+
+
+namespace mat_reader_priv
+{
+
+
+template<typename eT>
+inline
+mat_reader<eT>::~mat_reader()
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  close();
+  }
+
+
+
+template<typename eT>
+inline
+mat_reader<eT>::mat_reader()
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+mat_reader<eT>::mat_reader(const std::string& name, const file_type type, const uword block_size, const uword dim)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  open(name, type, block_size, dim);
+  }
+
+
+
+//! dim = 0: blocks of rows, with each block having block_size rows;
+//! dim = 1: blocks of columns, with each block having block_size columns (arma_binary and raw_binary only)
+template<typename eT>
+inline
+bool
+mat_reader<eT>::open(const std::string& name, const file_type type, const uword block_size, const uword dim)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( (block_size == 0), "mat_reader::open(): block_size must be greater than zero" );
+  arma_debug_check( (dim > 1),         "mat_reader::open(): parameter 'dim' must be 0 or 1"       );
+  
+  close();
+  
+  f.open(name, std::fstream::binary);
+  
+  if(f.is_open() == false)
+    {
+    arma_debug_warn_level(3, "mat_reader::open(): couldn't read from file: ", name);
+    
+    return false;
+    }
+  
+  f_type = type;
+  
+  if(type == auto_detect)
+    {
+    char header_mem[12] = {};
+    
+    f.read(header_mem, std::streamsize(12));
+    f.clear();
+    f.seekg(0, std::ios::beg);
+    
+    f_type = (std::strncmp("ARMA_MAT_BIN", header_mem, size_t(12)) == 0) ? arma_binary : diskio::guess_file_type_internal(f);
+    }
+  
+  f.clear();
+  f.seekg(0, std::ios::beg);
+  
+  bool open_okay = true;
+  
+  if( (f_type == csv_ascii) || (f_type == raw_ascii) )
+    {
+    if(dim != 0)
+      {
+      open_okay = false;
+      err_msg   = "blocks of columns are not supported for text files";
+      }
+    else
+      {
+      // the number of columns is given by the first line
+      std::getline(f, pending_line);
+      
+      bool junk = true;
+      
+      f_n_cols = (pending_line.empty()) ? uword(0) : parse_line(pending_line, nullptr, 0, junk);
+      f_at_end = (f_n_cols == 0);
+      }
+    }
+  else
+  if(f_type == arma_binary)
+    {
+    std::string f_header;
+    
+    f >> f_header;
+    f >> f_n_rows;
+    f >> f_n_cols;
+    f.get();
+    
+    if( (f.good() == false) || (f_header != diskio::gen_bin_header(Mat<eT>())) )
+      {
+      open_okay = false;
+      err_msg   = "incorrect header";
+      }
+    
+    f_offset = uword(f.tellg());
+    }
+  else
+  if(f_type == raw_binary)
+    {
+    // as with load(), the elements of a raw_binary file are taken as a column vector
+    f.seekg(0, std::ios::end);
+    
+    f_n_rows = uword(f.tellg()) / uword(sizeof(eT));
+    f_n_cols = 1;
+    }
+  else
+    {
+    open_okay = false;
+    err_msg   = "unsupported file type";
+    }
+  
+  if( open_okay && ((f_type == arma_binary) || (f_type == raw_binary)) )
+    {
+    f.seekg(0, std::ios::end);
+    
+    const uword f_len = uword(f.tellg());
+    
+    if( (f_offset + f_n_rows*f_n_cols*uword(sizeof(eT))) > f_len )
+      {
+      open_okay = false;
+      err_msg   = "file is too short";
+      }
+    
+    f.clear();
+    }
+  
+  if(open_okay == false)
+    {
+    arma_debug_warn_level(3, "mat_reader::open(): ", err_msg, "; file: ", name);
+    
+    close();
+    
+    return false;
+    }
+  
+  f_name    = name;
+  f_block   = block_size;
+  f_dim     = dim;
+  f_is_open = true;
+  
+  #if defined(ARMA_USE_THREAD_POOL)
+    {
+    start_worker();
+    }
+  #endif
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+void
+mat_reader<eT>::close()
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_THREAD_POOL)
+    {
+    stop_worker();
+    
+    staged.reset();
+    }
+  #endif
+  
+  if(f.is_open())  { f.close(); }
+  
+  f.clear();
+  
+  f_name.clear();
+  pending_line.clear();
+  err_msg.clear();
+  
+  f_type    = file_type_unknown;
+  f_block   = 0;
+  f_dim     = 0;
+  f_n_rows  = 0;
+  f_n_cols  = 0;
+  f_offset  = 0;
+  f_n_done  = 0;
+  f_is_open = false;
+  f_at_end  = false;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+mat_reader<eT>::is_open() const
+  {
+  return f_is_open;
+  }
+
+
+
+//! read the next block into X, reusing the memory of X where possible;
+//! returns false once all blocks have been read, or if the file couldn't be read
+template<typename eT>
+inline
+bool
+mat_reader<eT>::next(Mat<eT>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(f_is_open == false)  { X.soft_reset(); return false; }
+  
+  bool status = false;
+  
+  #if defined(ARMA_USE_THREAD_POOL)
+  if(has_worker)
+    {
+      {
+      std::unique_lock<std::mutex> lock(state_mutex);
+      
+      state_cv.wait(lock, [&]{ return ready; });
+      
+      ready  = false;
+      status = staged_ok;
+      }
+    
+    // once the end of the data is reached, the worker has nothing further to read
+    if(status == false)  { stop_worker(); }
+    
+    if(status)
+      {
+      // the memory of X is used by the worker for the next block
+      X.swap(staged);
+      
+        {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        
+        requested = true;
+        }
+      
+      state_cv.notify_all();
+      }
+    }
+  else
+  #endif
+    {
+    status = read_block(X);
+    }
+  
+  if(status == false)
+    {
+    if(err_msg.empty() == false)  { arma_debug_warn_level(3, "mat_reader::next(): ", err_msg, "; file: ", f_name); }
+    
+    X.soft_reset();
+    }
+  
+  return status;
+  }
+
+
+
+//! total number of rows; 0 for text files, where the number of rows is not known in advance
+template<typename eT>
+inline
+uword
+mat_reader<eT>::n_rows() const
+  {
+  return f_n_rows;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+mat_reader<eT>::n_cols() const
+  {
+  return f_n_cols;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+mat_reader<eT>::read_block(Mat<eT>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  if( f_at_end || (err_msg.empty() == false) )  { return false; }
+  
+  bool status = false;
+  
+  try
+    {
+    status = ( (f_type == csv_ascii) || (f_type == raw_ascii) ) ? read_block_text(X) : read_block_binary(X);
+    }
+  catch(std::bad_alloc&)
+    {
+    err_msg = "not enough memory";
+    }
+  catch(...)
+    {
+    err_msg = "couldn't read data";
+    }
+  
+  if(status == false)  { f_at_end = true; }
+  
+  return status;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+mat_reader<eT>::read_block_text(Mat<eT>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  X.set_size(f_block, f_n_cols);
+  
+  uword row = 0;
+  
+  while(row < f_block)
+    {
+    if(pending_line.empty() == false)
+      {
+      line.swap(pending_line);
+      
+      pending_line.clear();
+      }
+    else
+    if(std::getline(f, line).fail())
+      {
+      line.clear();
+      }
+    
+    // as with load(), the data ends at the first empty line
+    if(line.empty())  { f_at_end = true; break; }
+    
+    bool convert_okay = true;
+    
+    const uword line_n_cols = parse_line(line, &X, row, convert_okay);
+    
+    if(line_n_cols != f_n_cols)  { err_msg = "inconsistent number of columns"; return false; }
+    if(convert_okay == false)    { err_msg = "couldn't interpret data";        return false; }
+    
+    ++row;
+    }
+  
+  if(row == 0)  { return false; }
+  
+  if(row < f_block)  { X.shed_rows(row, f_block-1); }
+  
+  f_n_done += row;
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+mat_reader<eT>::read_block_binary(Mat<eT>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_total = (f_dim == 0) ? f_n_rows : f_n_cols;
+  
+  if(f_n_done >= n_total)  { return false; }
+  
+  const uword n = (std::min)(f_block, n_total - f_n_done);
+  
+  if(f_dim == 0)
+    {
+    // the rows of a block are not contiguous in the file
+    X.set_size(n, f_n_cols);
+    
+    for(uword col=0; col < f_n_cols; ++col)
+      {
+      f.seekg( std::streamoff(f_offset + (col*f_n_rows + f_n_done)*uword(sizeof(eT))), std::ios::beg );
+      
+      f.read( reinterpret_cast<char*>(X.colptr(col)), std::streamsize(n*sizeof(eT)) );
+      }
+    }
+  else
+    {
+    X.set_size(f_n_rows, n);
+    
+    f.seekg( std::streamoff(f_offset + f_n_done*f_n_rows*uword(sizeof(eT))), std::ios::beg );
+    
+    f.read( reinterpret_cast<char*>(X.memptr()), std::streamsize(X.n_elem*sizeof(eT)) );
+    }
+  
+  if(f.good() == false)  { err_msg = "couldn't read data"; return false; }
+  
+  f_n_done += n;
+  
+  return true;
+  }
+
+
+
+//! returns the number of tokens in in_line;
+//! if X is not null, the tokens are converted and stored in the given row of X
+template<typename eT>
+inline
+uword
+mat_reader<eT>::parse_line(const std::string& in_line, Mat<eT>* X, const uword row, bool& convert_okay) const
+  {
+  const char* str     = in_line.c_str();
+  const char* str_end = str + in_line.length();
+  
+  uword n_tokens = 0;
+  
+  if(f_type == csv_ascii)
+    {
+    // as with load(), each separator starts a new token, which may be empty
+    while(true)
+      {
+      const char* token_end = str;
+      
+      while( (token_end < str_end) && ((*token_end) != ',') )  { ++token_end; }
+      
+      if( (X != nullptr) && (n_tokens < f_n_cols) )
+        {
+        convert_okay = diskio::convert_csv_token(X->at(row, n_tokens), str, token_end) && convert_okay;
+        }
+      
+      ++n_tokens;
+      
+      if(token_end == str_end)  { break; }
+      
+      str = token_end + 1;
+      }
+    }
+  else
+    {
+    while(str < str_end)
+      {
+      while( (str < str_end) && is_space(*str) )  { ++str; }
+      
+      if(str == str_end)  { break; }
+      
+      const char* token_end = str;
+      
+      while( (token_end < str_end) && (is_space(*token_end) == false) )  { ++token_end; }
+      
+      if( (X != nullptr) && (n_tokens < f_n_cols) )
+        {
+        convert_okay = diskio::convert_csv_token(X->at(row, n_tokens), str, token_end) && convert_okay;
+        }
+      
+      ++n_tokens;
+      
+      str = token_end;
+      }
+    }
+  
+  return n_tokens;
+  }
+
+
+
+#if defined(ARMA_USE_THREAD_POOL)
+
+template<typename eT>
+inline
+void
+mat_reader<eT>::start_worker()
+  {
+  arma_extra_debug_sigprint();
+  
+  staged_ok = false;
+  requested = true;  // start reading the first block straight away
+  ready     = false;
+  stop      = false;
+  
+  try
+    {
+    worker = std::thread( [this]{ worker_loop(); } );
+    
+    has_worker = true;
+    }
+  catch(...)
+    {
+    // if a thread can't be created, blocks are read by next()
+    has_worker = false;
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+mat_reader<eT>::stop_worker()
+  {
+  arma_extra_debug_sigprint();
+  
+  if(has_worker == false)  { return; }
+  
+    {
+    std::lock_guard<std::mutex> lock(state_mutex);
+    
+    stop = true;
+    }
+  
+  state_cv.notify_all();
+  
+  worker.join();
+  
+  has_worker = false;
+  requested  = false;
+  ready      = false;
+  stop       = false;
+  }
+
+
+
+template<typename eT>
+inline
+void
+mat_reader<eT>::worker_loop()
+  {
+  while(true)
+    {
+      {
+      std::unique_lock<std::mutex> lock(state_mutex);
+      
+      state_cv.wait(lock, [&]{ return (requested || stop); });
+      
+      if(stop)  { return; }
+      
+      requested = false;
+      }
+    
+    const bool status = read_block(staged);
+    
+      {
+      std::lock_guard<std::mutex> lock(state_mutex);
+      
+      staged_ok = status;
+      ready     = true;
+      }
+    
+    state_cv.notify_all();
+    }
+  }
+
+#endif
+
+
+}
+
+
+//! @}
@@ -28,6 +28,13 @@ class memory
   
   template<typename eT> arma_inline static void release(eT* mem);
   
+  inline arma_malloc static void* acquire_bytes(const size_t n_bytes);
+  inline             static void  release_bytes(void* mem);
+  
+  static constexpr size_t huge_page_size = size_t(2097152);
+  
+  arma_inline static constexpr size_t alignment(const size_t n_bytes);
+  
   template<typename eT> arma_inline static bool      is_aligned(const eT*  mem);
   template<typename eT> arma_inline static void mark_as_aligned(      eT*& mem);
   template<typename eT> arma_inline static void mark_as_aligned(const eT*& mem);
@@ -49,60 +56,101 @@ memory::acquire(const uword n_elem)
     "arma::memory::acquire(): requested size is too large"
     );
   
-  eT* out_memptr;
+  #if defined(ARMA_USE_MEM_POOL)
+    eT* out_memptr = (eT *) memory_pool::acquire( sizeof(eT)*size_t(n_elem) );
+  #else
+    eT* out_memptr = (eT *) memory::acquire_bytes( sizeof(eT)*size_t(n_elem) );
+  #endif
+  
+  arma_check_bad_alloc( (out_memptr == nullptr), "arma::memory::acquire(): out of memory" );
+  
+  return out_memptr;
+  }
+
+
+
+inline
+arma_malloc
+void*
+memory::acquire_bytes(const size_t n_bytes)
+  {
+  void* out_memptr;
   
   #if   defined(ARMA_ALIEN_MEM_ALLOC_FUNCTION)
     {
-    out_memptr = (eT *) ARMA_ALIEN_MEM_ALLOC_FUNCTION(sizeof(eT)*n_elem);
+    out_memptr = ARMA_ALIEN_MEM_ALLOC_FUNCTION(n_bytes);
     }
   #elif defined(ARMA_USE_TBB_ALLOC)
     {
-    out_memptr = (eT *) scalable_malloc(sizeof(eT)*n_elem);
+    out_memptr = scalable_malloc(n_bytes);
     }
   #elif defined(ARMA_USE_MKL_ALLOC)
     {
-    out_memptr = (eT *) mkl_malloc( sizeof(eT)*n_elem, 32 );
+    out_memptr = mkl_malloc( n_bytes, int(memory::alignment(n_bytes)) );
     }
   #elif defined(ARMA_HAVE_POSIX_MEMALIGN)
     {
-    eT* memptr = nullptr;
+    void* memptr = nullptr;
+    
+    #if defined(ARMA_USE_HUGE_PAGES)
+      const bool use_huge = (n_bytes >= arma_config::huge_page_threshold);
+    #else
+      const bool use_huge = false;
+    #endif
     
-    const size_t n_bytes   = sizeof(eT)*size_t(n_elem);
-    const size_t alignment = (n_bytes >= size_t(1024)) ? size_t(32) : size_t(16);
+    const size_t alignment = (use_huge) ? memory::huge_page_size : memory::alignment(n_bytes);
     
-    // TODO: investigate apparent memory leak when using alignment >= 64 (as shown on Fedora 28, glibc 2.27)
-    int status = posix_memalign((void **)&memptr, ( (alignment >= sizeof(void*)) ? alignment : sizeof(void*) ), n_bytes);
+    // NOTE: an apparent memory leak when using alignment >= 64 was seen on Fedora 28 (glibc 2.27);
+    // NOTE: if this is a problem, use ARMA_MEM_ALIGNMENT to reduce the alignment
+    int status = posix_memalign(&memptr, ( (alignment >= sizeof(void*)) ? alignment : sizeof(void*) ), n_bytes);
     
     out_memptr = (status == 0) ? memptr : nullptr;
+    
+    #if defined(ARMA_USE_HUGE_PAGES) && defined(MADV_HUGEPAGE)
+      {
+      // only whole huge pages can be backed by a huge page; failure is harmless, as the memory is still usable
+      const size_t n_huge_bytes = (n_bytes / memory::huge_page_size) * memory::huge_page_size;
+      
+      if(use_huge && (out_memptr != nullptr) && (n_huge_bytes > 0))  { madvise(out_memptr, n_huge_bytes, MADV_HUGEPAGE); }
+      }
+    #endif
     }
   #elif defined(_MSC_VER)
     {
     // Windoze is too primitive to handle C++17 std::aligned_alloc()
     
-    //out_memptr = (eT *) malloc(sizeof(eT)*n_elem);
-    //out_memptr = (eT *) _aligned_malloc( sizeof(eT)*n_elem, 16 );  // lives in malloc.h
+    //out_memptr = malloc(n_bytes);
+    //out_memptr = _aligned_malloc( n_bytes, 16 );  // lives in malloc.h
     
-    const size_t n_bytes   = sizeof(eT)*size_t(n_elem);
-    const size_t alignment = (n_bytes >= size_t(1024)) ? size_t(32) : size_t(16);
+    const size_t alignment = memory::alignment(n_bytes);
     
-    out_memptr = (eT *) _aligned_malloc( n_bytes, alignment );
+    out_memptr = _aligned_malloc( n_bytes, alignment );
     }
   #else
     {
-    //return ( new(std::nothrow) eT[n_elem] );
-    out_memptr = (eT *) malloc(sizeof(eT)*n_elem);
+    out_memptr = malloc(n_bytes);
     }
   #endif
   
   // TODO: for mingw, use __mingw_aligned_malloc
   
-  arma_check_bad_alloc( (out_memptr == nullptr), "arma::memory::acquire(): out of memory" );
-  
   return out_memptr;
   }
 
 
 
+//! alignment used for a memory block of the given size;
+//! blocks of at least 1024 bytes are aligned to arma_config::mem_align (64 by default, ie. a cache line)
+arma_inline
+constexpr
+size_t
+memory::alignment(const size_t n_bytes)
+  {
+  return (n_bytes >= size_t(1024)) ? size_t(arma_config::mem_align) : size_t(16);
+  }
+
+
+
 template<typename eT>
 arma_inline
 void
@@ -110,6 +158,21 @@ memory::release(eT* mem)
   {
   if(mem == nullptr)  { return; }
   
+  #if defined(ARMA_USE_MEM_POOL)
+    memory_pool::release( (void *)(mem) );
+  #else
+    memory::release_bytes( (void *)(mem) );
+  #endif
+  }
+
+
+
+inline
+void
+memory::release_bytes(void* mem)
+  {
+  if(mem == nullptr)  { return; }
+  
   #if   defined(ARMA_ALIEN_MEM_FREE_FUNCTION)
     {
     ARMA_ALIEN_MEM_FREE_FUNCTION( (void *)(mem) );
@@ -143,6 +206,8 @@ memory::release(eT* mem)
 
 
 
+//! the aligned code paths only need 16 byte alignment, which small blocks and mem_local also have;
+//! the larger alignment given to large blocks by acquire_bytes() is for cache lines and is not assumed here
 template<typename eT>
 arma_inline
 bool
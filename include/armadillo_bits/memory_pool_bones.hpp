@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup memory_pool
+//! @{
+
+
+struct memory_pool_stats
+  {
+  u64 n_hits           = 0;  //!< number of requests served from a cached block or from an arena
+  u64 n_misses         = 0;  //!< number of requests that required fresh memory from the system
+  u64 n_bytes_retained = 0;  //!< number of bytes held in the cache of the calling thread
+  u64 n_bytes_arena    = 0;  //!< number of bytes handed out by the arenas active in the calling thread
+  };
+
+
+
+class memory_arena;
+
+
+
+//! Thread-local cache of released memory blocks, bucketed by power-of-two size classes.
+//! Each block is prefixed by a small header that records its size class and origin,
+//! so that memory can be released by any thread.
+//! Used by memory::acquire() and memory::release() when ARMA_USE_MEM_POOL is defined.
+class memory_pool
+  {
+  public:
+  
+  static constexpr size_t header_size     = (arma_config::mem_align > 32) ? size_t(arma_config::mem_align) : size_t(32);  // keeps blocks aligned
+  static constexpr size_t min_class_bytes = 64;
+  static constexpr uword  n_classes       = 40;
+  
+  inline arma_malloc static void* acquire(const size_t n_bytes);
+  inline             static void  release(void* mem);
+  
+  inline static void enable();     //!< enable caching of released blocks in the calling thread (default)
+  inline static void disable();    //!< disable caching of released blocks in the calling thread; cached blocks are returned to the system
+  inline static bool is_enabled();
+  
+  inline static void trim();       //!< return all blocks cached by the calling thread to the system
+  
+  inline static memory_pool_stats stats();        //!< statistics for the calling thread
+  inline static void              reset_stats();
+  
+  
+  private:
+  
+  struct header
+    {
+    header*      next;     // link in the free list of a size class
+    size_t       n_bytes;  // usable size of the block, excluding the header
+    unsigned int kind;     // 0 = plain system block; 1 = cacheable block; 2 = arena block
+    unsigned int bin;      // size class of cacheable blocks
+    };
+  
+  struct state
+    {
+    header*       bins[n_classes];
+    u64           n_hits;
+    u64           n_misses;
+    u64           n_bytes_retained;
+    u64           n_bytes_arena;
+    memory_arena* arena;
+    bool          disabled;
+    bool          finished;  // set once the cache of the thread has been torn down
+    };
+  
+  struct reaper
+    {
+    inline ~reaper();
+    };
+  
+  inline static state& get_state();
+  inline static void   register_reaper();
+  
+  inline static uword  class_index(const size_t n_bytes);
+  inline static void*  acquire_plain(state& st, const size_t n_bytes);
+  inline static void   flush(state& st);
+  
+  friend class memory_arena;
+  };
+
+
+
+//! Scope guard which redirects all memory requests made by the calling thread to a bump allocator.
+//! The memory is released in one go when the guard is destroyed.
+//! Objects which acquire memory while the arena is active must not outlive the arena.
+class memory_arena
+  {
+  public:
+  
+  inline ~memory_arena();
+  inline explicit memory_arena(const size_t chunk_bytes = size_t(1) << 20);
+  
+  inline size_t n_bytes() const;  //!< number of bytes handed out by this arena
+  
+  
+  private:
+  
+  struct chunk
+    {
+    chunk* next;
+    size_t capacity;
+    };
+  
+  inline memory_arena(const memory_arena&) = delete;
+  inline memory_arena& operator=(const memory_arena&) = delete;
+  
+  inline void* bump(const size_t n_bytes);
+  
+  size_t         chunk_bytes;
+  size_t         n_used     = 0;
+  chunk*         head       = nullptr;
+  unsigned char* cursor     = nullptr;
+  unsigned char* limit      = nullptr;
+  memory_arena*  prev_arena = nullptr;
+  
+  friend class memory_pool;
+  };
+
+
+
+//! @}
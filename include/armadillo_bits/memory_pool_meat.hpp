@@ -0,0 +1,363 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup memory_pool
+//! @{
+
+
+
+inline
+memory_pool::state&
+memory_pool::get_state()
+  {
+  // trivially destructible, so it remains usable while other thread_local objects are being destroyed
+  static thread_local state st;
+  
+  return st;
+  }
+
+
+
+inline
+memory_pool::reaper::~reaper()
+  {
+  state& st = memory_pool::get_state();
+  
+  memory_pool::flush(st);
+  
+  st.finished = true;
+  }
+
+
+
+inline
+void
+memory_pool::register_reaper()
+  {
+  static thread_local reaper obj;
+  
+  arma_ignore(obj);
+  }
+
+
+
+inline
+uword
+memory_pool::class_index(const size_t n_bytes)
+  {
+  uword  index       = 0;
+  size_t class_bytes = min_class_bytes;
+  
+  while(class_bytes < n_bytes)  { class_bytes <<= 1; ++index; }
+  
+  return index;
+  }
+
+
+
+inline
+void*
+memory_pool::acquire_plain(state& st, const size_t n_bytes)
+  {
+  header* h = (header*) memory::acquire_bytes(header_size + n_bytes);
+  
+  if(h == nullptr)  { return nullptr; }
+  
+  h->next    = nullptr;
+  h->n_bytes = n_bytes;
+  h->kind    = 0;
+  h->bin     = 0;
+  
+  st.n_misses++;
+  
+  return (void*)( ((unsigned char*)h) + header_size );
+  }
+
+
+
+inline
+arma_malloc
+void*
+memory_pool::acquire(const size_t n_bytes)
+  {
+  static_assert( (sizeof(header) <= header_size), "memory_pool::header is too large" );
+  
+  if( n_bytes > (std::numeric_limits<size_t>::max() - header_size - min_class_bytes) )  { return nullptr; }
+  
+  state& st = get_state();
+  
+  if(st.arena != nullptr)  { return st.arena->bump(n_bytes); }
+  
+  if( st.disabled || st.finished || (n_bytes > arma_config::mem_pool_max_bytes) )  { return acquire_plain(st, n_bytes); }
+  
+  const uword bin = class_index(n_bytes);
+  
+  header* h = st.bins[bin];
+  
+  if(h != nullptr)
+    {
+    st.bins[bin] = h->next;
+    
+    st.n_bytes_retained -= h->n_bytes;
+    st.n_hits++;
+    }
+  else
+    {
+    const size_t class_bytes = min_class_bytes << bin;
+    
+    h = (header*) memory::acquire_bytes(header_size + class_bytes);
+    
+    if(h == nullptr)  { return nullptr; }
+    
+    h->n_bytes = class_bytes;
+    h->kind    = 1;
+    h->bin     = (unsigned int)(bin);
+    
+    st.n_misses++;
+    }
+  
+  h->next = nullptr;
+  
+  return (void*)( ((unsigned char*)h) + header_size );
+  }
+
+
+
+inline
+void
+memory_pool::release(void* mem)
+  {
+  if(mem == nullptr)  { return; }
+  
+  header* h = (header*)( ((unsigned char*)mem) - header_size );
+  
+  if(h->kind == 2)  { return; }  // arena memory is released when the arena is destroyed
+  
+  state& st = get_state();
+  
+  const bool keep = (h->kind == 1) && (st.disabled == false) && (st.finished == false) && ( (st.n_bytes_retained + h->n_bytes) <= arma_config::mem_pool_max_retained );
+  
+  if(keep == false)  { memory::release_bytes( (void*)h ); return; }
+  
+  register_reaper();
+  
+  h->next = st.bins[h->bin];
+  
+  st.bins[h->bin] = h;
+  
+  st.n_bytes_retained += h->n_bytes;
+  }
+
+
+
+inline
+void
+memory_pool::flush(state& st)
+  {
+  for(uword bin=0; bin < n_classes; ++bin)
+    {
+    header* h = st.bins[bin];
+    
+    while(h != nullptr)
+      {
+      header* next = h->next;
+      
+      memory::release_bytes( (void*)h );
+      
+      h = next;
+      }
+    
+    st.bins[bin] = nullptr;
+    }
+  
+  st.n_bytes_retained = 0;
+  }
+
+
+
+inline
+void
+memory_pool::enable()
+  {
+  get_state().disabled = false;
+  }
+
+
+
+inline
+void
+memory_pool::disable()
+  {
+  state& st = get_state();
+  
+  flush(st);
+  
+  st.disabled = true;
+  }
+
+
+
+inline
+bool
+memory_pool::is_enabled()
+  {
+  const state& st = get_state();
+  
+  return ( (st.disabled == false) && (st.finished == false) );
+  }
+
+
+
+inline
+void
+memory_pool::trim()
+  {
+  flush(get_state());
+  }
+
+
+
+inline
+memory_pool_stats
+memory_pool::stats()
+  {
+  const state& st = get_state();
+  
+  memory_pool_stats out;
+  
+  out.n_hits           = st.n_hits;
+  out.n_misses         = st.n_misses;
+  out.n_bytes_retained = st.n_bytes_retained;
+  out.n_bytes_arena    = st.n_bytes_arena;
+  
+  return out;
+  }
+
+
+
+inline
+void
+memory_pool::reset_stats()
+  {
+  state& st = get_state();
+  
+  st.n_hits   = 0;
+  st.n_misses = 0;
+  }
+
+
+
+// 
+// memory_arena
+
+
+
+inline
+memory_arena::~memory_arena()
+  {
+  memory_pool::state& st = memory_pool::get_state();
+  
+  st.arena = prev_arena;
+  
+  st.n_bytes_arena -= n_used;
+  
+  while(head != nullptr)
+    {
+    chunk* next = head->next;
+    
+    memory::release_bytes( (void*)head );
+    
+    head = next;
+    }
+  }
+
+
+
+inline
+memory_arena::memory_arena(const size_t in_chunk_bytes)
+  : chunk_bytes( (std::max)(in_chunk_bytes, size_t(4096)) )
+  {
+  memory_pool::state& st = memory_pool::get_state();
+  
+  prev_arena = st.arena;
+  
+  st.arena = this;
+  }
+
+
+
+inline
+size_t
+memory_arena::n_bytes() const
+  {
+  return n_used;
+  }
+
+
+
+inline
+void*
+memory_arena::bump(const size_t n_bytes)
+  {
+  const size_t header_size = memory_pool::header_size;
+  
+  // keep every block aligned to header_size
+  const size_t block_bytes = header_size + ( (n_bytes + header_size - 1) / header_size ) * header_size;
+  
+  memory_pool::state& st = memory_pool::get_state();
+  
+  if( (cursor == nullptr) || (size_t(limit - cursor) < block_bytes) )
+    {
+    const size_t capacity = (std::max)(chunk_bytes, block_bytes);
+    
+    chunk* new_chunk = (chunk*) memory::acquire_bytes(header_size + capacity);
+    
+    if(new_chunk == nullptr)  { return nullptr; }
+    
+    new_chunk->next     = head;
+    new_chunk->capacity = capacity;
+    
+    head = new_chunk;
+    
+    cursor = ((unsigned char*)new_chunk) + header_size;
+    limit  = cursor + capacity;
+    
+    st.n_misses++;
+    }
+  else
+    {
+    st.n_hits++;
+    }
+  
+  memory_pool::header* h = (memory_pool::header*)cursor;
+  
+  h->next    = nullptr;
+  h->n_bytes = block_bytes - header_size;
+  h->kind    = 2;
+  h->bin     = 0;
+  
+  cursor += block_bytes;
+  n_used += block_bytes;
+  
+  st.n_bytes_arena += block_bytes;
+  
+  return (void*)( ((unsigned char*)h) + header_size );
+  }
+
+
+
+//! @}
@@ -0,0 +1,491 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup mp_backend
+//! @{
+
+
+
+
+//! executor supplied by the user, eg. to run tasks on the scheduler of a host application;
+//! it must call task(i) for each i in [0, n_tasks) and return once all calls have completed;
+//! the calls may run concurrently
+typedef std::function<void(uword n_tasks, const std::function<void(uword)>& task)> mp_executor_type;
+
+
+
+#if defined(ARMA_USE_THREAD_POOL)
+
+//! pool of worker threads for running the tasks of a parallel loop;
+//! the thread submitting a job also works on it;
+//! only one job runs at a time: jobs submitted from worker threads or while the pool is busy are declined
+class mp_thread_pool
+  {
+  public:
+  
+  typedef void (*task_fn_type)(void* ctx, const uword task_id);
+  
+  inline static mp_thread_pool& instance();
+  
+  inline static bool& in_worker();
+  
+  inline ~mp_thread_pool();
+  
+  inline uword n_workers() const;
+  
+  inline bool run(const uword n_tasks, task_fn_type task_fn, void* ctx);
+  
+  
+  private:
+  
+  inline mp_thread_pool();
+  
+  inline void worker_loop();
+  inline void work(task_fn_type task_fn, void* ctx, const uword n_tasks);
+  
+  std::vector<std::thread> workers;
+  
+  std::mutex              submit_mutex;
+  std::mutex              state_mutex;
+  std::condition_variable job_cv;
+  std::condition_variable done_cv;
+  
+  task_fn_type job_fn       = nullptr;
+  void*        job_ctx      = nullptr;
+  uword        job_n_tasks  = 0;
+  uword        job_id       = 0;
+  uword        n_active     = 0;
+  bool         stop_workers = false;
+  
+  std::atomic<uword> next_task{0};
+  std::atomic<uword> n_done{0};
+  };
+
+#endif
+
+
+
+//! selection of the backend used for parallel loops
+struct mp_backend
+  {
+  enum type
+    {
+    openmp      = 0,  //!< OpenMP (requires ARMA_USE_OPENMP)
+    thread_pool = 1,  //!< built-in pool of std::thread workers (requires ARMA_USE_THREAD_POOL)
+    executor    = 2   //!< executor supplied by the user via set_mp_executor()
+    };
+  
+  // the selection is read by worker threads, and can be changed at run time
+  #if (!defined(ARMA_DONT_USE_STD_MUTEX))
+    typedef std::atomic<int> state_type;
+  #else
+    typedef int state_type;
+  #endif
+  
+  inline static type get();
+  inline static bool set(const type backend);
+  
+  inline static mp_executor_type& user_executor();
+  inline static state_type&       executor_threads();
+  
+  inline static int  max_threads();
+  inline static bool in_parallel();
+  
+  
+  private:
+  
+  inline static state_type& state();
+  };
+
+
+
+//! evaluation of parallel loops with the selected backend
+struct mp_parallel
+  {
+  //! call fn(i) for each i in [0, n), using at most n_threads threads;
+  //! the range is split into contiguous chunks, one per thread
+  template<typename functor> inline static void run(const uword n, const int n_threads, const functor& fn);
+  
+  template<typename functor>
+  struct chunk_task
+    {
+    const functor& fn;
+    const uword    n;
+    const uword    n_chunks;
+    
+    inline static void run_chunk(void* ctx, const uword chunk);
+    };
+  };
+
+
+
+#if defined(ARMA_USE_THREAD_POOL)
+
+inline
+mp_thread_pool&
+mp_thread_pool::instance()
+  {
+  static mp_thread_pool pool;
+  
+  return pool;
+  }
+
+
+
+inline
+bool&
+mp_thread_pool::in_worker()
+  {
+  static thread_local bool flag = false;
+  
+  return flag;
+  }
+
+
+
+inline
+mp_thread_pool::mp_thread_pool()
+  {
+  const uword n_cores = uword(std::thread::hardware_concurrency());
+  
+  const uword n = (n_cores > 1) ? (n_cores - 1) : uword(0);
+  
+  workers.reserve(n);
+  
+  for(uword i=0; i < n; ++i)  { workers.push_back( std::thread(&mp_thread_pool::worker_loop, this) ); }
+  }
+
+
+
+inline
+mp_thread_pool::~mp_thread_pool()
+  {
+    {
+    std::lock_guard<std::mutex> lock(state_mutex);
+    
+    stop_workers = true;
+    }
+  
+  job_cv.notify_all();
+  
+  for(uword i=0; i < workers.size(); ++i)  { workers[i].join(); }
+  }
+
+
+
+inline
+uword
+mp_thread_pool::n_workers() const
+  {
+  return uword(workers.size());
+  }
+
+
+
+inline
+bool
+mp_thread_pool::run(const uword n_tasks, task_fn_type task_fn, void* ctx)
+  {
+  if( workers.empty() || in_worker() )  { return false; }
+  
+  std::unique_lock<std::mutex> submit_lock(submit_mutex, std::try_to_lock);
+  
+  if(submit_lock.owns_lock() == false)  { return false; }
+  
+    {
+    std::unique_lock<std::mutex> lock(state_mutex);
+    
+    // workers still leaving the previous job may not see the counters being reset
+    done_cv.wait(lock, [this] { return (n_active == 0); });
+    
+    job_fn      = task_fn;
+    job_ctx     = ctx;
+    job_n_tasks = n_tasks;
+    
+    next_task = 0;
+    n_done    = 0;
+    
+    ++job_id;
+    }
+  
+  job_cv.notify_all();
+  
+  work(task_fn, ctx, n_tasks);
+  
+    {
+    std::unique_lock<std::mutex> lock(state_mutex);
+    
+    done_cv.wait(lock, [this, n_tasks] { return (n_done == n_tasks); });
+    
+    job_fn  = nullptr;
+    job_ctx = nullptr;
+    }
+  
+  return true;
+  }
+
+
+
+inline
+void
+mp_thread_pool::worker_loop()
+  {
+  in_worker() = true;
+  
+  uword seen_job_id = 0;
+  
+  while(true)
+    {
+    task_fn_type task_fn = nullptr;
+    void*        ctx     = nullptr;
+    uword        n_tasks = 0;
+    
+      {
+      std::unique_lock<std::mutex> lock(state_mutex);
+      
+      job_cv.wait(lock, [this, &seen_job_id] { return (stop_workers || (job_id != seen_job_id)); });
+      
+      if(stop_workers)  { return; }
+      
+      seen_job_id = job_id;
+      
+      if(job_fn == nullptr)  { continue; }
+      
+      task_fn = job_fn;
+      ctx     = job_ctx;
+      n_tasks = job_n_tasks;
+      
+      ++n_active;
+      }
+    
+    work(task_fn, ctx, n_tasks);
+    
+      {
+      std::lock_guard<std::mutex> lock(state_mutex);
+      
+      --n_active;
+      }
+    
+    done_cv.notify_all();
+    }
+  }
+
+
+
+inline
+void
+mp_thread_pool::work(task_fn_type task_fn, void* ctx, const uword n_tasks)
+  {
+  while(true)
+    {
+    const uword task_id = next_task.fetch_add(1);
+    
+    if(task_id >= n_tasks)  { break; }
+    
+    task_fn(ctx, task_id);
+    
+    if( (n_done.fetch_add(1) + 1) == n_tasks )
+      {
+      std::lock_guard<std::mutex> lock(state_mutex);
+      
+      done_cv.notify_all();
+      }
+    }
+  }
+
+#endif
+
+
+
+inline
+mp_backend::state_type&
+mp_backend::state()
+  {
+  #if defined(ARMA_USE_OPENMP)
+    static state_type backend{ int(mp_backend::openmp) };
+  #else
+    static state_type backend{ int(mp_backend::thread_pool) };
+  #endif
+  
+  return backend;
+  }
+
+
+
+inline
+mp_backend::type
+mp_backend::get()
+  {
+  return mp_backend::type( int(mp_backend::state()) );
+  }
+
+
+
+//! returns false if the requested backend is not available
+inline
+bool
+mp_backend::set(const mp_backend::type backend)
+  {
+  bool ok = false;
+  
+  #if defined(ARMA_USE_OPENMP)
+    if(backend == mp_backend::openmp)  { ok = true; }
+  #endif
+  
+  #if defined(ARMA_USE_THREAD_POOL)
+    if(backend == mp_backend::thread_pool)  { ok = true; }
+  #endif
+  
+  #if defined(ARMA_USE_MP)
+    if( (backend == mp_backend::executor) && bool(mp_backend::user_executor()) )  { ok = true; }
+  #endif
+  
+  if(ok)  { mp_backend::state() = int(backend); }
+  
+  return ok;
+  }
+
+
+
+inline
+mp_executor_type&
+mp_backend::user_executor()
+  {
+  static mp_executor_type fn;
+  
+  return fn;
+  }
+
+
+
+//! number of tasks the executor can run concurrently
+inline
+mp_backend::state_type&
+mp_backend::executor_threads()
+  {
+  static state_type n_threads{ int(arma_config::mp_threads) };
+  
+  return n_threads;
+  }
+
+
+
+//! maximum number of threads the backend can use
+inline
+int
+mp_backend::max_threads()
+  {
+  #if defined(ARMA_USE_OPENMP)
+    if(mp_backend::get() == mp_backend::openmp)  { return (std::max)(int(1), int(omp_get_max_threads())); }
+  #endif
+  
+  #if defined(ARMA_USE_THREAD_POOL)
+    if(mp_backend::get() == mp_backend::thread_pool)  { return int(mp_thread_pool::instance().n_workers() + 1); }
+  #endif
+  
+  return (mp_backend::get() == mp_backend::executor) ? (std::max)(int(1), int(mp_backend::executor_threads())) : int(1);
+  }
+
+
+
+//! whether the calling thread is running a task of a parallel loop that does not allow nesting;
+//! an executor is expected to handle nested loops itself
+inline
+bool
+mp_backend::in_parallel()
+  {
+  #if defined(ARMA_USE_OPENMP)
+    if(mp_backend::get() == mp_backend::openmp)  { return bool(omp_in_parallel()); }
+  #endif
+  
+  #if defined(ARMA_USE_THREAD_POOL)
+    if(mp_backend::get() == mp_backend::thread_pool)  { return mp_thread_pool::in_worker(); }
+  #endif
+  
+  return false;
+  }
+
+
+
+template<typename functor>
+inline
+void
+mp_parallel::chunk_task<functor>::run_chunk(void* ctx, const uword chunk)
+  {
+  const chunk_task<functor>& task = *(static_cast<const chunk_task<functor>*>(ctx));
+  
+  const uword base = task.n / task.n_chunks;
+  const uword rem  = task.n % task.n_chunks;
+  
+  const uword start = chunk * base + ((chunk < rem) ? chunk : rem);
+  const uword endp1 = start + base + ((chunk < rem) ? uword(1) : uword(0));
+  
+  for(uword i=start; i < endp1; ++i)  { task.fn(i); }
+  }
+
+
+
+template<typename functor>
+inline
+void
+mp_parallel::run(const uword n, const int n_threads, const functor& fn)
+  {
+  const uword n_chunks = (std::min)(n, uword((std::max)(n_threads, int(1))));
+  
+  if(n_chunks <= 1)
+    {
+    for(uword i=0; i < n; ++i)  { fn(i); }
+    
+    return;
+    }
+  
+  #if defined(ARMA_USE_OPENMP)
+    if(mp_backend::get() == mp_backend::openmp)
+      {
+      #pragma omp parallel for schedule(static) num_threads(int(n_chunks))
+      for(uword i=0; i < n; ++i)  { fn(i); }
+      
+      return;
+      }
+  #endif
+  
+  chunk_task<functor> task = { fn, n, n_chunks };
+  
+  #if defined(ARMA_USE_MP)
+    if(mp_backend::get() == mp_backend::executor)
+      {
+      const mp_executor_type& exec = mp_backend::user_executor();
+      
+      exec(n_chunks, [&task](const uword chunk) { chunk_task<functor>::run_chunk(&task, chunk); });
+      
+      return;
+      }
+  #endif
+  
+  #if defined(ARMA_USE_THREAD_POOL)
+    if(mp_backend::get() == mp_backend::thread_pool)
+      {
+      if(mp_thread_pool::instance().run(n_chunks, &(chunk_task<functor>::run_chunk), &task))  { return; }
+      }
+  #endif
+  
+  for(uword chunk=0; chunk < n_chunks; ++chunk)  { chunk_task<functor>::run_chunk(&task, chunk); }
+  }
+
+
+
+//! @}
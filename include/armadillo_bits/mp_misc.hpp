@@ -22,6 +22,72 @@
 
 
 
+//! run-time settings for parallelisation
+class mp_state
+  {
+  public:
+  
+  //! estimated cost (CPU cycles per element) of element-wise functions such as exp();
+  //! the threshold is expressed as the number of elements for an operation of this cost
+  static constexpr uword cost_ref = 24;
+  
+  #if (!defined(ARMA_DONT_USE_STD_MUTEX))
+    typedef std::atomic<uword> state_type;
+  #else
+    typedef uword state_type;
+  #endif
+  
+  inline static state_type& threshold();
+  inline static state_type& threads();
+  
+  inline static uword measure_threshold();
+  
+  
+  private:
+  
+  inline static double time_ref_op(double* y, const double* x, const uword n_elem, const int n_threads);
+  };
+
+
+
+struct mp_thread_limit
+  {
+  arma_inline
+  static
+  int
+  get()
+    {
+    #if defined(ARMA_USE_MP)
+      int n_threads = (std::min)(int(uword(mp_state::threads())), mp_backend::max_threads());
+    #else
+      int n_threads = int(1);
+    #endif
+    
+    return n_threads;
+    }
+  
+  arma_inline
+  static
+  bool
+  in_parallel()
+    {
+    #if defined(ARMA_USE_MP)
+      {
+      return mp_backend::in_parallel();
+      }
+    #else
+      {
+      return false;
+      }
+    #endif
+    }
+  };
+
+
+
+//! decide whether an operation is worth parallelising:
+//! the number of elements, weighted by the estimated cost per element, is compared against the threshold;
+//! without an explicit cost, the operation is taken to have the reference cost (doubled for complex numbers)
 template<typename eT, const bool use_smaller_thresh = false>
 struct mp_gate
   {
@@ -30,13 +96,27 @@ struct mp_gate
   bool
   eval(const uword n_elem)
     {
-    #if defined(ARMA_USE_OPENMP)
+    return mp_gate<eT,use_smaller_thresh>::eval(n_elem, mp_state::cost_ref);
+    }
+  
+  
+  inline
+  static
+  bool
+  eval(const uword n_elem, const uword cost)
+    {
+    #if defined(ARMA_USE_MP)
       {
-      const bool length_ok = (is_cx<eT>::yes || use_smaller_thresh) ? (n_elem >= (arma_config::mp_threshold/uword(2))) : (n_elem >= arma_config::mp_threshold);
+      const uword eff_cost = (std::max)(cost, uword(1)) * ((is_cx<eT>::yes || use_smaller_thresh) ? uword(2) : uword(1));
+      
+      // floating point is used to avoid overflow
+      const bool length_ok = ( double(n_elem) * double(eff_cost) >= double(uword(mp_state::threshold())) * double(mp_state::cost_ref) );
       
       if(length_ok)
         {
-        if(omp_in_parallel())  { return false; }
+        if(mp_backend::in_parallel())  { return false; }
+        
+        if(mp_thread_limit::get() <= 1)  { return false; }
         }
       
       return length_ok;
@@ -44,6 +124,7 @@ struct mp_gate
     #else
       {
       arma_ignore(n_elem);
+      arma_ignore(cost);
       
       return false;
       }
@@ -53,38 +134,259 @@ struct mp_gate
 
 
 
-struct mp_thread_limit
+//! estimated cost per element of evaluating an expression; used by mp_gate
+template<typename T>
+struct mp_expr_cost
   {
-  arma_inline
-  static
-  int
-  get()
-    {
-    #if defined(ARMA_USE_OPENMP)
-      int n_threads = (std::min)(int(arma_config::mp_threads), int((std::max)(int(1), int(omp_get_max_threads()))));
-    #else
-      int n_threads = int(1);
-    #endif
-    
-    return n_threads;
-    }
+  static constexpr uword value = 0;
+  };
+
+
+template<typename T1, typename eop_type>
+struct mp_expr_cost< eOp<T1, eop_type> >
+  {
+  static constexpr uword value = mp_expr_cost<T1>::value + eop_type::mp_cost;
+  };
+
+
+template<typename T1, typename T2, typename eglue_type>
+struct mp_expr_cost< eGlue<T1, T2, eglue_type> >
+  {
+  static constexpr uword value = mp_expr_cost<T1>::value + mp_expr_cost<T2>::value + eglue_type::mp_cost;
+  };
+
+
+template<typename T1, typename eop_type>
+struct mp_expr_cost< eOpCube<T1, eop_type> >
+  {
+  static constexpr uword value = mp_expr_cost<T1>::value + eop_type::mp_cost;
+  };
+
+
+template<typename T1, typename T2, typename eglue_type>
+struct mp_expr_cost< eGlueCube<T1, T2, eglue_type> >
+  {
+  static constexpr uword value = mp_expr_cost<T1>::value + mp_expr_cost<T2>::value + eglue_type::mp_cost;
+  };
+
+
+
+inline
+mp_state::state_type&
+mp_state::threshold()
+  {
+  static state_type state{ arma_config::mp_calibrate ? mp_state::measure_threshold() : arma_config::mp_threshold };
   
-  arma_inline
-  static
-  bool
-  in_parallel()
+  return state;
+  }
+
+
+
+inline
+mp_state::state_type&
+mp_state::threads()
+  {
+  static state_type state{ arma_config::mp_threads };
+  
+  return state;
+  }
+
+
+
+//! time (in seconds) of evaluating exp() on n_elem elements, using the given number of threads;
+//! the minimum over several repetitions is taken
+inline
+double
+mp_state::time_ref_op(double* y, const double* x, const uword n_elem, const int n_threads)
+  {
+  typedef std::chrono::steady_clock clock_type;
+  
+  double t_min = std::numeric_limits<double>::max();
+  
+  for(uword rep=0; rep < 16; ++rep)
     {
-    #if defined(ARMA_USE_OPENMP)
+    const clock_type::time_point t0 = clock_type::now();
+    
+    #if defined(ARMA_USE_MP)
       {
-      return bool(omp_in_parallel());
+      mp_parallel::run(n_elem, n_threads, [&](const uword i) { y[i] = std::exp(x[i]); });
       }
     #else
       {
-      return false;
+      arma_ignore(n_threads);
+      
+      for(uword i=0; i < n_elem; ++i)  { y[i] = std::exp(x[i]); }
       }
     #endif
+    
+    t_min = (std::min)(t_min, std::chrono::duration<double>(clock_type::now() - t0).count());
     }
-  };
+  
+  return t_min;
+  }
+
+
+
+//! measure the time taken by an operation of reference cost (exp), with and without threads;
+//! returns the number of elements for which parallelisation is expected to pay off
+inline
+uword
+mp_state::measure_threshold()
+  {
+  #if defined(ARMA_USE_MP)
+    {
+    const int n_threads = mp_thread_limit::get();
+    
+    if( (n_threads <= 1) || mp_thread_limit::in_parallel() )  { return arma_config::mp_threshold; }
+    
+    const uword n_small = 1024;
+    const uword n_large = 32768;
+    
+    std::vector<double> x(n_large);
+    std::vector<double> y(n_large);
+    
+    for(uword i=0; i < n_large; ++i)  { x[i] = double(i) / double(n_large); }
+    
+    // model: serial time = n * t_elem;  parallel time = overhead + n * t_elem_mp
+    
+    const double t_elem = mp_state::time_ref_op(y.data(), x.data(), n_large, 1) / double(n_large);
+    
+    const double t_mp_small = mp_state::time_ref_op(y.data(), x.data(), n_small, n_threads);
+    const double t_mp_large = mp_state::time_ref_op(y.data(), x.data(), n_large, n_threads);
+    
+    const double t_elem_mp = (std::max)(double(0), (t_mp_large - t_mp_small) / double(n_large - n_small));
+    const double overhead  = (std::max)(double(0), t_mp_small - double(n_small) * t_elem_mp);
+    
+    // threads do not help, eg. when there are more threads than cores
+    if(t_elem_mp >= t_elem)  { return uword(1) << 24; }
+    
+    // require the saved time to be at least twice the overhead
+    const double n_min = double(2) * overhead / (t_elem - t_elem_mp);
+    
+    return uword( (std::min)( (std::max)(n_min, double(16)), double(uword(1) << 24) ) );
+    }
+  #else
+    {
+    return arma_config::mp_threshold;
+    }
+  #endif
+  }
+
+
+
+//! set the minimum number of elements for parallelisation of element-wise functions with a cost similar to exp();
+//! cheaper and more expensive operations are scaled by their estimated cost;
+//! 0 restores the default (ARMA_OPENMP_THRESHOLD)
+inline
+void
+set_mp_threshold(const uword n_elem)
+  {
+  mp_state::threshold() = (n_elem > 0) ? n_elem : uword(arma_config::mp_threshold);
+  }
+
+
+
+inline
+uword
+get_mp_threshold()
+  {
+  return uword(mp_state::threshold());
+  }
+
+
+
+//! set the maximum number of threads for parallelisation;
+//! 0 restores the default (ARMA_OPENMP_THREADS)
+inline
+void
+set_mp_threads(const uword n_threads)
+  {
+  mp_state::threads() = (n_threads > 0) ? n_threads : uword(arma_config::mp_threads);
+  }
+
+
+
+inline
+uword
+get_mp_threads()
+  {
+  return uword(mp_state::threads());
+  }
+
+
+
+//! measure the overhead of parallelisation on this machine and set the threshold accordingly;
+//! returns the new threshold
+inline
+uword
+calibrate_mp_threshold()
+  {
+  const uword n_elem = mp_state::measure_threshold();
+  
+  mp_state::threshold() = n_elem;
+  
+  return n_elem;
+  }
+
+
+
+//! select the backend for parallel loops: mp_backend::openmp, mp_backend::thread_pool or mp_backend::executor;
+//! returns false if the backend is not available
+inline
+bool
+set_mp_backend(const mp_backend::type backend)
+  {
+  return mp_backend::set(backend);
+  }
+
+
+
+inline
+mp_backend::type
+get_mp_backend()
+  {
+  return mp_backend::get();
+  }
+
+
+
+//! register an executor for parallel loops and select it as the backend;
+//! n_threads is the number of tasks the executor can run concurrently (0: use ARMA_OPENMP_THREADS);
+//! an empty executor restores the default backend;
+//! must not be called while a parallel loop is running, as the executor itself is not replaced atomically
+inline
+void
+set_mp_executor(const mp_executor_type& exec, const uword n_threads = 0)
+  {
+  mp_backend::user_executor()    = exec;
+  mp_backend::executor_threads() = int( (n_threads > 0) ? n_threads : uword(arma_config::mp_threads) );
+  
+  if(exec)
+    {
+    mp_backend::set(mp_backend::executor);
+    }
+  else
+    {
+    if(mp_backend::set(mp_backend::openmp) == false)  { mp_backend::set(mp_backend::thread_pool); }
+    }
+  }
+
+
+
+//! call fn(i) for each i in [0, n) using the selected backend;
+//! the calls may run concurrently, in chunks of at least grain indices;
+//! nested calls and calls with too little work run serially
+template<typename functor>
+inline
+void
+parallel_for(const uword n, const uword grain, const functor& fn)
+  {
+  const uword n_chunks_max = (grain > 1) ? ((n + grain - 1) / grain) : n;
+  
+  const int n_threads = (mp_thread_limit::in_parallel()) ? int(1) : int( (std::min)(uword(mp_thread_limit::get()), n_chunks_max) );
+  
+  mp_parallel::run(n, n_threads, fn);
+  }
 
 
 
@@ -197,7 +197,16 @@ class gemm_emul
     arma_extra_debug_sigprint();
     arma_ignore(junk);
     
-    gemm_emul_large<do_trans_A, do_trans_B, use_alpha, use_beta>::apply(C, A, B, alpha, beta);
+    const uword K = (do_trans_A) ? A.n_rows : A.n_cols;
+    
+    if(gemm_emul_blocked<do_trans_A, do_trans_B, use_alpha, use_beta>::template use<eT>(C.n_rows, C.n_cols, K))
+      {
+      gemm_emul_blocked<do_trans_A, do_trans_B, use_alpha, use_beta>::apply(C, A, B, alpha, beta);
+      }
+    else
+      {
+      gemm_emul_large<do_trans_A, do_trans_B, use_alpha, use_beta>::apply(C, A, B, alpha, beta);
+      }
     }
   
   
@@ -220,6 +229,16 @@ class gemm_emul
     arma_extra_debug_sigprint();
     arma_ignore(junk);
     
+    const uword K = (do_trans_A) ? A.n_rows : A.n_cols;
+    
+    if(gemm_emul_blocked<do_trans_A, do_trans_B, use_alpha, use_beta>::template use<eT>(C.n_rows, C.n_cols, K))
+      {
+      // hermitian transposes are handled while packing
+      gemm_emul_blocked<do_trans_A, do_trans_B, use_alpha, use_beta>::apply(C, A, B, alpha, beta);
+      
+      return;
+      }
+    
     // "better than nothing" handling of hermitian transposes for complex number matrices
     
     Mat<eT> tmp_A;
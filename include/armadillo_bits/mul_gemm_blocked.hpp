@@ -0,0 +1,449 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup gemm
+//! @{
+
+
+
+//! block sizes used by gemm_emul_blocked
+template<typename eT>
+struct gemm_emul_blocked_params
+  {
+  #if defined(__AVX512F__)
+    static constexpr uword n_bytes = 64;  //!< width of the vector registers
+  #elif defined(__AVX__)
+    static constexpr uword n_bytes = 32;
+  #else
+    static constexpr uword n_bytes = 16;
+  #endif
+  
+  #if defined(ARMA_GOOD_COMPILER)
+    static constexpr bool simd = (is_same_type<eT,float>::yes || is_same_type<eT,double>::yes);  //!< use the vector extensions of GCC and Clang
+  #else
+    static constexpr bool simd = false;
+  #endif
+  
+  //! rows of a micro-tile; two vector registers when simd is enabled
+  static constexpr uword mr = (simd) ? (2 * n_bytes / sizeof(eT)) : ( (sizeof(eT) <= 8) ? 8 : 4 );
+  
+  //! columns of a micro-tile
+  static constexpr uword nr = (simd || (sizeof(eT) <= 8)) ? 4 : 2;
+  
+  static constexpr uword kc = 256;   //!< depth of the packed panels; a kc x nr sliver of B stays in L1
+  static constexpr uword nc = 2048;  //!< columns of the packed panel of B, which stays in L3
+  
+  //! rows of the packed block of A, which stays in L2 (about 128 KB)
+  static constexpr uword mc = ( (131072 / (kc * sizeof(eT))) > mr ) ? ( (131072 / (kc * sizeof(eT))) / mr ) * mr : mr;
+  
+  //! smaller multiplications (m*n*k) are handled by gemm_emul_large
+  static constexpr uword min_work = 48*48*48;
+  };
+
+
+
+//! product of a packed panel of A (mr x k) and a packed sliver of B (k x nr); the mr x nr result is stored column by column
+template<typename eT, const bool simd = gemm_emul_blocked_params<eT>::simd>
+struct gemm_emul_blocked_kernel
+  {
+  arma_hot
+  inline
+  static
+  void
+  apply(eT* out, const uword k, const eT* A_panel, const eT* B_sliver)
+    {
+    const uword mr = gemm_emul_blocked_params<eT>::mr;
+    const uword nr = gemm_emul_blocked_params<eT>::nr;
+    
+    for(uword i=0; i < mr*nr; ++i)  { out[i] = eT(0); }
+    
+    for(uword p=0; p < k; ++p)
+      {
+      const eT* a = &(A_panel[p * mr]);
+      const eT* b = &(B_sliver[p * nr]);
+      
+      for(uword c=0; c < nr; ++c)
+        {
+        const eT b_val = b[c];
+        
+        eT* out_col = &(out[c * mr]);
+        
+        for(uword r=0; r < mr; ++r)  { madd(out_col[r], a[r], b_val); }
+        }
+      }
+    }
+  
+  
+  
+  template<typename T>
+  arma_inline
+  static
+  void
+  madd(T& acc, const T a, const T b)
+    {
+    acc += a*b;
+    }
+  
+  
+  
+  //! avoids the checks for infinities and NaNs done by the standard complex multiplication
+  template<typename T>
+  arma_inline
+  static
+  void
+  madd(std::complex<T>& acc, const std::complex<T>& a, const std::complex<T>& b)
+    {
+    const T a_re = a.real();
+    const T a_im = a.imag();
+    
+    const T b_re = b.real();
+    const T b_im = b.imag();
+    
+    acc = std::complex<T>( acc.real() + (a_re*b_re - a_im*b_im), acc.imag() + (a_re*b_im + a_im*b_re) );
+    }
+  };
+
+
+
+#if defined(ARMA_GOOD_COMPILER)
+
+//! register-tiled variant for float and double: the 2 x 4 tile of vector accumulators is held in registers
+template<typename eT>
+struct gemm_emul_blocked_kernel<eT, true>
+  {
+  static constexpr uword n_bytes = gemm_emul_blocked_params<eT>::n_bytes;
+  static constexpr uword n_lanes = n_bytes / sizeof(eT);
+  
+  typedef eT vT __attribute__((__vector_size__(n_bytes)));
+  
+  arma_hot
+  inline
+  static
+  void
+  apply(eT* out, const uword k, const eT* A_panel, const eT* B_sliver)
+    {
+    vT c00 = vT{};  vT c01 = vT{};  vT c02 = vT{};  vT c03 = vT{};
+    vT c10 = vT{};  vT c11 = vT{};  vT c12 = vT{};  vT c13 = vT{};
+    
+    for(uword p=0; p < k; ++p)
+      {
+      const eT* a = &(A_panel[p * 2 * n_lanes]);
+      const eT* b = &(B_sliver[p * 4]);
+      
+      vT a0;  std::memcpy(&a0, &(a[0      ]), sizeof(vT));
+      vT a1;  std::memcpy(&a1, &(a[n_lanes]), sizeof(vT));
+      
+      const eT b0 = b[0];
+      const eT b1 = b[1];
+      const eT b2 = b[2];
+      const eT b3 = b[3];
+      
+      c00 += a0 * b0;  c10 += a1 * b0;
+      c01 += a0 * b1;  c11 += a1 * b1;
+      c02 += a0 * b2;  c12 += a1 * b2;
+      c03 += a0 * b3;  c13 += a1 * b3;
+      }
+    
+    std::memcpy(&(out[0*n_lanes]), &c00, sizeof(vT));  std::memcpy(&(out[1*n_lanes]), &c10, sizeof(vT));
+    std::memcpy(&(out[2*n_lanes]), &c01, sizeof(vT));  std::memcpy(&(out[3*n_lanes]), &c11, sizeof(vT));
+    std::memcpy(&(out[4*n_lanes]), &c02, sizeof(vT));  std::memcpy(&(out[5*n_lanes]), &c12, sizeof(vT));
+    std::memcpy(&(out[6*n_lanes]), &c03, sizeof(vT));  std::memcpy(&(out[7*n_lanes]), &c13, sizeof(vT));
+    }
+  };
+
+#endif
+
+
+
+//! \brief
+//! Cache-blocked emulation of gemm(), used when BLAS is not available.
+//! Panels of op(A) and op(B) are packed into contiguous buffers sized for the L1/L2/L3 caches,
+//! and multiplied via a register-tiled micro-kernel.
+//! The macro-tiles of C are processed in parallel when ARMA_USE_MP is enabled.
+//! op(X) is trans(X) for real matrices and the hermitian transpose for complex matrices.
+//! Matrix 'C' is assumed to have been set to the correct size (ie. taking into account transposes)
+
+template<const bool do_trans_A=false, const bool do_trans_B=false, const bool use_alpha=false, const bool use_beta=false>
+class gemm_emul_blocked
+  {
+  public:
+  
+  template<typename eT>
+  arma_inline
+  static
+  bool
+  use(const uword M, const uword N, const uword K)
+    {
+    return ( (M >= gemm_emul_blocked_params<eT>::mr) && (N >= gemm_emul_blocked_params<eT>::nr) && (double(M) * double(N) * double(K) >= double(gemm_emul_blocked_params<eT>::min_work)) );
+    }
+  
+  
+  
+  template<typename eT, typename TA, typename TB>
+  arma_hot
+  inline
+  static
+  void
+  apply
+    (
+          Mat<eT>& C,
+    const TA&      A,
+    const TB&      B,
+    const eT       alpha = eT(1),
+    const eT       beta  = eT(0)
+    )
+    {
+    arma_extra_debug_sigprint();
+    
+    typedef gemm_emul_blocked_params<eT> params;
+    
+    const uword mr = params::mr;
+    const uword nr = params::nr;
+    const uword kc = params::kc;
+    const uword mc = params::mc;
+    const uword nc = params::nc;
+    
+    const uword M = C.n_rows;
+    const uword N = C.n_cols;
+    const uword K = (do_trans_A) ? A.n_rows : A.n_cols;
+    
+    if(K == 0)
+      {
+      if(use_beta)  { arrayops::inplace_mul(C.memptr(), beta, C.n_elem); }  else  { C.zeros(); }
+      
+      return;
+      }
+    
+    const uword n_ic = (M + mc - 1) / mc;
+    
+    int n_threads = 1;
+    
+    #if defined(ARMA_USE_MP)
+      {
+      // each element of C costs K multiply-adds
+      if(mp_gate<eT>::eval(C.n_elem, K))  { n_threads = mp_thread_limit::get(); }
+      }
+    #endif
+    
+    podarray<eT> B_packed( (std::min)(kc, K) * ((std::min)(nc, N) + nr) );
+    
+    for(uword jc=0; jc < N; jc += nc)
+      {
+      const uword nc_cur = (std::min)(nc, N - jc);
+      const uword n_jr   = (nc_cur + nr - 1) / nr;
+      
+      // with few blocks of rows, the columns of the panel are also split between the threads
+      const uword n_jg = (n_ic >= uword(n_threads)) ? uword(1) : (std::min)(n_jr, (uword(n_threads) + n_ic - 1) / n_ic);
+      
+      for(uword pc=0; pc < K; pc += kc)
+        {
+        const uword kc_cur = (std::min)(kc, K - pc);
+        
+        const bool first = (pc == 0);
+        
+        pack_B(B_packed.memptr(), B, pc, kc_cur, jc, nc_cur);
+        
+        const eT* B_mem = B_packed.memptr();
+        
+        mp_parallel::run(n_ic * n_jg, n_threads, [&](const uword task)
+          {
+          const uword ic = (task % n_ic) * mc;
+          const uword jg = (task / n_ic);
+          
+          const uword mc_cur = (std::min)(mc, M - ic);
+          
+          const uword jr_start = (jg * n_jr) / n_jg;
+          const uword jr_end   = ((jg+1) * n_jr) / n_jg;
+          
+          if(jr_start >= jr_end)  { return; }
+          
+          podarray<eT> A_packed(kc_cur * (mc_cur + mr));
+          
+          pack_A(A_packed.memptr(), A, ic, mc_cur, pc, kc_cur);
+          
+          for(uword jr=jr_start; jr < jr_end; ++jr)
+            {
+            const uword j     = jr * nr;
+            const uword n_cur = (std::min)(nr, nc_cur - j);
+            
+            const eT* B_sliver = &(B_mem[jr * kc_cur * nr]);
+            
+            for(uword i=0; i < mc_cur; i += mr)
+              {
+              const uword m_cur = (std::min)(mr, mc_cur - i);
+              
+              micro_kernel(kc_cur, &(A_packed[(i/mr) * kc_cur * mr]), B_sliver, C.colptr(jc + j) + (ic + i), C.n_rows, m_cur, n_cur, alpha, beta, first);
+              }
+            }
+          } );
+        }
+      }
+    }
+  
+  
+  
+  private:
+  
+  //! copy rows [i0, i0+m) and columns [p0, p0+k) of op(A) into panels of mr rows; each panel is stored column by column
+  template<typename eT, typename TA>
+  inline
+  static
+  void
+  pack_A(eT* out, const TA& A, const uword i0, const uword m, const uword p0, const uword k)
+    {
+    const uword mr = gemm_emul_blocked_params<eT>::mr;
+    
+    for(uword i=0; i < m; i += mr)
+      {
+      const uword m_cur = (std::min)(mr, m - i);
+      
+      eT* panel = &(out[(i/mr) * k * mr]);
+      
+      if(do_trans_A == false)
+        {
+        for(uword p=0; p < k; ++p)
+          {
+          const eT* A_col = &(A.colptr(p0 + p)[i0 + i]);
+          
+          eT* panel_col = &(panel[p * mr]);
+          
+          uword r=0;
+          
+          for(; r < m_cur; ++r)  { panel_col[r] = A_col[r]; }
+          for(; r < mr;    ++r)  { panel_col[r] = eT(0);    }
+          }
+        }
+      else
+        {
+        for(uword r=0; r < mr; ++r)
+          {
+          if(r < m_cur)
+            {
+            const eT* A_col = &(A.colptr(i0 + i + r)[p0]);
+            
+            for(uword p=0; p < k; ++p)  { panel[p * mr + r] = access::alt_conj(A_col[p]); }
+            }
+          else
+            {
+            for(uword p=0; p < k; ++p)  { panel[p * mr + r] = eT(0); }
+            }
+          }
+        }
+      }
+    }
+  
+  
+  
+  //! copy rows [p0, p0+k) and columns [j0, j0+n) of op(B) into slivers of nr columns; each sliver is stored row by row
+  template<typename eT, typename TB>
+  inline
+  static
+  void
+  pack_B(eT* out, const TB& B, const uword p0, const uword k, const uword j0, const uword n)
+    {
+    const uword nr = gemm_emul_blocked_params<eT>::nr;
+    
+    for(uword j=0; j < n; j += nr)
+      {
+      const uword n_cur = (std::min)(nr, n - j);
+      
+      eT* sliver = &(out[(j/nr) * k * nr]);
+      
+      if(do_trans_B == false)
+        {
+        for(uword c=0; c < nr; ++c)
+          {
+          if(c < n_cur)
+            {
+            const eT* B_col = &(B.colptr(j0 + j + c)[p0]);
+            
+            for(uword p=0; p < k; ++p)  { sliver[p * nr + c] = B_col[p]; }
+            }
+          else
+            {
+            for(uword p=0; p < k; ++p)  { sliver[p * nr + c] = eT(0); }
+            }
+          }
+        }
+      else
+        {
+        for(uword p=0; p < k; ++p)
+          {
+          const eT* B_col = &(B.colptr(p0 + p)[j0 + j]);
+          
+          eT* sliver_row = &(sliver[p * nr]);
+          
+          uword c=0;
+          
+          for(; c < n_cur; ++c)  { sliver_row[c] = access::alt_conj(B_col[c]); }
+          for(; c < nr;    ++c)  { sliver_row[c] = eT(0);                      }
+          }
+        }
+      }
+    }
+  
+  
+  
+  //! C(0:m_cur, 0:n_cur) = alpha * A_panel * B_sliver + (beta * C  or  C)
+  template<typename eT>
+  arma_hot
+  inline
+  static
+  void
+  micro_kernel
+    (
+    const uword k,
+    const eT*   A_panel,
+    const eT*   B_sliver,
+          eT*   C_mem,
+    const uword ldc,
+    const uword m_cur,
+    const uword n_cur,
+    const eT    alpha,
+    const eT    beta,
+    const bool  first
+    )
+    {
+    const uword mr = gemm_emul_blocked_params<eT>::mr;
+    const uword nr = gemm_emul_blocked_params<eT>::nr;
+    
+    arma_aligned eT acc[mr*nr];
+    
+    gemm_emul_blocked_kernel<eT>::apply(acc, k, A_panel, B_sliver);
+    
+    for(uword c=0; c < n_cur; ++c)
+      {
+      eT* C_col = &(C_mem[c * ldc]);
+      
+      const eT* acc_col = &(acc[c * mr]);
+      
+      for(uword r=0; r < m_cur; ++r)
+        {
+        const eT val = (use_alpha) ? eT(alpha * acc_col[r]) : acc_col[r];
+        
+             if(first == false)  { C_col[r] += val;                  }
+        else if(use_beta)        { C_col[r]  = val + beta*C_col[r]; }
+        else                     { C_col[r]  = val;                  }
+        }
+      }
+    }
+  
+  };
+
+
+
+//! @}
@@ -58,7 +58,7 @@ class gemm_mixed_large
       podarray<in_eT1> tmp(A_n_cols);
       in_eT1* A_rowdata = tmp.memptr();
       
-      #if defined(ARMA_USE_OPENMP)
+      #if defined(ARMA_USE_MP)
       const bool use_mp = (B_n_cols >= 2) && (B.n_elem >= 8192) && (mp_thread_limit::in_parallel() == false);
       #else
       const bool use_mp = false;
@@ -66,7 +66,7 @@ class gemm_mixed_large
       
       if(use_mp)
         {
-        #if defined(ARMA_USE_OPENMP)
+        #if defined(ARMA_USE_MP)
           {
           const int n_threads = int( (std::min)( uword(mp_thread_limit::get()), uword(B_n_cols) ) );
           
@@ -74,8 +74,7 @@ class gemm_mixed_large
             {
             tmp.copy_row(A, row_A);
             
-            #pragma omp parallel for schedule(static) num_threads(n_threads)
-            for(uword col_B=0; col_B < B_n_cols; ++col_B)
+            mp_parallel::run(B_n_cols, n_threads, [&](const uword col_B)
               {
               const in_eT2* B_coldata = B.colptr(col_B);
               
@@ -89,7 +88,7 @@ class gemm_mixed_large
               else if( (use_alpha == true ) && (use_beta == false) )  { C.at(row_A,col_B) = alpha*acc;                          }
               else if( (use_alpha == false) && (use_beta == true ) )  { C.at(row_A,col_B) =       acc + beta*C.at(row_A,col_B); }
               else if( (use_alpha == true ) && (use_beta == true ) )  { C.at(row_A,col_B) = alpha*acc + beta*C.at(row_A,col_B); }
-              }
+              });
             }
           }
         #endif
@@ -121,7 +120,7 @@ class gemm_mixed_large
     else
     if( (do_trans_A == true) && (do_trans_B == false) )
       {
-      #if defined(ARMA_USE_OPENMP)
+      #if defined(ARMA_USE_MP)
       const bool use_mp = (B_n_cols >= 2) && (B.n_elem >= 8192) && (mp_thread_limit::in_parallel() == false);
       #else
       const bool use_mp = false;
@@ -129,7 +128,7 @@ class gemm_mixed_large
       
       if(use_mp)
         {
-        #if defined(ARMA_USE_OPENMP)
+        #if defined(ARMA_USE_MP)
           {
           const int n_threads = int( (std::min)( uword(mp_thread_limit::get()), uword(B_n_cols) ) );
           
@@ -139,8 +138,7 @@ class gemm_mixed_large
             
             const in_eT1* A_coldata = A.colptr(col_A);
             
-            #pragma omp parallel for schedule(static) num_threads(n_threads)
-            for(uword col_B=0; col_B < B_n_cols; ++col_B)
+            mp_parallel::run(B_n_cols, n_threads, [&](const uword col_B)
               {
               const in_eT2* B_coldata = B.colptr(col_B);
               
@@ -154,7 +152,7 @@ class gemm_mixed_large
               else if( (use_alpha == true ) && (use_beta == false) )  { C.at(col_A,col_B) = alpha*acc;                          }
               else if( (use_alpha == false) && (use_beta == true ) )  { C.at(col_A,col_B) =       acc + beta*C.at(col_A,col_B); }
               else if( (use_alpha == true ) && (use_beta == true ) )  { C.at(col_A,col_B) = alpha*acc + beta*C.at(col_A,col_B); }
-              }
+              });
             }
           }
         #endif
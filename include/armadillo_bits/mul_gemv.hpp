@@ -229,6 +229,13 @@ class gemv_emul
     const uword A_n_rows = A.n_rows;
     const uword A_n_cols = A.n_cols;
     
+    if(gemv_emul_blocked<do_trans_A, use_alpha, use_beta>::template use<eT>(A_n_rows, A_n_cols))
+      {
+      gemv_emul_blocked<do_trans_A, use_alpha, use_beta>::apply(y, A, x, alpha, beta);
+      
+      return;
+      }
+    
     if(do_trans_A == false)
       {
       if(A_n_rows == 1)
@@ -0,0 +1,495 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup gemv
+//! @{
+
+
+
+template<typename eT>
+struct gemv_emul_blocked_params
+  {
+  #if defined(__AVX512F__)
+    static constexpr uword n_bytes = 64;  //!< width of the vector registers
+  #elif defined(__AVX__)
+    static constexpr uword n_bytes = 32;
+  #else
+    static constexpr uword n_bytes = 16;
+  #endif
+  
+  #if defined(ARMA_GOOD_COMPILER)
+    static constexpr bool simd = (is_same_type<eT,float>::yes || is_same_type<eT,double>::yes);
+  #else
+    static constexpr bool simd = false;
+  #endif
+  
+  static constexpr uword block_rows = 2048;  //!< rows of A (and elements of x or y) processed at a time; the block of x or y stays in L1
+  
+  static constexpr uword min_n_elem = 4096;  //!< smaller matrices are handled by gemv_emul
+  };
+
+
+
+//! kernels used by gemv_emul_blocked; the dot products use the complex conjugate of the columns of A
+template<typename eT, const bool simd = gemv_emul_blocked_params<eT>::simd>
+struct gemv_emul_blocked_kernel
+  {
+  template<typename T>
+  arma_inline
+  static
+  void
+  madd(T& acc, const T a, const T b)
+    {
+    acc += a*b;
+    }
+  
+  
+  
+  //! avoids the checks for infinities and NaNs done by the standard complex multiplication
+  template<typename T>
+  arma_inline
+  static
+  void
+  madd(std::complex<T>& acc, const std::complex<T>& a, const std::complex<T>& b)
+    {
+    acc = std::complex<T>( acc.real() + (a.real()*b.real() - a.imag()*b.imag()), acc.imag() + (a.real()*b.imag() + a.imag()*b.real()) );
+    }
+  
+  
+  
+  //! y += a0*x0 + a1*x1 + a2*x2 + a3*x3
+  arma_hot
+  inline
+  static
+  void
+  axpy4(eT* y, const uword n, const eT* a0, const eT* a1, const eT* a2, const eT* a3, const eT x0, const eT x1, const eT x2, const eT x3)
+    {
+    for(uword i=0; i < n; ++i)
+      {
+      eT acc = y[i];
+      
+      madd(acc, a0[i], x0);
+      madd(acc, a1[i], x1);
+      madd(acc, a2[i], x2);
+      madd(acc, a3[i], x3);
+      
+      y[i] = acc;
+      }
+    }
+  
+  
+  
+  //! y += a0*x0
+  arma_hot
+  inline
+  static
+  void
+  axpy1(eT* y, const uword n, const eT* a0, const eT x0)
+    {
+    for(uword i=0; i < n; ++i)  { madd(y[i], a0[i], x0); }
+    }
+  
+  
+  
+  //! out[k] += dot(conj(ak), x), for k = 0,...,3
+  arma_hot
+  inline
+  static
+  void
+  dot4(eT* out, const uword n, const eT* a0, const eT* a1, const eT* a2, const eT* a3, const eT* x)
+    {
+    eT acc0 = eT(0);
+    eT acc1 = eT(0);
+    eT acc2 = eT(0);
+    eT acc3 = eT(0);
+    
+    for(uword i=0; i < n; ++i)
+      {
+      const eT xi = x[i];
+      
+      madd(acc0, access::alt_conj(a0[i]), xi);
+      madd(acc1, access::alt_conj(a1[i]), xi);
+      madd(acc2, access::alt_conj(a2[i]), xi);
+      madd(acc3, access::alt_conj(a3[i]), xi);
+      }
+    
+    out[0] += acc0;
+    out[1] += acc1;
+    out[2] += acc2;
+    out[3] += acc3;
+    }
+  
+  
+  
+  //! returns dot(conj(a0), x)
+  arma_hot
+  inline
+  static
+  eT
+  dot1(const uword n, const eT* a0, const eT* x)
+    {
+    eT acc1 = eT(0);
+    eT acc2 = eT(0);
+    
+    uword i, j;
+    
+    for(i=0, j=1; j < n; i+=2, j+=2)
+      {
+      madd(acc1, access::alt_conj(a0[i]), x[i]);
+      madd(acc2, access::alt_conj(a0[j]), x[j]);
+      }
+    
+    if(i < n)  { madd(acc1, access::alt_conj(a0[i]), x[i]); }
+    
+    return (acc1 + acc2);
+    }
+  };
+
+
+
+#if defined(ARMA_GOOD_COMPILER)
+
+//! variant for float and double, using the vector extensions of GCC and Clang
+template<typename eT>
+struct gemv_emul_blocked_kernel<eT, true>
+  {
+  static constexpr uword n_bytes = gemv_emul_blocked_params<eT>::n_bytes;
+  static constexpr uword n_lanes = n_bytes / sizeof(eT);
+  
+  typedef eT vT __attribute__((__vector_size__(n_bytes)));
+  
+  
+  arma_inline
+  static
+  eT
+  sum(const vT& v)
+    {
+    eT acc = eT(0);
+    
+    for(uword k=0; k < n_lanes; ++k)  { acc += v[k]; }
+    
+    return acc;
+    }
+  
+  
+  
+  arma_hot
+  inline
+  static
+  void
+  axpy4(eT* y, const uword n, const eT* a0, const eT* a1, const eT* a2, const eT* a3, const eT x0, const eT x1, const eT x2, const eT x3)
+    {
+    uword i = 0;
+    
+    for(; (i + n_lanes) <= n; i += n_lanes)
+      {
+      vT v;   std::memcpy(&v,  &( y[i]), sizeof(vT));
+      vT v0;  std::memcpy(&v0, &(a0[i]), sizeof(vT));
+      vT v1;  std::memcpy(&v1, &(a1[i]), sizeof(vT));
+      vT v2;  std::memcpy(&v2, &(a2[i]), sizeof(vT));
+      vT v3;  std::memcpy(&v3, &(a3[i]), sizeof(vT));
+      
+      v += (v0 * x0 + v1 * x1) + (v2 * x2 + v3 * x3);
+      
+      std::memcpy(&(y[i]), &v, sizeof(vT));
+      }
+    
+    for(; i < n; ++i)  { y[i] += (a0[i] * x0 + a1[i] * x1) + (a2[i] * x2 + a3[i] * x3); }
+    }
+  
+  
+  
+  arma_hot
+  inline
+  static
+  void
+  axpy1(eT* y, const uword n, const eT* a0, const eT x0)
+    {
+    uword i = 0;
+    
+    for(; (i + n_lanes) <= n; i += n_lanes)
+      {
+      vT v;   std::memcpy(&v,  &( y[i]), sizeof(vT));
+      vT v0;  std::memcpy(&v0, &(a0[i]), sizeof(vT));
+      
+      v += v0 * x0;
+      
+      std::memcpy(&(y[i]), &v, sizeof(vT));
+      }
+    
+    for(; i < n; ++i)  { y[i] += a0[i] * x0; }
+    }
+  
+  
+  
+  arma_hot
+  inline
+  static
+  void
+  dot4(eT* out, const uword n, const eT* a0, const eT* a1, const eT* a2, const eT* a3, const eT* x)
+    {
+    vT acc0 = vT{};
+    vT acc1 = vT{};
+    vT acc2 = vT{};
+    vT acc3 = vT{};
+    
+    uword i = 0;
+    
+    for(; (i + n_lanes) <= n; i += n_lanes)
+      {
+      vT vx;  std::memcpy(&vx, &( x[i]), sizeof(vT));
+      vT v0;  std::memcpy(&v0, &(a0[i]), sizeof(vT));
+      vT v1;  std::memcpy(&v1, &(a1[i]), sizeof(vT));
+      vT v2;  std::memcpy(&v2, &(a2[i]), sizeof(vT));
+      vT v3;  std::memcpy(&v3, &(a3[i]), sizeof(vT));
+      
+      acc0 += v0 * vx;
+      acc1 += v1 * vx;
+      acc2 += v2 * vx;
+      acc3 += v3 * vx;
+      }
+    
+    eT s0 = sum(acc0);
+    eT s1 = sum(acc1);
+    eT s2 = sum(acc2);
+    eT s3 = sum(acc3);
+    
+    for(; i < n; ++i)
+      {
+      const eT xi = x[i];
+      
+      s0 += a0[i] * xi;
+      s1 += a1[i] * xi;
+      s2 += a2[i] * xi;
+      s3 += a3[i] * xi;
+      }
+    
+    out[0] += s0;
+    out[1] += s1;
+    out[2] += s2;
+    out[3] += s3;
+    }
+  
+  
+  
+  arma_hot
+  inline
+  static
+  eT
+  dot1(const uword n, const eT* a0, const eT* x)
+    {
+    vT acc1 = vT{};
+    vT acc2 = vT{};
+    vT acc3 = vT{};
+    vT acc4 = vT{};
+    
+    uword i = 0;
+    
+    for(; (i + 4*n_lanes) <= n; i += 4*n_lanes)
+      {
+      vT v1;  std::memcpy(&v1, &(a0[i            ]), sizeof(vT));
+      vT v2;  std::memcpy(&v2, &(a0[i +   n_lanes]), sizeof(vT));
+      vT v3;  std::memcpy(&v3, &(a0[i + 2*n_lanes]), sizeof(vT));
+      vT v4;  std::memcpy(&v4, &(a0[i + 3*n_lanes]), sizeof(vT));
+      
+      vT x1;  std::memcpy(&x1, &(x[i            ]), sizeof(vT));
+      vT x2;  std::memcpy(&x2, &(x[i +   n_lanes]), sizeof(vT));
+      vT x3;  std::memcpy(&x3, &(x[i + 2*n_lanes]), sizeof(vT));
+      vT x4;  std::memcpy(&x4, &(x[i + 3*n_lanes]), sizeof(vT));
+      
+      acc1 += v1 * x1;
+      acc2 += v2 * x2;
+      acc3 += v3 * x3;
+      acc4 += v4 * x4;
+      }
+    
+    eT acc = sum( (acc1 + acc2) + (acc3 + acc4) );
+    
+    for(; i < n; ++i)  { acc += a0[i] * x[i]; }
+    
+    return acc;
+    }
+  };
+
+#endif
+
+
+
+//! \brief
+//! Blocked emulation of gemv(), used for larger matrices when BLAS is not available.
+//! Without the transpose, y is accumulated from the columns of A (axpy form) over blocks of rows;
+//! with the transpose, four dot products are computed at a time, over blocks of rows so that the block of x is reused.
+//! The blocks of y are processed in parallel when ARMA_USE_MP is enabled.
+//! For complex matrices the transpose is the hermitian transpose.
+//! 'y' is assumed to have been set to the correct size (ie. taking into account the transpose)
+
+template<const bool do_trans_A=false, const bool use_alpha=false, const bool use_beta=false>
+class gemv_emul_blocked
+  {
+  public:
+  
+  template<typename eT>
+  arma_inline
+  static
+  bool
+  use(const uword A_n_rows, const uword A_n_cols)
+    {
+    return ( (A_n_rows * A_n_cols) >= gemv_emul_blocked_params<eT>::min_n_elem ) && ( (do_trans_A) || (A_n_rows > 1) );
+    }
+  
+  
+  
+  template<typename eT, typename TA>
+  arma_hot
+  inline
+  static
+  void
+  apply( eT* y, const TA& A, const eT* x, const eT alpha = eT(1), const eT beta = eT(0) )
+    {
+    arma_extra_debug_sigprint();
+    
+    typedef gemv_emul_blocked_kernel<eT> kernel;
+    
+    const uword A_n_rows = A.n_rows;
+    const uword A_n_cols = A.n_cols;
+    
+    const uword block_rows = gemv_emul_blocked_params<eT>::block_rows;
+    
+    int n_threads = 1;
+    
+    #if defined(ARMA_USE_MP)
+      {
+      // each element of A costs about one cycle
+      if(mp_gate<eT>::eval(A.n_elem, 1))  { n_threads = mp_thread_limit::get(); }
+      }
+    #endif
+    
+    if(do_trans_A == false)
+      {
+      // rows per task: at most block_rows, and at least 256 (a multiple of 64, to keep the blocks aligned)
+      const uword rows_per_thread = (A_n_rows + uword(n_threads) - 1) / uword(n_threads);
+      
+      const uword task_rows = (std::max)( uword(256), (std::min)( block_rows, ((rows_per_thread + 63) / 64) * 64 ) );
+      
+      const uword n_tasks = (A_n_rows + task_rows - 1) / task_rows;
+      
+      mp_parallel::run(n_tasks, n_threads, [&](const uword task)
+        {
+        const uword row_start = task * task_rows;
+        const uword n         = (std::min)(task_rows, A_n_rows - row_start);
+        
+        podarray<eT> tmp(n);
+        
+        eT* acc = tmp.memptr();
+        
+        arrayops::fill_zeros(acc, n);
+        
+        uword col = 0;
+        
+        for(; (col + 4) <= A_n_cols; col += 4)
+          {
+          kernel::axpy4
+            (
+            acc, n,
+            &(A.colptr(col  )[row_start]),
+            &(A.colptr(col+1)[row_start]),
+            &(A.colptr(col+2)[row_start]),
+            &(A.colptr(col+3)[row_start]),
+            x[col], x[col+1], x[col+2], x[col+3]
+            );
+          }
+        
+        for(; col < A_n_cols; ++col)  { kernel::axpy1(acc, n, &(A.colptr(col)[row_start]), x[col]); }
+        
+        store(&(y[row_start]), acc, n, alpha, beta);
+        } );
+      }
+    else
+      {
+      // columns per task: a multiple of 4, so that dot4() can be used throughout
+      const uword cols_per_thread = (A_n_cols + uword(n_threads) - 1) / uword(n_threads);
+      
+      const uword task_cols = (std::max)( uword(4), ((cols_per_thread + 3) / 4) * 4 );
+      
+      const uword n_tasks = (A_n_cols + task_cols - 1) / task_cols;
+      
+      mp_parallel::run(n_tasks, n_threads, [&](const uword task)
+        {
+        const uword col_start = task * task_cols;
+        const uword n         = (std::min)(task_cols, A_n_cols - col_start);
+        
+        podarray<eT> tmp(n);
+        
+        eT* acc = tmp.memptr();
+        
+        arrayops::fill_zeros(acc, n);
+        
+        for(uword row_start=0; row_start < A_n_rows; row_start += block_rows)
+          {
+          const uword n_block = (std::min)(block_rows, A_n_rows - row_start);
+          
+          const eT* x_block = &(x[row_start]);
+          
+          uword i = 0;
+          
+          for(; (i + 4) <= n; i += 4)
+            {
+            const uword col = col_start + i;
+            
+            kernel::dot4
+              (
+              &(acc[i]), n_block,
+              &(A.colptr(col  )[row_start]),
+              &(A.colptr(col+1)[row_start]),
+              &(A.colptr(col+2)[row_start]),
+              &(A.colptr(col+3)[row_start]),
+              x_block
+              );
+            }
+          
+          for(; i < n; ++i)  { acc[i] += kernel::dot1(n_block, &(A.colptr(col_start + i)[row_start]), x_block); }
+          }
+        
+        store(&(y[col_start]), acc, n, alpha, beta);
+        } );
+      }
+    }
+  
+  
+  
+  private:
+  
+  template<typename eT>
+  arma_inline
+  static
+  void
+  store(eT* y, const eT* acc, const uword n, const eT alpha, const eT beta)
+    {
+    for(uword i=0; i < n; ++i)
+      {
+           if( (use_alpha == false) && (use_beta == false) )  { y[i] =       acc[i];             }
+      else if( (use_alpha == true ) && (use_beta == false) )  { y[i] = alpha*acc[i];             }
+      else if( (use_alpha == false) && (use_beta == true ) )  { y[i] =       acc[i] + beta*y[i]; }
+      else if( (use_alpha == true ) && (use_beta == true ) )  { y[i] = alpha*acc[i] + beta*y[i]; }
+      }
+    }
+  
+  };
+
+
+
+//! @}
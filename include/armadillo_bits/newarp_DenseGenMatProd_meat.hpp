@@ -48,4 +48,17 @@ DenseGenMatProd<eT>::perform_op(eT* x_in, eT* y_out) const
   }
 
 
+
+// Perform the matrix-matrix multiplication operation Y = A * X on a block of vectors.
+template<typename eT>
+inline
+void
+DenseGenMatProd<eT>::perform_op(const Mat<eT>& X, Mat<eT>& Y) const
+  {
+  arma_extra_debug_sigprint();
+  
+  Y = op_mat * X;
+  }
+
+
 }  // namespace newarp
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+namespace newarp
+{
+
+
+//! Diagonal (Jacobi) preconditioner for the block eigen solver;
+//! when constructed without a matrix, it does nothing
+template<typename eT>
+class DiagPrecond
+  {
+  private:
+  
+  Col<eT> inv_diag;  // reciprocals of the absolute values of the diagonal; empty for no preconditioning
+  
+  
+  public:
+  
+  inline DiagPrecond();
+  inline DiagPrecond(const SpMat<eT>& mat_obj);
+  
+  inline void perform_op(Mat<eT>& W) const;
+  };
+
+
+}  // namespace newarp
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+namespace newarp
+{
+
+
+template<typename eT>
+inline
+DiagPrecond<eT>::DiagPrecond()
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+template<typename eT>
+inline
+DiagPrecond<eT>::DiagPrecond(const SpMat<eT>& mat_obj)
+  {
+  arma_extra_debug_sigprint();
+  
+  inv_diag = abs(Col<eT>(mat_obj.diag()));
+  
+  const eT scale = (inv_diag.n_elem > 0) ? eT(inv_diag.max()) : eT(0);
+  
+  if(scale <= eT(0))  { inv_diag.reset(); return; }
+  
+  // zero diagonal elements would make the preconditioner singular; leave those rows unscaled
+  const eT thresh = scale * std::numeric_limits<eT>::epsilon();
+  
+  eT* inv_diag_mem = inv_diag.memptr();
+  
+  for(uword i=0; i < inv_diag.n_elem; ++i)
+    {
+    const eT val = inv_diag_mem[i];
+    
+    inv_diag_mem[i] = (val > thresh) ? (scale / val) : eT(1);
+    }
+  }
+
+
+
+// Apply the preconditioner in-place to each column of W
+template<typename eT>
+inline
+void
+DiagPrecond<eT>::perform_op(Mat<eT>& W) const
+  {
+  arma_extra_debug_sigprint();
+  
+  if(inv_diag.n_elem == 0)  { return; }
+  
+  W.each_col() %= inv_diag;
+  }
+
+
+}  // namespace newarp
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+namespace newarp
+{
+
+
+//! Define matrix operations via a user-supplied function;
+//! fn(y, x) must set y to the product of the operator and x, without resizing y
+template<typename eT, typename fn_type>
+class FnGenMatProd
+  {
+  private:
+  
+  const fn_type& fn;
+  
+  
+  public:
+  
+  const uword n_rows;  // number of rows of the underlying operator
+  const uword n_cols;  // number of columns of the underlying operator
+  
+  inline FnGenMatProd(const fn_type& in_fn, const uword in_n);
+  
+  inline void perform_op(eT* x_in, eT* y_out) const;
+  
+  inline void perform_op(const Mat<eT>& X, Mat<eT>& Y) const;
+  };
+
+
+}  // namespace newarp
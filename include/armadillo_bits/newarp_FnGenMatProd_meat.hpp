@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+namespace newarp
+{
+
+
+template<typename eT, typename fn_type>
+inline
+FnGenMatProd<eT, fn_type>::FnGenMatProd(const fn_type& in_fn, const uword in_n)
+  : fn(in_fn)
+  , n_rows(in_n)
+  , n_cols(in_n)
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+// Perform the operation y = op(x) via the user function;
+// x and y use the memory of the solver, so no copies are made
+template<typename eT, typename fn_type>
+inline
+void
+FnGenMatProd<eT, fn_type>::perform_op(eT* x_in, eT* y_out) const
+  {
+  arma_extra_debug_sigprint();
+  
+  const Col<eT> x(x_in , n_cols, false, true);
+        Col<eT> y(y_out, n_rows, false, true);
+  
+  fn(y, x);
+  }
+
+
+
+// Perform the operation on each column of a block of vectors
+template<typename eT, typename fn_type>
+inline
+void
+FnGenMatProd<eT, fn_type>::perform_op(const Mat<eT>& X, Mat<eT>& Y) const
+  {
+  arma_extra_debug_sigprint();
+  
+  Y.set_size(n_rows, X.n_cols);
+  
+  for(uword i=0; i < X.n_cols; ++i)
+    {
+    const Col<eT> x(const_cast<eT*>(X.colptr(i)), n_cols, false, true);
+          Col<eT> y(Y.colptr(i),                  n_rows, false, true);
+    
+    fn(y, x);
+    }
+  }
+
+
+}  // namespace newarp
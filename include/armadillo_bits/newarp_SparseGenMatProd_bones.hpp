@@ -27,6 +27,7 @@ class SparseGenMatProd
   private:
   
   const SpMat<eT>& op_mat;
+  const bool       is_sym;  // if true, each element of the product is a dot product with one column of op_mat
   
   
   public:
@@ -34,9 +35,13 @@ class SparseGenMatProd
   const uword n_rows;  // number of rows of the underlying matrix
   const uword n_cols;  // number of columns of the underlying matrix
   
-  inline SparseGenMatProd(const SpMat<eT>& mat_obj);
+  //! in_is_sym indicates that mat_obj is known to be symmetric (eg. as required by eigs_sym());
+  //! symmetry is not detected, as that costs more than is saved
+  inline SparseGenMatProd(const SpMat<eT>& mat_obj, const bool in_is_sym = false);
   
   inline void perform_op(eT* x_in, eT* y_out) const;
+  
+  inline void perform_op(const Mat<eT>& X, Mat<eT>& Y) const;
   };
 
 
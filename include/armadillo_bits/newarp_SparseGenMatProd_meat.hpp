@@ -22,12 +22,16 @@ namespace newarp
 
 template<typename eT>
 inline
-SparseGenMatProd<eT>::SparseGenMatProd(const SpMat<eT>& mat_obj)
+SparseGenMatProd<eT>::SparseGenMatProd(const SpMat<eT>& mat_obj, const bool in_is_sym)
   : op_mat(mat_obj)
+  , is_sym(in_is_sym)
   , n_rows(mat_obj.n_rows)
   , n_cols(mat_obj.n_cols)
   {
   arma_extra_debug_sigprint();
+  
+  // perform_op() reads the CSC arrays directly
+  op_mat.sync();
   }
 
 
@@ -41,10 +45,31 @@ SparseGenMatProd<eT>::perform_op(eT* x_in, eT* y_out) const
   {
   arma_extra_debug_sigprint();
   
-  const Col<eT> x(x_in , n_cols, false, true);
-        Col<eT> y(y_out, n_rows, false, true);
+  // the product is computed in parallel when worthwhile;
+  // for symmetric matrices, the columns of op_mat are also its rows,
+  // so row-wise dot products can be used without forming a transpose or per-thread copies of y
+  
+  if(is_sym)
+    {
+    spglue_times_misc::sparse_trans_times_vec(y_out, op_mat, x_in);
+    }
+  else
+    {
+    spglue_times_misc::sparse_times_vec(y_out, op_mat, x_in);
+    }
+  }
+
+
+
+// Multiply a block of vectors at once; one pass over the sparse matrix serves all columns of X
+template<typename eT>
+inline
+void
+SparseGenMatProd<eT>::perform_op(const Mat<eT>& X, Mat<eT>& Y) const
+  {
+  arma_extra_debug_sigprint();
   
-  y = op_mat * x;
+  Y = op_mat * X;
   }
 
 
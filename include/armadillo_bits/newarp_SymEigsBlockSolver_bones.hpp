@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+namespace newarp
+{
+
+
+//! This class implements the locally optimal block preconditioned conjugate gradient (LOBPCG)
+//! eigen solver for real symmetric matrices.
+//! The matrix is applied to a block of vectors at a time, turning matrix-vector products into
+//! matrix-matrix products. Only the LARGEST_ALGE and SMALLEST_ALGE selection rules are supported.
+template<typename eT, int SelectionRule, typename OpType, typename PrecondType>
+class SymEigsBlockSolver
+  {
+  private:
+  
+  const OpType&      op;        // object to conduct matrix operation, eg. matrix-matrix product
+  const PrecondType& precond;   // object to apply the preconditioner in-place to a block of residuals
+  const uword        nev;       // number of eigenvalues requested
+  const uword        dim_n;     // dimension of matrix A
+  const uword        nblk;      // number of vectors in the block
+  uword              nmatop;    // number of matrix-vector products
+  uword              niter;     // number of iterations
+  Col<eT>            ritz_val;  // ritz values, ordered by the selection rule
+  Mat<eT>            ritz_vec;  // ritz vectors
+  std::vector<bool>  ritz_conv; // indicator of the convergence of ritz values
+  eT                 anorm;     // estimate of the norm of A, used in convergence test
+  const eT           eps;       // the machine precision
+  const eT           eps23;     // eps^(2/3), lower limit of the tolerance
+  
+  std::mt19937_64    local_rng; // local random number generator
+  
+  inline void fill_rand(eT* dest, const uword N, const uword seed_val);
+  
+  // Orthonormalise the columns of V, dropping linearly dependent directions;
+  // the same transformation is applied to AV, unless AV is empty
+  inline void orthonormalise(Mat<eT>& V, Mat<eT>& AV);
+  
+  // Remove the components of V in the span of the orthonormal columns of Q, with AQ = A*Q;
+  // the same update is applied to AV, unless AV is empty
+  inline void project_out(Mat<eT>& V, Mat<eT>& AV, const Mat<eT>& Q, const Mat<eT>& AQ);
+  
+  // Rayleigh-Ritz procedure on the orthonormal basis S, with AS = A*S;
+  // the first nblk selected Ritz values are stored in ritz_val;
+  // returns the coefficients of the selected Ritz vectors in terms of S
+  inline bool rayleigh_ritz(Mat<eT>& C, const Mat<eT>& S, const Mat<eT>& AS);
+  
+  // Calculate the residuals and the number of converged Ritz values;
+  // the indices of the vectors in the block which have not converged are stored in active
+  inline uword num_converged(Mat<eT>& R, uvec& active, const Mat<eT>& AX, eT tol);
+  
+  
+  public:
+  
+  //! Constructor to create a solver object.
+  inline SymEigsBlockSolver(const OpType& op_, const PrecondType& precond_, uword nev_, uword nblk_);
+  
+  //! Providing a random initial block of vectors.
+  inline void init();
+  
+  //! Conducting the major computation procedure.
+  inline uword compute(uword maxit = 1000, eT tol = 1e-10);
+  
+  //! Returning the number of iterations used in the computation.
+  inline uword num_iterations() { return niter; }
+  
+  //! Returning the number of matrix-vector products used in the computation.
+  inline uword num_operations() { return nmatop; }
+  
+  //! Returning the converged eigenvalues, in ascending algebraic order.
+  inline Col<eT> eigenvalues();
+  
+  //! Returning the eigenvectors associated with the converged eigenvalues.
+  inline Mat<eT> eigenvectors();
+  };
+
+
+}  // namespace newarp
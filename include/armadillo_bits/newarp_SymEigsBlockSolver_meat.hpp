@@ -0,0 +1,368 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+namespace newarp
+{
+
+
+template<typename eT, int SelectionRule, typename OpType, typename PrecondType>
+inline
+void
+SymEigsBlockSolver<eT, SelectionRule, OpType, PrecondType>::fill_rand(eT* dest, const uword N, const uword seed_val)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename std::mt19937_64::result_type seed_type;
+  
+  local_rng.seed( seed_type(seed_val) );
+  
+  std::uniform_real_distribution<double> dist(-1.0, +1.0);
+  
+  for(uword i=0; i < N; ++i)  { dest[i] = eT(dist(local_rng)); }
+  }
+
+
+
+// Orthonormalisation via the eigendecomposition of the Gram matrix (SVQB);
+// unlike Gram-Schmidt, it works on the whole block with matrix-matrix products
+template<typename eT, int SelectionRule, typename OpType, typename PrecondType>
+inline
+void
+SymEigsBlockSolver<eT, SelectionRule, OpType, PrecondType>::orthonormalise(Mat<eT>& V, Mat<eT>& AV)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(V.n_cols == 0)  { return; }
+  
+  Mat<eT> G = V.t() * V;
+  
+  // scale the columns to unit norm, so that the threshold below is relative
+  Col<eT> scale(G.n_rows, arma_nozeros_indicator());
+  
+  for(uword i=0; i < G.n_rows; ++i)
+    {
+    const eT d = G.at(i,i);
+    
+    scale[i] = (d > eT(0)) ? (eT(1) / std::sqrt(d)) : eT(0);
+    }
+  
+  G = G % (scale * scale.t());
+  G = eT(0.5) * (G + G.t());
+  
+  Col<eT> g;
+  Mat<eT> Q;
+  
+  const bool status = (G.is_finite()) ? bool(eig_sym(g, Q, G)) : false;
+  
+  const eT g_max = (status) ? eT(g.max()) : eT(0);
+  
+  if(g_max <= eT(0))
+    {
+    V.set_size(V.n_rows, 0);
+    
+    if(AV.n_cols > 0)  { AV.set_size(AV.n_rows, 0); }
+    
+    return;
+    }
+  
+  // drop directions which are numerically linearly dependent
+  const eT thresh = std::sqrt(eps) * g_max;
+  
+  const uvec keep = find(g > thresh);
+  
+  Mat<eT> T = Q.cols(keep);
+  
+  T.each_col() %= scale;
+  
+  for(uword i=0; i < keep.n_elem; ++i)  { T.col(i) /= std::sqrt(g[ keep[i] ]); }
+  
+  V = V * T;
+  
+  if(AV.n_cols > 0)  { AV = AV * T; }
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType, typename PrecondType>
+inline
+void
+SymEigsBlockSolver<eT, SelectionRule, OpType, PrecondType>::project_out(Mat<eT>& V, Mat<eT>& AV, const Mat<eT>& Q, const Mat<eT>& AQ)
+  {
+  arma_extra_debug_sigprint();
+  
+  if( (V.n_cols == 0) || (Q.n_cols == 0) )  { return; }
+  
+  const Mat<eT> M = Q.t() * V;
+  
+  V -= Q * M;
+  
+  if(AV.n_cols > 0)  { AV -= AQ * M; }
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType, typename PrecondType>
+inline
+bool
+SymEigsBlockSolver<eT, SelectionRule, OpType, PrecondType>::rayleigh_ritz(Mat<eT>& C, const Mat<eT>& S, const Mat<eT>& AS)
+  {
+  arma_extra_debug_sigprint();
+  
+  Mat<eT> H = S.t() * AS;
+  
+  H = eT(0.5) * (H + H.t());
+  
+  if(H.is_finite() == false)  { return false; }
+  
+  Col<eT> vals;
+  Mat<eT> vecs;
+  
+  if(eig_sym(vals, vecs, H) == false)  { return false; }
+  
+  const uword ns = H.n_rows;
+  
+  if(ns < nblk)  { return false; }
+  
+  anorm = (std::max)(anorm, eT(abs(vals).max()));
+  
+  C.set_size(ns, nblk);
+  ritz_val.set_size(nblk);
+  
+  // eig_sym() returns the eigenvalues in ascending order
+  for(uword i=0; i < nblk; ++i)
+    {
+    const uword j = (SelectionRule == EigsSelect::SMALLEST_ALGE) ? i : (ns - 1 - i);
+    
+    ritz_val[i] = vals[j];
+    C.col(i)    = vecs.col(j);
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType, typename PrecondType>
+inline
+uword
+SymEigsBlockSolver<eT, SelectionRule, OpType, PrecondType>::num_converged(Mat<eT>& R, uvec& active, const Mat<eT>& AX, eT tol)
+  {
+  arma_extra_debug_sigprint();
+  
+  R = AX - ritz_vec * diagmat(ritz_val);
+  
+  // the residuals of the smallest eigenvalues cannot fall much below eps * norm(A),
+  // so the threshold is relative to the norm rather than to each Ritz value
+  const eT thresh = (std::max)(tol, eps23) * anorm;
+  
+  active.set_size(nblk);
+  
+  uword n_active = 0;
+  
+  for(uword i=0; i < nblk; ++i)
+    {
+    const bool conv = (norm(R.col(i)) <= thresh);
+    
+    if(i < nev)  { ritz_conv[i] = conv; }
+    
+    if(conv == false)  { active[n_active] = i; ++n_active; }
+    }
+  
+  active.resize(n_active);
+  
+  return std::count(ritz_conv.begin(), ritz_conv.end(), true);
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType, typename PrecondType>
+inline
+SymEigsBlockSolver<eT, SelectionRule, OpType, PrecondType>::SymEigsBlockSolver(const OpType& op_, const PrecondType& precond_, uword nev_, uword nblk_)
+  : op(op_)
+  , precond(precond_)
+  , nev(nev_)
+  , dim_n(op.n_rows)
+  , nblk(nblk_)
+  , nmatop(0)
+  , niter(0)
+  , anorm(0)
+  , eps(std::numeric_limits<eT>::epsilon())
+  , eps23(std::pow(eps, eT(2.0) / 3))
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_static_check( ((SelectionRule != EigsSelect::LARGEST_ALGE) && (SelectionRule != EigsSelect::SMALLEST_ALGE)), "newarp::SymEigsBlockSolver: only LARGEST_ALGE and SMALLEST_ALGE are supported" );
+  
+  arma_debug_check( (nev_ < 1 || nev_ > dim_n - 1), "newarp::SymEigsBlockSolver: nev must satisfy 1 <= nev <= n - 1, n is the size of matrix" );
+  arma_debug_check( (nblk_ < nev_ || 3*nblk_ > dim_n), "newarp::SymEigsBlockSolver: nblk must satisfy nev <= nblk <= n/3, n is the size of matrix" );
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType, typename PrecondType>
+inline
+void
+SymEigsBlockSolver<eT, SelectionRule, OpType, PrecondType>::init()
+  {
+  arma_extra_debug_sigprint();
+  
+  ritz_val.zeros(nblk);
+  ritz_vec.set_size(dim_n, nblk);
+  ritz_conv.assign(nev, false);
+  
+  nmatop = 0;
+  niter  = 0;
+  anorm  = eT(0);
+  
+  fill_rand(ritz_vec.memptr(), ritz_vec.n_elem, 0);
+  
+  Mat<eT> tmp;
+  
+  orthonormalise(ritz_vec, tmp);
+  
+  if(ritz_vec.n_cols < nblk)  { arma_stop_runtime_error("newarp::SymEigsBlockSolver::init(): initial block of vectors is rank deficient"); return; }
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType, typename PrecondType>
+inline
+uword
+SymEigsBlockSolver<eT, SelectionRule, OpType, PrecondType>::compute(uword maxit, eT tol)
+  {
+  arma_extra_debug_sigprint();
+  
+  Mat<eT> AX;
+  Mat<eT> C;
+  
+  op.perform_op(ritz_vec, AX);
+  nmatop += nblk;
+  
+  if(rayleigh_ritz(C, ritz_vec, AX) == false)  { return 0; }
+  
+  ritz_vec = ritz_vec * C;
+  AX       = AX       * C;
+  
+  Mat<eT> P;  // search directions from the previous iteration
+  Mat<eT> AP;
+  Mat<eT> R;  // residuals
+  Mat<eT> W;  // preconditioned residuals
+  Mat<eT> AW;
+  Mat<eT> none;
+  
+  uvec active;
+  
+  uword nconv = 0;
+  
+  for(niter = 0; ; ++niter)
+    {
+    nconv = num_converged(R, active, AX, tol);
+    
+    if( (nconv >= nev) || (niter >= maxit) )  { break; }
+    
+    // converged vectors are kept in the basis, but their residuals are not expanded upon (soft locking)
+    W = R.cols(active);
+    
+    precond.perform_op(W);
+    
+    project_out(P, AP, ritz_vec, AX);
+    orthonormalise(P, AP);
+    
+    // two passes of block Gram-Schmidt against [X P], as a single pass can leave W far from orthogonal
+    for(uword pass=0; pass < 2; ++pass)
+      {
+      project_out(W, none, ritz_vec, AX);
+      project_out(W, none, P,        AP);
+      orthonormalise(W, none);
+      }
+    
+    if(W.n_cols == 0)  { break; }
+    
+    op.perform_op(W, AW);
+    nmatop += W.n_cols;
+    
+    const Mat<eT> S  = join_rows(ritz_vec, W,  P );
+    const Mat<eT> AS = join_rows(AX,       AW, AP);
+    
+    if(rayleigh_ritz(C, S, AS) == false)  { break; }
+    
+    const uword n_s = S.n_cols;
+    
+    // the new search directions are the components of the new Ritz vectors outside of the old block
+    P  = S.cols (nblk, n_s - 1) * C.rows(nblk, n_s - 1);
+    AP = AS.cols(nblk, n_s - 1) * C.rows(nblk, n_s - 1);
+    
+    ritz_vec = S  * C;
+    AX       = AS * C;
+    }
+  
+  return (std::min)(nev, nconv);
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType, typename PrecondType>
+inline
+Col<eT>
+SymEigsBlockSolver<eT, SelectionRule, OpType, PrecondType>::eigenvalues()
+  {
+  arma_extra_debug_sigprint();
+  
+  uword nconv = std::count(ritz_conv.begin(), ritz_conv.end(), true);
+  Col<eT> res(nconv, arma_zeros_indicator());
+  
+  // sort in ascending algebraic order, to be consistent with SymEigsSolver
+  uword j = 0;
+  
+  for(uword ii=0; ii < nev; ii++)
+    {
+    const uword i = (SelectionRule == EigsSelect::SMALLEST_ALGE) ? ii : (nev - 1 - ii);
+    
+    if(ritz_conv[i])  { res(j) = ritz_val(i); j++; }
+    }
+  
+  return res;
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType, typename PrecondType>
+inline
+Mat<eT>
+SymEigsBlockSolver<eT, SelectionRule, OpType, PrecondType>::eigenvectors()
+  {
+  arma_extra_debug_sigprint();
+  
+  uword nconv = std::count(ritz_conv.begin(), ritz_conv.end(), true);
+  Mat<eT> res(dim_n, nconv, arma_nozeros_indicator());
+  
+  uword j = 0;
+  
+  for(uword ii=0; ii < nev; ii++)
+    {
+    const uword i = (SelectionRule == EigsSelect::SMALLEST_ALGE) ? ii : (nev - 1 - ii);
+    
+    if(ritz_conv[i])  { res.col(j) = ritz_vec.col(i); j++; }
+    }
+  
+  return res;
+  }
+
+
+}  // namespace newarp
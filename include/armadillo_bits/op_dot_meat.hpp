@@ -126,6 +126,10 @@ op_dot::direct_dot(const uword n_elem, const eT* const A, const eT* const B)
       
       return blas::dot(n_elem, A, B);
       }
+    #elif defined(ARMA_USE_CPU_DISPATCH)
+      {
+      return (cpu_dispatch::use<eT>(n_elem)) ? cpu_dispatch::table<eT>().dot(n_elem, A, B) : op_dot::direct_dot_arma(n_elem, A, B);
+      }
     #else
       {
       return op_dot::direct_dot_arma(n_elem, A, B);
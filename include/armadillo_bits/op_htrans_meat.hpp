@@ -312,7 +312,7 @@ op_htrans::apply_direct(Mat<typename T1::elem_type>& out, const T1& X)
   typedef typename T1::elem_type eT;
   
   // allow detection of in-place transpose
-  if(is_Mat<T1>::value || (arma_config::openmp && Proxy<T1>::use_mp))
+  if(is_Mat<T1>::value || (arma_config::mp && Proxy<T1>::use_mp))
     {
     const unwrap<T1> U(X);
     
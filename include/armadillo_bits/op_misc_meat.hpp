@@ -222,14 +222,13 @@ op_abs::apply( Mat<typename T1::pod_type>& out, const mtOp<typename T1::pod_type
     const uword   n_elem  = P.get_n_elem();
           ea_type A       = P.get_ea();
     
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       const int n_threads = mp_thread_limit::get();
-      #pragma omp parallel for schedule(static) num_threads(n_threads)
-      for(uword i=0; i < n_elem; ++i)
+      mp_parallel::run(n_elem, n_threads, [&](const uword i)
         {
         out_mem[i] = std::abs( A[i] );
-        }
+        });
       }
     #else
       {
@@ -279,14 +278,13 @@ op_abs::apply( Cube<typename T1::pod_type>& out, const mtOpCube<typename T1::pod
     const uword   n_elem  = P.get_n_elem();
           ea_type A       = P.get_ea();
     
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_MP)
       {
       const int n_threads = mp_thread_limit::get();
-      #pragma omp parallel for schedule(static) num_threads(n_threads)
-      for(uword i=0; i < n_elem; ++i)
+      mp_parallel::run(n_elem, n_threads, [&](const uword i)
         {
         out_mem[i] = std::abs( A[i] );
-        }
+        });
       }
     #else
       {
@@ -34,7 +34,7 @@ op_reshape::apply(Mat<typename T1::elem_type>& actual_out, const Op<T1,op_reshap
   const uword new_n_rows = in.aux_uword_a;
   const uword new_n_cols = in.aux_uword_b;
   
-  if(is_Mat<T1>::value || (arma_config::openmp && Proxy<T1>::use_mp))
+  if(is_Mat<T1>::value || (arma_config::mp && Proxy<T1>::use_mp))
     {
     const unwrap<T1>   U(in.m);
     const Mat<eT>& A = U.M;
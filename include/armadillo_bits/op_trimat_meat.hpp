@@ -68,7 +68,7 @@ op_trimat::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_trimat>& in)
   const bool upper = (in.aux_uword_a == 0);
   
   // allow detection of in-place operation
-  if(is_Mat<T1>::value || (arma_config::openmp && Proxy<T1>::use_mp))
+  if(is_Mat<T1>::value || (arma_config::mp && Proxy<T1>::use_mp))
     {
     const unwrap<T1> U(in.m);
     
@@ -44,7 +44,7 @@ op_vectorise_col::apply_direct(Mat<typename T1::elem_type>& out, const T1& expr)
   typedef typename T1::elem_type eT;
   
   // allow detection of in-place operation
-  if(is_Mat<T1>::value || (arma_config::openmp && Proxy<T1>::use_mp))
+  if(is_Mat<T1>::value || (arma_config::mp && Proxy<T1>::use_mp))
     {
     const unwrap<T1> U(expr);
     
@@ -343,7 +343,7 @@ op_vectorise_cube_col::apply(Mat<typename T1::elem_type>& out, const CubeToMatOp
     }
   else
     {
-    if(is_Cube<T1>::value || (arma_config::openmp && ProxyCube<T1>::use_mp))
+    if(is_Cube<T1>::value || (arma_config::mp && ProxyCube<T1>::use_mp))
       {
       op_vectorise_cube_col::apply_unwrap(out, in.m);
       }
@@ -491,4 +491,58 @@ operator*
 
 
 
+//! multiplication of a CSR sparse matrix and a dense object
+template<typename T1>
+inline
+typename enable_if2< is_arma_type<T1>::value, Mat<typename T1::elem_type> >::result
+operator*
+  (
+  const SpMat_csr<typename T1::elem_type>& X,
+  const T1&                                Y
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const quasi_unwrap<T1> U(Y);
+  
+  arma_debug_assert_mul_size(X.n_rows, X.n_cols, U.M.n_rows, U.M.n_cols, "matrix multiplication");
+  
+  Mat<eT> out;
+  
+  spglue_times_misc::csr_times_dense_noalias(out, X.st(), U.M);
+  
+  return out;
+  }
+
+
+
+//! multiplication of a dense object and a CSR sparse matrix
+template<typename T1>
+inline
+typename enable_if2< is_arma_type<T1>::value, Mat<typename T1::elem_type> >::result
+operator*
+  (
+  const T1&                                X,
+  const SpMat_csr<typename T1::elem_type>& Y
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const quasi_unwrap<T1> U(X);
+  
+  arma_debug_assert_mul_size(U.M.n_rows, U.M.n_cols, Y.n_rows, Y.n_cols, "matrix multiplication");
+  
+  Mat<eT> out;
+  
+  spglue_times_misc::dense_times_csr_noalias(out, U.M, Y.st());
+  
+  return out;
+  }
+
+
+
 //! @}
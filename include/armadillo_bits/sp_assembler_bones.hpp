@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup sp_assembler
+//! @{
+
+
+
+//! Assembly of a sparse matrix by several threads.
+//! Each thread adds elements through its own handle, which writes to a private buffer without locking.
+//! finalise() merges the buffers with the existing elements of the target matrix;
+//! values at identical locations are added.
+//! The destructor calls finalise() if needed, but can only report a failure as a warning;
+//! finalise() should be called explicitly if errors such as running out of memory must be handled.
+template<typename eT>
+class sp_assembler
+  {
+  private:
+  
+  struct buffer
+    {
+    std::vector<uword> rows;
+    std::vector<uword> cols;
+    std::vector<eT>    vals;
+    
+    buffer* next;
+    };
+  
+  //! owner of a list of buffers, which are released even if an exception is thrown
+  struct buffer_list
+    {
+    buffer* first;
+    
+    inline ~buffer_list() { sp_assembler<eT>::release(first); }
+    };
+  
+  
+  public:
+  
+  typedef eT elem_type;
+  
+  class handle
+    {
+    public:
+    
+    inline void add(const uword in_row, const uword in_col, const eT in_val);
+    
+    inline void reserve(const uword n_elem);
+    
+    inline uword n_added() const;
+    
+    
+    private:
+    
+    inline handle(buffer* in_buf, const uword in_n_rows, const uword in_n_cols);
+    
+    buffer* buf;
+    uword   n_rows;
+    uword   n_cols;
+    
+    friend class sp_assembler<eT>;
+    };
+  
+  
+  inline ~sp_assembler();
+  inline explicit sp_assembler(SpMat<eT>& in_target);
+  
+  inline handle get_handle();
+  
+  inline void finalise();
+  
+  
+  private:
+  
+  SpMat<eT>& target;
+  
+  std::atomic<buffer*> head;
+  
+  bool finalised;
+  
+  inline static void release(buffer* buf);
+  
+  inline sp_assembler(const sp_assembler&) = delete;
+  inline sp_assembler& operator=(const sp_assembler&) = delete;
+  };
+
+
+
+//! @}
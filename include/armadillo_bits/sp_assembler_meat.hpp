@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup sp_assembler
+//! @{
+
+
+
+template<typename eT>
+inline
+sp_assembler<eT>::handle::handle(buffer* in_buf, const uword in_n_rows, const uword in_n_cols)
+  : buf   (in_buf   )
+  , n_rows(in_n_rows)
+  , n_cols(in_n_cols)
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+template<typename eT>
+inline
+void
+sp_assembler<eT>::handle::add(const uword in_row, const uword in_col, const eT in_val)
+  {
+  arma_debug_check_bounds( ((in_row >= n_rows) || (in_col >= n_cols)), "sp_assembler::handle::add(): index out of bounds" );
+  
+  buf->rows.push_back(in_row);
+  buf->cols.push_back(in_col);
+  buf->vals.push_back(in_val);
+  }
+
+
+
+template<typename eT>
+inline
+void
+sp_assembler<eT>::handle::reserve(const uword n_elem)
+  {
+  arma_extra_debug_sigprint();
+  
+  buf->rows.reserve(n_elem);
+  buf->cols.reserve(n_elem);
+  buf->vals.reserve(n_elem);
+  }
+
+
+
+template<typename eT>
+inline
+uword
+sp_assembler<eT>::handle::n_added() const
+  {
+  return uword(buf->vals.size());
+  }
+
+
+
+template<typename eT>
+inline
+sp_assembler<eT>::~sp_assembler()
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  // exceptions must not leave the destructor
+  try
+    {
+    finalise();
+    }
+  catch(...)
+    {
+    arma_warn_level(1, "sp_assembler::~sp_assembler(): couldn't add elements to target matrix; finalise() can be called explicitly to handle errors");
+    }
+  }
+
+
+
+template<typename eT>
+inline
+sp_assembler<eT>::sp_assembler(SpMat<eT>& in_target)
+  : target   (in_target)
+  , head     (nullptr  )
+  , finalised(false    )
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  // make sure the existing elements are in CSC form, as the element cache is bypassed during assembly
+  target.sync();
+  }
+
+
+
+//! get a handle with its own buffer;
+//! can be called concurrently by several threads, but each handle must be used by only one thread at a time
+template<typename eT>
+inline
+typename sp_assembler<eT>::handle
+sp_assembler<eT>::get_handle()
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( finalised, "sp_assembler::get_handle(): already finalised" );
+  
+  buffer* buf = new(std::nothrow) buffer;
+  
+  arma_check_bad_alloc( (buf == nullptr), "sp_assembler::get_handle(): out of memory" );
+  
+  // lock-free push onto the list of buffers
+  
+  buf->next = head.load(std::memory_order_relaxed);
+  
+  while(head.compare_exchange_weak(buf->next, buf, std::memory_order_release, std::memory_order_relaxed) == false)  { }
+  
+  return handle(buf, target.n_rows, target.n_cols);
+  }
+
+
+
+//! merge all buffers into the target matrix;
+//! must be called after all threads have finished adding elements;
+//! handles obtained beforehand are no longer valid
+template<typename eT>
+inline
+void
+sp_assembler<eT>::finalise()
+  {
+  arma_extra_debug_sigprint();
+  
+  if(finalised)  { return; }
+  
+  finalised = true;
+  
+  // elements may have been written to the target after construction, which are held in its element cache
+  target.sync();
+  
+  buffer_list list = { head.exchange(nullptr, std::memory_order_acquire) };
+  
+  const buffer* first = list.first;
+  
+  uword N = target.n_nonzero;
+  
+  for(const buffer* buf = first; buf != nullptr; buf = buf->next)  { N += uword(buf->vals.size()); }
+  
+  if(N == target.n_nonzero)  { return; }
+  
+  uvec    rows(N, arma_nozeros_indicator());
+  uvec    cols(N, arma_nozeros_indicator());
+  Col<eT> vals(N, arma_nozeros_indicator());
+  
+  uword* rows_mem = rows.memptr();
+  uword* cols_mem = cols.memptr();
+  eT*    vals_mem = vals.memptr();
+  
+  uword count = 0;
+  
+  for(uword col = 0; col < target.n_cols; ++col)
+    {
+    const uword start = target.col_ptrs[col    ];
+    const uword end   = target.col_ptrs[col + 1];
+    
+    for(uword i = start; i < end; ++i)
+      {
+      rows_mem[count] = target.row_indices[i];
+      cols_mem[count] = col;
+      vals_mem[count] = target.values[i];
+      
+      ++count;
+      }
+    }
+  
+  // the list holds the buffers in reverse order of creation
+  
+  std::vector<const buffer*> bufs;
+  
+  for(const buffer* buf = first; buf != nullptr; buf = buf->next)  { bufs.push_back(buf); }
+  
+  for(size_t k = bufs.size(); k > 0; --k)
+    {
+    const buffer& buf = *(bufs[k-1]);
+    
+    const uword buf_n = uword(buf.vals.size());
+    
+    if(buf_n == 0)  { continue; }
+    
+    arrayops::copy(&(rows_mem[count]), &(buf.rows[0]), buf_n);
+    arrayops::copy(&(cols_mem[count]), &(buf.cols[0]), buf_n);
+    arrayops::copy(&(vals_mem[count]), &(buf.vals[0]), buf_n);
+    
+    count += buf_n;
+    }
+  
+  // the buffers are no longer needed
+  release(list.first);  list.first = nullptr;
+  
+  SpMat<eT> tmp(true, rows, cols, vals, target.n_rows, target.n_cols);
+  
+  // values that add up to zero are not stored
+  tmp.remove_zeros();
+  
+  target.steal_mem(tmp);
+  }
+
+
+
+template<typename eT>
+inline
+void
+sp_assembler<eT>::release(buffer* buf)
+  {
+  arma_extra_debug_sigprint();
+  
+  while(buf != nullptr)
+    {
+    buffer* next = buf->next;
+    
+    delete buf;
+    
+    buf = next;
+    }
+  }
+
+
+
+//! @}
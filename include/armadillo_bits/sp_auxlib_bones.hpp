@@ -50,6 +50,24 @@ class sp_auxlib
   template<typename eT, bool use_sigma>
   inline static bool eigs_sym_arpack(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X, const uword n_eigvals, const form_type form_val, const eT sigma, const eigs_opts& opts);
   
+  template<typename eT, typename op_type>
+  inline static bool eigs_sym_newarp_op(Col<eT>& eigval, Mat<eT>& eigvec, const op_type& op, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
+  
+  template<typename eT, typename op_type, typename precond_type>
+  inline static bool eigs_sym_newarp_block(Col<eT>& eigval, Mat<eT>& eigvec, const op_type& op, const precond_type& precond, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
+  
+  template<typename eT, typename op_type>
+  inline static bool eigs_sym_newarp_shift_op(Col<eT>& eigval, Mat<eT>& eigvec, const op_type& op, const uword n_eigvals, const eT sigma, const eigs_opts& opts);
+  
+  //
+  // eigs_sym() for real operators given as functions
+  
+  template<typename eT, typename fn_type>
+  inline static bool eigs_sym_fn(Col<eT>& eigval, Mat<eT>& eigvec, const fn_type& fn, const uword n, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
+  
+  template<typename eT, typename fn_type>
+  inline static bool eigs_sym_fn(Col<eT>& eigval, Mat<eT>& eigvec, const fn_type& solve_fn, const uword n, const uword n_eigvals, const eT sigma, const eigs_opts& opts);
+  
   //
   // eigs_gen() for real matrices
   
@@ -65,6 +83,15 @@ class sp_auxlib
   template<typename T, bool use_sigma>
   inline static bool eigs_gen_arpack(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const SpMat<T>& X, const uword n_eigvals, const form_type form_val, const std::complex<T> sigma, const eigs_opts& opts);
   
+  template<typename T, typename op_type>
+  inline static bool eigs_gen_newarp_op(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const op_type& op, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
+  
+  //
+  // eigs_gen() for real operators given as functions
+  
+  template<typename T, typename fn_type>
+  inline static bool eigs_gen_fn(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const fn_type& fn, const uword n, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
+  
   //
   // eigs_gen() for complex matrices
   
@@ -184,6 +211,8 @@ class superlu_supermatrix_wrangler
   
   inline superlu::SuperMatrix& get_ref();
   inline superlu::SuperMatrix* get_ptr();
+  
+  inline void reset();
   };
 
 
@@ -167,11 +167,46 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
   
   #if defined(ARMA_USE_NEWARP)
     {
-    arma_debug_check( (form_val != form_lm) && (form_val != form_sm) && (form_val != form_la) && (form_val != form_sa), "eigs_sym(): unknown form specified" );
-    
     if(X.is_square() == false)  { return false; }
     
-    const newarp::SparseGenMatProd<eT> op(X);
+    // eigs_sym() requires a symmetric matrix
+    const newarp::SparseGenMatProd<eT> op(X, true);
+    
+    if(opts.method == eigs_opts::METHOD_LOBPCG)
+      {
+      const newarp::DiagPrecond<eT> precond = (opts.precond == eigs_opts::PRECOND_JACOBI) ? newarp::DiagPrecond<eT>(X) : newarp::DiagPrecond<eT>();
+      
+      return sp_auxlib::eigs_sym_newarp_block(eigval, eigvec, op, precond, n_eigvals, form_val, opts);
+      }
+    
+    return sp_auxlib::eigs_sym_newarp_op(eigval, eigvec, op, n_eigvals, form_val, opts);
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(X);
+    arma_ignore(n_eigvals);
+    arma_ignore(form_val);
+    arma_ignore(opts);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename eT, typename op_type>
+inline
+bool
+sp_auxlib::eigs_sym_newarp_op(Col<eT>& eigval, Mat<eT>& eigvec, const op_type& op, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
+    arma_debug_check( (form_val != form_lm) && (form_val != form_sm) && (form_val != form_la) && (form_val != form_sa), "eigs_sym(): unknown form specified" );
     
     arma_debug_check( (n_eigvals >= op.n_rows), "eigs_sym(): n_eigvals must be less than the number of rows in the matrix" );
     
@@ -229,7 +264,7 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
       {
       if(form_val == form_lm)
         {
-        newarp::SymEigsSolver< eT, newarp::EigsSelect::LARGEST_MAGN, newarp::SparseGenMatProd<eT> > eigs(op, n_eigvals, ncv);
+        newarp::SymEigsSolver< eT, newarp::EigsSelect::LARGEST_MAGN, op_type > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -238,7 +273,7 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
       else
       if(form_val == form_sm)
         {
-        newarp::SymEigsSolver< eT, newarp::EigsSelect::SMALLEST_MAGN, newarp::SparseGenMatProd<eT> > eigs(op, n_eigvals, ncv);
+        newarp::SymEigsSolver< eT, newarp::EigsSelect::SMALLEST_MAGN, op_type > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -247,7 +282,7 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
       else
       if(form_val == form_la)
         {
-        newarp::SymEigsSolver< eT, newarp::EigsSelect::LARGEST_ALGE, newarp::SparseGenMatProd<eT> > eigs(op, n_eigvals, ncv);
+        newarp::SymEigsSolver< eT, newarp::EigsSelect::LARGEST_ALGE, op_type > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -256,7 +291,7 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
       else
       if(form_val == form_sa)
         {
-        newarp::SymEigsSolver< eT, newarp::EigsSelect::SMALLEST_ALGE, newarp::SparseGenMatProd<eT> > eigs(op, n_eigvals, ncv);
+        newarp::SymEigsSolver< eT, newarp::EigsSelect::SMALLEST_ALGE, op_type > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -279,7 +314,115 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
     {
     arma_ignore(eigval);
     arma_ignore(eigvec);
-    arma_ignore(X);
+    arma_ignore(op);
+    arma_ignore(n_eigvals);
+    arma_ignore(form_val);
+    arma_ignore(opts);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+//! block eigensolver (LOBPCG) for "la" and "sa"; other forms are redirected to the Krylov solver
+template<typename eT, typename op_type, typename precond_type>
+inline
+bool
+sp_auxlib::eigs_sym_newarp_block(Col<eT>& eigval, Mat<eT>& eigvec, const op_type& op, const precond_type& precond, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
+    if( (form_val != form_la) && (form_val != form_sa) )
+      {
+      arma_debug_warn_level(1, "eigs_sym(): LOBPCG supports only forms \"la\" and \"sa\"; using Krylov method instead");
+      
+      return sp_auxlib::eigs_sym_newarp_op(eigval, eigvec, op, n_eigvals, form_val, opts);
+      }
+    
+    arma_debug_check( (n_eigvals >= op.n_rows), "eigs_sym(): n_eigvals must be less than the number of rows in the matrix" );
+    
+    // If the matrix is empty, the case is trivial.
+    if( (op.n_cols == 0) || (n_eigvals == 0) ) // We already know n_cols == n_rows.
+      {
+      eigval.reset();
+      eigvec.reset();
+      return true;
+      }
+    
+    const uword n = op.n_rows;
+    
+    // A few extra vectors in the block speed up the convergence of the last wanted eigenvalues.
+    uword nblk = n_eigvals + (std::min)(n_eigvals, uword(20));
+    
+    if(opts.subdim != 0)
+      {
+      if(opts.subdim < n_eigvals)
+        {
+        arma_debug_warn_level(1, "eigs_sym(): opts.subdim must be at least k for LOBPCG; using k instead of ", opts.subdim);
+        nblk = n_eigvals;
+        }
+      else
+        {
+        nblk = uword(opts.subdim);
+        }
+      }
+    
+    if(3*nblk > n)  { nblk = (std::max)(n_eigvals, n/3); }
+    
+    // The Rayleigh-Ritz step works on a basis of up to 3*nblk vectors;
+    // for small matrices there is no benefit over the Krylov solver.
+    if(3*nblk > n)  { return sp_auxlib::eigs_sym_newarp_op(eigval, eigvec, op, n_eigvals, form_val, opts); }
+    
+    eT tol = (std::max)(eT(opts.tol), std::numeric_limits<eT>::epsilon());
+    
+    uword maxiter = uword(opts.maxiter);
+    
+    bool status = true;
+    
+    uword nconv = 0;
+    
+    try
+      {
+      if(form_val == form_la)
+        {
+        newarp::SymEigsBlockSolver< eT, newarp::EigsSelect::LARGEST_ALGE, op_type, precond_type > eigs(op, precond, n_eigvals, nblk);
+        eigs.init();
+        nconv  = eigs.compute(maxiter, tol);
+        eigval = eigs.eigenvalues();
+        eigvec = eigs.eigenvectors();
+        }
+      else
+      if(form_val == form_sa)
+        {
+        newarp::SymEigsBlockSolver< eT, newarp::EigsSelect::SMALLEST_ALGE, op_type, precond_type > eigs(op, precond, n_eigvals, nblk);
+        eigs.init();
+        nconv  = eigs.compute(maxiter, tol);
+        eigval = eigs.eigenvalues();
+        eigvec = eigs.eigenvectors();
+        }
+      }
+    catch(const std::runtime_error&)
+      {
+      status = false;
+      }
+    
+    if(status == true)
+      {
+      if(nconv == 0)  { status = false; }
+      }
+    
+    return status;
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(op);
+    arma_ignore(precond);
     arma_ignore(n_eigvals);
     arma_ignore(form_val);
     arma_ignore(opts);
@@ -306,6 +449,33 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
     
     if(op.valid == false)  { return false; }
     
+    return sp_auxlib::eigs_sym_newarp_shift_op(eigval, eigvec, op, n_eigvals, sigma, opts);
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(X);
+    arma_ignore(n_eigvals);
+    arma_ignore(sigma);
+    arma_ignore(opts);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename eT, typename op_type>
+inline
+bool
+sp_auxlib::eigs_sym_newarp_shift_op(Col<eT>& eigval, Mat<eT>& eigvec, const op_type& op, const uword n_eigvals, const eT sigma, const eigs_opts& opts)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
     arma_debug_check( (n_eigvals >= op.n_rows), "eigs_sym(): n_eigvals must be less than the number of rows in the matrix" );
     
     // If the matrix is empty, the case is trivial.
@@ -360,7 +530,7 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
     
     try
       {
-      newarp::SymEigsShiftSolver< eT, newarp::EigsSelect::LARGEST_MAGN, newarp::SparseGenRealShiftSolve<eT> > eigs(op, n_eigvals, ncv, sigma);
+      newarp::SymEigsShiftSolver< eT, newarp::EigsSelect::LARGEST_MAGN, op_type > eigs(op, n_eigvals, ncv, sigma);
       eigs.init();
       nconv  = eigs.compute(maxiter, tol);
       eigval = eigs.eigenvalues();
@@ -382,11 +552,84 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
     {
     arma_ignore(eigval);
     arma_ignore(eigvec);
-    arma_ignore(X);
+    arma_ignore(op);
+    arma_ignore(n_eigvals);
+    arma_ignore(sigma);
+    arma_ignore(opts);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+//! eigendecomposition of the symmetric real operator given by fn, where fn(y,x) evaluates y = A*x
+template<typename eT, typename fn_type>
+inline
+bool
+sp_auxlib::eigs_sym_fn(Col<eT>& eigval, Mat<eT>& eigvec, const fn_type& fn, const uword n, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
+    const newarp::FnGenMatProd<eT, fn_type> op(fn, n);
+    
+    if(opts.method == eigs_opts::METHOD_LOBPCG)
+      {
+      if(opts.precond != eigs_opts::PRECOND_NONE)  { arma_debug_warn_level(1, "eigs_sym(): opts.precond is ignored for operators given as functions"); }
+      
+      const newarp::DiagPrecond<eT> precond;
+      
+      return sp_auxlib::eigs_sym_newarp_block(eigval, eigvec, op, precond, n_eigvals, form_val, opts);
+      }
+    
+    return sp_auxlib::eigs_sym_newarp_op(eigval, eigvec, op, n_eigvals, form_val, opts);
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(fn);
+    arma_ignore(n);
+    arma_ignore(n_eigvals);
+    arma_ignore(form_val);
+    arma_ignore(opts);
+    
+    arma_stop_logic_error("eigs_sym(): use of NEWARP must be enabled for operators given as functions");
+    return false;
+    }
+  #endif
+  }
+
+
+
+//! shift-invert mode for the operator A, where solve_fn(y,x) evaluates y = inv(A - sigma*I)*x
+template<typename eT, typename fn_type>
+inline
+bool
+sp_auxlib::eigs_sym_fn(Col<eT>& eigval, Mat<eT>& eigvec, const fn_type& solve_fn, const uword n, const uword n_eigvals, const eT sigma, const eigs_opts& opts)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
+    const newarp::FnGenMatProd<eT, fn_type> op(solve_fn, n);
+    
+    return sp_auxlib::eigs_sym_newarp_shift_op(eigval, eigvec, op, n_eigvals, sigma, opts);
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(solve_fn);
+    arma_ignore(n);
     arma_ignore(n_eigvals);
     arma_ignore(sigma);
     arma_ignore(opts);
     
+    arma_stop_logic_error("eigs_sym(): use of NEWARP must be enabled for operators given as functions");
     return false;
     }
   #endif
@@ -620,12 +863,39 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
   
   #if defined(ARMA_USE_NEWARP)
     {
-    arma_debug_check( (form_val != form_lm) && (form_val != form_sm) && (form_val != form_lr) && (form_val != form_sr) && (form_val != form_li) && (form_val != form_si), "eigs_gen(): unknown form specified" );
-    
     if(X.is_square() == false)  { return false; }
     
     const newarp::SparseGenMatProd<T> op(X);
     
+    return sp_auxlib::eigs_gen_newarp_op(eigval, eigvec, op, n_eigvals, form_val, opts);
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(X);
+    arma_ignore(n_eigvals);
+    arma_ignore(form_val);
+    arma_ignore(opts);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename T, typename op_type>
+inline
+bool
+sp_auxlib::eigs_gen_newarp_op(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const op_type& op, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
+    arma_debug_check( (form_val != form_lm) && (form_val != form_sm) && (form_val != form_lr) && (form_val != form_sr) && (form_val != form_li) && (form_val != form_si), "eigs_gen(): unknown form specified" );
+    
     arma_debug_check( (n_eigvals + 1 >= op.n_rows), "eigs_gen(): n_eigvals + 1 must be less than the number of rows in the matrix" );
     
     // If the matrix is empty, the case is trivial.
@@ -682,7 +952,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       {
       if(form_val == form_lm)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_MAGN, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
+        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_MAGN, op_type > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -691,7 +961,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_sm)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_MAGN, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
+        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_MAGN, op_type > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -700,7 +970,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_lr)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_REAL, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
+        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_REAL, op_type > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -709,7 +979,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_sr)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_REAL, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
+        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_REAL, op_type > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -718,7 +988,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_li)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_IMAG, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
+        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_IMAG, op_type > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -727,7 +997,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_si)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_IMAG, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
+        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_IMAG, op_type > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -750,7 +1020,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
     {
     arma_ignore(eigval);
     arma_ignore(eigvec);
-    arma_ignore(X);
+    arma_ignore(op);
     arma_ignore(n_eigvals);
     arma_ignore(form_val);
     arma_ignore(opts);
@@ -763,6 +1033,38 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
 
 
 
+//! eigendecomposition of the general real operator given by fn, where fn(y,x) evaluates y = A*x
+template<typename T, typename fn_type>
+inline
+bool
+sp_auxlib::eigs_gen_fn(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const fn_type& fn, const uword n, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
+    const newarp::FnGenMatProd<T, fn_type> op(fn, n);
+    
+    return sp_auxlib::eigs_gen_newarp_op(eigval, eigvec, op, n_eigvals, form_val, opts);
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(fn);
+    arma_ignore(n);
+    arma_ignore(n_eigvals);
+    arma_ignore(form_val);
+    arma_ignore(opts);
+    
+    arma_stop_logic_error("eigs_gen(): use of NEWARP must be enabled for operators given as functions");
+    return false;
+    }
+  #endif
+  }
+
+
+
 template<typename T, bool use_sigma>
 inline
 bool
@@ -2503,17 +2805,7 @@ superlu_supermatrix_wrangler::~superlu_supermatrix_wrangler()
   {
   arma_extra_debug_sigprint_this(this);
   
-  if(used == false)  { return; }
-  
-  char* m_char   = reinterpret_cast<char*>(&m);
-  bool  all_zero = true;
-  
-  for(size_t i=0; i < sizeof(superlu::SuperMatrix); ++i)
-    {
-    if(m_char[i] != char(0))  { all_zero = false; break; }
-    }
-  
-  if(all_zero == false)  { sp_auxlib::destroy_supermatrix(m); }
+  reset();
   }
 
 inline
@@ -2542,6 +2834,29 @@ superlu_supermatrix_wrangler::get_ptr()
   return &m;
   }
 
+inline
+void
+superlu_supermatrix_wrangler::reset()
+  {
+  arma_extra_debug_sigprint();
+  
+  if(used == false)  { return; }
+  
+  char* m_char   = reinterpret_cast<char*>(&m);
+  bool  all_zero = true;
+  
+  for(size_t i=0; i < sizeof(superlu::SuperMatrix); ++i)
+    {
+    if(m_char[i] != char(0))  { all_zero = false; break; }
+    }
+  
+  if(all_zero == false)  { sp_auxlib::destroy_supermatrix(m); }
+  
+  arrayops::fill_zeros(reinterpret_cast<char*>(&m), sizeof(superlu::SuperMatrix));
+  
+  used = false;
+  }
+
 
 //
 
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup sp_krylov
+//! @{
+
+
+
+//! preconditioners for the iterative solvers;
+//! the matrix is given in compressed sparse row form via the CSC form of its transpose
+template<typename eT>
+class sp_krylov_precond
+  {
+  public:
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  inline sp_krylov_precond();
+  
+  inline bool init(const SpMat<eT>& At, const spsolve_opts::precond_type in_type);
+  
+  inline void apply(Col<eT>& z, const Col<eT>& r) const;
+  
+  
+  private:
+  
+  spsolve_opts::precond_type type;
+  
+  Col<eT> inv_diag;   //!< Jacobi
+  
+  uvec    row_ptrs;   //!< ILU(0) and IC(0) factors, stored row by row
+  uvec    col_idx;
+  Col<eT> vals;
+  uvec    diag_pos;
+  
+  inline bool init_jacobi(const SpMat<eT>& At);
+  inline bool init_ilu0  (const SpMat<eT>& At);
+  inline bool init_ic0   (const SpMat<eT>& At);
+  };
+
+
+
+class sp_krylov
+  {
+  public:
+  
+  template<typename eT>
+  inline static bool solve(Mat<eT>& X, const SpMat<eT>& A, const Mat<eT>& B, const char method, const spsolve_opts& opts);
+  
+  
+  private:
+  
+  template<typename eT>
+  inline static void spmv(Col<eT>& y, const SpMat<eT>& At, const Col<eT>& x);
+  
+  template<typename eT, typename T>
+  inline static bool cg(Col<eT>& x, const SpMat<eT>& At, const Col<eT>& b, const sp_krylov_precond<eT>& M, const T tol, const uword max_iter, T& rel_res);
+  
+  template<typename eT, typename T>
+  inline static bool bicgstab(Col<eT>& x, const SpMat<eT>& At, const Col<eT>& b, const sp_krylov_precond<eT>& M, const T tol, const uword max_iter, T& rel_res);
+  
+  template<typename eT, typename T>
+  inline static bool gmres(Col<eT>& x, const SpMat<eT>& At, const Col<eT>& b, const sp_krylov_precond<eT>& M, const T tol, const uword max_iter, const uword restart, T& rel_res);
+  };
+
+
+
+//! @}
@@ -0,0 +1,702 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup sp_krylov
+//! @{
+
+
+
+template<typename eT>
+inline
+sp_krylov_precond<eT>::sp_krylov_precond()
+  : type(spsolve_opts::PRECOND_NONE)
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+template<typename eT>
+inline
+bool
+sp_krylov_precond<eT>::init(const SpMat<eT>& At, const spsolve_opts::precond_type in_type)
+  {
+  arma_extra_debug_sigprint();
+  
+  type = in_type;
+  
+  bool status = true;
+  
+  switch(type)
+    {
+    case spsolve_opts::PRECOND_JACOBI:  status = init_jacobi(At);  break;
+    case spsolve_opts::PRECOND_ILU0:    status = init_ilu0(At);    break;
+    case spsolve_opts::PRECOND_IC0:     status = init_ic0(At);     break;
+    default:                            break;
+    }
+  
+  if(status == false)  { type = spsolve_opts::PRECOND_NONE; }
+  
+  return status;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+sp_krylov_precond<eT>::init_jacobi(const SpMat<eT>& At)
+  {
+  arma_extra_debug_sigprint();
+  
+  inv_diag = Col<eT>(At.diag());
+  
+  if(any(inv_diag == eT(0)))  { return false; }
+  
+  inv_diag = eT(1) / inv_diag;
+  
+  return true;
+  }
+
+
+
+//! incomplete LU factorisation with the sparsity pattern of A;
+//! L has a unit diagonal, and both factors are stored in place of the elements of A
+template<typename eT>
+inline
+bool
+sp_krylov_precond<eT>::init_ilu0(const SpMat<eT>& At)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n = At.n_cols;
+  
+  row_ptrs = uvec(   const_cast<uword*>(At.col_ptrs),    n+1,          true );
+  col_idx  = uvec(   const_cast<uword*>(At.row_indices), At.n_nonzero, true );
+  vals     = Col<eT>(const_cast<eT*   >(At.values),      At.n_nonzero, true );
+  
+  diag_pos.set_size(n);
+  
+  for(uword i=0; i < n; ++i)
+    {
+    uword p = row_ptrs[i];
+    
+    while( (p < row_ptrs[i+1]) && (col_idx[p] < i) )  { ++p; }
+    
+    if( (p == row_ptrs[i+1]) || (col_idx[p] != i) )  { return false; }
+    
+    diag_pos[i] = p;
+    }
+  
+  const uword none = n;
+  
+  uvec marker(n);
+  
+  marker.fill(none);
+  
+  eT* vals_mem = vals.memptr();
+  
+  for(uword i=0; i < n; ++i)
+    {
+    const uword start = row_ptrs[i  ];
+    const uword end   = row_ptrs[i+1];
+    
+    for(uword p=start; p < end; ++p)  { marker[ col_idx[p] ] = p; }
+    
+    for(uword p=start; p < diag_pos[i]; ++p)
+      {
+      const uword k = col_idx[p];
+      
+      const eT l_ik = vals_mem[p] / vals_mem[ diag_pos[k] ];
+      
+      vals_mem[p] = l_ik;
+      
+      for(uword q = diag_pos[k] + 1; q < row_ptrs[k+1]; ++q)
+        {
+        const uword pos = marker[ col_idx[q] ];
+        
+        if(pos != none)  { vals_mem[pos] -= l_ik * vals_mem[q]; }
+        }
+      }
+    
+    for(uword p=start; p < end; ++p)  { marker[ col_idx[p] ] = none; }
+    
+    if(vals_mem[ diag_pos[i] ] == eT(0))  { return false; }
+    }
+  
+  return vals.is_finite();
+  }
+
+
+
+//! incomplete Cholesky factorisation A = L*L^H with the sparsity pattern of the lower triangle of A
+template<typename eT>
+inline
+bool
+sp_krylov_precond<eT>::init_ic0(const SpMat<eT>& At)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n = At.n_cols;
+  
+  // extract the lower triangle; the diagonal is the last element of each row
+  
+  uword n_lower = 0;
+  
+  for(uword i=0; i < n; ++i)
+  for(uword p = At.col_ptrs[i]; p < At.col_ptrs[i+1]; ++p)
+    {
+    n_lower += (At.row_indices[p] <= i) ? uword(1) : uword(0);
+    }
+  
+  row_ptrs.set_size(n+1);
+  col_idx.set_size(n_lower);
+  vals.set_size(n_lower);
+  diag_pos.set_size(n);
+  
+  uword count = 0;
+  
+  row_ptrs[0] = 0;
+  
+  for(uword i=0; i < n; ++i)
+    {
+    for(uword p = At.col_ptrs[i]; p < At.col_ptrs[i+1]; ++p)
+      {
+      const uword j = At.row_indices[p];
+      
+      if(j > i)  { break; }
+      
+      col_idx[count] = j;
+      vals[count]    = At.values[p];
+      
+      ++count;
+      }
+    
+    row_ptrs[i+1] = count;
+    
+    if( (count == row_ptrs[i]) || (col_idx[count-1] != i) )  { return false; }
+    
+    diag_pos[i] = count-1;
+    }
+  
+  const uword none = n;
+  
+  uvec marker(n);
+  
+  marker.fill(none);
+  
+  eT* vals_mem = vals.memptr();
+  
+  for(uword i=0; i < n; ++i)
+    {
+    const uword start = row_ptrs[i];
+    
+    for(uword p=start; p < diag_pos[i]; ++p)  { marker[ col_idx[p] ] = p; }
+    
+    T d = access::tmp_real(vals_mem[ diag_pos[i] ]);
+    
+    for(uword p=start; p < diag_pos[i]; ++p)
+      {
+      const uword k = col_idx[p];
+      
+      // dot product of the already computed parts of rows i and k
+      
+      eT acc = vals_mem[p];
+      
+      for(uword q = row_ptrs[k]; q < diag_pos[k]; ++q)
+        {
+        const uword pos = marker[ col_idx[q] ];
+        
+        if( (pos != none) && (pos < p) )  { acc -= vals_mem[pos] * access::alt_conj(vals_mem[q]); }
+        }
+      
+      const eT l_ik = acc / vals_mem[ diag_pos[k] ];
+      
+      vals_mem[p] = l_ik;
+      
+      const T l_ik_abs = std::abs(l_ik);
+      
+      d -= l_ik_abs * l_ik_abs;
+      }
+    
+    for(uword p=start; p < diag_pos[i]; ++p)  { marker[ col_idx[p] ] = none; }
+    
+    if( (d <= T(0)) || (arma_isfinite(d) == false) )  { return false; }
+    
+    vals_mem[ diag_pos[i] ] = eT(std::sqrt(d));
+    }
+  
+  return vals.is_finite();
+  }
+
+
+
+template<typename eT>
+inline
+void
+sp_krylov_precond<eT>::apply(Col<eT>& z, const Col<eT>& r) const
+  {
+  arma_extra_debug_sigprint();
+  
+  if(type == spsolve_opts::PRECOND_NONE)    { z = r;  return; }
+  if(type == spsolve_opts::PRECOND_JACOBI)  { z = inv_diag % r;  return; }
+  
+  const uword n = r.n_elem;
+  
+  z.set_size(n);
+  
+  const eT* r_mem    = r.memptr();
+        eT* z_mem    = z.memptr();
+  const eT* vals_mem = vals.memptr();
+  
+  if(type == spsolve_opts::PRECOND_ILU0)
+    {
+    // forward substitution with L (unit diagonal), then backward substitution with U
+    
+    for(uword i=0; i < n; ++i)
+      {
+      eT acc = r_mem[i];
+      
+      for(uword p = row_ptrs[i]; p < diag_pos[i]; ++p)  { acc -= vals_mem[p] * z_mem[ col_idx[p] ]; }
+      
+      z_mem[i] = acc;
+      }
+    
+    for(uword i=n; i-- > 0;)
+      {
+      eT acc = z_mem[i];
+      
+      for(uword p = diag_pos[i] + 1; p < row_ptrs[i+1]; ++p)  { acc -= vals_mem[p] * z_mem[ col_idx[p] ]; }
+      
+      z_mem[i] = acc / vals_mem[ diag_pos[i] ];
+      }
+    }
+  else
+  if(type == spsolve_opts::PRECOND_IC0)
+    {
+    // forward substitution with L, then backward substitution with L^H by columns of L^H (ie. rows of L)
+    
+    for(uword i=0; i < n; ++i)
+      {
+      eT acc = r_mem[i];
+      
+      for(uword p = row_ptrs[i]; p < diag_pos[i]; ++p)  { acc -= vals_mem[p] * z_mem[ col_idx[p] ]; }
+      
+      z_mem[i] = acc / vals_mem[ diag_pos[i] ];
+      }
+    
+    for(uword i=n; i-- > 0;)
+      {
+      const eT z_i = z_mem[i] / vals_mem[ diag_pos[i] ];
+      
+      z_mem[i] = z_i;
+      
+      for(uword p = row_ptrs[i]; p < diag_pos[i]; ++p)  { z_mem[ col_idx[p] ] -= access::alt_conj(vals_mem[p]) * z_i; }
+      }
+    }
+  }
+
+
+
+// 
+// sp_krylov
+
+
+
+//! solve A*X = B with a Krylov subspace method:
+//! 'c' = conjugate gradient (A must be Hermitian positive definite), 'b' = BiCGSTAB, 'g' = restarted GMRES
+template<typename eT>
+inline
+bool
+sp_krylov::solve(Mat<eT>& X, const SpMat<eT>& A, const Mat<eT>& B, const char method, const spsolve_opts& opts)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  arma_debug_check( (A.n_rows != A.n_cols), "spsolve(): matrix A must be square sized" );
+  arma_debug_check( (A.n_rows != B.n_rows), "spsolve(): number of rows in the given objects must be the same" );
+  arma_debug_check( (opts.tol < double(0)), "spsolve(): tol must be >= 0" );
+  
+  const uword n = A.n_rows;
+  
+  const T tol = (opts.tol > double(0)) ? T(opts.tol) : T(std::sqrt(std::numeric_limits<T>::epsilon()));
+  
+  const bool use_guess = opts.warm_start && (X.n_rows == n) && (X.n_cols == B.n_cols);
+  
+  if(opts.warm_start && (use_guess == false))
+    {
+    arma_debug_warn_level(1, "spsolve(): initial guess has incorrect size; ignoring it");
+    }
+  
+  Mat<eT> out;
+  
+  if(use_guess)  { out = X; }  else  { out.zeros(n, B.n_cols); }
+  
+  // the rows of A are the columns of At, which gives independent rows in the products
+  
+  A.sync();
+  
+  const SpMat<eT> At = A.st();
+  
+  sp_krylov_precond<eT> M;
+  
+  if(M.init(At, opts.precond) == false)
+    {
+    arma_debug_warn_level(2, "spsolve(): preconditioner could not be formed; continuing without preconditioning");
+    }
+  
+  bool status = true;
+  
+  for(uword col=0; col < B.n_cols; ++col)
+    {
+          Col<eT> x(                     out.colptr(col),  n, false, true);
+    const Col<eT> b(const_cast<eT*>(B.colptr(col)), n, false, true);
+    
+    T rel_res = T(0);
+    
+    bool col_status = false;
+    
+    switch(method)
+      {
+      case 'c':  col_status = sp_krylov::cg      (x, At, b, M, tol, uword(opts.max_iter), rel_res);                        break;
+      case 'b':  col_status = sp_krylov::bicgstab(x, At, b, M, tol, uword(opts.max_iter), rel_res);                        break;
+      case 'g':  col_status = sp_krylov::gmres   (x, At, b, M, tol, uword(opts.max_iter), uword(opts.restart), rel_res);  break;
+      default:   break;
+      }
+    
+    if(col_status == false)
+      {
+      arma_debug_warn_level(2, "spsolve(): iterative solver did not converge (relative residual: ", rel_res, ")");
+      
+      status = false;
+      }
+    }
+  
+  X.steal_mem(out);
+  
+  return status;
+  }
+
+
+
+template<typename eT>
+inline
+void
+sp_krylov::spmv(Col<eT>& y, const SpMat<eT>& At, const Col<eT>& x)
+  {
+  spglue_times_misc::csr_times_dense_noalias(y, At, x);
+  }
+
+
+
+//! preconditioned conjugate gradient
+template<typename eT, typename T>
+inline
+bool
+sp_krylov::cg(Col<eT>& x, const SpMat<eT>& At, const Col<eT>& b, const sp_krylov_precond<eT>& M, const T tol, const uword max_iter, T& rel_res)
+  {
+  arma_extra_debug_sigprint();
+  
+  const T b_norm = norm(b);
+  
+  if(b_norm == T(0))  { x.zeros(); rel_res = T(0); return true; }
+  
+  Col<eT> r;
+  Col<eT> z;
+  Col<eT> p;
+  Col<eT> Ap;
+  
+  sp_krylov::spmv(Ap, At, x);
+  
+  r = b - Ap;
+  
+  rel_res = norm(r) / b_norm;
+  
+  if(rel_res <= tol)  { return true; }
+  
+  M.apply(z, r);
+  
+  p = z;
+  
+  eT rz = cdot(r, z);
+  
+  for(uword iter=0; iter < max_iter; ++iter)
+    {
+    sp_krylov::spmv(Ap, At, p);
+    
+    const eT pAp = cdot(p, Ap);
+    
+    if(pAp == eT(0))  { return false; }
+    
+    const eT alpha = rz / pAp;
+    
+    x += alpha * p;
+    r -= alpha * Ap;
+    
+    rel_res = norm(r) / b_norm;
+    
+    if(rel_res <= tol)  { return true; }
+    
+    if(arma_isfinite(rel_res) == false)  { return false; }
+    
+    M.apply(z, r);
+    
+    const eT rz_new = cdot(r, z);
+    
+    const eT beta = rz_new / rz;
+    
+    rz = rz_new;
+    
+    p = z + beta * p;
+    }
+  
+  return false;
+  }
+
+
+
+//! BiCGSTAB with right preconditioning
+template<typename eT, typename T>
+inline
+bool
+sp_krylov::bicgstab(Col<eT>& x, const SpMat<eT>& At, const Col<eT>& b, const sp_krylov_precond<eT>& M, const T tol, const uword max_iter, T& rel_res)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n = b.n_elem;
+  
+  const T b_norm = norm(b);
+  
+  if(b_norm == T(0))  { x.zeros(); rel_res = T(0); return true; }
+  
+  Col<eT> r;
+  Col<eT> v(n, arma_zeros_indicator());
+  Col<eT> p(n, arma_zeros_indicator());
+  Col<eT> s;
+  Col<eT> t;
+  Col<eT> p_hat;
+  Col<eT> s_hat;
+  
+  sp_krylov::spmv(t, At, x);
+  
+  r = b - t;
+  
+  rel_res = norm(r) / b_norm;
+  
+  if(rel_res <= tol)  { return true; }
+  
+  const Col<eT> r0 = r;
+  
+  eT rho   = eT(1);
+  eT alpha = eT(1);
+  eT omega = eT(1);
+  
+  for(uword iter=0; iter < max_iter; ++iter)
+    {
+    const eT rho_new = cdot(r0, r);
+    
+    if(rho_new == eT(0))  { return false; }
+    
+    const eT beta = (rho_new / rho) * (alpha / omega);
+    
+    p = r + beta * (p - omega * v);
+    
+    M.apply(p_hat, p);
+    
+    sp_krylov::spmv(v, At, p_hat);
+    
+    const eT r0v = cdot(r0, v);
+    
+    if(r0v == eT(0))  { return false; }
+    
+    alpha = rho_new / r0v;
+    
+    s = r - alpha * v;
+    
+    const T s_rel = norm(s) / b_norm;
+    
+    if(s_rel <= tol)  { x += alpha * p_hat; rel_res = s_rel; return true; }
+    
+    M.apply(s_hat, s);
+    
+    sp_krylov::spmv(t, At, s_hat);
+    
+    const eT tt = cdot(t, t);
+    
+    if(tt == eT(0))  { return false; }
+    
+    omega = cdot(t, s) / tt;
+    
+    x += alpha * p_hat + omega * s_hat;
+    
+    r = s - omega * t;
+    
+    rel_res = norm(r) / b_norm;
+    
+    if(rel_res <= tol)  { return true; }
+    
+    if( (omega == eT(0)) || (arma_isfinite(rel_res) == false) )  { return false; }
+    
+    rho = rho_new;
+    }
+  
+  return false;
+  }
+
+
+
+//! restarted GMRES with right preconditioning; the Hessenberg matrix is reduced with Givens rotations
+template<typename eT, typename T>
+inline
+bool
+sp_krylov::gmres(Col<eT>& x, const SpMat<eT>& At, const Col<eT>& b, const sp_krylov_precond<eT>& M, const T tol, const uword max_iter, const uword restart, T& rel_res)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n = b.n_elem;
+  
+  const T b_norm = norm(b);
+  
+  if(b_norm == T(0))  { x.zeros(); rel_res = T(0); return true; }
+  
+  const uword m = (std::max)(uword(1), (std::min)(restart, n));
+  
+  Mat<eT> V(n, m+1, arma_nozeros_indicator());
+  Mat<eT> H(m+1, m, arma_nozeros_indicator());
+  
+  Col<T>  cs(m, arma_nozeros_indicator());
+  Col<eT> sn(m, arma_nozeros_indicator());
+  Col<eT> g(m+1, arma_nozeros_indicator());
+  
+  Col<eT> r;
+  Col<eT> w;
+  Col<eT> z;
+  Col<eT> y;
+  
+  uword iter = 0;
+  
+  while(true)
+    {
+    sp_krylov::spmv(w, At, x);
+    
+    r = b - w;
+    
+    const T beta = norm(r);
+    
+    rel_res = beta / b_norm;
+    
+    if(rel_res <= tol)  { return true; }
+    
+    if( (iter >= max_iter) || (arma_isfinite(rel_res) == false) )  { return false; }
+    
+    V.col(0) = r / beta;
+    
+    H.zeros();
+    g.zeros();
+    
+    g[0] = eT(beta);
+    
+    uword k = 0;
+    
+    for(uword j=0; (j < m) && (iter < max_iter); ++j)
+      {
+      ++iter;
+      
+      const Col<eT> v_j(V.colptr(j), n, false, true);
+      
+      M.apply(z, v_j);
+      
+      sp_krylov::spmv(w, At, z);
+      
+      // modified Gram-Schmidt
+      
+      for(uword i=0; i <= j; ++i)
+        {
+        const Col<eT> v_i(V.colptr(i), n, false, true);
+        
+        const eT h = cdot(v_i, w);
+        
+        H.at(i,j) = h;
+        
+        w -= h * v_i;
+        }
+      
+      const T h_next = norm(w);
+      
+      H.at(j+1,j) = eT(h_next);
+      
+      if(h_next != T(0))  { V.col(j+1) = w / h_next; }
+      
+      for(uword i=0; i < j; ++i)
+        {
+        const eT h_i  = H.at(i,  j);
+        const eT h_i1 = H.at(i+1,j);
+        
+        H.at(i,  j) =  cs[i] * h_i + sn[i] * h_i1;
+        H.at(i+1,j) = -access::alt_conj(sn[i]) * h_i + cs[i] * h_i1;
+        }
+      
+      const eT a = H.at(j,  j);
+      const eT c = H.at(j+1,j);
+      
+      const T a_abs = std::abs(a);
+      const T c_abs = std::abs(c);
+      const T r_abs = std::sqrt(a_abs*a_abs + c_abs*c_abs);
+      
+      const eT phase = (a_abs != T(0)) ? eT(a / a_abs) : eT(1);
+      
+      cs[j] = (r_abs != T(0)) ? T(a_abs / r_abs) : T(1);
+      sn[j] = (r_abs != T(0)) ? eT(phase * access::alt_conj(c) / r_abs) : eT(0);
+      
+      H.at(j,  j) = phase * r_abs;
+      H.at(j+1,j) = eT(0);
+      
+      g[j+1] = -access::alt_conj(sn[j]) * g[j];
+      g[j]   = cs[j] * g[j];
+      
+      k = j+1;
+      
+      const T res_estimate = std::abs(g[j+1]) / b_norm;
+      
+      if( (res_estimate <= tol) || (h_next == T(0)) )  { break; }
+      }
+    
+    // solve the upper triangular system and update the solution
+    
+    y.set_size(k);
+    
+    for(uword i=k; i-- > 0;)
+      {
+      eT acc = g[i];
+      
+      for(uword l=i+1; l < k; ++l)  { acc -= H.at(i,l) * y[l]; }
+      
+      y[i] = acc / H.at(i,i);
+      }
+    
+    w = V.cols(0, k-1) * y;
+    
+    M.apply(z, w);
+    
+    x += z;
+    }
+  }
+
+
+
+//! @}
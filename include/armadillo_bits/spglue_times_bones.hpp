@@ -41,6 +41,68 @@ class spglue_times
   
   template<typename eT>
   arma_hot inline static void apply_noalias(SpMat<eT>& c, const SpMat<eT>& x, const SpMat<eT>& y);
+  
+  template<typename eT, typename acc_type>
+  arma_hot inline static void symbolic_cols(uword* counts, const SpMat<eT>& x, const SpMat<eT>& y, const uword col_start, const uword col_end, acc_type& acc);
+  
+  template<typename eT, typename acc_type>
+  arma_hot inline static void numeric_cols(SpMat<eT>& c, uword* counts, const SpMat<eT>& x, const SpMat<eT>& y, const uword col_start, const uword col_end, acc_type& acc);
+  };
+
+
+
+//! dense sparse accumulator, indexed directly by row; used when the rows of the result are relatively dense
+template<typename eT>
+class spglue_times_dense_acc
+  {
+  public:
+  
+  inline spglue_times_dense_acc(const uword n_rows, const uword max_col_nnz, const bool with_values);
+  
+  arma_inline void mark(const uword row);
+  arma_inline void add (const uword row, const eT val);
+  
+  inline uword flush_count();                           //!< number of distinct rows in the current column; starts a new column
+  inline uword flush(uword* out_rows, eT* out_values);  //!< sorted rows and non-zero sums of the current column; starts a new column
+  
+  
+  private:
+  
+  uword           tag;
+  podarray<uword> marker;  //!< marker[row] == tag when the row is used in the current column
+  podarray<uword> used;
+  uword           n_used;
+  podarray<eT>    sums;
+  };
+
+
+
+//! hash based sparse accumulator, with memory proportional to the number of rows used in one column;
+//! used when the result is very sparse relative to its number of rows
+template<typename eT>
+class spglue_times_hash_acc
+  {
+  public:
+  
+  inline spglue_times_hash_acc(const uword n_rows, const uword max_col_nnz, const bool with_values);
+  
+  arma_inline void mark(const uword row);
+  arma_inline void add (const uword row, const eT val);
+  
+  inline uword flush_count();
+  inline uword flush(uword* out_rows, eT* out_values);
+  
+  
+  private:
+  
+  arma_inline uword find_slot(const uword row);
+  
+  uword           mask;
+  uword           empty_key;
+  podarray<uword> keys;
+  podarray<uword> used;  //!< slots used in the current column
+  uword           n_used;
+  podarray<eT>    sums;
   };
 
 
@@ -62,6 +124,27 @@ class spglue_times_misc
   
   template<typename T1, typename T2>
   inline static void dense_times_sparse(Mat<typename T1::elem_type>& out, const T1& x, const T2& y);
+  
+  template<typename eT>
+  inline static void sparse_times_dense_noalias(Mat<eT>& out, const SpMat<eT>& A, const Mat<eT>& B);
+  
+  template<typename eT>
+  inline static void dense_times_sparse_noalias(Mat<eT>& out, const Mat<eT>& A, const SpMat<eT>& B);
+  
+  template<typename eT>
+  inline static void csr_times_dense_noalias(Mat<eT>& out, const SpMat<eT>& At, const Mat<eT>& B);
+  
+  template<typename eT>
+  inline static void dense_times_csr_noalias(Mat<eT>& out, const Mat<eT>& A, const SpMat<eT>& Bt);
+  
+  template<typename eT>
+  inline static void sparse_times_vec(eT* y, const SpMat<eT>& A, const eT* x);
+  
+  template<typename eT>
+  inline static void sparse_trans_times_vec(eT* y, const SpMat<eT>& A, const eT* x);
+  
+  template<typename eT>
+  inline static void nnz_balanced_cols(podarray<uword>& bounds, const SpMat<eT>& A, const uword n_tasks);
   };
 
 
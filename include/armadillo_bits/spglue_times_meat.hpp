@@ -95,192 +95,415 @@ spglue_times::apply_noalias(SpMat<eT>& c, const SpMat<eT>& x, const SpMat<eT>& y
   const uword x_n_cols = x.n_cols;
   const uword y_n_rows = y.n_rows;
   const uword y_n_cols = y.n_cols;
-
+  
   arma_debug_assert_mul_size(x_n_rows, x_n_cols, y_n_rows, y_n_cols, "matrix multiplication");
-
-  // First we must determine the structure of the new matrix (column pointers).
+  
   // This follows the algorithm described in 'Sparse Matrix Multiplication
-  // Package (SMMP)' (R.E. Bank and C.C. Douglas, 2001).  Their description of
-  // "SYMBMM" does not include anything about memory allocation.  In addition it
-  // does not consider that there may be elements which space may be allocated
-  // for but which evaluate to zero anyway.  So we have to modify the algorithm
-  // to work that way.  For the "SYMBMM" implementation we will not determine
-  // the row indices but instead just the column pointers.
-  
-  //SpMat<typename T1::elem_type> c(x_n_rows, y_n_cols); // Initializes col_ptrs to 0.
+  // Package (SMMP)' (R.E. Bank and C.C. Douglas, 2001).
+  // The columns of the result are split into ranges of roughly equal work, which are processed in parallel.
+  // The symbolic phase ("SYMBMM") counts the distinct rows in each column of the result,
+  // giving the column pointers after a prefix sum.  The numeric phase ("NUMBMM") then fills each column in place.
+  // Elements which evaluate to zero are not stored.
+  
   c.zeros(x_n_rows, y_n_cols);
   
-  //if( (x.n_elem == 0) || (y.n_elem == 0) )  { return; }
   if( (x.n_nonzero == 0) || (y.n_nonzero == 0) )  { return; }
   
-  // Auxiliary storage which denotes when items have been found.
-  podarray<uword> index(x_n_rows);
-  index.fill(x_n_rows); // Fill with invalid links.
+  x.sync();
+  y.sync();
   
-  typename SpMat<eT>::const_iterator y_it  = y.begin();
-  typename SpMat<eT>::const_iterator y_end = y.end();
-
-  // SYMBMM: calculate column pointers for resultant matrix to obtain a good
-  // upper bound on the number of nonzero elements.
-  uword cur_col_length = 0;
-  uword last_ind = x_n_rows + 1;
-  do
+  // work[j] is the number of multiplications required for column j,
+  // which is also an upper bound on the number of elements in that column
+  podarray<uword> work(y_n_cols + 1);
+  
+  work[0] = 0;
+  
+  for(uword j=0; j < y_n_cols; ++j)
+    {
+    uword col_work = 0;
+    
+    for(uword k = y.col_ptrs[j]; k < y.col_ptrs[j+1]; ++k)
+      {
+      const uword y_row = y.row_indices[k];
+      
+      col_work += x.col_ptrs[y_row + 1] - x.col_ptrs[y_row];
+      }
+    
+    work[j+1] = work[j] + col_work;
+    }
+  
+  const uword total_work = work[y_n_cols];
+  
+  if(total_work == 0)  { return; }
+  
+  int n_threads = 1;
+  
+  #if defined(ARMA_USE_MP)
+    {
+    // each multiplication costs a few cycles, as the accumulator is accessed at random
+    if(mp_gate<eT>::eval(total_work, 4))  { n_threads = mp_thread_limit::get(); }
+    }
+  #endif
+  
+  const uword n_tasks = (std::min)(uword(n_threads), y_n_cols);
+  
+  // boundaries of the column ranges, with roughly equal work in each range
+  podarray<uword> bounds(n_tasks + 1);
+  
+  bounds[0]       = 0;
+  bounds[n_tasks] = y_n_cols;
+  
+  for(uword t=1; t < n_tasks; ++t)
+    {
+    const uword target = (std::max)( bounds[t-1], uword( (double(total_work) * double(t)) / double(n_tasks) ) );
+    
+    bounds[t] = uword( std::lower_bound(work.memptr() + bounds[t-1], work.memptr() + y_n_cols, target) - work.memptr() );
+    }
+  
+  // the accumulator is chosen per range: the dense accumulator needs memory proportional to the number of rows,
+  // so it is used only when the number of rows is not much larger than the work in the range
+  podarray<uword> max_col_work(n_tasks);
+  podarray<uword> use_hash(n_tasks);
+  
+  for(uword t=0; t < n_tasks; ++t)
     {
-    const uword y_it_row = y_it.row();
+    uword max_val = 0;
     
-    // Look through the column that this point (*y_it) could affect.
-    typename SpMat<eT>::const_iterator x_it = x.begin_col_no_sync(y_it_row);
+    for(uword j = bounds[t]; j < bounds[t+1]; ++j)  { max_val = (std::max)(max_val, work[j+1] - work[j]); }
     
-    while(x_it.col() == y_it_row)
+    max_col_work[t] = (std::min)(max_val, x_n_rows);
+    
+    use_hash[t] = ( x_n_rows > 4 * (work[bounds[t+1]] - work[bounds[t]]) ) ? uword(1) : uword(0);
+    }
+  
+  // symbolic phase; the counts are stored in the column pointers
+  uword* c_col_ptrs = access::rwp(c.col_ptrs);
+  
+  mp_parallel::run(n_tasks, n_threads, [&](const uword t)
+    {
+    if(use_hash[t] == 0)
       {
-      const uword x_it_row = x_it.row();
+      spglue_times_dense_acc<eT> acc(x_n_rows, max_col_work[t], false);
       
-      // A point at x(i, j) and y(j, k) implies a point at c(i, k).
-      if(index[x_it_row] == x_n_rows)
+      spglue_times::symbolic_cols(&(c_col_ptrs[1]), x, y, bounds[t], bounds[t+1], acc);
+      }
+    else
+      {
+      spglue_times_hash_acc<eT> acc(x_n_rows, max_col_work[t], false);
+      
+      spglue_times::symbolic_cols(&(c_col_ptrs[1]), x, y, bounds[t], bounds[t+1], acc);
+      }
+    } );
+  
+  for(uword j=0; j < y_n_cols; ++j)  { c_col_ptrs[j+1] += c_col_ptrs[j]; }
+  
+  c.mem_resize(c_col_ptrs[y_n_cols]);
+  
+  // numeric phase; each column is written at its position from the symbolic phase
+  podarray<uword> counts(y_n_cols);
+  
+  mp_parallel::run(n_tasks, n_threads, [&](const uword t)
+    {
+    if(use_hash[t] == 0)
+      {
+      spglue_times_dense_acc<eT> acc(x_n_rows, max_col_work[t], true);
+      
+      spglue_times::numeric_cols(c, counts.memptr(), x, y, bounds[t], bounds[t+1], acc);
+      }
+    else
+      {
+      spglue_times_hash_acc<eT> acc(x_n_rows, max_col_work[t], true);
+      
+      spglue_times::numeric_cols(c, counts.memptr(), x, y, bounds[t], bounds[t+1], acc);
+      }
+    } );
+  
+  // remove the gaps left by elements which evaluated to zero
+  uword* c_row_indices = access::rwp(c.row_indices);
+  eT*    c_values      = access::rwp(c.values);
+  
+  uword cur_pos = 0;
+  
+  for(uword j=0; j < y_n_cols; ++j)
+    {
+    const uword start = c_col_ptrs[j];
+    const uword count = counts[j];
+    
+    if(start != cur_pos)
+      {
+      for(uword k=0; k < count; ++k)
         {
-        index[x_it_row] = last_ind;
-        last_ind = x_it_row;
-        ++cur_col_length;
+        c_row_indices[cur_pos + k] = c_row_indices[start + k];
+        c_values     [cur_pos + k] = c_values     [start + k];
         }
-
-      ++x_it;
       }
+    
+    c_col_ptrs[j] = cur_pos;
+    
+    cur_pos += count;
+    }
+  
+  c_col_ptrs[y_n_cols] = cur_pos;
+  
+  if(cur_pos != c.n_nonzero)  { c.mem_resize(cur_pos); }
+  }
 
-    const uword old_col = y_it.col();
-    ++y_it;
 
-    // See if column incremented.
-    if(old_col != y_it.col())
+
+//! counts the distinct rows in columns [col_start, col_end) of x*y
+template<typename eT, typename acc_type>
+arma_hot
+inline
+void
+spglue_times::symbolic_cols(uword* counts, const SpMat<eT>& x, const SpMat<eT>& y, const uword col_start, const uword col_end, acc_type& acc)
+  {
+  for(uword j=col_start; j < col_end; ++j)
+    {
+    for(uword k = y.col_ptrs[j]; k < y.col_ptrs[j+1]; ++k)
       {
-      // Set column pointer (this is not a cumulative count; that is done later).
-      access::rw(c.col_ptrs[old_col + 1]) = cur_col_length;
-      cur_col_length = 0;
+      const uword y_row = y.row_indices[k];
+      
+      for(uword i = x.col_ptrs[y_row]; i < x.col_ptrs[y_row + 1]; ++i)  { acc.mark(x.row_indices[i]); }
+      }
+    
+    counts[j] = acc.flush_count();
+    }
+  }
 
-      // Return index markers to zero.  Use last_ind for traversal.
-      while(last_ind != x_n_rows + 1)
-        {
-        const uword tmp = index[last_ind];
-        index[last_ind] = x_n_rows;
-        last_ind = tmp;
-        }
+
+
+//! computes columns [col_start, col_end) of x*y, storing the number of non-zero elements of each column in counts
+template<typename eT, typename acc_type>
+arma_hot
+inline
+void
+spglue_times::numeric_cols(SpMat<eT>& c, uword* counts, const SpMat<eT>& x, const SpMat<eT>& y, const uword col_start, const uword col_end, acc_type& acc)
+  {
+  uword* c_row_indices = access::rwp(c.row_indices);
+  eT*    c_values      = access::rwp(c.values);
+  
+  for(uword j=col_start; j < col_end; ++j)
+    {
+    for(uword k = y.col_ptrs[j]; k < y.col_ptrs[j+1]; ++k)
+      {
+      const uword y_row   = y.row_indices[k];
+      const eT    y_value = y.values[k];
+      
+      for(uword i = x.col_ptrs[y_row]; i < x.col_ptrs[y_row + 1]; ++i)  { acc.add(x.row_indices[i], x.values[i] * y_value); }
       }
+    
+    const uword pos = c.col_ptrs[j];
+    
+    counts[j] = acc.flush( &(c_row_indices[pos]), &(c_values[pos]) );
     }
-  while(y_it != y_end);
+  }
+
+
 
-  // Accumulate column pointers.
-  for(uword i = 0; i < c.n_cols; ++i)
+template<typename eT>
+inline
+spglue_times_dense_acc<eT>::spglue_times_dense_acc(const uword n_rows, const uword max_col_nnz, const bool with_values)
+  : tag(0)
+  , marker(n_rows)
+  , used(max_col_nnz)
+  , n_used(0)
+  {
+  marker.fill(uword(0) - uword(1));
+  
+  if(with_values)  { sums.zeros(n_rows); }
+  }
+
+
+
+template<typename eT>
+arma_inline
+void
+spglue_times_dense_acc<eT>::mark(const uword row)
+  {
+  if(marker[row] != tag)
     {
-    access::rw(c.col_ptrs[i + 1]) += c.col_ptrs[i];
+    marker[row] = tag;
+    
+    used[n_used] = row;
+    ++n_used;
     }
+  }
+
+
+
+template<typename eT>
+arma_inline
+void
+spglue_times_dense_acc<eT>::add(const uword row, const eT val)
+  {
+  mark(row);
+  
+  sums[row] += val;
+  }
+
 
-  // Now that we know a decent bound on the number of nonzero elements, allocate
-  // the memory and fill it.
-  c.mem_resize(c.col_ptrs[c.n_cols]);
 
-  // Now the implementation of the NUMBMM algorithm.
-  uword cur_pos = 0; // Current position in c matrix.
-  podarray<eT> sums(x_n_rows); // Partial sums.
-  sums.zeros();
+template<typename eT>
+inline
+uword
+spglue_times_dense_acc<eT>::flush_count()
+  {
+  const uword count = n_used;
   
-  podarray<uword> sorted_indices(x_n_rows);  // upper bound
+  n_used = 0;
+  ++tag;
   
-  // last_ind is already set to x_n_rows, and cur_col_length is already set to 0.
-  // We will loop through all columns as necessary.
-  uword cur_col = 0;
-  while(cur_col < c.n_cols)
+  return count;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+spglue_times_dense_acc<eT>::flush(uword* out_rows, eT* out_values)
+  {
+  op_sort::direct_sort_ascending(used.memptr(), n_used);
+  
+  uword count = 0;
+  
+  for(uword k=0; k < n_used; ++k)
     {
-    // Skip to next column with elements in it.
-    while((cur_col < c.n_cols) && (c.col_ptrs[cur_col] == c.col_ptrs[cur_col + 1]))
+    const uword row = used[k];
+    const eT    val = sums[row];
+    
+    if(val != eT(0))
       {
-      // Update current column pointer to actual number of nonzero elements up
-      // to this point.
-      access::rw(c.col_ptrs[cur_col]) = cur_pos;
-      ++cur_col;
+      out_rows  [count] = row;
+      out_values[count] = val;
+      ++count;
       }
+    
+    sums[row] = eT(0);
+    }
+  
+  n_used = 0;
+  ++tag;
+  
+  return count;
+  }
 
-    if(cur_col == c.n_cols)
-      {
-      break;
-      }
 
-    // Update current column pointer.
-    access::rw(c.col_ptrs[cur_col]) = cur_pos;
 
-    // Check all elements in this column.
-    typename SpMat<eT>::const_iterator y_col_it = y.begin_col_no_sync(cur_col);
+template<typename eT>
+inline
+spglue_times_hash_acc<eT>::spglue_times_hash_acc(const uword n_rows, const uword max_col_nnz, const bool with_values)
+  : mask(0)
+  , empty_key(n_rows)
+  , n_used(0)
+  {
+  // table size: power of two, at least twice the number of rows that can be used in one column
+  uword table_size = 16;
+  
+  while(table_size < 2*max_col_nnz)  { table_size *= 2; }
+  
+  mask = table_size - 1;
+  
+  keys.set_size(table_size);
+  keys.fill(empty_key);
+  
+  used.set_size(max_col_nnz);
+  
+  if(with_values)  { sums.zeros(table_size); }
+  }
+
+
+
+template<typename eT>
+arma_inline
+uword
+spglue_times_hash_acc<eT>::find_slot(const uword row)
+  {
+  uword slot = (row * uword(2654435761u)) & mask;
+  
+  while( (keys[slot] != row) && (keys[slot] != empty_key) )  { slot = (slot + 1) & mask; }
+  
+  if(keys[slot] == empty_key)
+    {
+    keys[slot] = row;
     
-    while(y_col_it.col() == cur_col)
-      {
-      const uword y_col_it_row = y_col_it.row();
-      
-      // Check all elements in the column of the other matrix corresponding to
-      // the row of this column.
-      typename SpMat<eT>::const_iterator x_col_it = x.begin_col_no_sync(y_col_it_row);
+    used[n_used] = slot;
+    ++n_used;
+    }
+  
+  return slot;
+  }
 
-      const eT y_value = (*y_col_it);
 
-      while(x_col_it.col() == y_col_it_row)
-        {
-        const uword x_col_it_row = x_col_it.row();
-        
-        // A point at x(i, j) and y(j, k) implies a point at c(i, k).
-        // Add to partial sum.
-        const eT x_value = (*x_col_it);
-        sums[x_col_it_row] += (x_value * y_value);
 
-        // Add point if it hasn't already been marked.
-        if(index[x_col_it_row] == x_n_rows)
-          {
-          index[x_col_it_row] = last_ind;
-          last_ind = x_col_it_row;
-          }
+template<typename eT>
+arma_inline
+void
+spglue_times_hash_acc<eT>::mark(const uword row)
+  {
+  find_slot(row);
+  }
 
-        ++x_col_it;
-        }
 
-      ++y_col_it;
-      }
 
-    // Now sort the indices that were used in this column.
-    uword cur_index = 0;
-    while(last_ind != x_n_rows + 1)
-      {
-      const uword tmp = last_ind;
+template<typename eT>
+arma_inline
+void
+spglue_times_hash_acc<eT>::add(const uword row, const eT val)
+  {
+  sums[ find_slot(row) ] += val;
+  }
 
-      // Check that it wasn't a "fake" nonzero element.
-      if(sums[tmp] != eT(0))
-        {
-        // Assign to next open position.
-        sorted_indices[cur_index] = tmp;
-        ++cur_index;
-        }
 
-      last_ind = index[tmp];
-      index[tmp] = x_n_rows;
-      }
 
-    // Now sort the indices.
-    if(cur_index != 0)
-      {
-      op_sort::direct_sort_ascending(sorted_indices.memptr(), cur_index);
+template<typename eT>
+inline
+uword
+spglue_times_hash_acc<eT>::flush_count()
+  {
+  const uword count = n_used;
+  
+  for(uword k=0; k < n_used; ++k)  { keys[ used[k] ] = empty_key; }
+  
+  n_used = 0;
+  
+  return count;
+  }
 
-      for(uword k = 0; k < cur_index; ++k)
-        {
-        const uword row = sorted_indices[k];
-        access::rw(c.row_indices[cur_pos]) = row;
-        access::rw(c.values[cur_pos]) = sums[row];
-        sums[row] = eT(0);
-        ++cur_pos;
-        }
-      }
 
-    // Move to next column.
-    ++cur_col;
-    }
 
-  // Update last column pointer and resize to actual memory size.
-  access::rw(c.col_ptrs[c.n_cols]) = cur_pos;
-  c.mem_resize(cur_pos);
+template<typename eT>
+inline
+uword
+spglue_times_hash_acc<eT>::flush(uword* out_rows, eT* out_values)
+  {
+  uword* slots = used.memptr();
+  
+  const uword* keys_mem = keys.memptr();
+  
+  std::sort( slots, slots + n_used, [keys_mem](const uword a, const uword b) { return (keys_mem[a] < keys_mem[b]); } );
+  
+  uword count = 0;
+  
+  for(uword k=0; k < n_used; ++k)
+    {
+    const uword slot = slots[k];
+    const eT    val  = sums[slot];
+    
+    if(val != eT(0))
+      {
+      out_rows  [count] = keys[slot];
+      out_values[count] = val;
+      ++count;
+      }
+    
+    keys[slot] = empty_key;
+    sums[slot] = eT(0);
+    }
+  
+  n_used = 0;
+  
+  return count;
   }
 
 
@@ -331,51 +554,7 @@ spglue_times_misc::sparse_times_dense(Mat<typename T1::elem_type>& out, const T1
     
     arma_debug_assert_mul_size(A_n_rows, A_n_cols, B_n_rows, B_n_cols, "matrix multiplication");
     
-    if(B_n_cols >= (B_n_rows / uword(100)))
-      {
-      arma_extra_debug_print("using transpose-based multiplication");
-      
-      const SpMat<eT> At = A.st();
-      const   Mat<eT> Bt = B.st();
-      
-      if(A_n_rows == B_n_cols)
-        {
-        spglue_times_misc::dense_times_sparse(out, Bt, At);
-        
-        op_strans::apply_mat(out, out);  // since 'out' is square-sized, this will do an inplace transpose
-        }
-      else
-        {
-        Mat<eT> tmp;
-        
-        spglue_times_misc::dense_times_sparse(tmp, Bt, At);
-        
-        op_strans::apply_mat(out, tmp);
-        }
-      }
-    else
-      {
-      arma_extra_debug_print("using standard multiplication");
-      
-      out.zeros(A_n_rows, B_n_cols);
-      
-      typename SpMat<eT>::const_iterator A_it     = A.begin();
-      typename SpMat<eT>::const_iterator A_it_end = A.end();
-      
-      while(A_it != A_it_end)
-        {
-        const eT    A_it_val = (*A_it);
-        const uword A_it_row = A_it.row();
-        const uword A_it_col = A_it.col();
-        
-        for(uword col = 0; col < B_n_cols; ++col)
-          {
-          out.at(A_it_row, col) += A_it_val * B.at(A_it_col, col);
-          }
-        
-        ++A_it;
-        }
-      }
+    spglue_times_misc::sparse_times_dense_noalias(out, A, B);
     }
   }
 
@@ -415,62 +594,521 @@ spglue_times_misc::dense_times_sparse(Mat<typename T1::elem_type>& out, const T1
     
     arma_debug_assert_mul_size(A.n_rows, A.n_cols, B.n_rows, B.n_cols, "matrix multiplication");
     
-    out.zeros(A.n_rows, B.n_cols);
+    spglue_times_misc::dense_times_sparse_noalias(out, A, B);
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+spglue_times_misc::sparse_times_dense_noalias(Mat<eT>& out, const SpMat<eT>& A, const Mat<eT>& B)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword A_n_rows = A.n_rows;
+  const uword B_n_rows = B.n_rows;
+  const uword B_n_cols = B.n_cols;
+  
+  if( (A.n_nonzero == 0) || (B_n_cols == 0) )  { out.zeros(A_n_rows, B_n_cols); return; }
+  
+  if(B_n_cols == 1)
+    {
+    out.set_size(A_n_rows, 1);
+    
+    spglue_times_misc::sparse_times_vec(out.memptr(), A, B.memptr());
+    
+    return;
+    }
+  
+  int n_threads = 1;
+  
+  #if defined(ARMA_USE_MP)
+    {
+    if(mp_gate<eT>::eval(A.n_nonzero, B_n_cols))  { n_threads = mp_thread_limit::get(); }
+    }
+  #endif
+  
+  if( (B_n_cols < 4) && (n_threads == 1) )
+    {
+    arma_extra_debug_print("using column-wise multiplication");
+    
+    // a few columns: scatter the columns of A, avoiding the transposes below
+    
+    out.zeros(A_n_rows, B_n_cols);
     
-    if( (A.n_elem > 0) && (B.n_nonzero > 0) )
+    for(uword col=0; col < B_n_cols; ++col)
       {
-      if( (arma_config::openmp) && (mp_thread_limit::in_parallel() == false) && (A.n_rows <= (A.n_cols / uword(100))) )
+            eT* out_col = out.colptr(col);
+      const eT*   B_col =   B.colptr(col);
+      
+      for(uword k=0; k < B_n_rows; ++k)
         {
-        #if defined(ARMA_USE_OPENMP)
+        const eT B_val = B_col[k];
+        
+        for(uword i = A.col_ptrs[k]; i < A.col_ptrs[k+1]; ++i)  { out_col[ A.row_indices[i] ] += A.values[i] * B_val; }
+        }
+      }
+    
+    return;
+    }
+  
+  arma_extra_debug_print("using row-wise multiplication");
+  
+  // the columns of At are the rows of A, ie. At holds A in compressed sparse row form
+  
+  const SpMat<eT> At = A.st();
+  
+  spglue_times_misc::csr_times_dense_noalias(out, At, B);
+  }
+
+
+
+//! multiply A by B, where A is given in compressed sparse row form via the CSC form of its transpose;
+//! each row of the result only depends on one column of At, so rows are computed independently
+template<typename eT>
+inline
+void
+spglue_times_misc::csr_times_dense_noalias(Mat<eT>& out, const SpMat<eT>& At, const Mat<eT>& B)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword A_n_rows = At.n_cols;
+  const uword B_n_cols = B.n_cols;
+  
+  if( (At.n_nonzero == 0) || (B_n_cols == 0) )  { out.zeros(A_n_rows, B_n_cols); return; }
+  
+  int n_threads = 1;
+  
+  #if defined(ARMA_USE_MP)
+    {
+    if(mp_gate<eT>::eval(At.n_nonzero, B_n_cols))  { n_threads = mp_thread_limit::get(); }
+    }
+  #endif
+  
+  const uword* At_col_ptrs     = At.col_ptrs;
+  const uword* At_row_indices  = At.row_indices;
+  const eT*    At_values       = At.values;
+  
+  const uword block_rows = 512;
+  const uword n_blocks   = (A_n_rows + block_rows - 1) / block_rows;
+  
+  if(B_n_cols == 1)
+    {
+    arma_extra_debug_print("using row-wise dot products");
+    
+    out.set_size(A_n_rows, 1);
+    
+          eT* out_mem = out.memptr();
+    const eT*   B_mem =   B.memptr();
+    
+    mp_parallel::run(n_blocks, n_threads, [&](const uword block)
+      {
+      const uword row_start = block * block_rows;
+      const uword row_end   = (std::min)(row_start + block_rows, A_n_rows);
+      
+      for(uword row=row_start; row < row_end; ++row)
+        {
+        const uword index_end = At_col_ptrs[row+1];
+        
+        eT acc1 = eT(0);
+        eT acc2 = eT(0);
+        
+        uword i = At_col_ptrs[row];
+        
+        for(; (i + 2) <= index_end; i += 2)
           {
-          arma_extra_debug_print("using parallelised multiplication");
-          
-          const uword B_n_cols  = B.n_cols;
-          const int   n_threads = mp_thread_limit::get();
-          
-          #pragma omp parallel for schedule(static) num_threads(n_threads)
-          for(uword i=0; i < B_n_cols; ++i)
-            {
-            const uword col_offset_1 = B.col_ptrs[i  ];
-            const uword col_offset_2 = B.col_ptrs[i+1];
-            
-            const uword col_offset_delta = col_offset_2 - col_offset_1;
-            
-            const uvec    indices(const_cast<uword*>(&(B.row_indices[col_offset_1])), col_offset_delta, false, false);
-            const Col<eT>   B_col(const_cast<   eT*>(&(     B.values[col_offset_1])), col_offset_delta, false, false);
-            
-            out.col(i) = A.cols(indices) * B_col;
-            }
+          acc1 += At_values[i  ] * B_mem[ At_row_indices[i  ] ];
+          acc2 += At_values[i+1] * B_mem[ At_row_indices[i+1] ];
           }
-        #endif
+        
+        if(i < index_end)  { acc1 += At_values[i] * B_mem[ At_row_indices[i] ]; }
+        
+        out_mem[row] = acc1 + acc2;
+        }
+      } );
+    
+    return;
+    }
+  
+  arma_extra_debug_print("using row-blocked multiplication");
+  
+  // each row of the result is a linear combination of the rows of B;
+  // B is processed as panels of a few columns, and the rows of each panel are copied into a contiguous buffer
+  // which is reused for all panels; only the rows of one panel are stored, rather than a transposed copy of B
+  
+  out.set_size(A_n_rows, B_n_cols);
+  
+  typedef gemv_emul_blocked_kernel<eT> kernel;
+  
+  const uword B_n_rows   = B.n_rows;
+  const uword block_cols = 16;
+  
+  podarray<eT> panel_mem( B_n_rows * (std::min)(block_cols, B_n_cols) );
+  
+  eT* panel = panel_mem.memptr();
+  
+  const uword panel_block_rows = 4096;
+  const uword panel_n_blocks   = (B_n_rows + panel_block_rows - 1) / panel_block_rows;
+  
+  for(uword col_start=0; col_start < B_n_cols; col_start += block_cols)
+    {
+    const uword n = (std::min)(block_cols, B_n_cols - col_start);
+    
+    // row k of the panel is stored at panel + k*n
+    
+    mp_parallel::run(panel_n_blocks, n_threads, [&](const uword block)
+      {
+      const uword k_start = block * panel_block_rows;
+      const uword k_end   = (std::min)(k_start + panel_block_rows, B_n_rows);
+      
+      for(uword c=0; c < n; ++c)
+        {
+        const eT* B_col = B.colptr(col_start + c);
+        
+        for(uword k=k_start; k < k_end; ++k)  { panel[k*n + c] = B_col[k]; }
         }
-      else
+      } );
+    
+    mp_parallel::run(n_blocks, n_threads, [&](const uword block)
+      {
+      const uword row_start = block * block_rows;
+      const uword row_end   = (std::min)(row_start + block_rows, A_n_rows);
+      
+      podarray<eT> acc_mem(block_cols);
+      
+      eT* acc = acc_mem.memptr();
+      
+      for(uword row=row_start; row < row_end; ++row)
         {
-        arma_extra_debug_print("using standard multiplication");
+        arrayops::fill_zeros(acc, n);
         
-        typename SpMat<eT>::const_iterator B_it     = B.begin();
-        typename SpMat<eT>::const_iterator B_it_end = B.end();
+        const uword index_end = At_col_ptrs[row+1];
         
-        const uword out_n_rows = out.n_rows;
+        uword i = At_col_ptrs[row];
         
-        while(B_it != B_it_end)
+        for(; (i + 4) <= index_end; i += 4)
           {
-          const eT    B_it_val = (*B_it);
-          const uword B_it_col = B_it.col();
-          const uword B_it_row = B_it.row();
-          
-          eT* out_col = out.colptr(B_it_col);
-          
-          for(uword row = 0; row < out_n_rows; ++row)
-            {
-            out_col[row] += A.at(row, B_it_row) * B_it_val;
-            }
-          
-          ++B_it;
+          kernel::axpy4
+            (
+            acc, n,
+            &(panel[At_row_indices[i  ] * n]),
+            &(panel[At_row_indices[i+1] * n]),
+            &(panel[At_row_indices[i+2] * n]),
+            &(panel[At_row_indices[i+3] * n]),
+            At_values[i], At_values[i+1], At_values[i+2], At_values[i+3]
+            );
           }
+        
+        for(; i < index_end; ++i)  { kernel::axpy1(acc, n, &(panel[At_row_indices[i] * n]), At_values[i]); }
+        
+        eT* out_mem = &(out.at(row, col_start));
+        
+        for(uword c=0; c < n; ++c)  { out_mem[c * A_n_rows] = acc[c]; }
+        }
+      } );
+    }
+  }
+
+
+
+//! multiply A by B, where B is given in compressed sparse row form via the CSC form of its transpose;
+//! each nonzero B(k,j) adds a multiple of column k of A to column j of the result
+template<typename eT>
+inline
+void
+spglue_times_misc::dense_times_csr_noalias(Mat<eT>& out, const Mat<eT>& A, const SpMat<eT>& Bt)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword A_n_rows = A.n_rows;
+  const uword B_n_rows = Bt.n_cols;
+  const uword B_n_cols = Bt.n_rows;
+  
+  out.zeros(A_n_rows, B_n_cols);
+  
+  if( (Bt.n_nonzero == 0) || (A_n_rows == 0) )  { return; }
+  
+  int n_threads = 1;
+  
+  #if defined(ARMA_USE_MP)
+    {
+    if(mp_gate<eT>::eval(Bt.n_nonzero, A_n_rows))  { n_threads = mp_thread_limit::get(); }
+    }
+  #endif
+  
+  typedef gemv_emul_blocked_kernel<eT> kernel;
+  
+  // each thread updates its own block of rows of the result
+  
+  const uword block_rows = 1024;
+  const uword n_blocks   = (A_n_rows + block_rows - 1) / block_rows;
+  
+  const uword* Bt_col_ptrs    = Bt.col_ptrs;
+  const uword* Bt_row_indices = Bt.row_indices;
+  const eT*    Bt_values      = Bt.values;
+  
+  mp_parallel::run(n_blocks, n_threads, [&](const uword block)
+    {
+    const uword row_start = block * block_rows;
+    const uword n         = (std::min)(block_rows, A_n_rows - row_start);
+    
+    for(uword k=0; k < B_n_rows; ++k)
+      {
+      const eT* A_col = &(A.colptr(k)[row_start]);
+      
+      for(uword i = Bt_col_ptrs[k]; i < Bt_col_ptrs[k+1]; ++i)
+        {
+        kernel::axpy1( &(out.colptr(Bt_row_indices[i])[row_start]), n, A_col, Bt_values[i] );
         }
       }
+    } );
+  }
+
+
+
+template<typename eT>
+inline
+void
+spglue_times_misc::dense_times_sparse_noalias(Mat<eT>& out, const Mat<eT>& A, const SpMat<eT>& B)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword A_n_rows = A.n_rows;
+  const uword B_n_cols = B.n_cols;
+  
+  out.zeros(A_n_rows, B_n_cols);
+  
+  if( (A.n_elem == 0) || (B.n_nonzero == 0) )  { return; }
+  
+  int n_threads = 1;
+  
+  #if defined(ARMA_USE_MP)
+    {
+    if(mp_gate<eT>::eval(B.n_nonzero, A_n_rows))  { n_threads = mp_thread_limit::get(); }
+    }
+  #endif
+  
+  // each column of the result is a linear combination of the columns of A;
+  // the columns are split into ranges with roughly equal numbers of non-zero elements
+  
+  const uword n_tasks = (std::min)(uword(n_threads), B_n_cols);
+  
+  podarray<uword> bounds;
+  
+  spglue_times_misc::nnz_balanced_cols(bounds, B, n_tasks);
+  
+  typedef gemv_emul_blocked_kernel<eT> kernel;
+  
+  const uword block_rows = gemv_emul_blocked_params<eT>::block_rows;
+  
+  mp_parallel::run(n_tasks, n_threads, [&](const uword t)
+    {
+    for(uword col = bounds[t]; col < bounds[t+1]; ++col)
+      {
+      const uword index_start = B.col_ptrs[col  ];
+      const uword index_end   = B.col_ptrs[col+1];
+      
+      const uword* B_rows   = B.row_indices;
+      const eT*    B_values = B.values;
+      
+      // blocks of rows keep the segment of the result in L1
+      for(uword row_start=0; row_start < A_n_rows; row_start += block_rows)
+        {
+        const uword n = (std::min)(block_rows, A_n_rows - row_start);
+        
+        eT* out_seg = &(out.colptr(col)[row_start]);
+        
+        uword i = index_start;
+        
+        for(; (i + 4) <= index_end; i += 4)
+          {
+          kernel::axpy4
+            (
+            out_seg, n,
+            &(A.colptr(B_rows[i  ])[row_start]),
+            &(A.colptr(B_rows[i+1])[row_start]),
+            &(A.colptr(B_rows[i+2])[row_start]),
+            &(A.colptr(B_rows[i+3])[row_start]),
+            B_values[i], B_values[i+1], B_values[i+2], B_values[i+3]
+            );
+          }
+        
+        for(; i < index_end; ++i)  { kernel::axpy1(out_seg, n, &(A.colptr(B_rows[i])[row_start]), B_values[i]); }
+        }
+      }
+    } );
+  }
+
+
+
+//! split the columns of A into n_tasks contiguous ranges with roughly equal numbers of non-zero elements;
+//! range t is [bounds[t], bounds[t+1])
+template<typename eT>
+inline
+void
+spglue_times_misc::nnz_balanced_cols(podarray<uword>& bounds, const SpMat<eT>& A, const uword n_tasks)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword A_n_cols = A.n_cols;
+  
+  bounds.set_size(n_tasks + 1);
+  
+  bounds[0]       = 0;
+  bounds[n_tasks] = A_n_cols;
+  
+  for(uword t=1; t < n_tasks; ++t)
+    {
+    const uword target = uword( (double(A.n_nonzero) * double(t)) / double(n_tasks) );
+    
+    bounds[t] = (std::max)( bounds[t-1], uword(std::lower_bound(A.col_ptrs, A.col_ptrs + A_n_cols, target) - A.col_ptrs) );
+    }
+  }
+
+
+
+//! y = A*x for a single vector x, without forming the transpose of A;
+//! each thread scatters a range of columns of A into its own copy of y, and the copies are then summed
+template<typename eT>
+inline
+void
+spglue_times_misc::sparse_times_vec(eT* y, const SpMat<eT>& A, const eT* x)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword A_n_rows = A.n_rows;
+  const uword A_n_cols = A.n_cols;
+  
+  arrayops::fill_zeros(y, A_n_rows);
+  
+  if( (A.n_nonzero == 0) || (A_n_rows == 0) )  { return; }
+  
+  int n_threads = 1;
+  
+  #if defined(ARMA_USE_MP)
+    {
+    if(mp_gate<eT>::eval(A.n_nonzero, 2))  { n_threads = mp_thread_limit::get(); }
     }
+  #endif
+  
+  const uword* A_col_ptrs    = A.col_ptrs;
+  const uword* A_row_indices = A.row_indices;
+  const eT*    A_values      = A.values;
+  
+  const uword n_tasks = (std::min)(uword(n_threads), A_n_cols);
+  
+  if(n_tasks <= 1)
+    {
+    arma_extra_debug_print("using column-wise scatter");
+    
+    for(uword col=0; col < A_n_cols; ++col)
+      {
+      const eT x_val = x[col];
+      
+      for(uword i = A_col_ptrs[col]; i < A_col_ptrs[col+1]; ++i)  { y[ A_row_indices[i] ] += A_values[i] * x_val; }
+      }
+    
+    return;
+    }
+  
+  arma_extra_debug_print("using privatised column-wise scatter");
+  
+  podarray<uword> bounds;
+  
+  spglue_times_misc::nnz_balanced_cols(bounds, A, n_tasks);
+  
+  // task 0 writes directly into y
+  Mat<eT> partial(A_n_rows, n_tasks - 1, arma_zeros_indicator());
+  
+  mp_parallel::run(n_tasks, n_threads, [&](const uword t)
+    {
+    eT* dest = (t == 0) ? y : partial.colptr(t-1);
+    
+    for(uword col = bounds[t]; col < bounds[t+1]; ++col)
+      {
+      const eT x_val = x[col];
+      
+      for(uword i = A_col_ptrs[col]; i < A_col_ptrs[col+1]; ++i)  { dest[ A_row_indices[i] ] += A_values[i] * x_val; }
+      }
+    } );
+  
+  const uword block_rows = 4096;
+  const uword n_blocks   = (A_n_rows + block_rows - 1) / block_rows;
+  
+  mp_parallel::run(n_blocks, n_threads, [&](const uword block)
+    {
+    const uword row_start = block * block_rows;
+    const uword n         = (std::min)(block_rows, A_n_rows - row_start);
+    
+    eT* y_seg = &(y[row_start]);
+    
+    for(uword t=0; t < (n_tasks - 1); ++t)
+      {
+      const eT* src = &(partial.colptr(t)[row_start]);
+      
+      for(uword r=0; r < n; ++r)  { y_seg[r] += src[r]; }
+      }
+    } );
+  }
+
+
+
+//! y = A.st()*x for a single vector x; each element of y is the dot product of one column of A with x,
+//! so the columns are processed in parallel without a reduction;
+//! for symmetric A this is the same as A*x
+template<typename eT>
+inline
+void
+spglue_times_misc::sparse_trans_times_vec(eT* y, const SpMat<eT>& A, const eT* x)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword A_n_cols = A.n_cols;
+  
+  if(A.n_nonzero == 0)  { arrayops::fill_zeros(y, A_n_cols); return; }
+  
+  int n_threads = 1;
+  
+  #if defined(ARMA_USE_MP)
+    {
+    if(mp_gate<eT>::eval(A.n_nonzero, 2))  { n_threads = mp_thread_limit::get(); }
+    }
+  #endif
+  
+  const uword* A_col_ptrs    = A.col_ptrs;
+  const uword* A_row_indices = A.row_indices;
+  const eT*    A_values      = A.values;
+  
+  const uword n_tasks = (std::min)(uword(n_threads), A_n_cols);
+  
+  podarray<uword> bounds;
+  
+  spglue_times_misc::nnz_balanced_cols(bounds, A, (std::max)(n_tasks, uword(1)));
+  
+  mp_parallel::run(bounds.n_elem - 1, n_threads, [&](const uword t)
+    {
+    for(uword col = bounds[t]; col < bounds[t+1]; ++col)
+      {
+      const uword index_end = A_col_ptrs[col+1];
+      
+      eT acc1 = eT(0);
+      eT acc2 = eT(0);
+      
+      uword i = A_col_ptrs[col];
+      
+      for(; (i + 2) <= index_end; i += 2)
+        {
+        acc1 += A_values[i  ] * x[ A_row_indices[i  ] ];
+        acc2 += A_values[i+1] * x[ A_row_indices[i+1] ];
+        }
+      
+      if(i < index_end)  { acc1 += A_values[i] * x[ A_row_indices[i] ]; }
+      
+      y[col] = acc1 + acc2;
+      }
+    } );
   }
 
 
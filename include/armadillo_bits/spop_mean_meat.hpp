@@ -114,11 +114,21 @@ spop_mean::apply_noalias_fast
     
     eT* acc_mem = acc.memptr();
     
-    typename SpProxy<T1>::const_iterator_type it = p.begin();
-    
     const uword N = p.get_n_nonzero();
     
-    for(uword i=0; i < N; ++i)  { acc_mem[it.row()] += (*it); ++it; }
+    if(SpProxy<T1>::use_iterator)
+      {
+      typename SpProxy<T1>::const_iterator_type it = p.begin();
+      
+      for(uword i=0; i < N; ++i)  { acc_mem[it.row()] += (*it); ++it; }
+      }
+    else
+      {
+      const eT*    values      = p.get_values();
+      const uword* row_indices = p.get_row_indices();
+      
+      for(uword i=0; i < N; ++i)  { acc_mem[ row_indices[i] ] += values[i]; }
+      }
     
     acc /= T(p_n_cols);
     
@@ -30,6 +30,9 @@ class spop_normalise
   
   template<typename eT>
   inline static void apply_direct(SpMat<eT>& out, const SpMat<eT>& X, const uword p);
+  
+  template<typename eT>
+  inline static bool apply_rows_direct(SpMat<eT>& out, const SpMat<eT>& X, const uword p);
   };
 
 
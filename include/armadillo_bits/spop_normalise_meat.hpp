@@ -51,6 +51,8 @@ spop_normalise::apply(SpMat<typename T1::elem_type>& out, const SpOp<T1,spop_nor
   else
   if(dim == 1)
     {
+    if(spop_normalise::apply_rows_direct(out, X, p))  { return; }
+    
     SpMat<eT> tmp1;
     SpMat<eT> tmp2;
     
@@ -64,6 +66,77 @@ spop_normalise::apply(SpMat<typename T1::elem_type>& out, const SpOp<T1,spop_nor
 
 
 
+//! normalise the rows without transposing, by accumulating the 1-norms or 2-norms of all rows in one pass;
+//! returns false for other norms, or when the accumulated norms may have lost precision
+template<typename eT>
+inline
+bool
+spop_normalise::apply_rows_direct(SpMat<eT>& out, const SpMat<eT>& X, const uword p)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  if( (p != 1) && (p != 2) )  { return false; }
+  
+  const uword  N           = X.n_nonzero;
+  const eT*    values      = X.values;
+  const uword* row_indices = X.row_indices;
+  
+  podarray<T> norm_vals(X.n_rows);
+  
+  norm_vals.zeros();
+  
+  T* norm_vals_mem = norm_vals.memptr();
+  
+  T min_abs = Datum<T>::inf;
+  
+  for(uword i=0; i < N; ++i)
+    {
+    const T val_abs = std::abs(values[i]);
+    
+    min_abs = (std::min)(min_abs, val_abs);
+    
+    norm_vals_mem[ row_indices[i] ] += (p == 1) ? val_abs : (val_abs * val_abs);
+    }
+  
+  // squares of tiny values underflow; norm() handles these and non-finite values more carefully
+  
+  if( (p == 2) && (min_abs < std::sqrt(std::numeric_limits<T>::min())) )  { return false; }
+  
+  if(arrayops::is_finite(norm_vals_mem, X.n_rows) == false)  { return false; }
+  
+  for(uword row=0; row < X.n_rows; ++row)
+    {
+    const T norm_val = (p == 1) ? norm_vals_mem[row] : std::sqrt(norm_vals_mem[row]);
+    
+    norm_vals_mem[row] = (norm_val != T(0)) ? norm_val : T(1);
+    }
+  
+  SpMat<eT> tmp(X);
+  
+  eT* tmp_values = access::rwp(tmp.values);
+  
+  bool has_zero = false;
+  
+  for(uword i=0; i < N; ++i)
+    {
+    const eT val = values[i] / norm_vals_mem[ row_indices[i] ];
+    
+    if(val == eT(0))  { has_zero = true; }
+    
+    tmp_values[i] = val;
+    }
+  
+  if(has_zero)  { tmp.remove_zeros(); }
+  
+  out.steal_mem(tmp);
+  
+  return true;
+  }
+
+
+
 template<typename eT>
 inline
 void
@@ -86,14 +86,26 @@ spop_sum::apply(SpMat<typename T1::elem_type>& out, const SpOp<T1,spop_sum>& in)
     
     eT* acc_mem = acc.memptr();
     
-    typename SpProxy<T1>::const_iterator_type it = p.begin();
-    
     const uword N = p.get_n_nonzero();
     
-    for(uword i=0; i < N; ++i)
+    if(SpProxy<T1>::use_iterator)
       {
-      acc_mem[it.row()] += (*it);
-      ++it;
+      typename SpProxy<T1>::const_iterator_type it = p.begin();
+      
+      for(uword i=0; i < N; ++i)
+        {
+        acc_mem[it.row()] += (*it);
+        ++it;
+        }
+      }
+    else
+      {
+      // the column structure is irrelevant here, so scan the values and row indices directly
+      
+      const eT*    values      = p.get_values();
+      const uword* row_indices = p.get_row_indices();
+      
+      for(uword i=0; i < N; ++i)  { acc_mem[ row_indices[i] ] += values[i]; }
       }
     
     out = acc;
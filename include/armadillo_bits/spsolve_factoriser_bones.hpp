@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup spsolve_factoriser
+//! @{
+
+
+
+#if defined(ARMA_USE_SUPERLU)
+
+//! SuperLU factorisation of a square sparse matrix, kept for repeated triangular solves
+template<typename eT>
+class spsolve_factoriser_worker
+  {
+  public:
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  const uword n;
+  const bool  allow_ugly;
+  
+  T rcond_value = T(0);
+  
+  inline spsolve_factoriser_worker(const uword in_n, const superlu_opts& in_opts);
+  
+  inline spsolve_factoriser_worker(const spsolve_factoriser_worker&) = delete;
+  inline void operator=           (const spsolve_factoriser_worker&) = delete;
+  
+  inline bool factorise(const SpMat<eT>& A, const bool reuse_perm);
+  
+  inline bool same_pattern(const SpMat<eT>& A) const;
+  
+  inline bool solve(Mat<eT>& X) const;
+  
+  
+  private:
+  
+  superlu::superlu_options_t options;
+  
+  // the following objects are read-only in solve()
+  mutable superlu_supermatrix_wrangler l;
+  mutable superlu_supermatrix_wrangler u;
+  mutable superlu_array_wrangler<int>  perm_c;
+  mutable superlu_array_wrangler<int>  perm_r;
+  
+  superlu_array_wrangler<int> etree;
+  
+  uvec pattern_col_ptrs;      //!< sparsity pattern of the factorised matrix, for refactorise()
+  uvec pattern_row_indices;
+  };
+
+#endif
+
+
+
+//! factorise a sparse matrix once, then solve for many right-hand sides;
+//! refactorise() reuses the column permutation for a matrix with the same sparsity pattern
+template<typename eT>
+class spsolve_factoriser
+  {
+  public:
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  inline ~spsolve_factoriser();
+  inline  spsolve_factoriser();
+  
+  inline spsolve_factoriser(const spsolve_factoriser&) = delete;
+  inline void operator=    (const spsolve_factoriser&) = delete;
+  
+  template<typename T1> inline bool factorise  (const SpBase<eT,T1>& A, const superlu_opts& opts = superlu_opts());
+  template<typename T1> inline bool refactorise(const SpBase<eT,T1>& A);
+  
+  template<typename T1> inline bool solve(Mat<eT>& X, const Base<eT,T1>& B) const;
+  
+  template<typename T1> inline arma_warn_unused Mat<eT> solve(const Base<eT,T1>& B) const;
+  
+  inline arma_warn_unused bool is_factorised() const;
+  inline arma_warn_unused T    rcond()         const;
+  
+  inline void reset();
+  
+  
+  private:
+  
+  #if defined(ARMA_USE_SUPERLU)
+    spsolve_factoriser_worker<eT>* worker = nullptr;
+  #endif
+  
+  superlu_opts opts_used;  //!< settings given to factorise(), which are also used by refactorise()
+  
+  inline bool factorise_helper(const SpMat<eT>& A, const superlu_opts& opts, const bool reuse_perm);
+  };
+
+
+
+//! @}
@@ -0,0 +1,459 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup spsolve_factoriser
+//! @{
+
+
+
+#if defined(ARMA_USE_SUPERLU)
+
+template<typename eT>
+inline
+spsolve_factoriser_worker<eT>::spsolve_factoriser_worker(const uword in_n, const superlu_opts& in_opts)
+  : n         (in_n              )
+  , allow_ugly(in_opts.allow_ugly)
+  , perm_c(in_n+1)  // paranoia: increase array lengths by 1
+  , perm_r(in_n+1)
+  , etree (in_n+1)
+  {
+  arma_extra_debug_sigprint();
+  
+  sp_auxlib::set_superlu_opts(options, in_opts);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+spsolve_factoriser_worker<eT>::factorise(const SpMat<eT>& A, const bool reuse_perm)
+  {
+  arma_extra_debug_sigprint();
+  
+  // derived from the factorisation steps of superlu::gssvx()
+  
+  rcond_value = T(0);
+  
+  superlu_supermatrix_wrangler a;
+  superlu_supermatrix_wrangler ac;
+  
+  const bool status_a = sp_auxlib::copy_to_supermatrix(a.get_ref(), A);
+  
+  if(status_a == false)  { return false; }
+  
+  // release the previous factors, as superlu::gstrf() allocates new ones
+  l.reset();
+  u.reset();
+  
+  if(reuse_perm)
+    {
+    options.Fact = superlu::SamePattern;
+    }
+  else
+    {
+    options.Fact = superlu::DOFACT;
+    
+    arma_extra_debug_print("superlu::get_permutation_c()");
+    superlu::get_permutation_c(options.ColPerm, a.get_ptr(), perm_c.get_ptr());
+    }
+  
+  superlu::sp_preorder_mat(&options, a.get_ptr(), perm_c.get_ptr(), etree.get_ptr(), ac.get_ptr());
+  
+  superlu::GlobalLU_t glu;
+  arrayops::fill_zeros(reinterpret_cast<char*>(&glu), sizeof(superlu::GlobalLU_t));
+  
+  superlu_stat_wrangler stat;
+  
+  int panel_size = superlu::sp_ispec_environ(1);
+  int relax      = superlu::sp_ispec_environ(2);
+  int lwork      = 0;  // 0 means superlu will allocate memory
+  int info       = 0;
+  
+  arma_extra_debug_print("superlu::gstrf()");
+  superlu::gstrf<eT>(&options, ac.get_ptr(), relax, panel_size, etree.get_ptr(), NULL, lwork, perm_c.get_ptr(), perm_r.get_ptr(), l.get_ptr(), u.get_ptr(), &glu, stat.get_ptr(), &info);
+  
+  if(info > int(A.n_cols))
+    {
+    arma_debug_warn_level(1, "spsolve_factoriser: memory allocation failure");
+    }
+  else
+  if(info < 0)
+    {
+    arma_debug_warn_level(1, "spsolve_factoriser: unknown SuperLU error code from gstrf(): ", info);
+    }
+  
+  if(info != 0)  { return false; }
+  
+  const T norm_val = sp_auxlib::norm1<eT>(a.get_ptr());
+  
+  rcond_value = sp_auxlib::lu_rcond<eT>(l.get_ptr(), u.get_ptr(), norm_val);
+  
+  if(arma_isnan(rcond_value))  { rcond_value = T(0); }
+  
+  if(reuse_perm == false)
+    {
+    pattern_col_ptrs    = uvec(const_cast<uword*>(A.col_ptrs),    A.n_cols+1, true, false);
+    pattern_row_indices = uvec(const_cast<uword*>(A.row_indices), A.n_nonzero, true, false);
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+spsolve_factoriser_worker<eT>::same_pattern(const SpMat<eT>& A) const
+  {
+  arma_extra_debug_sigprint();
+  
+  A.sync();
+  
+  if( (A.n_rows != n) || (A.n_cols != n) || (A.n_nonzero != pattern_row_indices.n_elem) )  { return false; }
+  
+  const bool same_col_ptrs    = std::equal(A.col_ptrs,    A.col_ptrs    + (n+1),       pattern_col_ptrs.memptr()   );
+  const bool same_row_indices = std::equal(A.row_indices, A.row_indices + A.n_nonzero, pattern_row_indices.memptr());
+  
+  return (same_col_ptrs && same_row_indices);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+spsolve_factoriser_worker<eT>::solve(Mat<eT>& X) const
+  {
+  arma_extra_debug_sigprint();
+  
+  superlu_supermatrix_wrangler x;
+  
+  const bool status_x = sp_auxlib::wrap_to_supermatrix(x.get_ref(), X);
+  
+  if(status_x == false)  { return false; }
+  
+  superlu_stat_wrangler stat;
+  
+  int info = 0;
+  
+  arma_extra_debug_print("superlu::gstrs()");
+  superlu::gstrs<eT>(superlu::NOTRANS, l.get_ptr(), u.get_ptr(), perm_c.get_ptr(), perm_r.get_ptr(), x.get_ptr(), stat.get_ptr(), &info);
+  
+  // no need to extract the data from x, since it's using the same memory as X
+  
+  return (info == 0);
+  }
+
+#endif
+
+
+
+// 
+
+
+
+template<typename eT>
+inline
+spsolve_factoriser<eT>::~spsolve_factoriser()
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  reset();
+  }
+
+
+
+template<typename eT>
+inline
+spsolve_factoriser<eT>::spsolve_factoriser()
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  arma_type_check(( is_supported_blas_type<eT>::value == false ));
+  }
+
+
+
+template<typename eT>
+inline
+void
+spsolve_factoriser<eT>::reset()
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_SUPERLU)
+    {
+    if(worker != nullptr)  { delete worker; worker = nullptr; }
+    }
+  #endif
+  }
+
+
+
+template<typename eT>
+inline
+bool
+spsolve_factoriser<eT>::is_factorised() const
+  {
+  #if defined(ARMA_USE_SUPERLU)
+    {
+    return (worker != nullptr);
+    }
+  #else
+    {
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename eT>
+inline
+typename spsolve_factoriser<eT>::T
+spsolve_factoriser<eT>::rcond() const
+  {
+  #if defined(ARMA_USE_SUPERLU)
+    {
+    return (worker != nullptr) ? worker->rcond_value : T(0);
+    }
+  #else
+    {
+    return T(0);
+    }
+  #endif
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+bool
+spsolve_factoriser<eT>::factorise(const SpBase<eT,T1>& A_expr, const superlu_opts& opts)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check( ( (opts.pivot_thresh < double(0)) || (opts.pivot_thresh > double(1)) ), "spsolve_factoriser::factorise(): pivot_thresh must be in the [0,1] interval" );
+  
+  if( (opts.equilibrate) || (opts.refine != superlu_opts::REF_NONE) )
+    {
+    arma_debug_warn_level(1, "spsolve_factoriser::factorise(): ignoring equilibration and refinement settings");
+    }
+  
+  // superlu_opts can't be assigned, as its id is const
+  opts_used.allow_ugly   = opts.allow_ugly;
+  opts_used.equilibrate  = opts.equilibrate;
+  opts_used.symmetric    = opts.symmetric;
+  opts_used.pivot_thresh = opts.pivot_thresh;
+  opts_used.permutation  = opts.permutation;
+  opts_used.refine       = opts.refine;
+  
+  const unwrap_spmat<T1> U(A_expr.get_ref());
+  
+  return factorise_helper(U.M, opts_used, false);
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+bool
+spsolve_factoriser<eT>::refactorise(const SpBase<eT,T1>& A_expr)
+  {
+  arma_extra_debug_sigprint();
+  
+  const unwrap_spmat<T1> U(A_expr.get_ref());
+  const SpMat<eT>& A   = U.M;
+  
+  bool reuse_perm = false;
+  
+  #if defined(ARMA_USE_SUPERLU)
+    {
+    if(worker != nullptr)
+      {
+      reuse_perm = worker->same_pattern(A);
+      
+      if(reuse_perm == false)  { arma_debug_warn_level(3, "spsolve_factoriser::refactorise(): sparsity pattern has changed; performing full factorisation"); }
+      }
+    }
+  #endif
+  
+  // without a previous call to factorise() the default settings are used
+  
+  return factorise_helper(A, opts_used, reuse_perm);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+spsolve_factoriser<eT>::factorise_helper(const SpMat<eT>& A, const superlu_opts& opts, const bool reuse_perm)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_SUPERLU)
+    {
+    if(reuse_perm == false)  { reset(); }
+    
+    if(A.is_square() == false)
+      {
+      reset();
+      arma_stop_logic_error("spsolve_factoriser::factorise(): matrix must be square sized");
+      return false;
+      }
+    
+    if(A.is_empty() || (A.n_nonzero == uword(0)))  { reset(); return false; }
+    
+    if(arma_config::check_nonfinite && A.has_nonfinite())
+      {
+      reset();
+      arma_debug_warn_level(3, "spsolve_factoriser::factorise(): detected non-finite elements");
+      return false;
+      }
+    
+    if(arma_config::debug)
+      {
+      bool overflow = false;
+      
+      overflow = (A.n_nonzero > INT_MAX);
+      overflow = (A.n_rows > INT_MAX) || overflow;
+      overflow = (A.n_cols > INT_MAX) || overflow;
+      
+      if(overflow)
+        {
+        reset();
+        arma_stop_runtime_error("spsolve_factoriser::factorise(): integer overflow: matrix dimensions are too large for integer type used by SuperLU");
+        return false;
+        }
+      }
+    
+    if(worker == nullptr)  { worker = new spsolve_factoriser_worker<eT>(A.n_rows, opts); }
+    
+    bool status = worker->factorise(A, reuse_perm);
+    
+    if(status)
+      {
+      const T rcond_val = worker->rcond_value;
+      
+      if( (rcond_val < std::numeric_limits<T>::epsilon()) && (worker->allow_ugly == false) )
+        {
+        arma_debug_warn_level(2, "spsolve_factoriser::factorise(): system is singular to working precision (rcond: ", rcond_val, ")");
+        status = false;
+        }
+      }
+    
+    if(status == false)  { reset(); }
+    
+    return status;
+    }
+  #else
+    {
+    arma_ignore(A);
+    arma_ignore(opts);
+    arma_ignore(reuse_perm);
+    arma_stop_logic_error("spsolve_factoriser::factorise(): use of SuperLU must be enabled");
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+bool
+spsolve_factoriser<eT>::solve(Mat<eT>& X, const Base<eT,T1>& B_expr) const
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_USE_SUPERLU)
+    {
+    if(worker == nullptr)
+      {
+      X.soft_reset();
+      arma_debug_warn_level(1, "spsolve_factoriser::solve(): no factorisation available");
+      return false;
+      }
+    
+    X = B_expr.get_ref();   // superlu::gstrs() uses X as input (the B matrix) and as output (the solution)
+    
+    arma_debug_check( (X.n_rows != worker->n), "spsolve_factoriser::solve(): number of rows in the given object must be the same as the size of the factorised matrix", [&](){ X.soft_reset(); } );
+    
+    if(X.is_empty())  { return true; }
+    
+    if(arma_config::check_nonfinite && X.has_nonfinite())
+      {
+      X.soft_reset();
+      arma_debug_warn_level(3, "spsolve_factoriser::solve(): detected non-finite elements");
+      return false;
+      }
+    
+    if( (arma_config::debug) && (X.n_cols > INT_MAX) )
+      {
+      X.soft_reset();
+      arma_stop_runtime_error("spsolve_factoriser::solve(): integer overflow: matrix dimensions are too large for integer type used by SuperLU");
+      return false;
+      }
+    
+    const bool status = worker->solve(X);
+    
+    if(status == false)  { X.soft_reset(); }
+    
+    return status;
+    }
+  #else
+    {
+    arma_ignore(X);
+    arma_ignore(B_expr);
+    arma_stop_logic_error("spsolve_factoriser::solve(): use of SuperLU must be enabled");
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+Mat<eT>
+spsolve_factoriser<eT>::solve(const Base<eT,T1>& B_expr) const
+  {
+  arma_extra_debug_sigprint();
+  
+  Mat<eT> X;
+  
+  const bool status = solve(X, B_expr);
+  
+  if(status == false)
+    {
+    arma_stop_runtime_error("spsolve_factoriser::solve(): solution not found");
+    }
+  
+  return X;
+  }
+
+
+
+//! @}
@@ -151,7 +151,7 @@ subview<eT>::inplace_op(const Base<eT,T1>& in, const char* identifier)
   
   arma_debug_assert_same_size(s, P, identifier);
   
-  const bool use_mp      = arma_config::openmp && Proxy<T1>::use_mp && mp_gate<eT>::eval(s.n_elem);
+  const bool use_mp      = arma_config::mp && Proxy<T1>::use_mp && mp_gate<eT>::eval(s.n_elem, mp_expr_cost<T1>::value);
   const bool has_overlap = P.has_overlap(s);
   
   if(has_overlap)  { arma_extra_debug_print("aliasing or overlap detected"); }
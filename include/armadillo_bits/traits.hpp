@@ -78,9 +78,30 @@ struct is_Mat_fixed
 
 
 
+template<typename T>
+struct is_Mat_mapped_only
+  {
+  typedef char yes[1];
+  typedef char  no[2];
+  
+  template<typename X> static yes& check(typename X::Mat_mapped_type*);
+  template<typename>   static  no& check(...);
+  
+  static constexpr bool value = ( sizeof(check<T>(0)) == sizeof(yes) );
+  };
+
+
+
+//! Mat::fixed and Mat::mapped objects can be held by reference wherever a Mat can
+template<typename T>
+struct is_Mat_fixed_or_mapped
+  { static constexpr bool value = ( is_Mat_fixed<T>::value || is_Mat_mapped_only<T>::value ); };
+
+
+
 template<typename T>
 struct is_Mat_only
-  { static constexpr bool value = is_Mat_fixed_only<T>::value; };
+  { static constexpr bool value = ( is_Mat_fixed_only<T>::value || is_Mat_mapped_only<T>::value ); };
 
 template<typename eT>
 struct is_Mat_only< Mat<eT> >
@@ -94,7 +115,7 @@ struct is_Mat_only< const Mat<eT> >
 
 template<typename T>
 struct is_Mat
-  { static constexpr bool value = ( is_Mat_fixed_only<T>::value || is_Row_fixed_only<T>::value || is_Col_fixed_only<T>::value ); };
+  { static constexpr bool value = ( is_Mat_fixed_only<T>::value || is_Row_fixed_only<T>::value || is_Col_fixed_only<T>::value || is_Mat_mapped_only<T>::value ); };
 
 template<typename eT>
 struct is_Mat< Mat<eT> >
@@ -248,9 +269,23 @@ struct is_subview_elem2< const subview_elem2<eT, T1, T2> >
 
 
 
+template<typename T>
+struct is_Cube_mapped_only
+  {
+  typedef char yes[1];
+  typedef char  no[2];
+  
+  template<typename X> static yes& check(typename X::Cube_mapped_type*);
+  template<typename>   static  no& check(...);
+  
+  static constexpr bool value = ( sizeof(check<T>(0)) == sizeof(yes) );
+  };
+
+
+
 template<typename T>
 struct is_Cube
-  { static constexpr bool value = false; };
+  { static constexpr bool value = is_Cube_mapped_only<T>::value; };
 
 template<typename eT>
 struct is_Cube< Cube<eT> >
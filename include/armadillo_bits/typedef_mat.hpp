@@ -140,5 +140,10 @@ typedef SpCol <cx_double> sp_cx_vec;
 typedef SpCol <cx_double> sp_cx_colvec;
 typedef SpRow <cx_double> sp_cx_rowvec;
 
+typedef SpMat_csr <float>     sp_fmat_csr;
+typedef SpMat_csr <double>    sp_mat_csr;
+typedef SpMat_csr <cx_float>  sp_cx_fmat_csr;
+typedef SpMat_csr <cx_double> sp_cx_mat_csr;
+
 
 //! @}
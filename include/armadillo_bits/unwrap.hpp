@@ -70,11 +70,11 @@ struct unwrap_redirect<T1, true>  { typedef unwrap_fixed<T1>   result; };
 
 
 template<typename T1>
-struct unwrap : public unwrap_redirect<T1, is_Mat_fixed<T1>::value>::result
+struct unwrap : public unwrap_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result
   {
   inline
   unwrap(const T1& A)
-    : unwrap_redirect<T1, is_Mat_fixed<T1>::value>::result(A)
+    : unwrap_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result(A)
     {
     }
   };
@@ -266,9 +266,9 @@ struct quasi_unwrap_redirect<T1, true>  { typedef quasi_unwrap_fixed<T1>   resul
 
 
 template<typename T1>
-struct quasi_unwrap : public quasi_unwrap_redirect<T1, is_Mat_fixed<T1>::value>::result
+struct quasi_unwrap : public quasi_unwrap_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result
   {
-  typedef typename quasi_unwrap_redirect<T1, is_Mat_fixed<T1>::value>::result quasi_unwrap_extra;
+  typedef typename quasi_unwrap_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result quasi_unwrap_extra;
   
   inline
   quasi_unwrap(const T1& A)
@@ -913,15 +913,15 @@ struct unwrap_check_redirect<T1, true>  { typedef unwrap_check_fixed<T1>   resul
 
 
 template<typename T1>
-struct unwrap_check : public unwrap_check_redirect<T1, is_Mat_fixed<T1>::value>::result
+struct unwrap_check : public unwrap_check_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result
   {
   inline unwrap_check(const T1& A, const Mat<typename T1::elem_type>& B)
-    : unwrap_check_redirect<T1, is_Mat_fixed<T1>::value>::result(A, B)
+    : unwrap_check_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result(A, B)
     {
     }
   
   inline unwrap_check(const T1& A, const bool is_alias)
-    : unwrap_check_redirect<T1, is_Mat_fixed<T1>::value>::result(A, is_alias)
+    : unwrap_check_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result(A, is_alias)
     {
     }
   };
@@ -1250,11 +1250,11 @@ template<typename T1>
 struct partial_unwrap_redirect<T1, true>  { typedef partial_unwrap_fixed<T1>   result; };
 
 template<typename T1>
-struct partial_unwrap : public partial_unwrap_redirect<T1, is_Mat_fixed<T1>::value>::result
+struct partial_unwrap : public partial_unwrap_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result
   {
   inline
   partial_unwrap(const T1& A)
-    : partial_unwrap_redirect< T1, is_Mat_fixed<T1>::value>::result(A)
+    : partial_unwrap_redirect< T1, is_Mat_fixed_or_mapped<T1>::value>::result(A)
     {
     }
   };
@@ -1503,10 +1503,10 @@ template<typename T1>
 struct partial_unwrap_htrans_redirect<T1, true>  { typedef partial_unwrap_htrans_fixed<T1>   result; };
 
 template<typename T1>
-struct partial_unwrap< Op<T1, op_htrans> > : public partial_unwrap_htrans_redirect<T1, is_Mat_fixed<T1>::value>::result
+struct partial_unwrap< Op<T1, op_htrans> > : public partial_unwrap_htrans_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result
   {
   inline partial_unwrap(const Op<T1, op_htrans>& A)
-    : partial_unwrap_htrans_redirect<T1, is_Mat_fixed<T1>::value>::result(A)
+    : partial_unwrap_htrans_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result(A)
     {
     }
   };
@@ -1759,10 +1759,10 @@ template<typename T1>
 struct partial_unwrap_htrans2_redirect<T1, true>  { typedef partial_unwrap_htrans2_fixed<T1>   result; };
 
 template<typename T1>
-struct partial_unwrap< Op<T1, op_htrans2> > : public partial_unwrap_htrans2_redirect<T1, is_Mat_fixed<T1>::value>::result
+struct partial_unwrap< Op<T1, op_htrans2> > : public partial_unwrap_htrans2_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result
   {
   inline partial_unwrap(const Op<T1, op_htrans2>& A)
-    : partial_unwrap_htrans2_redirect<T1, is_Mat_fixed<T1>::value>::result(A)
+    : partial_unwrap_htrans2_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result(A)
     {
     }
   };
@@ -2032,13 +2032,13 @@ struct partial_unwrap_scalar_times_redirect<T1, true>  { typedef partial_unwrap_
 
 
 template<typename T1>
-struct partial_unwrap< eOp<T1, eop_scalar_times> > : public partial_unwrap_scalar_times_redirect<T1, is_Mat_fixed<T1>::value>::result
+struct partial_unwrap< eOp<T1, eop_scalar_times> > : public partial_unwrap_scalar_times_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result
   {
   typedef typename T1::elem_type eT;
   
   inline
   partial_unwrap(const eOp<T1, eop_scalar_times>& A)
-    : partial_unwrap_scalar_times_redirect< T1, is_Mat_fixed<T1>::value>::result(A)
+    : partial_unwrap_scalar_times_redirect< T1, is_Mat_fixed_or_mapped<T1>::value>::result(A)
     {
     }
   };
@@ -2246,13 +2246,13 @@ struct partial_unwrap_neg_redirect<T1, true>  { typedef partial_unwrap_neg_fixed
 
 
 template<typename T1>
-struct partial_unwrap< eOp<T1, eop_neg> > : public partial_unwrap_neg_redirect<T1, is_Mat_fixed<T1>::value>::result
+struct partial_unwrap< eOp<T1, eop_neg> > : public partial_unwrap_neg_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result
   {
   typedef typename T1::elem_type eT;
   
   inline
   partial_unwrap(const eOp<T1, eop_neg>& A)
-    : partial_unwrap_neg_redirect< T1, is_Mat_fixed<T1>::value>::result(A)
+    : partial_unwrap_neg_redirect< T1, is_Mat_fixed_or_mapped<T1>::value>::result(A)
     {
     }
   };
@@ -2455,12 +2455,12 @@ template<typename T1>
 struct partial_unwrap_check_redirect<T1, true>  { typedef partial_unwrap_check_fixed<T1>   result; };
 
 template<typename T1>
-struct partial_unwrap_check : public partial_unwrap_check_redirect<T1, is_Mat_fixed<T1>::value>::result
+struct partial_unwrap_check : public partial_unwrap_check_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result
   {
   typedef typename T1::elem_type eT;
   
   inline partial_unwrap_check(const T1& A, const Mat<eT>& B)
-    : partial_unwrap_check_redirect<T1, is_Mat_fixed<T1>::value>::result(A, B)
+    : partial_unwrap_check_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result(A, B)
     {
     }
   };
@@ -2659,12 +2659,12 @@ struct partial_unwrap_check_htrans_redirect<T1, true>  { typedef partial_unwrap_
 
 
 template<typename T1>
-struct partial_unwrap_check< Op<T1, op_htrans> > : public partial_unwrap_check_htrans_redirect<T1, is_Mat_fixed<T1>::value>::result
+struct partial_unwrap_check< Op<T1, op_htrans> > : public partial_unwrap_check_htrans_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result
   {
   typedef typename T1::elem_type eT;
   
   inline partial_unwrap_check(const Op<T1, op_htrans>& A, const Mat<eT>& B)
-    : partial_unwrap_check_htrans_redirect<T1, is_Mat_fixed<T1>::value>::result(A, B)
+    : partial_unwrap_check_htrans_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result(A, B)
     {
     }
   };
@@ -2865,12 +2865,12 @@ struct partial_unwrap_check_htrans2_redirect<T1, true>  { typedef partial_unwrap
 
 
 template<typename T1>
-struct partial_unwrap_check< Op<T1, op_htrans2> > : public partial_unwrap_check_htrans2_redirect<T1, is_Mat_fixed<T1>::value>::result
+struct partial_unwrap_check< Op<T1, op_htrans2> > : public partial_unwrap_check_htrans2_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result
   {
   typedef typename T1::elem_type eT;
   
   inline partial_unwrap_check(const Op<T1, op_htrans2>& A, const Mat<eT>& B)
-    : partial_unwrap_check_htrans2_redirect<T1, is_Mat_fixed<T1>::value>::result(A, B)
+    : partial_unwrap_check_htrans2_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result(A, B)
     {
     }
   };
@@ -3079,12 +3079,12 @@ struct partial_unwrap_check_scalar_times_redirect<T1, true>  { typedef partial_u
 
 
 template<typename T1>
-struct partial_unwrap_check< eOp<T1, eop_scalar_times> > : public partial_unwrap_check_scalar_times_redirect<T1, is_Mat_fixed<T1>::value>::result
+struct partial_unwrap_check< eOp<T1, eop_scalar_times> > : public partial_unwrap_check_scalar_times_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result
   {
   typedef typename T1::elem_type eT;
   
   inline partial_unwrap_check(const eOp<T1, eop_scalar_times>& A, const Mat<eT>& B)
-    : partial_unwrap_check_scalar_times_redirect<T1, is_Mat_fixed<T1>::value>::result(A, B)
+    : partial_unwrap_check_scalar_times_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result(A, B)
     {
     }
   };
@@ -3286,12 +3286,12 @@ struct partial_unwrap_check_neg_redirect<T1, true>  { typedef partial_unwrap_che
 
 
 template<typename T1>
-struct partial_unwrap_check< eOp<T1, eop_neg> > : public partial_unwrap_check_neg_redirect<T1, is_Mat_fixed<T1>::value>::result
+struct partial_unwrap_check< eOp<T1, eop_neg> > : public partial_unwrap_check_neg_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result
   {
   typedef typename T1::elem_type eT;
   
   inline partial_unwrap_check(const eOp<T1, eop_neg>& A, const Mat<eT>& B)
-    : partial_unwrap_check_neg_redirect<T1, is_Mat_fixed<T1>::value>::result(A, B)
+    : partial_unwrap_check_neg_redirect<T1, is_Mat_fixed_or_mapped<T1>::value>::result(A, B)
     {
     }
   };
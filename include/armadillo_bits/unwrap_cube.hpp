@@ -22,12 +22,12 @@
 
 
 template<typename T1>
-struct unwrap_cube
+struct unwrap_cube_default
   {
   typedef typename T1::elem_type eT;
   
   inline
-  unwrap_cube(const T1& A)
+  unwrap_cube_default(const T1& A)
     : M(A)
     {
     arma_extra_debug_sigprint();
@@ -41,6 +41,42 @@ struct unwrap_cube
 
 
 
+//! Cube::mapped is handled as its Cube base class
+template<typename T1>
+struct unwrap_cube_mapped : public unwrap_cube< Cube<typename T1::elem_type> >
+  {
+  inline
+  unwrap_cube_mapped(const T1& A)
+    : unwrap_cube< Cube<typename T1::elem_type> >(A)
+    {
+    arma_extra_debug_sigprint();
+    }
+  };
+
+
+
+template<typename T1, bool condition>
+struct unwrap_cube_redirect {};
+
+template<typename T1>
+struct unwrap_cube_redirect<T1, false> { typedef unwrap_cube_default<T1> result; };
+
+template<typename T1>
+struct unwrap_cube_redirect<T1, true>  { typedef unwrap_cube_mapped<T1>  result; };
+
+
+template<typename T1>
+struct unwrap_cube : public unwrap_cube_redirect<T1, is_Cube_mapped_only<T1>::value>::result
+  {
+  inline
+  unwrap_cube(const T1& A)
+    : unwrap_cube_redirect<T1, is_Cube_mapped_only<T1>::value>::result(A)
+    {
+    }
+  };
+
+
+
 template<typename eT>
 struct unwrap_cube< Cube<eT> >
   {
@@ -66,12 +102,12 @@ struct unwrap_cube< Cube<eT> >
 
 
 template<typename T1>
-struct unwrap_cube_check
+struct unwrap_cube_check_default
   {
   typedef typename T1::elem_type eT;
   
   inline
-  unwrap_cube_check(const T1& A, const Cube<eT>&)
+  unwrap_cube_check_default(const T1& A, const Cube<eT>&)
     : M(A)
     {
     arma_extra_debug_sigprint();
@@ -80,7 +116,7 @@ struct unwrap_cube_check
     }
   
   inline
-  unwrap_cube_check(const T1& A, const bool)
+  unwrap_cube_check_default(const T1& A, const bool)
     : M(A)
     {
     arma_extra_debug_sigprint();
@@ -93,6 +129,57 @@ struct unwrap_cube_check
 
 
 
+//! Cube::mapped is handled as its Cube base class
+template<typename T1>
+struct unwrap_cube_check_mapped : public unwrap_cube_check< Cube<typename T1::elem_type> >
+  {
+  typedef typename T1::elem_type eT;
+  
+  inline
+  unwrap_cube_check_mapped(const T1& A, const Cube<eT>& B)
+    : unwrap_cube_check< Cube<eT> >(A, B)
+    {
+    arma_extra_debug_sigprint();
+    }
+  
+  inline
+  unwrap_cube_check_mapped(const T1& A, const bool is_alias)
+    : unwrap_cube_check< Cube<eT> >(A, is_alias)
+    {
+    arma_extra_debug_sigprint();
+    }
+  };
+
+
+
+template<typename T1, bool condition>
+struct unwrap_cube_check_redirect {};
+
+template<typename T1>
+struct unwrap_cube_check_redirect<T1, false> { typedef unwrap_cube_check_default<T1> result; };
+
+template<typename T1>
+struct unwrap_cube_check_redirect<T1, true>  { typedef unwrap_cube_check_mapped<T1>  result; };
+
+
+template<typename T1>
+struct unwrap_cube_check : public unwrap_cube_check_redirect<T1, is_Cube_mapped_only<T1>::value>::result
+  {
+  inline
+  unwrap_cube_check(const T1& A, const Cube<typename T1::elem_type>& B)
+    : unwrap_cube_check_redirect<T1, is_Cube_mapped_only<T1>::value>::result(A, B)
+    {
+    }
+  
+  inline
+  unwrap_cube_check(const T1& A, const bool is_alias)
+    : unwrap_cube_check_redirect<T1, is_Cube_mapped_only<T1>::value>::result(A, is_alias)
+    {
+    }
+  };
+
+
+
 template<typename eT>
 struct unwrap_cube_check< Cube<eT> >
   {
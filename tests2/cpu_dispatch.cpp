@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+#if defined(ARMA_USE_CPU_DISPATCH)
+
+// run the same operations with every variant supported by the CPU;
+// each variant must agree with the generic code
+
+template<typename eT>
+static
+void
+check_variants()
+  {
+  typedef Col<eT> vec_type;
+  
+  typedef typename cpu_dispatch_other<eT>::result other_eT;
+  
+  const eT tol = eT(100) * std::numeric_limits<eT>::epsilon();
+  
+  vec_type A = randu<vec_type>(1001) - eT(0.5);  // odd size exercises the tails
+  vec_type B = randu<vec_type>(1001) - eT(0.5);
+  
+  A(7)   = eT(1e-5);
+  A(500) = eT(-1e-5);
+  
+  Col<other_eT> C = randu< Col<other_eT> >(1001);
+  
+  const cpu_dispatch::isa_type best = cpu_dispatch::detected();
+  
+  cpu_dispatch::set_active(cpu_dispatch::isa_generic);
+  
+  REQUIRE( cpu_dispatch::active() == cpu_dispatch::isa_generic );
+  REQUIRE( std::string(cpu_dispatch::active_name()) == "generic" );
+  
+  const vec_type ref_plus  = A + B;
+  const eT       ref_accu  = accu(A);
+  const eT       ref_dot   = dot(A, B);
+  const vec_type ref_clamp = clamp(A, eT(-0.25), eT(0.25));
+  const vec_type ref_conv  = conv_to<vec_type>::from(C);
+  
+  vec_type ref_clean = A;  ref_clean.clean(eT(1e-4));
+  
+  for(int isa = int(cpu_dispatch::isa_generic); isa <= int(best); ++isa)
+    {
+    cpu_dispatch::set_active(cpu_dispatch::isa_type(isa));
+    
+    REQUIRE( cpu_dispatch::active() == cpu_dispatch::isa_type(isa) );
+    
+    vec_type X = A;  X += B;
+    
+    REQUIRE( approx_equal(X, ref_plus, "absdiff", tol) );
+    
+    REQUIRE( accu(A)   == Approx(ref_accu).margin(tol) );
+    REQUIRE( dot(A, B) == Approx(ref_dot ).margin(tol) );
+    
+    REQUIRE( approx_equal(vec_type(clamp(A, eT(-0.25), eT(0.25))), ref_clamp, "absdiff", eT(0)) );
+    
+    vec_type Y = A;  Y.clean(eT(1e-4));
+    
+    REQUIRE( approx_equal(Y, ref_clean, "absdiff", eT(0)) );
+    
+    REQUIRE( approx_equal(conv_to<vec_type>::from(C), ref_conv, "absdiff", eT(0)) );
+    
+    REQUIRE( A.is_finite() );
+    
+    vec_type Z = A;
+    
+    Z(1000) = Datum<eT>::inf;  REQUIRE( Z.is_finite() == false );
+    Z(1000) = Datum<eT>::nan;  REQUIRE( Z.is_finite() == false );
+    Z(1000) = eT(0);
+    Z(3)    = -Datum<eT>::inf; REQUIRE( Z.is_finite() == false );
+    }
+  
+  cpu_dispatch::set_active(best);
+  }
+
+
+
+TEST_CASE("cpu_dispatch_1")
+  {
+  const cpu_dispatch::isa_type best = cpu_dispatch::detected();
+  
+  REQUIRE( cpu_dispatch::active() == best );
+  
+  // requests beyond the capabilities of the CPU are clamped
+  cpu_dispatch::set_active(cpu_dispatch::isa_avx512);
+  
+  REQUIRE( cpu_dispatch::active() == best );
+  
+  check_variants<double>();
+  check_variants<float>();
+  
+  REQUIRE( cpu_dispatch::active() == best );
+  }
+
+#endif
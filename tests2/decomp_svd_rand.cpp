@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("decomp_svd_rand_1")
+  {
+  // matrix with known, quickly decaying singular values
+  const uword m = 300;
+  const uword n = 200;
+  
+  mat Q1, Q2, R;
+  REQUIRE( qr_econ(Q1, R, randn<mat>(m, n)) );
+  REQUIRE( qr_econ(Q2, R, randn<mat>(n, n)) );
+  
+  const vec s_true = 100.0 * exp(-0.3 * regspace<vec>(0, n-1));
+  
+  const mat A = Q1 * diagmat(s_true) * Q2.t();
+  
+  mat U, V;
+  vec s;
+  
+  REQUIRE( svd_rand(U, s, V, A, 10) );
+  
+  REQUIRE( s.n_elem   == 10 );
+  REQUIRE( U.n_rows   == m  );
+  REQUIRE( U.n_cols   == 10 );
+  REQUIRE( V.n_rows   == n  );
+  REQUIRE( V.n_cols   == 10 );
+  
+  for(uword i=0; i < 10; ++i)
+    {
+    REQUIRE( s(i) == Approx(s_true(i)).epsilon(1e-6) );
+    }
+  
+  REQUIRE( norm(U.t() * U - eye<mat>(10,10), "fro") == Approx(0.0).margin(1e-10) );
+  REQUIRE( norm(V.t() * V - eye<mat>(10,10), "fro") == Approx(0.0).margin(1e-10) );
+  
+  // rank-10 approximation error should match that of the exact truncated SVD
+  const double err   = norm(A - U * diagmat(s) * V.t(), "fro");
+  const double err_0 = norm(s_true.tail(n - 10));
+  
+  REQUIRE( err == Approx(err_0).epsilon(1e-4) );
+  
+  const vec s2 = svd_rand(A, 10);
+  
+  REQUIRE( approx_equal(s, s2, "reldiff", 1e-6) );
+  }
+
+
+
+TEST_CASE("decomp_svd_rand_sparse")
+  {
+  // the result must not depend on the state of the RNG left by other tests
+  arma_rng::set_seed(123);
+  
+  // scaling the first columns gives 5 dominant singular values, well separated from the rest
+  sp_mat B;
+  B.sprandu(400, 300, 0.05);
+  
+  vec d(300);
+  d.fill(0.1);
+  d.head(5) = linspace<vec>(10.0, 6.0, 5);
+  
+  const sp_mat A = B * sp_mat(diagmat(d));
+  
+  const vec s_dense = svd(mat(A));
+  
+  svd_rand_opts opts;
+  opts.power_iter = 4;
+  
+  mat U, V;
+  vec s;
+  
+  REQUIRE( svds(U, s, V, A, 5, opts) );
+  
+  REQUIRE( s.n_elem == 5 );
+  
+  for(uword i=0; i < 5; ++i)
+    {
+    REQUIRE( s(i) == Approx(s_dense(i)).epsilon(1e-8) );
+    
+    REQUIRE( norm(A * V.col(i) - s(i) * U.col(i)) == Approx(0.0).margin(1e-8 * s(0)) );
+    }
+  
+  vec s2;
+  REQUIRE( svds(s2, A, 5, opts) );
+  REQUIRE( s2.n_elem == 5 );
+  }
+
+
+
+TEST_CASE("decomp_svd_rand_empty")
+  {
+  mat U, V;
+  vec s;
+  
+  REQUIRE( svd_rand(U, s, V, mat(10, 0), 3) );
+  REQUIRE( s.n_elem == 0 );
+  }
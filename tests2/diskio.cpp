@@ -0,0 +1,709 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+
+TEST_CASE("diskio_csv_load_1")
+  {
+  const std::string name = "diskio_csv_load_1.csv";
+  
+  const uword orig_threshold = get_mp_threshold();
+  
+  mat A = randn<mat>(1000, 37);
+  
+  A(0,0) = 1e300;
+  A(1,0) = -1.5e-310;
+  A(2,0) = 123456789012345678.0;
+  
+  REQUIRE( A.save(name, csv_ascii) );
+  
+  for(uword pass=0; pass < 2; ++pass)
+    {
+    set_mp_threshold( (pass == 0) ? (uword(1) << 24) : uword(1) );
+    
+    mat B;
+    
+    REQUIRE( B.load(name, csv_ascii) );
+    
+    REQUIRE( B.n_rows == A.n_rows );
+    REQUIRE( B.n_cols == A.n_cols );
+    
+    // the saved values have 16 significant digits
+    REQUIRE( approx_equal(A, B, "reldiff", 1e-14) );
+    
+    fmat C;
+    
+    REQUIRE( C.load(name, csv_ascii) );
+    
+    REQUIRE( approx_equal(C.rows(3, C.n_rows-1), conv_to<fmat>::from(A.rows(3, A.n_rows-1)), "reldiff", 1e-6) );
+    
+    // stream-based loading
+    std::ifstream f(name.c_str());
+    
+    mat D;
+    
+    REQUIRE( D.load(f, csv_ascii) );
+    
+    REQUIRE( approx_equal(B, D, "absdiff", 0.0) );
+    
+    mat E;
+    
+    REQUIRE( E.load(name, auto_detect) );
+    
+    REQUIRE( approx_equal(B, E, "absdiff", 0.0) );
+    }
+  
+  set_mp_threshold(orig_threshold);
+  
+  std::remove(name.c_str());
+  }
+
+
+
+TEST_CASE("diskio_csv_load_2")
+  {
+  // ragged lines, missing values, special values and data after an empty line
+  const std::string name = "diskio_csv_load_2.csv";
+  
+  const uword orig_threshold = get_mp_threshold();
+  
+  std::ofstream f(name.c_str());
+  
+  f << "a,b,c\n";
+  f << "1, 2.5 ,-3e2\r\n";
+  f << "4,,inf\n";
+  f << "-NaN\n";
+  f << ".5,1e-3,7,8\n";
+  
+  for(uword i=0; i < 2000; ++i)  { f << i << ',' << (double(i) / 8.0) << '\n'; }
+  
+  f << "\n";
+  f << "9,9,9\n";
+  
+  f.close();
+  
+  for(uword pass=0; pass < 2; ++pass)
+    {
+    set_mp_threshold( (pass == 0) ? (uword(1) << 24) : uword(1) );
+    
+    field<std::string> header;
+    
+    mat A;
+    
+    REQUIRE( A.load(csv_name(name, header), csv_ascii) );
+    
+    REQUIRE( header.n_elem == 3 );
+    REQUIRE( header(2) == "c" );
+    
+    REQUIRE( A.n_rows == 2004 );
+    REQUIRE( A.n_cols == 4    );
+    
+    REQUIRE( A(0,0) == Approx(1.0)    );
+    REQUIRE( A(0,1) == Approx(2.5)    );
+    REQUIRE( A(0,2) == Approx(-300.0) );
+    REQUIRE( A(0,3) == 0.0            );
+    REQUIRE( A(1,1) == 0.0            );
+    REQUIRE( A(1,2) == Datum<double>::inf );
+    REQUIRE( std::isnan(A(2,0))       );
+    REQUIRE( A(3,0) == Approx(0.5)    );
+    REQUIRE( A(3,1) == Approx(0.001)  );
+    REQUIRE( A(3,3) == Approx(8.0)    );
+    
+    REQUIRE( approx_equal(A.submat(4, 0, 2003, 0), regspace<vec>(0, 1999),          "absdiff", 0.0) );
+    REQUIRE( approx_equal(A.submat(4, 1, 2003, 1), regspace<vec>(0, 1999) / 8.0,    "absdiff", 0.0) );
+    REQUIRE( accu(abs(A.submat(4, 2, 2003, 3))) == 0.0 );
+    
+    imat B;
+    
+    REQUIRE( B.load(csv_name(name, csv_opts::with_header), csv_ascii) );
+    
+    REQUIRE( B.n_rows == 2004 );
+    REQUIRE( B(0,0)   == 1    );
+    REQUIRE( B(3,3)   == 8    );
+    REQUIRE( B(2004-1,0) == 1999 );
+    
+    cx_mat C;
+    
+    REQUIRE( C.load(csv_name(name, csv_opts::with_header), csv_ascii) );
+    
+    REQUIRE( approx_equal(real(C.rows(3, C.n_rows-1)), A.rows(3, A.n_rows-1), "absdiff", 0.0) );
+    }
+  
+  set_mp_threshold(orig_threshold);
+  
+  std::remove(name.c_str());
+  }
+
+
+
+TEST_CASE("diskio_csv_load_cx")
+  {
+  const std::string name = "diskio_csv_load_cx.csv";
+  
+  cx_mat A = randu<cx_mat>(50, 20);
+  
+  REQUIRE( A.save(name, csv_ascii) );
+  
+  cx_mat B;
+  
+  REQUIRE( B.load(name, csv_ascii) );
+  
+  REQUIRE( approx_equal(A, B, "absdiff", 1e-12) );
+  
+  std::remove(name.c_str());
+  }
+
+
+
+TEST_CASE("diskio_mapped_mat")
+  {
+  const std::string name = "diskio_mapped_mat.bin";
+  
+  mat A = randu<mat>(100, 37);
+  
+  REQUIRE( A.save(name, arma_binary) );
+  
+  // the padded header can still be read by load()
+  mat B;
+  
+  REQUIRE( B.load(name, arma_binary) );
+  REQUIRE( B.load(name) );
+  
+  REQUIRE( approx_equal(A, B, "absdiff", 0.0) );
+  
+    {
+    const mat::mapped M(name);
+    
+    REQUIRE( M.n_rows == 100 );
+    REQUIRE( M.n_cols == 37  );
+    
+    REQUIRE( (std::size_t(M.memptr()) % 64) == 0 );
+    
+    REQUIRE( approx_equal(M, A, "absdiff", 0.0) );
+    
+    // mapped matrices can be used in expressions
+    
+    REQUIRE( accu(M) == Approx(accu(A)) );
+    
+    const vec x = linspace<vec>(0, 1, 37);
+    
+    REQUIRE( approx_equal(vec(M*x), vec(A*x), "reldiff", 1e-12) );
+    REQUIRE( approx_equal(mat(M.t()*M), mat(A.t()*A), "reldiff", 1e-12) );
+    REQUIRE( approx_equal(mat(2*M + A), mat(3*A), "reldiff", 1e-12) );
+    
+    // copies are ordinary matrices
+    
+    mat::mapped N(M);
+    
+    REQUIRE( N.memptr() != M.memptr() );
+    REQUIRE( approx_equal(N, A, "absdiff", 0.0) );
+    }
+  
+  // moving from a mapped matrix copies the elements, as the file is unmapped by the destructor
+  mat C;
+  mat D;
+  
+    {
+    mat::mapped M(name);
+    
+    C = std::move(M);
+    
+    REQUIRE( C.memptr() != M.memptr() );
+    
+    mat E(std::move(M));
+    
+    REQUIRE( E.memptr() != M.memptr() );
+    
+    D.steal_mem(E);
+    }
+  
+  REQUIRE( C.mem_state == 0 );
+  REQUIRE( D.mem_state == 0 );
+  
+  REQUIRE( approx_equal(C, A, "absdiff", 0.0) );
+  REQUIRE( approx_equal(D, A, "absdiff", 0.0) );
+  
+  // changes in copy-on-write mode are not written to the file
+    {
+    mat::mapped M(name, arma_binary, map_mode::copy_on_write);
+    
+    M.fill(123.0);
+    
+    REQUIRE( M(3,4) == 123.0 );
+    }
+  
+  // as are changes in read-only mode
+    {
+    mat::mapped M(name);
+    
+    M *= 2.0;
+    
+    REQUIRE( M(3,4) == 2.0 * A(3,4) );
+    }
+  
+  REQUIRE( B.load(name) );
+  REQUIRE( approx_equal(A, B, "absdiff", 0.0) );
+  
+  // changes in read-write mode are written to the file
+    {
+    mat::mapped M(name, arma_binary, map_mode::read_write);
+    
+    M.col(2) = 2.0 * M.col(2);
+    
+    M(0,0) = -1.0;
+    
+    REQUIRE( M.flush() );
+    }
+  
+  A.col(2) *= 2.0;
+  A(0,0)    = -1.0;
+  
+  REQUIRE( B.load(name) );
+  REQUIRE( approx_equal(A, B, "absdiff", 0.0) );
+  
+  // the size of a mapped matrix is fixed
+    {
+    mat::mapped M(name, arma_binary, map_mode::copy_on_write);
+    
+    REQUIRE_THROWS( M.set_size(3,3) );
+    }
+  
+  REQUIRE_THROWS( fmat::mapped(name) );
+  REQUIRE_THROWS( mat::mapped(name, csv_ascii) );
+  REQUIRE_THROWS( mat::mapped("no_such_file.bin") );
+  
+  std::remove(name.c_str());
+  }
+
+
+
+TEST_CASE("diskio_mapped_raw")
+  {
+  const std::string name = "diskio_mapped_raw.bin";
+  
+  fvec a = randu<fvec>(1001);
+  
+  REQUIRE( a.save(name, raw_binary) );
+  
+  const fmat::mapped M(name, raw_binary);
+  
+  REQUIRE( M.n_rows == 1001 );
+  REQUIRE( M.n_cols == 1    );
+  
+  REQUIRE( approx_equal(vectorise(M), a, "absdiff", 0.0f) );
+  
+  std::remove(name.c_str());
+  }
+
+
+
+TEST_CASE("diskio_mapped_cube")
+  {
+  const std::string name = "diskio_mapped_cube.bin";
+  
+  cx_cube A = randu<cx_cube>(20, 30, 4);
+  
+  REQUIRE( A.save(name, arma_binary) );
+  
+  cx_cube B;
+  
+  REQUIRE( B.load(name) );
+  
+  REQUIRE( approx_equal(A, B, "absdiff", 0.0) );
+  
+    {
+    const cx_cube::mapped C(name);
+    
+    REQUIRE( C.n_rows   == 20 );
+    REQUIRE( C.n_cols   == 30 );
+    REQUIRE( C.n_slices == 4  );
+    
+    REQUIRE( approx_equal(C, A, "absdiff", 0.0) );
+    
+    REQUIRE( approx_equal(C.slice(3), A.slice(3), "absdiff", 0.0) );
+    
+    REQUIRE( approx_equal(cx_cube(C + C), cx_cube(2*A), "reldiff", 1e-12) );
+    
+    REQUIRE( accu(C) == accu(A) );
+    }
+  
+  // moving from a mapped cube copies the elements, as the file is unmapped by the destructor
+  cx_cube D;
+  
+    {
+    cx_cube::mapped C(name);
+    
+    D = std::move(C);
+    
+    REQUIRE( D.memptr() != C.memptr() );
+    
+    cx_cube E(std::move(C));
+    
+    REQUIRE( E.memptr() != C.memptr() );
+    }
+  
+  REQUIRE( D.mem_state == 0 );
+  
+  REQUIRE( approx_equal(D, A, "absdiff", 0.0) );
+  REQUIRE( approx_equal(D.slice(3), A.slice(3), "absdiff", 0.0) );
+  
+    {
+    cx_cube::mapped C(name, arma_binary, map_mode::read_write);
+    
+    C.slice(1).zeros();
+    }
+  
+  A.slice(1).zeros();
+  
+  REQUIRE( B.load(name) );
+  
+  REQUIRE( approx_equal(A, B, "absdiff", 0.0) );
+  
+  std::remove(name.c_str());
+  }
+
+
+
+TEST_CASE("diskio_mat_reader_text")
+  {
+  const std::string name = "diskio_mat_reader.csv";
+  
+  mat A = randu<mat>(1003, 7);
+  
+  A(5,2) = -3.5e-10;
+  
+  REQUIRE( A.save(name, csv_ascii) );
+  
+  // check against load(), as the text format doesn't preserve all digits
+  mat B;
+  
+  REQUIRE( B.load(name, csv_ascii) );
+  
+  for(uword block_size : { uword(1), uword(100), uword(1003), uword(5000) })
+    {
+    mat_reader R(name, csv_ascii, block_size);
+    
+    REQUIRE( R.is_open() );
+    REQUIRE( R.n_cols() == 7 );
+    
+    mat X;
+    
+    uword row = 0;
+    
+    while(R.next(X))
+      {
+      REQUIRE( X.n_cols == 7 );
+      REQUIRE( X.n_rows == (std::min)(block_size, B.n_rows - row) );
+      
+      REQUIRE( approx_equal(X, B.rows(row, row + X.n_rows - 1), "absdiff", 0.0) );
+      
+      row += X.n_rows;
+      }
+    
+    REQUIRE( row == B.n_rows );
+    
+    REQUIRE( X.is_empty() );
+    REQUIRE( R.next(X) == false );
+    }
+  
+  // statistics over blocks
+    {
+    mat_reader R(name, auto_detect, 64);
+    
+    running_stat_vec<vec> stats;
+    
+    mat X;
+    
+    while(R.next(X))  { X.each_row( [&](const rowvec& r) { stats(r.t()); } ); }
+    
+    REQUIRE( approx_equal(stats.mean(), vec(mean(B,0).t()), "reldiff", 1e-12) );
+    }
+  
+  imat C = randi<imat>(50, 3, distr_param(-1000, 1000));
+  
+  REQUIRE( C.save(name, raw_ascii) );
+  
+    {
+    imat_reader R(name, raw_ascii, 16);
+    
+    imat X;
+    imat D;
+    
+    while(R.next(X))  { D = join_cols(D, X); }
+    
+    REQUIRE( all(vectorise(C == D)) );
+    }
+  
+  std::remove(name.c_str());
+  }
+
+
+
+TEST_CASE("diskio_mat_reader_binary")
+  {
+  const std::string name = "diskio_mat_reader.bin";
+  
+  mat A = randu<mat>(257, 33);
+  
+  REQUIRE( A.save(name, arma_binary) );
+  
+  // blocks of rows
+    {
+    mat_reader R(name, arma_binary, 50, 0);
+    
+    REQUIRE( R.n_rows() == 257 );
+    REQUIRE( R.n_cols() == 33  );
+    
+    mat X;
+    mat B;
+    
+    while(R.next(X))  { B = join_cols(B, X); }
+    
+    REQUIRE( approx_equal(A, B, "absdiff", 0.0) );
+    }
+  
+  // blocks of columns
+    {
+    mat_reader R(name, auto_detect, 10, 1);
+    
+    mat X;
+    mat B;
+    
+    while(R.next(X))
+      {
+      REQUIRE( X.n_rows == 257 );
+      
+      B = join_rows(B, X);
+      }
+    
+    REQUIRE( approx_equal(A, B, "absdiff", 0.0) );
+    }
+  
+  // raw_binary files are taken as a column vector
+  REQUIRE( A.save(name, raw_binary) );
+  
+    {
+    mat_reader R(name, raw_binary, 1000);
+    
+    REQUIRE( R.n_rows() == A.n_elem );
+    REQUIRE( R.n_cols() == 1        );
+    
+    mat X;
+    vec b;
+    
+    while(R.next(X))  { b = join_cols(b, vec(X)); }
+    
+    REQUIRE( approx_equal(vectorise(A), b, "absdiff", 0.0) );
+    }
+  
+  // incorrect element type
+  REQUIRE( A.save(name, arma_binary) );
+  
+    {
+    fmat_reader R;
+    
+    REQUIRE( R.open(name, arma_binary) == false );
+    REQUIRE( R.is_open() == false );
+    }
+  
+  std::remove(name.c_str());
+  }
+
+
+
+TEST_CASE("diskio_arma_binary_compressed_mat")
+  {
+  const std::string name = "diskio_arma_binary_compressed_mat.bin";
+  
+  const uword orig_threshold = get_mp_threshold();
+  
+  // low entropy data; several blocks of columns
+  umat A = randi<umat>(3000, 100, distr_param(0, 3));
+  
+  A.cols(10, 59).zeros();
+  
+  mat B = randn<mat>(1000, 300);
+  
+  B.col(7).zeros();
+  
+  for(uword pass=0; pass < 2; ++pass)
+    {
+    set_mp_threshold( (pass == 0) ? (uword(1) << 24) : uword(1) );
+    
+    REQUIRE( A.save(name, arma_binary_compressed) );
+    
+    std::ifstream f(name.c_str(), std::fstream::binary | std::fstream::ate);
+    
+    REQUIRE( uword(f.tellg()) < (A.n_elem * sizeof(uword)) / 4 );
+    
+    f.close();
+    
+    umat C;
+    
+    REQUIRE( C.load(name, arma_binary_compressed) );
+    
+    REQUIRE( C.n_rows == A.n_rows );
+    REQUIRE( C.n_cols == A.n_cols );
+    
+    REQUIRE( accu(C != A) == 0 );
+    
+    mat D;
+    
+    REQUIRE( B.save(name, arma_binary_compressed) );
+    REQUIRE( D.load(name) );
+    
+    REQUIRE( approx_equal(B, D, "absdiff", 0.0) );
+    }
+  
+  set_mp_threshold(orig_threshold);
+  
+  std::stringstream ss;
+  
+  mat E;
+  
+  REQUIRE( B.save(ss, arma_binary_compressed) );
+  REQUIRE( E.load(ss, arma_binary_compressed) );
+  
+  REQUIRE( approx_equal(B, E, "absdiff", 0.0) );
+  
+  // empty matrix
+  mat F(0, 5);
+  mat G;
+  
+  REQUIRE( F.save(name, arma_binary_compressed) );
+  REQUIRE( G.load(name, arma_binary_compressed) );
+  
+  REQUIRE( G.n_rows == 0 );
+  REQUIRE( G.n_cols == 5 );
+  
+  // incorrect element type
+  fmat H;
+  
+  REQUIRE( B.save(name, arma_binary_compressed) );
+  REQUIRE( H.load(name, arma_binary_compressed) == false );
+  
+  // damaged data
+  std::string data = ss.str();
+  
+  for(uword i = data.size() / 2; i < data.size(); i += 7)  { data[i] = char(data[i] ^ 0x5A); }
+  
+  std::stringstream ss2(data);
+  
+  mat K;
+  
+  REQUIRE( K.load(ss2, arma_binary_compressed) == false );
+  
+  std::remove(name.c_str());
+  }
+
+
+
+TEST_CASE("diskio_arma_binary_compressed_cube")
+  {
+  const std::string name = "diskio_arma_binary_compressed_cube.bin";
+  
+  cube A = randu<cube>(200, 150, 10);
+  
+  A.slice(3).zeros();
+  
+  REQUIRE( A.save(name, arma_binary_compressed) );
+  
+  cube B;
+  
+  REQUIRE( B.load(name) );
+  
+  REQUIRE( B.n_rows   == A.n_rows   );
+  REQUIRE( B.n_cols   == A.n_cols   );
+  REQUIRE( B.n_slices == A.n_slices );
+  
+  REQUIRE( approx_equal(A, B, "absdiff", 0.0) );
+  
+  icube C = randi<icube>(40, 30, 20, distr_param(-5, 5));
+  icube D;
+  
+  REQUIRE( C.save(name, arma_binary_compressed) );
+  REQUIRE( D.load(name, arma_binary_compressed) );
+  
+  REQUIRE( accu(C != D) == 0 );
+  
+  std::remove(name.c_str());
+  }
+
+
+
+TEST_CASE("diskio_text_save")
+  {
+  const std::string name = "diskio_text_save.csv";
+  
+  const uword orig_threshold = get_mp_threshold();
+  
+  mat A = { { 1.5, -datum::inf }, { 0.0, 1e-300 }, { -2.0, datum::nan } };
+  
+  std::ostringstream os1;
+  std::ostringstream os2;
+  
+  REQUIRE( A.save(os1, csv_ascii) );
+  REQUIRE( A.save(os2, raw_ascii) );
+  
+  REQUIRE( os1.str() == "1.5000000000000000e+00,-inf\n0.0000000000000000e+00,1.0000000000000000e-300\n-2.0000000000000000e+00,nan\n" );
+  
+  REQUIRE( os2.str() == "   1.5000000000000000e+00                     -inf\n   0.0000000000000000e+00  1.0000000000000000e-300\n  -2.0000000000000000e+00                      nan\n" );
+  
+  imat B = { { -12, 0 }, { 7, 123456789 } };
+  
+  std::ostringstream os3;
+  
+  REQUIRE( B.save(os3, raw_ascii) );
+  
+  REQUIRE( os3.str() == " -12 0\n 7 123456789\n" );
+  
+  cx_mat C(1, 1);
+  
+  C(0,0) = cx_double(1.0, -datum::inf);
+  
+  std::ostringstream os4;
+  
+  REQUIRE( C.save(os4, raw_ascii) );
+  
+  REQUIRE( os4.str() == " (1.0000000000000000e+00,-inf)\n" );
+  
+  // several blocks of lines
+  mat D = randn<mat>(20000, 11);
+  
+  for(uword pass=0; pass < 2; ++pass)
+    {
+    set_mp_threshold( (pass == 0) ? (uword(1) << 24) : uword(1) );
+    
+    REQUIRE( D.save(name, csv_ascii) );
+    
+    mat E;
+    
+    REQUIRE( E.load(name, csv_ascii) );
+    
+    REQUIRE( approx_equal(D, E, "reldiff", 1e-15) );
+    }
+  
+  set_mp_threshold(orig_threshold);
+  
+  std::remove(name.c_str());
+  }
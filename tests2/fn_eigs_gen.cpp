@@ -2277,3 +2277,37 @@ TEST_CASE("fn_eigs_gen_even_complex_sm_opts_test")
   
   REQUIRE(count > 0);
   }
+
+
+
+TEST_CASE("fn_eigs_gen_fn_test")
+  {
+  const uword n = 100;
+  
+  sp_mat m; m.sprandu(n, n, 0.1);
+  for(uword i = 0; i < n; ++i)  { m(i, i) += 5 * double(i) / double(n); }
+  
+  auto op = [&](vec& y, const vec& x)  { y = m * x; };
+  
+  cx_vec eigval;
+  cx_mat eigvec;
+  const bool status_fn = eigs_gen(eigval, eigvec, op, n, 5);
+  
+  cx_vec sp_eigval;
+  const bool status_sp = eigs_gen(sp_eigval, m, 5);
+  
+  REQUIRE( status_fn == true );
+  REQUIRE( status_sp == true );
+  
+  REQUIRE( eigvec.n_rows == n );
+  REQUIRE( eigvec.n_cols == 5 );
+  
+  const cx_mat mc = conv_to<cx_mat>::from(mat(m));
+  
+  for(uword i = 0; i < 5; ++i)
+    {
+    REQUIRE( std::abs(eigval(i) - sp_eigval(i)) == Approx(0.0).margin(1e-6) );
+    
+    REQUIRE( norm(mc * eigvec.col(i) - eigval(i) * eigvec.col(i)) == Approx(0.0).margin(1e-6) );
+    }
+  }
@@ -185,3 +185,178 @@ TEST_CASE("fn_eigs_sigma_test")
   
   REQUIRE( count > 0 );
   }
+
+
+
+TEST_CASE("fn_eigs_sym_fn_test")
+  {
+  // Operator L = D - W of a path graph, applied without forming L.
+  const uword n = 200;
+  
+  vec w = 1.0 + randu<vec>(n-1);
+  
+  auto laplacian = [&](vec& y, const vec& x)
+    {
+    y.zeros();
+    for(uword i = 0; i < n-1; ++i)
+      {
+      const double t = w(i) * (x(i) - x(i+1));
+      y(i)   += t;
+      y(i+1) -= t;
+      }
+    };
+  
+  sp_mat L(n, n);
+  for(uword i = 0; i < n-1; ++i)
+    {
+    L(i,   i  ) += w(i);
+    L(i+1, i+1) += w(i);
+    L(i,   i+1) -= w(i);
+    L(i+1, i  ) -= w(i);
+    }
+  
+  vec eigval;
+  mat eigvec;
+  
+  const bool status_fn = eigs_sym(eigval, eigvec, laplacian, n, 5, "la");
+  
+  vec sp_eigval;
+  mat sp_eigvec;
+  
+  const bool status_sp = eigs_sym(sp_eigval, sp_eigvec, L, 5, "la");
+  
+  REQUIRE( status_fn == true );
+  REQUIRE( status_sp == true );
+  
+  REQUIRE( eigvec.n_rows == n );
+  REQUIRE( eigvec.n_cols == 5 );
+  
+  for(uword i = 0; i < 5; ++i)
+    {
+    REQUIRE( eigval(i) == Approx(sp_eigval(i)).margin(1e-6) );
+    
+    REQUIRE( norm(L * eigvec.col(i) - eigval(i) * eigvec.col(i)) == Approx(0.0).margin(1e-6) );
+    }
+  }
+
+
+
+TEST_CASE("fn_eigs_sym_fn_sigma_test")
+  {
+  const uword n = 100;
+  
+  sp_mat m; m.sprandu(n, n, 0.1);
+  m = m.t() + m;
+  for(uword i = 0; i < n; ++i)  { m(i, i) = i + 10; }
+  
+  const double sigma = 12.1;
+  
+  // solve callback for (m - sigma*I), factorised once
+  mat A(m);
+  A.diag() -= sigma;
+  
+  mat A_inv;
+  REQUIRE( inv(A_inv, A) );
+  
+  auto solve_fn = [&](vec& y, const vec& x)  { y = A_inv * x; };
+  
+  vec eigval;
+  mat eigvec;
+  const bool status_fn = eigs_sym(eigval, eigvec, solve_fn, n, 5, sigma);
+  
+  REQUIRE( status_fn == true );
+  REQUIRE( eigval.n_elem == 5 );
+  
+  // dense reference: the 5 eigenvalues nearest to sigma
+  vec eigval_dense;
+  REQUIRE( eig_sym(eigval_dense, A) );
+  
+  const uvec nearest = sort_index(abs(eigval_dense));
+  
+  const vec eigval_ref = sort(eigval_dense.elem(nearest.head(5))) + sigma;
+  const vec eigval_srt = sort(eigval);
+  
+  for(uword i = 0; i < 5; ++i)
+    {
+    REQUIRE( eigval_srt(i) == Approx(eigval_ref(i)).margin(1e-6) );
+    
+    REQUIRE( norm(m * eigvec.col(i) - eigval(i) * eigvec.col(i)) == Approx(0.0).margin(1e-6) );
+    }
+  }
+
+
+
+TEST_CASE("fn_eigs_sym_lobpcg_test")
+  {
+  const uword n = 600;
+  
+  sp_mat m; m.sprandu(n, n, 0.01);
+  m = m.t() + m;
+  for(uword i = 0; i < n; ++i)  { m(i, i) = double(i % 50) + 1.0; }
+  
+  vec eigval_dense;
+  REQUIRE( eig_sym(eigval_dense, mat(m)) );
+  
+  eigs_opts opts;
+  opts.method = eigs_opts::METHOD_LOBPCG;
+  
+  for(uword use_precond = 0; use_precond < 2; ++use_precond)
+    {
+    opts.precond = (use_precond == 0) ? eigs_opts::PRECOND_NONE : eigs_opts::PRECOND_JACOBI;
+    
+    vec eigval;
+    mat eigvec;
+    
+    // smallest algebraic
+    REQUIRE( eigs_sym(eigval, eigvec, m, 10, "sa", opts) );
+    REQUIRE( eigval.n_elem == 10 );
+    
+    for(uword i = 0; i < 10; ++i)
+      {
+      REQUIRE( eigval(i) == Approx(eigval_dense(i)).margin(1e-6) );
+      
+      REQUIRE( norm(m * eigvec.col(i) - eigval(i) * eigvec.col(i)) == Approx(0.0).margin(1e-6) );
+      }
+    
+    // largest algebraic
+    REQUIRE( eigs_sym(eigval, eigvec, m, 10, "la", opts) );
+    REQUIRE( eigval.n_elem == 10 );
+    
+    for(uword i = 0; i < 10; ++i)
+      {
+      REQUIRE( eigval(i) == Approx(eigval_dense(n - 10 + i)).margin(1e-6) );
+      
+      REQUIRE( norm(m * eigvec.col(i) - eigval(i) * eigvec.col(i)) == Approx(0.0).margin(1e-6) );
+      }
+    }
+  }
+
+
+
+TEST_CASE("fn_eigs_sym_lobpcg_fn_test")
+  {
+  const uword n = 300;
+  
+  sp_mat m; m.sprandu(n, n, 0.02);
+  m = m.t() + m;
+  
+  auto op = [&](vec& y, const vec& x)  { y = m * x; };
+  
+  eigs_opts opts;
+  opts.method = eigs_opts::METHOD_LOBPCG;
+  opts.subdim = 12;
+  
+  vec eigval;
+  mat eigvec;
+  REQUIRE( eigs_sym(eigval, eigvec, op, n, 4, "sa", opts) );
+  
+  vec eigval_ref;
+  REQUIRE( eigs_sym(eigval_ref, m, 4, "sa") );
+  
+  REQUIRE( eigval.n_elem == 4 );
+  
+  for(uword i = 0; i < 4; ++i)
+    {
+    REQUIRE( eigval(i) == Approx(eigval_ref(i)).margin(1e-6) );
+    }
+  }
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+// the results are compared against the standard library;
+// when ARMA_USE_VECMATH is enabled, this checks the SIMD kernels (including the block tails)
+
+template<typename eT, typename T1, typename fn_type>
+static
+bool
+check_fn(const Base<eT,T1>& expr, const Mat<eT>& A, fn_type fn, const eT tol)
+  {
+  const Mat<eT> X = expr.get_ref();
+  
+  if( (X.n_rows != A.n_rows) || (X.n_cols != A.n_cols) )  { return false; }
+  
+  for(uword i=0; i < A.n_elem; ++i)
+    {
+    const eT ref = fn(A[i]);
+    const eT val = X[i];
+    
+    if(std::isnan(ref))  { if(std::isnan(val) == false)  { return false; }  continue; }
+    
+    if(std::isinf(ref) || (ref == eT(0)))
+      {
+      if( (val != ref) || (std::signbit(val) != std::signbit(ref)) )  { return false; }
+      continue;
+      }
+    
+    if( std::abs(val - ref) > tol * std::abs(ref) )  { return false; }
+    }
+  
+  return true;
+  }
+
+
+
+TEST_CASE("fn_exp_log_trig_1")
+  {
+  mat A = 20.0 * randu<mat>(37, 29) - 10.0;  // odd sizes exercise the tails
+  
+  const mat B = abs(A) + 1e-3;
+  
+  const double tol = 4.0 * std::numeric_limits<double>::epsilon();
+  
+  REQUIRE( check_fn( exp(A),  A, [](double x) { return std::exp(x);  }, tol ) );
+  REQUIRE( check_fn( log(B),  B, [](double x) { return std::log(x);  }, tol ) );
+  REQUIRE( check_fn( sin(A),  A, [](double x) { return std::sin(x);  }, tol ) );
+  REQUIRE( check_fn( cos(A),  A, [](double x) { return std::cos(x);  }, tol ) );
+  REQUIRE( check_fn( tanh(A), A, [](double x) { return std::tanh(x); }, tol ) );
+  
+  // expressions
+  mat C = 0.5 * A;
+  
+  REQUIRE( check_fn( exp(0.5*A), C, [](double x) { return std::exp(x); }, tol ) );
+  REQUIRE( check_fn( sin(0.5*A), C, [](double x) { return std::sin(x); }, tol ) );
+  
+  // large arguments
+  mat D = 2e6 * randu<mat>(20, 20) - 1e6;
+  
+  REQUIRE( check_fn( sin(D), D, [](double x) { return std::sin(x); }, tol ) );
+  REQUIRE( check_fn( cos(D), D, [](double x) { return std::cos(x); }, tol ) );
+  
+  // aliasing
+  mat E = A;
+  
+  E = exp(E);
+  
+  REQUIRE( approx_equal(E, exp(A), "reldiff", tol) );
+  }
+
+
+
+TEST_CASE("fn_exp_log_trig_2")
+  {
+  fmat A = 20.0f * randu<fmat>(37, 29) - 10.0f;
+  
+  const fmat B = abs(A) + 1e-3f;
+  
+  const float tol = 4.0f * std::numeric_limits<float>::epsilon();
+  
+  REQUIRE( check_fn( exp(A),  A, [](float x) { return std::exp(x);  }, tol ) );
+  REQUIRE( check_fn( log(B),  B, [](float x) { return std::log(x);  }, tol ) );
+  REQUIRE( check_fn( sin(A),  A, [](float x) { return std::sin(x);  }, tol ) );
+  REQUIRE( check_fn( cos(A),  A, [](float x) { return std::cos(x);  }, tol ) );
+  REQUIRE( check_fn( tanh(A), A, [](float x) { return std::tanh(x); }, tol ) );
+  
+  fmat D = 2e5f * randu<fmat>(20, 20) - 1e5f;
+  
+  REQUIRE( check_fn( sin(D), D, [](float x) { return std::sin(x); }, tol ) );
+  REQUIRE( check_fn( cos(D), D, [](float x) { return std::cos(x); }, tol ) );
+  }
+
+
+
+TEST_CASE("fn_exp_log_trig_special")
+  {
+  const double inf = datum::inf;
+  const double nan = datum::nan;
+  
+  vec A = { 0.0, -0.0, inf, -inf, nan, 1e-310, 5e-324, -1.0, 710.0, -750.0, 1e300, -1e300, 1e-20, -1e-20, 0.5, 1e7, 20.0, -20.0 };
+  
+  const double tol = 4.0 * std::numeric_limits<double>::epsilon();
+  
+  REQUIRE( check_fn( exp(A),  A, [](double x) { return std::exp(x);  }, tol ) );
+  REQUIRE( check_fn( log(A),  A, [](double x) { return std::log(x);  }, tol ) );
+  REQUIRE( check_fn( sin(A),  A, [](double x) { return std::sin(x);  }, tol ) );
+  REQUIRE( check_fn( cos(A),  A, [](double x) { return std::cos(x);  }, tol ) );
+  REQUIRE( check_fn( tanh(A), A, [](double x) { return std::tanh(x); }, tol ) );
+  
+  fvec B = conv_to<fvec>::from(A);
+  
+  const float ftol = 4.0f * std::numeric_limits<float>::epsilon();
+  
+  REQUIRE( check_fn( exp(B),  B, [](float x) { return std::exp(x);  }, ftol ) );
+  REQUIRE( check_fn( log(B),  B, [](float x) { return std::log(x);  }, ftol ) );
+  REQUIRE( check_fn( sin(B),  B, [](float x) { return std::sin(x);  }, ftol ) );
+  REQUIRE( check_fn( cos(B),  B, [](float x) { return std::cos(x);  }, ftol ) );
+  REQUIRE( check_fn( tanh(B), B, [](float x) { return std::tanh(x); }, ftol ) );
+  }
+
+
+
+TEST_CASE("fn_exp_log_trig_cube")
+  {
+  cube A = 4.0 * randu<cube>(5, 7, 3) - 2.0;
+  
+  cube X = exp(A);
+  cube Y = tanh(2.0*A);
+  
+  for(uword i=0; i < A.n_elem; ++i)
+    {
+    REQUIRE( X[i] == Approx(std::exp(A[i]))      );
+    REQUIRE( Y[i] == Approx(std::tanh(2.0*A[i])) );
+    }
+  }
@@ -881,4 +881,245 @@ TEST_CASE("fn_spsolve_cx_float_function_test")
     }
   }
 
+
+
+TEST_CASE("fn_spsolve_factoriser_test")
+  {
+  sp_mat A;
+  A.sprandu(100, 100, 0.05);
+  A.diag().randu();
+  A.diag() += 1;
+
+  spsolve_factoriser<double> F;
+
+  REQUIRE( F.is_factorised() == false );
+  REQUIRE( F.factorise(A) );
+  REQUIRE( F.is_factorised() );
+  REQUIRE( F.rcond() > 0.0 );
+
+  // right-hand sides one at a time, as well as a block
+  for (uword t = 0; t < 5; ++t)
+    {
+    vec b(100, fill::randu);
+
+    vec x;
+    REQUIRE( F.solve(x, b) );
+
+    REQUIRE( norm(A * x - b) == Approx(0.0).margin(1e-8) );
+    }
+
+  mat B(100, 7, fill::randu);
+
+  mat X = F.solve(B);
+  REQUIRE( norm(A * X - B, "fro") == Approx(0.0).margin(1e-8) );
+  REQUIRE( norm(X - spsolve(A, B), "fro") == Approx(0.0).margin(1e-8) );
+
+  // new values, same sparsity pattern
+  sp_mat A2 = A;
+  A2 *= 3.0;
+  A2.diag() += 2.0;
+
+  REQUIRE( F.refactorise(A2) );
+
+  X = F.solve(B);
+  REQUIRE( norm(A2 * X - B, "fro") == Approx(0.0).margin(1e-8) );
+
+  // different sparsity pattern falls back to a full factorisation
+  sp_mat A3 = A2 + 0.1 * speye<sp_mat>(100, 100);
+  A3(0, 99) = 0.5;
+
+  REQUIRE( F.refactorise(A3) );
+
+  X = F.solve(B);
+  REQUIRE( norm(A3 * X - B, "fro") == Approx(0.0).margin(1e-8) );
+
+  F.reset();
+  REQUIRE( F.is_factorised() == false );
+
+  // singular matrix
+  sp_mat S(10, 10);
+  S(0, 0) = 1.0;
+  REQUIRE( F.factorise(S) == false );
+  REQUIRE( F.is_factorised() == false );
+
+  // settings given to factorise() are also used when refactorise() does a full factorisation
+  sp_mat C = speye<sp_mat>(10, 10);
+  C(9, 9) = 1e-20;
+
+  superlu_opts opts;
+  opts.allow_ugly = true;
+
+  REQUIRE( F.factorise(C, opts) );
+
+  sp_mat C2 = C;
+  C2(0, 9) = 0.5;
+
+  REQUIRE( F.refactorise(C2) );
+  REQUIRE( F.is_factorised() );
+  }
+
+
+
+TEST_CASE("fn_spsolve_factoriser_cx_test")
+  {
+  sp_cx_mat A;
+  A.sprandu(60, 60, 0.1);
+  A.diag() += cx_double(2.0, 1.0);
+
+  spsolve_factoriser<cx_double> F;
+
+  REQUIRE( F.factorise(A) );
+
+  cx_mat B(60, 3, fill::randu);
+
+  cx_mat X;
+  REQUIRE( F.solve(X, B) );
+
+  REQUIRE( norm(A * X - B, "fro") == Approx(0.0).margin(1e-8) );
+  }
+
 #endif
+
+
+
+// built-in iterative solvers; these do not need SuperLU
+
+template<typename eT>
+static
+SpMat<eT>
+spsolve_poisson_2d(const uword k, const double convection = 0.0)
+  {
+  // 5-point Laplacian on a k x k grid, optionally with a non-symmetric convection term
+  const uword n = k*k;
+
+  umat    locs(2, 5*n);
+  Col<eT> vals(5*n);
+
+  uword count = 0;
+
+  for (uword i = 0; i < k; ++i)
+  for (uword j = 0; j < k; ++j)
+    {
+    const uword row = i*k + j;
+
+    locs(0, count) = row;  locs(1, count) = row;  vals(count) = eT(4);  ++count;
+
+    if (i > 0)    { locs(0, count) = row;  locs(1, count) = row - k;  vals(count) = eT(-1.0 - convection);  ++count; }
+    if (i < k-1)  { locs(0, count) = row;  locs(1, count) = row + k;  vals(count) = eT(-1.0 + convection);  ++count; }
+    if (j > 0)    { locs(0, count) = row;  locs(1, count) = row - 1;  vals(count) = eT(-1);                 ++count; }
+    if (j < k-1)  { locs(0, count) = row;  locs(1, count) = row + 1;  vals(count) = eT(-1);                 ++count; }
+    }
+
+  return SpMat<eT>(locs.cols(0, count-1), vals.rows(0, count-1), n, n);
+  }
+
+
+
+TEST_CASE("fn_spsolve_iterative_test")
+  {
+  const sp_mat A = spsolve_poisson_2d<double>(30);
+  const mat    X = randu<mat>(A.n_rows, 2);
+  const mat    B = A * X;
+
+  const spsolve_opts::precond_type preconds[] = { spsolve_opts::PRECOND_NONE, spsolve_opts::PRECOND_JACOBI, spsolve_opts::PRECOND_ILU0, spsolve_opts::PRECOND_IC0 };
+
+  const uword old_threshold = get_mp_threshold();
+
+  for (uword pass = 0; pass < 2; ++pass)
+    {
+    set_mp_threshold( (pass == 0) ? old_threshold : uword(1) );
+
+    for (uword k = 0; k < 4; ++k)
+      {
+      spsolve_opts opts;
+
+      opts.tol     = 1e-10;
+      opts.precond = preconds[k];
+
+      mat Y;
+
+      REQUIRE( spsolve(Y, A, B, "cg",       opts) );  REQUIRE( approx_equal(Y, X, "absdiff", 1e-6) );
+      REQUIRE( spsolve(Y, A, B, "bicgstab", opts) );  REQUIRE( approx_equal(Y, X, "absdiff", 1e-6) );
+      REQUIRE( spsolve(Y, A, B, "gmres",    opts) );  REQUIRE( approx_equal(Y, X, "absdiff", 1e-6) );
+      }
+    }
+
+  set_mp_threshold(old_threshold);
+
+  // non-symmetric system
+  const sp_mat C = spsolve_poisson_2d<double>(20, 0.5);
+  const vec    x = randu<vec>(C.n_rows);
+  const vec    b = C * x;
+
+  spsolve_opts opts;
+
+  opts.tol     = 1e-10;
+  opts.precond = spsolve_opts::PRECOND_ILU0;
+
+  REQUIRE( approx_equal(vec(spsolve(C, b, "bicgstab", opts)), x, "absdiff", 1e-6) );
+  REQUIRE( approx_equal(vec(spsolve(C, b, "gmres",    opts)), x, "absdiff", 1e-6) );
+
+  opts.restart = 5;
+  REQUIRE( approx_equal(vec(spsolve(C, b, "gmres",    opts)), x, "absdiff", 1e-6) );
+
+  // warm start from the solution needs no iterations
+  opts.max_iter   = 0;
+  opts.warm_start = true;
+
+  vec y = x;
+  REQUIRE( spsolve(y, C, b, "bicgstab", opts) );
+  REQUIRE( approx_equal(y, x, "absdiff", 1e-10) );
+
+  // not enough iterations; the expected warning is kept out of the test output
+  opts.max_iter   = 2;
+  opts.warm_start = false;
+
+  std::ostringstream warnings;
+
+  std::streambuf* cerr_buf = get_cerr_stream().rdbuf(warnings.rdbuf());
+
+  vec z;
+  const bool status = spsolve(z, C, b, "gmres", opts);
+
+  get_cerr_stream().rdbuf(cerr_buf);
+
+  REQUIRE( status == false );
+  }
+
+
+
+TEST_CASE("fn_spsolve_iterative_cx_test")
+  {
+  sp_cx_mat A = spsolve_poisson_2d<cx_double>(15);
+
+  A.diag() += cx_double(0.0, 1.0);
+
+  const cx_vec x = randu<cx_vec>(A.n_rows);
+  const cx_vec b = A * x;
+
+  spsolve_opts opts;
+
+  opts.tol     = 1e-10;
+  opts.precond = spsolve_opts::PRECOND_ILU0;
+
+  REQUIRE( approx_equal(cx_vec(spsolve(A, b, "bicgstab", opts)), x, "absdiff", 1e-6) );
+  REQUIRE( approx_equal(cx_vec(spsolve(A, b, "gmres",    opts)), x, "absdiff", 1e-6) );
+
+  // Hermitian positive definite
+  sp_cx_mat H = spsolve_poisson_2d<cx_double>(15);
+
+  H(0, 1) = cx_double(-1.0, 0.5);
+  H(1, 0) = cx_double(-1.0, -0.5);
+
+  const cx_vec c = H * x;
+
+  opts.precond = spsolve_opts::PRECOND_IC0;
+
+  REQUIRE( approx_equal(cx_vec(spsolve(H, c, "cg", opts)), x, "absdiff", 1e-6) );
+
+  // single precision
+  const sp_fmat F = spsolve_poisson_2d<float>(15);
+  const fvec    f = randu<fvec>(F.n_rows);
+
+  REQUIRE( approx_equal(fvec(spsolve(F, fvec(F * f), "cg")), f, "absdiff", 1e-2) );
+  }
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+// gemm_emul is used when BLAS is not available;
+// the results are compared against a direct evaluation of each element
+
+template<typename eT>
+static
+Mat<eT>
+ref_op(const Mat<eT>& X, const bool do_trans)
+  {
+  return (do_trans) ? Mat<eT>(X.t()) : X;  // hermitian transpose for complex matrices
+  }
+
+
+
+template<const bool do_trans_A, const bool do_trans_B, const bool use_alpha, const bool use_beta, typename eT>
+static
+bool
+check_gemm(const uword M, const uword N, const uword K)
+  {
+  typedef typename get_pod_type<eT>::result T;
+  
+  const Mat<eT> A = (do_trans_A) ? randu< Mat<eT> >(K, M) : randu< Mat<eT> >(M, K);
+  const Mat<eT> B = (do_trans_B) ? randu< Mat<eT> >(N, K) : randu< Mat<eT> >(K, N);
+  
+  const Mat<eT> C_orig = randu< Mat<eT> >(M, N);
+  
+  const eT alpha = eT(T(0.75));
+  const eT beta  = eT(T(-1.5));
+  
+  const Mat<eT> AA = ref_op(A, do_trans_A);
+  const Mat<eT> BB = ref_op(B, do_trans_B);
+  
+  Mat<eT> C_ref(M, N);
+  
+  for(uword col=0; col < N; ++col)
+  for(uword row=0; row < M; ++row)
+    {
+    eT acc = eT(0);
+    
+    for(uword k=0; k < K; ++k)  { acc += AA.at(row,k) * BB.at(k,col); }
+    
+    if(use_alpha)  { acc *= alpha; }
+    if(use_beta )  { acc += beta * C_orig.at(row,col); }
+    
+    C_ref.at(row,col) = acc;
+    }
+  
+  Mat<eT> C = C_orig;
+  
+  gemm_emul<do_trans_A, do_trans_B, use_alpha, use_beta>::apply(C, A, B, alpha, beta);
+  
+  const T tol = T(K+1) * T(10) * std::numeric_limits<T>::epsilon();
+  
+  return approx_equal(C, C_ref, "absdiff", tol);
+  }
+
+
+
+template<typename eT>
+static
+void
+check_all_variants(const uword M, const uword N, const uword K)
+  {
+  REQUIRE( (check_gemm<false, false, false, false, eT>(M, N, K)) );
+  REQUIRE( (check_gemm<true,  false, false, false, eT>(M, N, K)) );
+  REQUIRE( (check_gemm<false, true,  false, false, eT>(M, N, K)) );
+  REQUIRE( (check_gemm<true,  true,  false, false, eT>(M, N, K)) );
+  
+  REQUIRE( (check_gemm<false, false, true,  false, eT>(M, N, K)) );
+  REQUIRE( (check_gemm<false, false, false, true,  eT>(M, N, K)) );
+  REQUIRE( (check_gemm<true,  true,  true,  true,  eT>(M, N, K)) );
+  REQUIRE( (check_gemm<false, true,  true,  true,  eT>(M, N, K)) );
+  }
+
+
+
+TEST_CASE("gemm_emul_1")
+  {
+  // odd sizes exercise partial micro-tiles; K > 256 spans several packed panels
+  check_all_variants<double>(101, 67, 300);
+  check_all_variants<double>(  9, 130, 61);
+  check_all_variants<float >( 77, 45, 83);
+  }
+
+
+
+TEST_CASE("gemm_emul_2")
+  {
+  check_all_variants< std::complex<double> >(53, 37, 270);
+  check_all_variants< std::complex<float>  >(41, 29, 50);
+  }
+
+
+
+TEST_CASE("gemm_emul_3")
+  {
+  // element types without BLAS support always use the emulation
+  imat A = randi<imat>(70, 90, distr_param(-10, 10));
+  imat B = randi<imat>(90, 60, distr_param(-10, 10));
+  
+  const imat C = A * B;
+  const imat D = conv_to<imat>::from( conv_to<mat>::from(A) * conv_to<mat>::from(B) );
+  
+  REQUIRE( all(vectorise(C == D)) );
+  
+  const imat E = A.t() * A;
+  const imat F = conv_to<imat>::from( conv_to<mat>::from(A).t() * conv_to<mat>::from(A) );
+  
+  REQUIRE( all(vectorise(E == F)) );
+  }
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+// gemv_emul is used when BLAS is not available;
+// the results are compared against a direct evaluation of each element
+
+template<const bool do_trans_A, const bool use_alpha, const bool use_beta, typename eT>
+static
+bool
+check_gemv(const uword n_rows, const uword n_cols)
+  {
+  typedef typename get_pod_type<eT>::result T;
+  
+  const Mat<eT> A = randu< Mat<eT> >(n_rows, n_cols);
+  
+  const Col<eT> x = randu< Col<eT> >( (do_trans_A) ? n_rows : n_cols );
+  
+  const Col<eT> y_orig = randu< Col<eT> >( (do_trans_A) ? n_cols : n_rows );
+  
+  const eT alpha = eT(T(0.75));
+  const eT beta  = eT(T(-1.5));
+  
+  const Mat<eT> AA = (do_trans_A) ? Mat<eT>(A.t()) : A;  // hermitian transpose for complex matrices
+  
+  Col<eT> y_ref(AA.n_rows);
+  
+  for(uword row=0; row < AA.n_rows; ++row)
+    {
+    eT acc = eT(0);
+    
+    for(uword k=0; k < AA.n_cols; ++k)  { acc += AA.at(row,k) * x[k]; }
+    
+    if(use_alpha)  { acc *= alpha; }
+    if(use_beta )  { acc += beta * y_orig[row]; }
+    
+    y_ref[row] = acc;
+    }
+  
+  Col<eT> y = y_orig;
+  
+  gemv_emul<do_trans_A, use_alpha, use_beta>::apply(y.memptr(), A, x.memptr(), alpha, beta);
+  
+  const T tol = T(x.n_elem + 1) * T(10) * std::numeric_limits<T>::epsilon();
+  
+  return approx_equal(y, y_ref, "absdiff", tol);
+  }
+
+
+
+template<typename eT>
+static
+void
+check_all_variants(const uword n_rows, const uword n_cols)
+  {
+  REQUIRE( (check_gemv<false, false, false, eT>(n_rows, n_cols)) );
+  REQUIRE( (check_gemv<true,  false, false, eT>(n_rows, n_cols)) );
+  REQUIRE( (check_gemv<false, true,  true,  eT>(n_rows, n_cols)) );
+  REQUIRE( (check_gemv<true,  true,  true,  eT>(n_rows, n_cols)) );
+  REQUIRE( (check_gemv<false, false, true,  eT>(n_rows, n_cols)) );
+  REQUIRE( (check_gemv<true,  true,  false, eT>(n_rows, n_cols)) );
+  }
+
+
+
+TEST_CASE("gemv_emul_1")
+  {
+  // odd sizes exercise the tails; more than 2048 rows spans several blocks
+  check_all_variants<double>(4103, 13);
+  check_all_variants<double>(  67, 301);
+  check_all_variants<float >(2501, 7);
+  check_all_variants<float >(   3, 2000);
+  }
+
+
+
+TEST_CASE("gemv_emul_2")
+  {
+  check_all_variants< std::complex<double> >(2111, 9);
+  check_all_variants< std::complex<float>  >(  45, 203);
+  }
+
+
+
+TEST_CASE("gemv_emul_3")
+  {
+  imat A = randi<imat>(300, 41, distr_param(-10, 10));
+  ivec x = randi<ivec>(41,      distr_param(-10, 10));
+  ivec z = randi<ivec>(300,     distr_param(-10, 10));
+  
+  const ivec y = A * x;
+  const ivec w = A.t() * z;
+  
+  const vec y_ref = conv_to<mat>::from(A)     * conv_to<vec>::from(x);
+  const vec w_ref = conv_to<mat>::from(A).t() * conv_to<vec>::from(z);
+  
+  REQUIRE( all(y == conv_to<ivec>::from(y_ref)) );
+  REQUIRE( all(w == conv_to<ivec>::from(w_ref)) );
+  }
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("memory_pool_1")
+  {
+  memory_pool::enable();
+  memory_pool::trim();
+  memory_pool::reset_stats();
+  
+  void* A = memory_pool::acquire(1000);
+  
+  REQUIRE( A != nullptr );
+  REQUIRE( memory_pool::stats().n_misses == 1 );
+  
+  memory_pool::release(A);
+  
+  REQUIRE( memory_pool::stats().n_bytes_retained == 1024 );
+  
+  void* B = memory_pool::acquire(1024);
+  
+  REQUIRE( B == A );
+  REQUIRE( memory_pool::stats().n_hits == 1 );
+  REQUIRE( memory_pool::stats().n_bytes_retained == 0 );
+  
+  memory_pool::release(B);
+  memory_pool::trim();
+  
+  REQUIRE( memory_pool::stats().n_bytes_retained == 0 );
+  }
+
+
+
+TEST_CASE("memory_pool_2")
+  {
+  memory_pool::disable();
+  memory_pool::reset_stats();
+  
+  REQUIRE( memory_pool::is_enabled() == false );
+  
+  void* A = memory_pool::acquire(100);
+  
+  memory_pool::release(A);
+  
+  REQUIRE( memory_pool::stats().n_misses == 1 );
+  REQUIRE( memory_pool::stats().n_bytes_retained == 0 );
+  
+  memory_pool::enable();
+  
+  REQUIRE( memory_pool::is_enabled() == true );
+  }
+
+
+
+TEST_CASE("memory_pool_arena_1")
+  {
+  memory_pool::reset_stats();
+  
+  const u64 arena_bytes = memory_pool::stats().n_bytes_arena;
+  
+    {
+    memory_arena arena(8192);
+    
+    double* A = (double*) memory_pool::acquire(100*sizeof(double));
+    double* B = (double*) memory_pool::acquire(100*sizeof(double));
+    
+    REQUIRE( A != nullptr );
+    REQUIRE( B != nullptr );
+    REQUIRE( B > A );
+    
+    for(uword i=0; i < 100; ++i)  { A[i] = double(i); B[i] = double(2*i); }
+    
+    REQUIRE( A[99] == Approx(99.0) );
+    REQUIRE( B[99] == Approx(198.0) );
+    
+    memory_pool::release(A);  // no-op; memory is released by the arena
+    
+    REQUIRE( arena.n_bytes() >= 200*sizeof(double) );
+    REQUIRE( memory_pool::stats().n_bytes_arena == arena_bytes + arena.n_bytes() );
+    }
+  
+  REQUIRE( memory_pool::stats().n_bytes_arena == arena_bytes );
+  }
+
+
+
+TEST_CASE("memory_alignment_1")
+  {
+  mat A(100, 100, fill::randu);
+  
+  REQUIRE( memory::is_aligned(A.memptr()) );
+  REQUIRE( (std::size_t(A.memptr()) % arma_config::mem_align) == 0 );
+  
+  mat B = A + 1.0;
+  
+  REQUIRE( memory::is_aligned(B.memptr()) );
+  REQUIRE( accu(B - A) == Approx(double(A.n_elem)) );
+  
+  // small matrices use 16 byte aligned local memory and keep the aligned code paths
+  mat C(2, 2, fill::randu);
+  
+  REQUIRE( memory::is_aligned(C.memptr()) );
+  }
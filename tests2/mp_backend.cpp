@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+// run a few parallelised operations and compare against serial evaluation
+
+static
+void
+check_ops()
+  {
+  const uword orig_threshold = get_mp_threshold();
+  
+  mat A = randu<mat>(61, 43);
+  mat B = randu<mat>(61, 43);
+  
+  cube C = randu<cube>(7, 5, 9);
+  
+  set_mp_threshold(uword(1) << 24);
+  
+  const mat  X1 = exp(A) + B;
+  const mat  Y1 = pow(A, B);
+  const cube Z1 = sqrt(C) * 2.0;
+  
+  const double s1 = accu(exp(A));
+  
+  set_mp_threshold(1);
+  
+  const mat  X2 = exp(A) + B;
+  const mat  Y2 = pow(A, B);
+  const cube Z2 = sqrt(C) * 2.0;
+  
+  const double s2 = accu(exp(A));
+  
+  set_mp_threshold(orig_threshold);
+  
+  REQUIRE( approx_equal(X1, X2, "reldiff", 1e-14) );
+  REQUIRE( approx_equal(Y1, Y2, "reldiff", 1e-14) );
+  REQUIRE( approx_equal(Z1, Z2, "reldiff", 1e-14) );
+  
+  REQUIRE( s1 == Approx(s2) );
+  
+  // every index is visited exactly once
+  
+  uvec counts(1001, fill::zeros);
+  
+  parallel_for(counts.n_elem, 16, [&](const uword i) { counts[i] += 1; });
+  
+  REQUIRE( all(counts == 1) );
+  }
+
+
+
+TEST_CASE("mp_backend_1")
+  {
+  const mp_backend::type orig_backend = get_mp_backend();
+  
+  check_ops();
+  
+  if(set_mp_backend(mp_backend::openmp))
+    {
+    REQUIRE( get_mp_backend() == mp_backend::openmp );
+    
+    check_ops();
+    }
+  
+  if(set_mp_backend(mp_backend::thread_pool))
+    {
+    REQUIRE( get_mp_backend() == mp_backend::thread_pool );
+    
+    check_ops();
+    }
+  
+  set_mp_backend(orig_backend);
+  
+  REQUIRE( get_mp_backend() == orig_backend );
+  }
+
+
+
+TEST_CASE("mp_backend_2")
+  {
+  const mp_backend::type orig_backend = get_mp_backend();
+  
+  // executor that runs the tasks in reverse order on the calling thread
+  
+  uword n_calls = 0;
+  
+  set_mp_executor( [&n_calls](uword n_tasks, const std::function<void(uword)>& task)
+    {
+    ++n_calls;
+    
+    for(uword i=n_tasks; i > 0; --i)  { task(i-1); }
+    },
+    4 );
+  
+  if(arma_config::mp)
+    {
+    REQUIRE( get_mp_backend() == mp_backend::executor );
+    
+    check_ops();
+    
+    REQUIRE( n_calls > 0 );
+    }
+  
+  set_mp_executor(mp_executor_type());
+  
+  REQUIRE( get_mp_backend() != mp_backend::executor );
+  
+  set_mp_backend(orig_backend);
+  }
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+TEST_CASE("mp_gate_1")
+  {
+  const uword orig_threshold = get_mp_threshold();
+  const uword orig_threads   = get_mp_threads();
+  
+  set_mp_threshold(100);
+  set_mp_threads(3);
+  
+  REQUIRE( get_mp_threshold() == uword(100) );
+  REQUIRE( get_mp_threads()   == uword(3)   );
+  
+  set_mp_threshold(0);
+  set_mp_threads(0);
+  
+  REQUIRE( get_mp_threshold() == uword(arma_config::mp_threshold) );
+  REQUIRE( get_mp_threads()   == uword(arma_config::mp_threads)   );
+  
+  const uword n_elem = calibrate_mp_threshold();
+  
+  REQUIRE( n_elem >= uword(1) );
+  REQUIRE( get_mp_threshold() == n_elem );
+  
+  set_mp_threshold(orig_threshold);
+  set_mp_threads(orig_threads);
+  }
+
+
+
+TEST_CASE("mp_gate_2")
+  {
+  // cheap operations need more elements than expensive ones
+  
+  const uword cost_plus = mp_expr_cost< eOp<mat, eop_scalar_plus> >::value;
+  const uword cost_exp  = mp_expr_cost< eOp<mat, eop_exp>         >::value;
+  const uword cost_pow  = mp_expr_cost< eOp<mat, eop_pow>         >::value;
+  
+  REQUIRE( cost_plus < cost_exp );
+  REQUIRE( cost_exp  < cost_pow );
+  
+  const uword cost_expr = mp_expr_cost< eGlue< eOp<mat, eop_exp>, mat, eglue_div > >::value;
+  const uword cost_div  = eglue_div::mp_cost;
+  
+  REQUIRE( cost_expr == (cost_exp + cost_div) );
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    if(omp_get_max_threads() > 1)
+      {
+      const uword thresh = get_mp_threshold();
+      
+      REQUIRE( mp_gate<double>::eval(thresh, eop_exp::mp_cost) == (eop_exp::mp_cost >= mp_state::cost_ref) );
+      
+      REQUIRE( mp_gate<double>::eval(thresh,   eop_scalar_plus::mp_cost) == false );
+      REQUIRE( mp_gate<double>::eval(thresh/2, eop_pow::mp_cost)         == true  );
+      }
+    }
+  #endif
+  }
+
+
+
+TEST_CASE("mp_gate_3")
+  {
+  // results must not depend on whether the operations were parallelised
+  
+  const uword orig_threshold = get_mp_threshold();
+  
+  mat A = randu<mat>(53, 37);
+  mat B = randu<mat>(53, 37);
+  
+  const mat X1 = exp(A) + B;
+  const mat Y1 = 2.0*A + B/3.0;
+  const mat Z1 = pow(A, 3.0);
+  
+  const double s1 = accu(exp(A));
+  
+  set_mp_threshold(1);
+  
+  const mat X2 = exp(A) + B;
+  const mat Y2 = 2.0*A + B/3.0;
+  const mat Z2 = pow(A, 3.0);
+  
+  const double s2 = accu(exp(A));
+  
+  set_mp_threshold(orig_threshold);
+  
+  REQUIRE( approx_equal(X1, X2, "reldiff", 1e-14) );
+  REQUIRE( approx_equal(Y1, Y2, "reldiff", 1e-14) );
+  REQUIRE( approx_equal(Z1, Z2, "reldiff", 1e-14) );
+  
+  REQUIRE( s1 == Approx(s2) );
+  
+  for(uword i=0; i < A.n_elem; ++i)
+    {
+    REQUIRE( Y2[i] == Approx(2.0*A[i] + B[i]/3.0) );
+    }
+  }
@@ -2310,6 +2310,71 @@ TEST_CASE("spmat_batch_insert_unsorted_test")
 
 
 
+// Batch insertion from triplets, with duplicate locations, checked against a dense matrix.
+TEST_CASE("spmat_batch_insert_triplets_test")
+  {
+  const uword orig_threshold = get_mp_threshold();
+
+  for (uword pass = 0; pass < 2; ++pass)
+    {
+    set_mp_threshold( (pass == 0) ? (uword(1) << 24) : uword(1) );
+
+    // few columns, so that some columns are long
+    const uword n_rows = 500;
+    const uword n_cols = 40;
+    const uword N      = 20000;
+
+    const uvec rows = randi<uvec>(N, distr_param(0, int(n_rows - 1)));
+    const uvec cols = randi<uvec>(N, distr_param(0, int(n_cols - 1)));
+    const vec  vals = round(randu<vec>(N) * 4.0);  // some zeros
+
+    mat D(n_rows, n_cols, fill::zeros);
+
+    for (uword i = 0; i < N; ++i)  { D(rows(i), cols(i)) += vals(i); }
+
+    const umat locations = join_cols(rows.t(), cols.t());
+
+    const sp_mat A(true, locations, vals, n_rows, n_cols);
+    const sp_mat B(true, rows, cols, vals, n_rows, n_cols);
+
+    REQUIRE( approx_equal(mat(A), D, "absdiff", 1e-10) );
+    REQUIRE( approx_equal(mat(B), D, "absdiff", 1e-10) );
+
+    REQUIRE( A.n_nonzero == B.n_nonzero );
+
+    // the row indices are sorted within each column
+    bool sorted = true;
+
+    for (uword c = 0; c < B.n_cols; ++c)
+    for (uword k = B.col_ptrs[c] + 1; k < B.col_ptrs[c+1]; ++k)
+      {
+      sorted = sorted && (B.row_indices[k-1] < B.row_indices[k]);
+      }
+
+    REQUIRE( sorted );
+
+    // unique locations without adding
+    const uvec u_rows = { 3, 0, 7, 2 };
+    const uvec u_cols = { 1, 1, 0, 4 };
+    const vec  u_vals = { 1.0, 2.0, 0.0, 4.0 };
+
+    const sp_mat C(false, u_rows, u_cols, u_vals, 8, 5);
+
+    REQUIRE( C.n_nonzero == 3 );
+    REQUIRE( (double) C(3, 1) == Approx(1.0) );
+    REQUIRE( (double) C(0, 1) == Approx(2.0) );
+    REQUIRE( (double) C(2, 4) == Approx(4.0) );
+
+    const sp_mat E(false, u_rows, u_cols, u_vals, 8, 5, true, false);
+
+    REQUIRE( E.n_nonzero == 4 );
+    }
+
+  set_mp_threshold(orig_threshold);
+  }
+
+
+
 TEST_CASE("spmat_batch_insert_empty_test")
   {
   Mat<uword> locations(2, 0);
@@ -3190,3 +3255,177 @@ TEST_CASE("spmat_vectorise_dimension_alias")
     REQUIRE(m(i) == Approx(n(i)));
     }
   }
+
+
+
+// Element writes with many insertions, updates and erasures, checked against a dense matrix.
+TEST_CASE("spmat_element_cache")
+  {
+  const uword n_rows = 300;
+  const uword n_cols = 200;
+
+  sp_mat A(n_rows, n_cols);
+  mat    B(n_rows, n_cols, fill::zeros);
+
+  const uvec rows = randi<uvec>(20000, distr_param(0, int(n_rows - 1)));
+  const uvec cols = randi<uvec>(20000, distr_param(0, int(n_cols - 1)));
+  const ivec vals = randi<ivec>(20000, distr_param(-3, 3));
+
+  for (uword i = 0; i < rows.n_elem; ++i)
+    {
+    const uword r = rows(i);
+    const uword c = cols(i);
+    const double v = double(vals(i));
+
+    // plain assignments erase elements when v is zero
+    switch (i % 3)
+      {
+      case 0:  A(r, c)  = v;  B(r, c)  = v;  break;
+      case 1:  A(r, c) += v;  B(r, c) += v;  break;
+      default: A(r, c) -= v;  B(r, c) -= v;  break;
+      }
+
+    // interleave reads of the CSC representation
+    if ((i % 997) == 0)
+      {
+      REQUIRE( A.n_nonzero == uword(accu(B != 0.0)) );
+      }
+    }
+
+  REQUIRE( approx_equal(mat(A), B, "absdiff", 0.0) );
+  REQUIRE( A.n_nonzero == uword(accu(B != 0.0)) );
+
+  // sparse writes into a large synchronised matrix are inserted directly
+  sp_mat C = sprandu<sp_mat>(2000, 1000, 0.01);
+  mat    D(C);
+
+  for (uword i = 0; i < 40; ++i)
+    {
+    C(i * 37, i * 11) = double(i + 1);
+    D(i * 37, i * 11) = double(i + 1);
+
+    REQUIRE( accu(C) == Approx(accu(D)) );
+    }
+
+  REQUIRE( approx_equal(mat(C), D, "absdiff", 0.0) );
+  }
+
+
+
+TEST_CASE("spmat_assembler")
+  {
+  const uword n_rows  = 400;
+  const uword n_cols  = 300;
+  const uword n_parts = 8;
+  const uword n_per   = 5000;
+
+  sp_mat A = sprandu<sp_mat>(n_rows, n_cols, 0.01);
+  mat    B(A);
+
+  const uvec rows = randi<uvec>(n_parts * n_per, distr_param(0, int(n_rows - 1)));
+  const uvec cols = randi<uvec>(n_parts * n_per, distr_param(0, int(n_cols - 1)));
+  const ivec vals = randi<ivec>(n_parts * n_per, distr_param(-3, 3));
+
+  for (uword i = 0; i < vals.n_elem; ++i)
+    {
+    B(rows(i), cols(i)) += double(vals(i));
+    }
+
+  const uword old_threshold = get_mp_threshold();
+
+  set_mp_threshold(1);
+
+    {
+    sp_assembler<double> asmb(A);
+
+    uvec n_added(n_parts, fill::zeros);
+
+    parallel_for(n_parts, 1, [&](const uword part)
+      {
+      sp_assembler<double>::handle h = asmb.get_handle();
+
+      h.reserve(n_per);
+
+      for (uword i = part * n_per; i < (part + 1) * n_per; ++i)
+        {
+        h.add(rows(i), cols(i), double(vals(i)));
+        }
+
+      n_added(part) = h.n_added();
+      });
+
+    asmb.finalise();
+
+    REQUIRE( all(n_added == n_per) );
+    REQUIRE( approx_equal(mat(A), B, "absdiff", 1e-12) );
+    REQUIRE( A.n_nonzero == uword(accu(B != 0.0)) );
+
+    // concurrent reads of the synchronised result
+    uvec ok(n_parts, fill::zeros);
+
+    parallel_for(n_parts, 1, [&](const uword part)
+      {
+      const sp_mat& CA = A;
+
+      bool part_ok = true;
+
+      for (uword c = part; c < n_cols; c += n_parts)
+      for (uword r = 0; r < n_rows; ++r)
+        {
+        part_ok = part_ok && (std::abs(CA.at(r, c) - B(r, c)) < 1e-12);
+        }
+
+      double sum = 0.0;
+
+      for (sp_mat::const_iterator it = CA.begin(); it != CA.end(); ++it)  { sum += (*it); }
+
+      part_ok = part_ok && (std::abs(sum - accu(B)) < 1e-8);
+
+      ok(part) = part_ok ? 1 : 0;
+      });
+
+    REQUIRE( all(ok == 1) );
+    }
+
+  // the destructor finalises
+    {
+    sp_mat C(10, 10);
+
+      {
+      sp_assembler<double> asmb(C);
+
+      sp_assembler<double>::handle h1 = asmb.get_handle();
+      sp_assembler<double>::handle h2 = asmb.get_handle();
+
+      h1.add(1, 2, 1.0);
+      h2.add(1, 2, 2.0);
+      h2.add(9, 9, 3.0);
+      h1.add(9, 9, -3.0);
+      }
+
+    REQUIRE( C.n_nonzero == 1 );
+    REQUIRE( C(1, 2) == Approx(3.0) );
+    }
+
+  // elements written to the target during assembly are kept
+    {
+    sp_mat D(10, 10);
+
+    sp_assembler<double> asmb(D);
+
+    sp_assembler<double>::handle h = asmb.get_handle();
+
+    h.add(3, 4, 1.0);
+
+    D(3, 4) = 5.0;
+    D(0, 0) = 2.0;
+
+    asmb.finalise();
+
+    REQUIRE( D.n_nonzero == 2 );
+    REQUIRE( D(3, 4) == Approx(6.0) );
+    REQUIRE( D(0, 0) == Approx(2.0) );
+    }
+
+  set_mp_threshold(old_threshold);
+  }
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("spmat_csr_1")
+  {
+  sp_mat A = sprandu<sp_mat>(300, 200, 0.05);
+
+  A.row(17).zeros();  // empty row
+
+  mat Ad(A);
+
+  sp_mat_csr B(A);
+
+  REQUIRE( B.n_rows    == A.n_rows    );
+  REQUIRE( B.n_cols    == A.n_cols    );
+  REQUIRE( B.n_nonzero == A.n_nonzero );
+
+  // storage layout
+  bool layout_ok = (B.row_ptrs[0] == 0) && (B.row_ptrs[B.n_rows] == B.n_nonzero);
+
+  for (uword r = 0; r < B.n_rows; ++r)
+  for (uword i = B.row_ptrs[r]; i < B.row_ptrs[r+1]; ++i)
+    {
+    layout_ok = layout_ok && (B.values[i] == Ad(r, B.col_indices[i]));
+
+    if (i > B.row_ptrs[r])  { layout_ok = layout_ok && (B.col_indices[i-1] < B.col_indices[i]); }
+    }
+
+  REQUIRE( layout_ok );
+
+  // iterators visit the elements in row-major order
+  uword count = 0;
+  uword last  = 0;
+  bool  it_ok = true;
+
+  for (sp_mat_csr::const_iterator it = B.begin(); it != B.end(); ++it)
+    {
+    const uword lin = it.row() * B.n_cols + it.col();
+
+    it_ok = it_ok && ((count == 0) || (lin > last)) && ((*it) == Ad(it.row(), it.col()));
+
+    last = lin;
+    ++count;
+    }
+
+  REQUIRE( it_ok );
+  REQUIRE( count == A.n_nonzero );
+
+  REQUIRE( (B.begin_row(17) == B.end_row(17)) );
+
+  count = 0;
+  for (sp_mat_csr::const_iterator it = B.begin_row(5); it != B.end_row(5); ++it)  { REQUIRE( it.row() == 5 ); ++count; }
+  REQUIRE( count == uword(accu(Ad.row(5) != 0.0)) );
+
+  // element access and row views
+  REQUIRE( B(3, 4) == Ad(3, 4) );
+  REQUIRE_THROWS( B.rows(290, 300) );
+
+  sp_mat_csr C = B.rows(10, 29);
+
+  REQUIRE( C.n_rows == 20 );
+  REQUIRE( approx_equal(mat(sp_mat(C)), Ad.rows(10, 29), "absdiff", 0.0) );
+  REQUIRE( approx_equal(mat(sp_mat(B.row(5))), Ad.row(5), "absdiff", 0.0) );
+
+  // conversions
+  REQUIRE( approx_equal(mat(sp_mat(B)), Ad, "absdiff", 0.0) );
+  REQUIRE( approx_equal(mat(B.st()), mat(Ad.t()), "absdiff", 0.0) );
+
+  sp_mat D = A.t();
+  const double* D_values = D.values;
+
+  sp_mat_csr E;
+  E.steal_st(D);
+
+  REQUIRE( E.values == D_values );  // no copy
+  REQUIRE( approx_equal(mat(sp_mat(E)), Ad, "absdiff", 0.0) );
+  }
+
+
+
+TEST_CASE("spmat_csr_2")
+  {
+  sp_mat A = sprandu<sp_mat>(600, 400, 0.02);
+  mat    Ad(A);
+
+  const sp_mat_csr B(A);
+
+  const uword old_threshold = get_mp_threshold();
+
+  for (uword pass = 0; pass < 2; ++pass)
+    {
+    set_mp_threshold( (pass == 0) ? old_threshold : uword(1) );
+
+    vec x = randu<vec>(400);
+    mat X = randu<mat>(400, 7);
+    mat Y = randu<mat>(5, 600);
+
+    REQUIRE( approx_equal(vec(B * x), vec(Ad * x), "reldiff", 1e-12) );
+    REQUIRE( approx_equal(mat(B * X), mat(Ad * X), "reldiff", 1e-12) );
+    REQUIRE( approx_equal(mat(Y * B), mat(Y * Ad), "reldiff", 1e-12) );
+
+    // the CSC path with several threads goes through the CSR kernel
+    REQUIRE( approx_equal(mat(A * X), mat(Ad * X), "reldiff", 1e-12) );
+
+    REQUIRE_THROWS( B * randu<vec>(401) );
+    }
+
+  set_mp_threshold(old_threshold);
+
+  REQUIRE( approx_equal(mat(sum(B, 0)),  mat(sum(Ad, 0)),  "reldiff", 1e-12) );
+  REQUIRE( approx_equal(mat(sum(B, 1)),  mat(sum(Ad, 1)),  "reldiff", 1e-12) );
+  REQUIRE( approx_equal(mat(mean(B, 0)), mat(mean(Ad, 0)), "reldiff", 1e-12) );
+  REQUIRE( approx_equal(mat(mean(B, 1)), mat(mean(Ad, 1)), "reldiff", 1e-12) );
+
+  REQUIRE( approx_equal(mat(sum(A, 1)),  mat(sum(Ad, 1)),  "reldiff", 1e-12) );
+  REQUIRE( approx_equal(mat(mean(A, 1)), mat(mean(Ad, 1)), "reldiff", 1e-12) );
+
+  for (uword p = 1; p <= 3; ++p)
+    {
+    REQUIRE( approx_equal(mat(sp_mat(normalise(B, p, 1))), mat(normalise(Ad, p, 1)), "absdiff", 1e-12) );
+    REQUIRE( approx_equal(mat(sp_mat(normalise(B, p, 0))), mat(normalise(Ad, p, 0)), "absdiff", 1e-12) );
+    REQUIRE( approx_equal(mat(normalise(A, p, 1)), mat(normalise(Ad, p, 1)), "absdiff", 1e-12) );
+    }
+
+  // tiny values take the careful route
+  sp_mat T = A * 1e-200;
+  REQUIRE( approx_equal(mat(normalise(T, 2, 1)), mat(normalise(Ad, 2, 1)), "absdiff", 1e-12) );
+
+  // complex elements
+  sp_cx_mat  Z = sp_cx_mat(A, sprandu<sp_mat>(600, 400, 0.02));
+  sp_cx_mat_csr Zr(Z);
+  cx_vec     z = randu<cx_vec>(400);
+
+  REQUIRE( approx_equal(cx_vec(Zr * z), cx_vec(cx_mat(Z) * z), "reldiff", 1e-12) );
+  REQUIRE( approx_equal(cx_mat(sp_cx_mat(normalise(Zr, 2, 1))), normalise(cx_mat(Z), 2, 1), "absdiff", 1e-12) );
+  }
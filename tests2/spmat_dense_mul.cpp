@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+// sparse-dense products are checked against the dense product;
+// the parallel paths are exercised by lowering the threshold for parallelisation
+
+template<typename eT>
+static
+bool
+check_products(const SpMat<eT>& A, const Mat<eT>& B)
+  {
+  typedef typename get_pod_type<eT>::result T;
+  
+  const Mat<eT> A_dense(A);
+  
+  const Mat<eT> C1 = A * B;
+  const Mat<eT> D1 = A_dense * B;
+  
+  const Mat<eT> C2 = B.st() * A.st();
+  const Mat<eT> D2 = B.st() * A_dense.st();
+  
+  return approx_equal(C1, D1, "absdiff", T(1e-10)) && approx_equal(C2, D2, "absdiff", T(1e-10));
+  }
+
+
+
+TEST_CASE("spmat_dense_mul_1")
+  {
+  const uword orig_threshold = get_mp_threshold();
+  
+  for(uword pass=0; pass < 2; ++pass)
+    {
+    set_mp_threshold( (pass == 0) ? (uword(1) << 24) : uword(1) );
+    
+    // a varying number of columns in the dense operand exercises the column tiles and their tails
+    const uword n_cols[] = { 0, 1, 3, 4, 17 };
+    
+    for(uword i=0; i < 5; ++i)
+      {
+      sp_mat A = sprandu<sp_mat>(1100, 300, 0.02);
+      
+      A.rows(100, 200).zeros();
+      A.cols(20,   40).zeros();
+      
+      REQUIRE( check_products(A, mat(randu<mat>(300, n_cols[i]))) );
+      }
+    
+    // few rows, and many rows (the result spans several row blocks)
+    REQUIRE( check_products(sp_mat(sprandu<sp_mat>(   3, 500, 0.1  )), mat(randu<mat>(500, 40))) );
+    REQUIRE( check_products(sp_mat(sprandu<sp_mat>(5000,  60, 0.01 )), mat(randu<mat>( 60,  9))) );
+    
+    REQUIRE( check_products(sp_mat(200, 100), mat(randu<mat>(100, 5))) );
+    
+    REQUIRE( check_products(sp_cx_mat(sprandu<sp_cx_mat>(400, 150, 0.05)), cx_mat(randu<cx_mat>(150, 7))) );
+    }
+  
+  set_mp_threshold(orig_threshold);
+  }
+
+
+
+TEST_CASE("spmat_dense_mul_vec")
+  {
+  // matrix-vector products, including symmetric matrices as used by eigs_sym()
+  const uword orig_threshold = get_mp_threshold();
+  
+  for(uword pass=0; pass < 2; ++pass)
+    {
+    set_mp_threshold( (pass == 0) ? (uword(1) << 24) : uword(1) );
+    
+    sp_mat A = sprandu<sp_mat>(9000, 700, 0.01);
+    
+    A.cols(100, 300).zeros();
+    
+    const vec x = randu<vec>(700);
+    
+    REQUIRE( approx_equal(vec(A * x), vec(mat(A) * x), "absdiff", 1e-10) );
+    
+    sp_mat S = sprandu<sp_mat>(3000, 3000, 0.002);
+    
+    S = S + S.t();
+    
+    const vec z = randu<vec>(3000);
+    
+    REQUIRE( approx_equal(vec(S * z),     vec(mat(S) * z), "absdiff", 1e-10) );
+    REQUIRE( approx_equal(vec(S.t() * z), vec(mat(S) * z), "absdiff", 1e-10) );
+    }
+  
+  set_mp_threshold(orig_threshold);
+  }
+
+
+
+TEST_CASE("spmat_dense_mul_2")
+  {
+  // mixed element types
+  const uword orig_threshold = get_mp_threshold();
+  
+  set_mp_threshold(1);
+  
+  sp_mat A = sprandu<sp_mat>(300, 120, 0.05);
+  cx_mat B = randu<cx_mat>(120, 6);
+  cx_mat C = randu<cx_mat>(5, 300);
+  
+  const cx_mat X = A * B;
+  const cx_mat Y = C * A;
+  
+  set_mp_threshold(orig_threshold);
+  
+  const cx_mat A_cx = conv_to<cx_mat>::from(mat(A));
+  
+  REQUIRE( approx_equal(X, cx_mat(A_cx * B), "absdiff", 1e-10) );
+  REQUIRE( approx_equal(Y, cx_mat(C * A_cx), "absdiff", 1e-10) );
+  }
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2026 Conrad Sanderson (http://conradsanderson.id.au)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+// the sparse product is checked against the dense product;
+// the parallel path is exercised by lowering the threshold for parallelisation
+
+template<typename eT>
+static
+bool
+check_product(const SpMat<eT>& A, const SpMat<eT>& B)
+  {
+  typedef typename get_pod_type<eT>::result T;
+  
+  const SpMat<eT> C = A * B;
+  
+  const Mat<eT> D = Mat<eT>(A) * Mat<eT>(B);
+  
+  if( (C.n_rows != D.n_rows) || (C.n_cols != D.n_cols) )  { return false; }
+  
+  // no explicit zeros, and the row indices are sorted within each column
+  for(uword j=0; j < C.n_cols; ++j)
+  for(uword k=C.col_ptrs[j]; k < C.col_ptrs[j+1]; ++k)
+    {
+    if(C.values[k] == eT(0))  { return false; }
+    
+    if( (k > C.col_ptrs[j]) && (C.row_indices[k-1] >= C.row_indices[k]) )  { return false; }
+    }
+  
+  return approx_equal(Mat<eT>(C), D, "absdiff", T(1e-10));
+  }
+
+
+
+TEST_CASE("spmat_mul_1")
+  {
+  const uword orig_threshold = get_mp_threshold();
+  
+  for(uword pass=0; pass < 2; ++pass)
+    {
+    set_mp_threshold( (pass == 0) ? (uword(1) << 24) : uword(1) );
+    
+    sp_mat A = sprandu<sp_mat>(300, 200, 0.05);
+    sp_mat B = sprandu<sp_mat>(200, 250, 0.05);
+    
+    REQUIRE( check_product(A, B) );
+    
+    // empty columns and rows
+    A.cols(10, 40).zeros();
+    B.rows(50, 90).zeros();
+    B.cols(200, 249).zeros();
+    
+    REQUIRE( check_product(A, B) );
+    
+    // very sparse, with many rows (uses the hash based accumulator)
+    sp_mat E = sprandu<sp_mat>(50000, 100, 0.001);
+    sp_mat F = sprandu<sp_mat>(100, 80, 0.05);
+    
+    REQUIRE( check_product(E, F) );
+    
+    sp_cx_mat G = sprandu<sp_cx_mat>(120, 90, 0.1);
+    sp_cx_mat H = sprandu<sp_cx_mat>(90, 70, 0.1);
+    
+    REQUIRE( check_product(G, H) );
+    }
+  
+  set_mp_threshold(orig_threshold);
+  }
+
+
+
+TEST_CASE("spmat_mul_2")
+  {
+  // elements which cancel out are not stored
+  sp_mat A(4, 2);
+  sp_mat B(2, 3);
+  
+  A(0,0) = 1.0;  A(0,1) = 1.0;
+  A(2,0) = 2.0;  A(2,1) = 3.0;
+  A(3,1) = 5.0;
+  
+  B(0,0) = 1.0;  B(1,0) = -1.0;
+  B(0,2) = 2.0;  B(1,2) = 4.0;
+  
+  const uword orig_threshold = get_mp_threshold();
+  
+  set_mp_threshold(1);
+  
+  const sp_mat C = A * B;
+  
+  set_mp_threshold(orig_threshold);
+  
+  REQUIRE( C.n_nonzero == 5 );
+  
+  REQUIRE( C(0,0) == Approx( 0.0) );
+  REQUIRE( C(2,0) == Approx(-1.0) );
+  REQUIRE( C(3,0) == Approx(-5.0) );
+  REQUIRE( C(0,2) == Approx( 6.0) );
+  REQUIRE( C(2,2) == Approx(16.0) );
+  REQUIRE( C(3,2) == Approx(20.0) );
+  
+  REQUIRE( check_product(A, B) );
+  }